@@ -11,10 +11,17 @@
 #include <memory>
 #include <string>
 #include <iostream>
+#include <type_traits>
 
 #include "JobQueue.h"
+#include "BoundedJobQueue.h"
+#include "PriorityJobQueue.h"
+#include "DequeuePolicy.h"
+#include "WaitStrategy.h"
 #include "Commons.h"
 #include "ThreadWrapper.h"
+#include "CpuTopology.h"
+#include "../measuring/TraceScope.h"
 
 
 
@@ -31,21 +38,27 @@ namespace utils::aot
      *  sequentially, one-by-one.
      *
      * @tparam R        Return value type of task
+     * @tparam Queue    Queue policy: the thread-safe queue of tasks,
+     *                  either the JobQueue (default), the lock-free BoundedJobQueue,
+     *                  or the PriorityJobQueue - with the priority lanes and deadlines
      *
      */
-    template <typename R = void>
+    template <typename R = void, typename Queue = JobQueue<R>>
     class AOThread final
     {
 
         public:
 
-            using task_queue_t = JobQueue<R>;
+            using task_queue_t = Queue;
 
             AOThread(std::string name
-                    , utils::thread::ThreadWrapper::schedule_t policy
-                    , utils::thread::ThreadWrapper::priority_t priority):
-                m_pJobQueue (std::make_unique<task_queue_t>()),
-                m_pJobThread(utils::thread::make_thread_ptr(&AOThread::threadFunc, this))
+                    , utils::ThreadWrapper::schedule_policy_t policy
+                    , utils::ThreadWrapper::priority_t priority
+                    , dequeue_policy_t dequeuePolicy = dequeue_policy_t::single
+                    , utils::WaitStrategy waitStrategy = utils::WaitStrategy::blocking()):
+                m_dequeuePolicy(dequeuePolicy),
+                m_pJobQueue (makeQueue(waitStrategy)),
+                m_pJobThread(utils::make_thread_ptr(&AOThread::threadFunc, this))
 
             {
                start(name, policy, priority);
@@ -75,10 +88,109 @@ namespace utils::aot
                return m_pJobQueue->enqueue(std::move(job));//thread-safe task queue
             }
 
+            /**
+             * Enqueue the batch of tasks, signaling the thread only once
+             *
+             * @param jobs  The range of tasks to be enqueued
+             * @return      The futures, in the same order as the tasks
+             */
+            template <typename Range>
+            auto enqueue_bulk(Range&& jobs) noexcept
+                requires requires (task_queue_t& queue) { queue.enqueue_bulk(std::forward<Range>(jobs)); }
+            {
+               return m_pJobQueue->enqueue_bulk(std::forward<Range>(jobs));
+            }
+
+            /**
+             * Enqueue the task, without blocking - for the bounded queue policies
+             *
+             * @param job   The task to be enqueued
+             * @return      The future, or none-value in case that the queue is full (back-pressure).
+             *              The job is not consumed in that case
+             */
+            auto try_enqueue(utils::aot::job_t<R>&& job) noexcept
+                requires requires (task_queue_t& queue) { queue.try_enqueue(std::move(job)); }
+            {
+               return m_pJobQueue->try_enqueue(std::move(job));
+            }
+
+            /**
+             * Enqueue the task into the given priority lane - for the priority queue policies
+             *
+             * @param job       The task to be enqueued
+             * @param priority  The priority lane
+             * @return          The future, for waiting on result, if any
+             */
+            template <typename Priority>
+            auto enqueue(utils::aot::job_t<R>&& job, Priority priority) noexcept
+                requires requires (task_queue_t& queue) { queue.enqueue(std::move(job), priority); }
+            {
+               return m_pJobQueue->enqueue(std::move(job), priority);
+            }
+
+            /**
+             * Enqueue the task that should be executed by the given deadline,
+             * in EDF order - for the priority queue policies
+             *
+             * @param deadline  The point in time by which the task should be executed
+             * @param job       The task to be enqueued
+             * @return          The future, for waiting on result, if any
+             */
+            template <typename Deadline>
+            auto enqueue_by(Deadline deadline, utils::aot::job_t<R>&& job) noexcept
+                requires requires (task_queue_t& queue) { queue.enqueue_by(deadline, std::move(job)); }
+            {
+               return m_pJobQueue->enqueue_by(deadline, std::move(job));
+            }
+
+            /**
+             * Pin the background thread to the given CPUs, i.e: to the same cache domain
+             * as the producer thread, @see CpuTopology::sharingCache
+             *
+             * @param cpus  The CPU list
+             * @return      Indication of the operation outcome: true on success
+             */
+            bool setAffinity(const std::vector<int>& cpus) noexcept
+            {
+                return m_pJobThread && utils::setAffinity(m_pJobThread->native_handle(), cpus);
+            }
+
+            /**
+             * Snapshot of the queue depth, enqueue-to-start latency, execution time and throughput.
+             * Available for the queue policies that keep the metrics, and only when built
+             * with AOT_ENABLE_METRICS - otherwise, empty snapshot.
+             *
+             * @return The metrics snapshot
+             */
+            metrics::Snapshot metrics() const noexcept
+            {
+                if constexpr (requires (const task_queue_t& queue) { queue.metrics(); })
+                {
+                    return m_pJobQueue->metrics().snapshot();
+                }
+                else
+                {
+                    return {};
+                }
+            }
+
         private:
 
+            // The wait strategy is applied only for the queue policies that support it
+            static std::unique_ptr<task_queue_t> makeQueue([[maybe_unused]] utils::WaitStrategy waitStrategy)
+            {
+                if constexpr (std::is_constructible_v<task_queue_t, utils::WaitStrategy>)
+                {
+                    return std::make_unique<task_queue_t>(waitStrategy);
+                }
+                else
+                {
+                    return std::make_unique<task_queue_t>();
+                }
+            }
+
             void start(std::string name
-                    , utils::thread::ThreadWrapper::schedule_t policy
+                    , utils::ThreadWrapper::schedule_policy_t policy
                     , int priority) noexcept
             {
                 if (m_pJobThread)
@@ -107,17 +219,63 @@ namespace utils::aot
 
         private:
 
+            const dequeue_policy_t m_dequeuePolicy;
             std::unique_ptr<task_queue_t> m_pJobQueue = nullptr;
-            utils::thread::thread_ptr_t m_pJobThread = nullptr;
+            utils::thread_ptr_t m_pJobThread = nullptr;
     };
 
-    template <typename R>
-    void AOThread<R>::threadFunc() noexcept
+    template <typename R, typename Queue>
+    void AOThread<R, Queue>::threadFunc() noexcept
     {
         using namespace std;
 
+        constexpr bool drainable = requires (task_queue_t& queue) { queue.dequeue_all(); };
+
+        // Execute the job, measuring it with the queue metrics - if any
+        const auto execute = [this](auto& job)
+        {
+            TRACE_SCOPE("AOThread::job");
+
+            if constexpr (requires (task_queue_t& queue) { queue.metrics(); })
+            {
+                m_pJobQueue->metrics().execute(job);
+            }
+            else
+            {
+                job();
+            }
+        };
+
         for(;;)
         {
+            if constexpr (drainable)
+            {
+                if (dequeue_policy_t::drain == m_dequeuePolicy)
+                {
+                    // Suspend thread, until the queue is empty or exit is not signaled
+                    auto jobs = m_pJobQueue->dequeue_all();
+
+                    if (!jobs) //exit signaled
+                    {
+                        break;
+                    }
+
+                    // Execute the batch without touching the queue lock
+                    for (; !jobs->empty(); jobs->pop())
+                    {
+                        try
+                        {
+                            execute(jobs->front());
+                        }
+                        catch(const std::bad_function_call& e)
+                        {
+                            //todo: add logging policy
+                            return;
+                        }
+                    }
+                    continue;
+                }
+            }
 
             // Suspend thread, until the queue is empty or exit is not signaled
             auto job = m_pJobQueue->dequeue();
@@ -130,7 +288,7 @@ namespace utils::aot
 
             try
             {
-                (*job)();
+                execute(*job);
             }
             catch(const std::bad_function_call& e)
             {
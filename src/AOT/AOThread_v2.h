@@ -16,6 +16,20 @@
 #include <memory>
 #include <iostream>
 #include <type_traits>
+#include <functional>
+#include <vector>
+#include <ranges>
+#include <cstddef>
+#include <utility>
+#include <new>
+
+#include "DequeuePolicy.h"
+#include "FunctionWrapper.h"
+#include "JobMetrics.h"
+#include "WaitStrategy.h"
+#include "CpuTopology.h"
+#include "Future.h"
+#include "../measuring/TraceScope.h"
 
 namespace utils::aot
 {
@@ -49,70 +63,6 @@ namespace utils::aot
         );
     }
 
-    /**
-     * Type Erasure
-     * For wrapping the only copy-constructible callable objects
-     * into movable object, since std::packaged_task is move-only
-     * The solution is taken from "Concurrency in action" Anthony Williams
-     */
-    class FunctionWrapper final
-    {
-        struct FunctionWrapperBase
-        {
-            virtual ~FunctionWrapperBase() = default;
-            virtual void call() = 0;
-        };
-
-        template <typename Func>
-        struct FunctionWrapperBaseImpl final : FunctionWrapperBase
-        {
-                FunctionWrapperBaseImpl(Func&& func):
-                    m_func(std::move(func))
-                {}
-                ~FunctionWrapperBaseImpl() override = default;
-
-                void call() override
-                {
-                    m_func();
-                }
-
-            private:
-                Func m_func;
-        };
-
-        public:
-            template <typename Func>
-            FunctionWrapper(Func&& func):
-                m_pFunctionWrapper(std::make_unique<FunctionWrapperBaseImpl<Func>>(std::move(func)))
-            {}
-
-            FunctionWrapper() = default;
-            ~FunctionWrapper() = default;
-
-            FunctionWrapper(FunctionWrapper&& other) : m_pFunctionWrapper(std::move(other.m_pFunctionWrapper))
-            {}
-            FunctionWrapper& operator=(FunctionWrapper&& other)
-            {
-                m_pFunctionWrapper = std::move(other.m_pFunctionWrapper);
-                return *this;
-            }
-
-            // Copy-functions are forbidden
-
-            FunctionWrapper(const FunctionWrapper&) = delete;
-            FunctionWrapper& operator=(const FunctionWrapper&) = delete;
-
-            void operator ()()
-            {
-                m_pFunctionWrapper->call();
-            }
-
-        private:
-            std::unique_ptr<FunctionWrapperBase> m_pFunctionWrapper = nullptr;
-
-    };
-
-
     /**
      * AOT thread design pattern - heterogeneous version
      * More flexible version which allows handling the heterogeneous jobs
@@ -124,6 +74,20 @@ namespace utils::aot
 
 
             AOThread() = default;
+
+            /**
+             * C-tor
+             *
+             * @param policy        The way how the jobs are dequeued: one-by-one, or
+             *                      the whole pending queue at once
+             * @param waitStrategy  The way how the thread waits on the jobs: spinning, before being parked
+             */
+            explicit AOThread(dequeue_policy_t policy
+                    , utils::WaitStrategy waitStrategy = utils::WaitStrategy::blocking()) noexcept :
+                m_dequeuePolicy(policy),
+                m_waitStrategy(waitStrategy)
+            {}
+
             ~AOThread()
             {
                 /*
@@ -147,12 +111,13 @@ namespace utils::aot
                 using result_t = invoke_result_t<Func>;
                 using task_t = packaged_task<result_t()>;
 
-                task_t task {FunctionWrapper(move(func))};
+                task_t task {std::forward<Func>(func)};
                 auto f = task.get_future();
 
                 {
                     lock_guard<std::mutex> lock {m_lock};
                     m_jobs.push(move(task));
+                    onEnqueue();
                 }
 
                 m_condition.notify_one();
@@ -160,6 +125,27 @@ namespace utils::aot
                 return f;
             }
 
+            /**
+             * Enqueue the job, without the means to synchronize on its outcome.
+             * The callable object is stored directly into the queue - there is
+             * no std::packaged_task shared state to be allocated.
+             *
+             * @note The job should not throw: there is no future to propagate the exception to
+             *
+             * @param func  The job to enqueue
+             */
+            template <typename Func>
+            void post(Func&& func)
+            {
+                {
+                    std::lock_guard<std::mutex> lock {m_lock};
+                    m_jobs.emplace(std::forward<Func>(func));
+                    onEnqueue();
+                }
+
+                m_condition.notify_one();
+            }
+
             template <typename Func, typename...Args>
             auto emplace_enqueue(Func&& func, Args&&...args)
             {
@@ -175,6 +161,7 @@ namespace utils::aot
                 {
                     lock_guard<mutex> lock {m_lock};
                     m_jobs.push(move(task));
+                    onEnqueue();
                 }
 
                 m_condition.notify_one();
@@ -183,6 +170,96 @@ namespace utils::aot
 
             }
 
+            /**
+             * Enqueue the job, returning the future which supports continuations
+             * @see Future::then
+             *
+             * @param func  The job to enqueue
+             * @return      The future of the job result
+             */
+            template <typename Func>
+            auto submit(Func&& func)
+            {
+                using result_t = std::invoke_result_t<Func>;
+
+                Promise<result_t> promise;
+                auto future = promise.get_future();
+
+                post([func = std::forward<Func>(func), promise = std::move(promise)]() mutable
+                {
+                    try
+                    {
+                        if constexpr (std::is_void_v<result_t>)
+                        {
+                            func();
+                            promise.set_value();
+                        }
+                        else
+                        {
+                            promise.set_value(func());
+                        }
+                    }
+                    catch (...)
+                    {
+                        promise.set_exception(std::current_exception());
+                    }
+                });
+
+                return future;
+            }
+
+            /**
+             * Enqueue the batch of jobs.
+             * The lock is taken, and the background thread signaled only once per batch.
+             *
+             * @param funcs The range of callable objects
+             * @return      The futures, in the same order as the jobs in the range
+             */
+            template <std::ranges::input_range Range>
+            auto enqueue_bulk(Range&& funcs)
+            {
+                using namespace std;
+
+                using func_t = ranges::range_value_t<Range>;
+                using result_t = invoke_result_t<func_t&>;
+                using task_t = packaged_task<result_t()>;
+
+                vector<future<result_t>> results;
+                vector<FunctionWrapper> tasks;
+                if constexpr (ranges::sized_range<Range>)
+                {
+                    results.reserve(ranges::size(funcs));
+                    tasks.reserve(ranges::size(funcs));
+                }
+
+                // Wrap the jobs outside of the critical section
+                for (auto&& func : funcs)
+                {
+                    task_t task = [&]() -> task_t {
+                        if constexpr (is_lvalue_reference_v<Range>) return task_t{func};
+                        else return task_t{std::move(func)};
+                    }();
+                    results.push_back(task.get_future());
+                    tasks.emplace_back(move(task));
+                }
+
+                if (tasks.empty()) return results;
+
+                {
+                    lock_guard<mutex> lock {m_lock};
+                    for (auto& task : tasks)
+                    {
+                        m_jobs.push(move(task));
+                        m_stamps.push();
+                    }
+                    m_metrics.onEnqueue(tasks.size());
+                }
+
+                m_condition.notify_one();
+
+                return results;
+            }
+
             bool start()
             {
                 try
@@ -210,41 +287,105 @@ namespace utils::aot
                 m_pThread.reset(nullptr); // wait on thread to join
             }
 
+            /**
+             * Pin the background thread to the given CPUs, once it's started
+             * @see CpuTopology
+             *
+             * @param cpus  The CPU list
+             * @return      Indication of the operation outcome: true on success
+             */
+            bool setAffinity(const std::vector<int>& cpus) noexcept
+            {
+                return m_pThread && utils::setAffinity(m_pThread->native_handle(), cpus);
+            }
+
+            /**
+             * @return The snapshot of the queue and execution metrics,
+             * empty unless AOT_ENABLE_METRICS is defined
+             */
+            metrics::Snapshot metrics() const noexcept
+            {
+                return m_metrics.snapshot();
+            }
+
         private:
 
             void dequeue()
             {
                 using namespace std;
 
+                queue<FunctionWrapper> jobs; // drained batch: reused between the iterations
+
                 for(;;)
                 {
                     FunctionWrapper job;
 
                     {
                         unique_lock<std::mutex> lock {m_lock};
-                        m_condition.wait(lock, [this]{ return m_stopThread || !m_jobs.empty();});
+                        m_waitStrategy.wait(m_condition, lock, [this]{ return m_stopThread || !m_jobs.empty();});
 
                         if (m_stopThread) break;
 
-                        job = move(m_jobs.front());
-                        m_jobs.pop();
+                        if (dequeue_policy_t::drain == m_dequeuePolicy)
+                        {
+                            jobs.swap(m_jobs); // take all pending jobs at once
+                            for (auto n = jobs.size(); n > 0; --n)
+                            {
+                                m_metrics.onDequeue(m_stamps.pop_front());
+                            }
+                        }
+                        else
+                        {
+                            job = move(m_jobs.front());
+                            m_jobs.pop();
+                            m_metrics.onDequeue(m_stamps.pop_front());
+                        }
                     }
 
-                    try
-                    {
-                        job();
-                    }
-                    catch (const bad_function_call& e)
+                    if (job) execute(job);
+
+                    for (; !jobs.empty(); jobs.pop())
                     {
-                        cerr << e.what() << '\n';
-                        //throw; // rethrow
+                        execute(jobs.front());
                     }
                 }
             }
 
+            void execute(FunctionWrapper& job) noexcept
+            {
+                using namespace std;
+
+                TRACE_SCOPE("AOThread::job");
+
+                try
+                {
+                    m_metrics.execute(job);
+                }
+                catch (const bad_function_call& e)
+                {
+                    cerr << e.what() << '\n';
+                    //throw; // rethrow
+                }
+                catch (const exception& e) // posted job
+                {
+                    cerr << e.what() << '\n';
+                }
+            }
+
+        private:
+
+            // Under the lock
+            void onEnqueue()
+            {
+                m_stamps.push();
+                m_metrics.onEnqueue();
+            }
+
         private:
 
             bool m_stopThread = false;
+            const dequeue_policy_t m_dequeuePolicy = dequeue_policy_t::single;
+            const utils::WaitStrategy m_waitStrategy {};
             
            // @note: Order of declaration is important!
         
@@ -253,6 +394,9 @@ namespace utils::aot
         
             std::queue<FunctionWrapper> m_jobs;
 
+            [[no_unique_address]] metrics::metrics_t m_metrics {};
+            [[no_unique_address]] metrics::metrics_t::stamps_t m_stamps {};
+
             thread_with_deleter_t<std::thread> m_pThread = nullptr;
            
     };
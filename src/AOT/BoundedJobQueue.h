@@ -0,0 +1,226 @@
+/*
+ * BoundedJobQueue.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef AOT_BOUNDEDJOBQUEUE_H_
+#define AOT_BOUNDEDJOBQUEUE_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <thread>
+
+#include "JobQueue.h"
+
+namespace utils::aot
+{
+    /**
+     *  Bounded lock-free queue of the jobs, with multiple producers and single consumer.
+     *
+     *  Alternative queue policy for AOThread, instead of the JobQueue.
+     *  Based on the D. Vyukov bounded queue, with the per-slot sequence numbers:
+     *  producers compete for the slot only through the single atomic (CAS) operation.
+     *  The consumer (AOThread) is parked (atomic wait) only when the queue is empty.
+     *
+     *  @see AOThread
+     *
+     *  @tparam R           Callable object return type
+     *  @tparam Capacity    Maximum number of the pending jobs, power of 2
+     */
+    template <typename R, std::size_t Capacity = 1024>
+    class BoundedJobQueue final
+    {
+            static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2!");
+
+        public:
+
+            using value_type = job_t<R>;
+
+            BoundedJobQueue() noexcept
+            {
+                for (std::size_t i = 0; i < Capacity; ++i)
+                {
+                    m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            ~BoundedJobQueue() = default;
+
+            // Copy operations discarded
+
+            BoundedJobQueue(const BoundedJobQueue&) = delete;
+            BoundedJobQueue& operator = (const BoundedJobQueue&) = delete;
+
+            /**
+             * Enqueue the task, without blocking.
+             *
+             * @param job   The callable object to enqueue
+             * @return      The result of the task, or none-value in case that the queue is full:
+             *              the job is not touched (moved from) in that case, and can be re-enqueued later
+             */
+            std::optional<std::future<R>> try_enqueue(value_type&& job) noexcept
+            {
+                auto* slot = claim();
+                if (!slot) return {}; // back-pressure
+
+                auto result = job.get_future();
+                publish(*slot, std::move(job));
+
+                return result;
+            }
+
+            /**
+             * Enqueue the task.
+             * In case that the queue is full, it will wait (yield) until
+             * the consumer frees the slot.
+             *
+             * @param job   The callable object to enqueue
+             * @return      The result of the task, if any
+             */
+            std::future<R> enqueue(value_type&& job) noexcept
+            {
+                Slot* slot = nullptr;
+                while (nullptr == (slot = claim()))
+                {
+                    std::this_thread::yield();
+                }
+
+                auto result = job.get_future();
+                publish(*slot, std::move(job));
+
+                return result;
+            }
+
+            /**
+             * Dequeue the job from the queue.
+             * It will park the consumer thread, only when the queue is empty
+             *
+             * @return  The task to be executed, or none-value in case that stop is signaled
+             */
+            std::optional<value_type> dequeue() noexcept
+            {
+                for (;;)
+                {
+                    if (m_stopDequeuing.load(std::memory_order_acquire)) return {};
+
+                    if (auto job = pop()) return job;
+
+                    // Announce the parking, and re-check: prevents the lost wake-up
+                    const auto signal = m_signal.load(std::memory_order_acquire);
+                    m_parked.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if (!empty() || m_stopDequeuing.load(std::memory_order_acquire))
+                    {
+                        m_parked.store(false, std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    m_signal.wait(signal, std::memory_order_acquire);
+                    m_parked.store(false, std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * Force stopping dequeuing
+             */
+            void stop() noexcept
+            {
+                m_stopDequeuing.store(true, std::memory_order_release);
+                wakeUp();
+            }
+
+            bool empty() const noexcept
+            {
+                const auto& slot = m_slots[m_dequeuePos & (Capacity - 1)];
+                return slot.m_sequence.load(std::memory_order_acquire) != m_dequeuePos + 1;
+            }
+
+            static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+        private:
+
+            struct alignas(64) Slot
+            {
+                std::atomic<std::size_t> m_sequence;
+                std::optional<value_type> m_job;
+            };
+
+            Slot* claim() noexcept
+            {
+                auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    auto& slot = m_slots[pos & (Capacity - 1)];
+                    const auto seq = slot.m_sequence.load(std::memory_order_acquire);
+                    const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+                    if (0 == diff)
+                    {
+                        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        {
+                            return &slot;
+                        }
+                    }
+                    else if (diff < 0) // full
+                    {
+                        return nullptr;
+                    }
+                    else
+                    {
+                        pos = m_enqueuePos.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            void publish(Slot& slot, value_type&& job) noexcept
+            {
+                const auto pos = slot.m_sequence.load(std::memory_order_relaxed);
+
+                slot.m_job.emplace(std::move(job));
+                slot.m_sequence.store(pos + 1, std::memory_order_release);
+
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (m_parked.load(std::memory_order_relaxed)) wakeUp();
+            }
+
+            // Single consumer: the dequeue position is not shared
+            std::optional<value_type> pop() noexcept
+            {
+                auto& slot = m_slots[m_dequeuePos & (Capacity - 1)];
+                if (slot.m_sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) return {};
+
+                std::optional<value_type> job = std::move(slot.m_job);
+                slot.m_job.reset();
+
+                slot.m_sequence.store(m_dequeuePos + Capacity, std::memory_order_release);
+                ++m_dequeuePos;
+
+                return job;
+            }
+
+            void wakeUp() noexcept
+            {
+                m_signal.fetch_add(1, std::memory_order_release);
+                m_signal.notify_one();
+            }
+
+        private:
+
+            std::array<Slot, Capacity> m_slots;
+
+            alignas(64) std::atomic<std::size_t> m_enqueuePos {0};
+            alignas(64) std::size_t m_dequeuePos = 0;
+
+            std::atomic<bool> m_parked {false};
+            std::atomic<std::uint32_t> m_signal {0};
+            std::atomic<bool> m_stopDequeuing {false};
+    };
+}
+
+
+#endif /* AOT_BOUNDEDJOBQUEUE_H_ */
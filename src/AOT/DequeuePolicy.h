@@ -0,0 +1,28 @@
+/*
+ * DequeuePolicy.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef AOT_DEQUEUEPOLICY_H_
+#define AOT_DEQUEUEPOLICY_H_
+
+#include <cstdint>
+
+namespace utils::aot
+{
+    /**
+     * The way how the AOT thread drains the jobs queue
+     *
+     * - single: one job is taken from the queue at the time (lock per job)
+     * - drain:  the whole pending queue is swapped out under single lock, and
+     *           jobs are executed afterwards, without touching the lock
+     */
+    using dequeue_policy_t = enum class EDequeuePolicy : std::uint8_t
+    {
+          single = 0
+        , drain
+    };
+}
+
+#endif /* AOT_DEQUEUEPOLICY_H_ */
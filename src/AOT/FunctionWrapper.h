@@ -0,0 +1,177 @@
+/*
+ * FunctionWrapper.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef DS_AOT_FUNCTIONWRAPPER_H_
+#define DS_AOT_FUNCTIONWRAPPER_H_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace utils::aot
+{
+    /**
+     * Type Erasure
+     * For wrapping the only copy-constructible callable objects
+     * into movable object, since std::packaged_task is move-only
+     * The solution is taken from "Concurrency in action" Anthony Williams
+     *
+     * Small-buffer optimization: callable object that fits into inline storage
+     * (along with the vtable pointer), and is nothrow-movable, is constructed in place.
+     * Only the larger ones are allocated on the heap.
+     *
+     * @tparam Capacity The size of the inline storage, in bytes
+     */
+    template <std::size_t Capacity = 64>
+    class BasicFunctionWrapper final
+    {
+        struct FunctionWrapperBase
+        {
+            virtual ~FunctionWrapperBase() = default;
+            virtual void call() = 0;
+            virtual FunctionWrapperBase* moveTo(void* storage) noexcept = 0;
+        };
+
+        template <typename Func>
+        struct FunctionWrapperBaseImpl final : FunctionWrapperBase
+        {
+                template <typename F>
+                explicit FunctionWrapperBaseImpl(F&& func):
+                    m_func(std::forward<F>(func))
+                {}
+                ~FunctionWrapperBaseImpl() override = default;
+
+                void call() override
+                {
+                    m_func();
+                }
+
+                // Move into the inline storage of another wrapper
+                FunctionWrapperBase* moveTo(void* storage) noexcept override
+                {
+                    if constexpr (is_inline<Func>)
+                    {
+                        return ::new (storage) FunctionWrapperBaseImpl(std::move(m_func));
+                    }
+                    else // heap-allocated: ownership is transferred by pointer
+                    {
+                        return nullptr;
+                    }
+                }
+
+            private:
+                Func m_func;
+        };
+
+        template <typename Func>
+        static constexpr bool is_inline = sizeof(FunctionWrapperBaseImpl<Func>) <= Capacity
+                                       && alignof(FunctionWrapperBaseImpl<Func>) <= alignof(std::max_align_t)
+                                       && std::is_nothrow_move_constructible_v<Func>;
+
+        public:
+
+            template <typename Func
+                    , typename = std::enable_if_t<!std::is_same_v<std::decay_t<Func>, BasicFunctionWrapper>>>
+            BasicFunctionWrapper(Func&& func)
+            {
+                using impl_t = FunctionWrapperBaseImpl<std::decay_t<Func>>;
+
+                if constexpr (is_inline<std::decay_t<Func>>)
+                {
+                    m_pFunctionWrapper = ::new (static_cast<void*>(m_storage)) impl_t(std::forward<Func>(func));
+                }
+                else
+                {
+                    m_pFunctionWrapper = new impl_t(std::forward<Func>(func));
+                }
+            }
+
+            BasicFunctionWrapper() = default;
+            ~BasicFunctionWrapper()
+            {
+                reset();
+            }
+
+            BasicFunctionWrapper(BasicFunctionWrapper&& other) noexcept
+            {
+                moveFrom(other);
+            }
+            BasicFunctionWrapper& operator=(BasicFunctionWrapper&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    moveFrom(other);
+                }
+                return *this;
+            }
+
+            // Copy-functions are forbidden
+
+            BasicFunctionWrapper(const BasicFunctionWrapper&) = delete;
+            BasicFunctionWrapper& operator=(const BasicFunctionWrapper&) = delete;
+
+            void operator ()()
+            {
+                if (!m_pFunctionWrapper) throw std::bad_function_call();
+                m_pFunctionWrapper->call();
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return nullptr != m_pFunctionWrapper;
+            }
+
+        private:
+
+            bool isInline() const noexcept
+            {
+                return static_cast<const void*>(m_pFunctionWrapper) == static_cast<const void*>(m_storage);
+            }
+
+            void moveFrom(BasicFunctionWrapper& other) noexcept
+            {
+                if (!other.m_pFunctionWrapper) return;
+
+                if (other.isInline())
+                {
+                    m_pFunctionWrapper = other.m_pFunctionWrapper->moveTo(m_storage);
+                    other.reset();
+                }
+                else
+                {
+                    m_pFunctionWrapper = std::exchange(other.m_pFunctionWrapper, nullptr);
+                }
+            }
+
+            void reset() noexcept
+            {
+                if (!m_pFunctionWrapper) return;
+
+                if (isInline())
+                {
+                    m_pFunctionWrapper->~FunctionWrapperBase();
+                }
+                else
+                {
+                    delete m_pFunctionWrapper;
+                }
+                m_pFunctionWrapper = nullptr;
+            }
+
+        private:
+
+            FunctionWrapperBase* m_pFunctionWrapper = nullptr;
+            alignas(std::max_align_t) std::byte m_storage[Capacity];
+
+    };
+
+    using FunctionWrapper = BasicFunctionWrapper<>;
+}
+
+#endif /* DS_AOT_FUNCTIONWRAPPER_H_ */
@@ -0,0 +1,608 @@
+/*
+ * Future.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef DS_AOT_FUTURE_H_
+#define DS_AOT_FUTURE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "FunctionWrapper.h"
+
+namespace utils::aot
+{
+    template <typename T> class Future;
+    template <typename T> class Promise;
+
+    namespace details
+    {
+        template <typename T> struct FutureAwaiter; // @see Task.h
+    }
+
+    /**
+     * Executor: the execution context (AOThread, ThreadPool) into which
+     * the continuation will be posted
+     */
+    template <typename Executor>
+    concept executor = requires (Executor& executor) { executor.post([]{}); };
+
+    /**
+     * Executes the continuation in place: within the context of the thread
+     * that fulfilled the promise
+     */
+    struct InlineExecutor
+    {
+        template <typename Func>
+        void post(Func&& func) const
+        {
+            std::forward<Func>(func)();
+        }
+    };
+
+    namespace details
+    {
+        template <typename T>
+        using storage_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        /**
+         * Shared state between the promise and the future.
+         * Holds either the value, or the exception - and at most
+         * one continuation to be invoked once the state gets ready
+         */
+        template <typename T>
+        struct SharedState
+        {
+            using value_type = storage_t<T>;
+
+            template <typename...Args>
+            void setValue(Args&&...args)
+            {
+                FunctionWrapper continuation;
+                {
+                    std::lock_guard<std::mutex> lock {m_lock};
+                    if (m_ready) throw std::future_error(std::future_errc::promise_already_satisfied);
+
+                    m_value.emplace(std::forward<Args>(args)...);
+                    m_ready = true;
+                    continuation = std::move(m_continuation);
+                }
+                m_condition.notify_all();
+
+                if (continuation) continuation();
+            }
+
+            void setException(std::exception_ptr error)
+            {
+                FunctionWrapper continuation;
+                {
+                    std::lock_guard<std::mutex> lock {m_lock};
+                    if (m_ready) throw std::future_error(std::future_errc::promise_already_satisfied);
+
+                    m_error = std::move(error);
+                    m_ready = true;
+                    continuation = std::move(m_continuation);
+                }
+                m_condition.notify_all();
+
+                if (continuation) continuation();
+            }
+
+            /*
+             * Register the continuation.
+             * If the state is already ready, its invoked immediately, in the caller context
+             */
+            void setContinuation(FunctionWrapper&& continuation)
+            {
+                {
+                    std::lock_guard<std::mutex> lock {m_lock};
+                    if (!m_ready)
+                    {
+                        m_continuation = std::move(continuation);
+                        return;
+                    }
+                }
+                continuation();
+            }
+
+            void wait()
+            {
+                std::unique_lock<std::mutex> lock {m_lock};
+                m_condition.wait(lock, [this]{ return m_ready; });
+            }
+
+            bool isReady()
+            {
+                std::lock_guard<std::mutex> lock {m_lock};
+                return m_ready;
+            }
+
+            // Only once the state is ready
+            value_type take()
+            {
+                if (m_error) std::rethrow_exception(m_error);
+                return std::move(*m_value);
+            }
+
+            std::mutex m_lock;
+            std::condition_variable m_condition;
+
+            bool m_ready = false;
+            std::optional<value_type> m_value;
+            std::exception_ptr m_error;
+
+            FunctionWrapper m_continuation;
+        };
+
+        template <typename T>
+        using shared_state_ptr = std::shared_ptr<SharedState<T>>;
+    }
+
+
+    /**
+     * The producer side of the asynchronous result
+     *
+     * @tparam T    The result type
+     */
+    template <typename T>
+    class Promise final
+    {
+        public:
+
+            Promise() : m_pState(std::make_shared<details::SharedState<T>>())
+            {}
+
+            ~Promise()
+            {
+                if (m_pState && !m_pState->isReady())
+                {
+                    m_pState->setException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+                }
+            }
+
+            Promise(Promise&&) noexcept = default;
+            Promise& operator = (Promise&& other) noexcept
+            {
+                Promise tmp {std::move(other)};
+                std::swap(m_pState, tmp.m_pState);
+                std::swap(m_retrieved, tmp.m_retrieved); // together with the state it tells about
+                return *this;
+            }
+
+            Promise(const Promise&) = delete;
+            Promise& operator = (const Promise&) = delete;
+
+            Future<T> get_future()
+            {
+                if (m_retrieved) throw std::future_error(std::future_errc::future_already_retrieved);
+                m_retrieved = true;
+                return Future<T>{m_pState};
+            }
+
+            template <typename...Args>
+            requires (std::is_void_v<T> && sizeof...(Args) == 0) || std::is_constructible_v<details::storage_t<T>, Args...>
+            void set_value(Args&&...args)
+            {
+                m_pState->setValue(std::forward<Args>(args)...);
+            }
+
+            void set_exception(std::exception_ptr error)
+            {
+                m_pState->setException(std::move(error));
+            }
+
+        private:
+
+            details::shared_state_ptr<T> m_pState;
+            bool m_retrieved = false;
+    };
+
+
+    /**
+     * The consumer side of the asynchronous result.
+     *
+     * Unlike the std::future, allows chaining the continuations that will be
+     * scheduled onto the given executor once the result gets ready, without
+     * blocking any thread in between.
+     *
+     * @tparam T    The result type
+     */
+    template <typename T>
+    class Future final
+    {
+        public:
+
+            using value_type = T;
+
+            Future() = default;
+
+            Future(Future&&) noexcept = default;
+            Future& operator = (Future&&) noexcept = default;
+
+            Future(const Future&) = delete;
+            Future& operator = (const Future&) = delete;
+
+            bool valid() const noexcept { return nullptr != m_pState; }
+
+            bool is_ready() const
+            {
+                return m_pState && m_pState->isReady();
+            }
+
+            void wait() const
+            {
+                m_pState->wait();
+            }
+
+            /**
+             * Blocking call: wait on result being ready.
+             * @note Invalidates the future
+             */
+            T get()
+            {
+                auto state = std::move(m_pState);
+                state->wait();
+
+                if constexpr (std::is_void_v<T>)
+                {
+                    (void)state->take();
+                }
+                else
+                {
+                    return state->take();
+                }
+            }
+
+            /**
+             * Attach the continuation.
+             * Once the result is ready, the continuation will be posted to the executor,
+             * taking the result as argument (none, for void).
+             * In case of the exception, the continuation is skipped: the exception
+             * is propagated to the resulting future.
+             *
+             * @note Invalidates the future
+             *
+             * @param exec  The execution context of the continuation
+             * @param func  The continuation
+             * @return      The future of the continuation result
+             */
+            template <executor Executor, typename Func>
+            auto then(Executor& exec, Func&& func)
+            {
+                using result_t = typename continuation_result<Func>::type;
+
+                Promise<result_t> promise;
+                auto future = promise.get_future();
+
+                auto state = std::move(m_pState);
+                auto* pState = state.get();
+
+                pState->setContinuation(
+                    [&exec, state = std::move(state), func = std::forward<Func>(func), promise = std::move(promise)]() mutable
+                    {
+                        exec.post([state = std::move(state), func = std::move(func), promise = std::move(promise)]() mutable
+                        {
+                            try
+                            {
+                                if constexpr (std::is_void_v<T>)
+                                {
+                                    (void)state->take();
+                                    fulfill(promise, func);
+                                }
+                                else
+                                {
+                                    fulfill(promise, func, state->take());
+                                }
+                            }
+                            catch (...)
+                            {
+                                promise.set_exception(std::current_exception());
+                            }
+                        });
+                    });
+
+                return future;
+            }
+
+            /**
+             * Attach the continuation that will be executed inline,
+             * within the context of the thread which fulfilled the promise
+             */
+            template <typename Func>
+            auto then(Func&& func)
+            {
+                return then(s_inlineExecutor, std::forward<Func>(func));
+            }
+
+        private:
+
+            template <typename U> friend class Promise;
+            template <typename U> friend class Future;
+            template <typename U> friend struct details::FutureAwaiter;
+
+            template <typename U>
+            friend auto when_all(std::vector<Future<U>> futures) -> Future<std::conditional_t<std::is_void_v<U>, void, std::vector<U>>>;
+
+            template <typename U>
+            friend auto when_any(std::vector<Future<U>> futures) -> Future<std::conditional_t<std::is_void_v<U>, std::size_t, std::pair<std::size_t, U>>>;
+
+            template <typename...Ts>
+            friend Future<std::tuple<Ts...>> when_all(Future<Ts>&&...futures);
+
+            explicit Future(details::shared_state_ptr<T> state) noexcept : m_pState(std::move(state))
+            {}
+
+            template <typename Func>
+            struct continuation_result
+            {
+                using type = std::invoke_result_t<std::decay_t<Func>&, T>;
+            };
+
+            template <typename Func>
+            requires std::is_void_v<T>
+            struct continuation_result<Func>
+            {
+                using type = std::invoke_result_t<std::decay_t<Func>&>;
+            };
+
+            template <typename R, typename Func, typename...Args>
+            static void fulfill(Promise<R>& promise, Func& func, Args&&...args)
+            {
+                if constexpr (std::is_void_v<R>)
+                {
+                    std::invoke(func, std::forward<Args>(args)...);
+                    promise.set_value();
+                }
+                else
+                {
+                    promise.set_value(std::invoke(func, std::forward<Args>(args)...));
+                }
+            }
+
+            // Inline registration: invoked once the state is ready, with the state itself
+            template <typename Func>
+            void onReady(Func&& func)
+            {
+                auto state = std::move(m_pState);
+                auto* pState = state.get();
+                pState->setContinuation([state = std::move(state), func = std::forward<Func>(func)]() mutable
+                {
+                    func(*state);
+                });
+            }
+
+        private:
+
+            inline static InlineExecutor s_inlineExecutor {};
+
+            details::shared_state_ptr<T> m_pState;
+    };
+
+
+    /**
+     * Create the future which is already ready
+     */
+    template <typename T, typename...Args>
+    Future<T> make_ready_future(Args&&...args)
+    {
+        Promise<T> promise;
+        auto future = promise.get_future();
+        promise.set_value(std::forward<Args>(args)...);
+        return future;
+    }
+
+
+    /**
+     * Create the future which has already failed
+     */
+    template <typename T>
+    Future<T> make_exceptional_future(std::exception_ptr error)
+    {
+        Promise<T> promise;
+        auto future = promise.get_future();
+        promise.set_exception(std::move(error));
+        return future;
+    }
+
+
+    /**
+     * Future which gets ready once all the given futures are ready.
+     * The first exception (if any) is propagated.
+     *
+     * @param futures   The futures to wait on: they are invalidated
+     * @return          The future of the all results, in the same order
+     */
+    template <typename T>
+    auto when_all(std::vector<Future<T>> futures) -> Future<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>
+    {
+        using result_t = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+        struct Context
+        {
+            explicit Context(std::size_t n) : m_pending(n), m_values(n) {}
+
+            std::atomic<std::size_t> m_pending;
+            std::vector<std::optional<details::storage_t<T>>> m_values;
+            std::exception_ptr m_error;
+            std::once_flag m_errorOnce;
+            Promise<result_t> m_promise;
+        };
+
+        const auto n = futures.size();
+        auto context = std::make_shared<Context>(n);
+        auto result = context->m_promise.get_future();
+
+        if (0 == n)
+        {
+            if constexpr (std::is_void_v<T>) context->m_promise.set_value();
+            else context->m_promise.set_value(result_t{});
+            return result;
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            futures[i].onReady([context, i](details::SharedState<T>& state)
+            {
+                try
+                {
+                    context->m_values[i].emplace(state.take());
+                }
+                catch (...)
+                {
+                    auto error = std::current_exception();
+                    std::call_once(context->m_errorOnce, [&]{ context->m_error = error; });
+                }
+
+                if (1 != context->m_pending.fetch_sub(1, std::memory_order_acq_rel)) return;
+
+                // The last one: fulfill the promise
+                if (context->m_error)
+                {
+                    context->m_promise.set_exception(context->m_error);
+                }
+                else if constexpr (std::is_void_v<T>)
+                {
+                    context->m_promise.set_value();
+                }
+                else
+                {
+                    std::vector<T> values;
+                    values.reserve(context->m_values.size());
+                    for (auto& value : context->m_values) values.push_back(std::move(*value));
+                    context->m_promise.set_value(std::move(values));
+                }
+            });
+        }
+
+        return result;
+    }
+
+    /**
+     * Heterogeneous version of the when_all
+     *
+     * @param futures   The futures to wait on: they are invalidated
+     * @return          The future of the all results, as tuple
+     */
+    template <typename...Ts>
+    Future<std::tuple<Ts...>> when_all(Future<Ts>&&...futures)
+    {
+        static_assert((!std::is_void_v<Ts> && ...), "Use homogeneous when_all for the void futures!");
+
+        struct Context
+        {
+            std::atomic<std::size_t> m_pending {sizeof...(Ts)};
+            std::tuple<std::optional<Ts>...> m_values;
+            std::exception_ptr m_error;
+            std::once_flag m_errorOnce;
+            Promise<std::tuple<Ts...>> m_promise;
+
+            void complete()
+            {
+                if (1 != m_pending.fetch_sub(1, std::memory_order_acq_rel)) return;
+
+                if (m_error)
+                {
+                    m_promise.set_exception(m_error);
+                    return;
+                }
+                m_promise.set_value(std::apply([](auto&...values) { return std::tuple<Ts...>{std::move(*values)...}; }
+                                    , m_values));
+            }
+        };
+
+        auto context = std::make_shared<Context>();
+        auto result = context->m_promise.get_future();
+
+        auto attach = [&context]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, Future<U>& future)
+        {
+            future.onReady([context](details::SharedState<U>& state)
+            {
+                try
+                {
+                    std::get<I>(context->m_values).emplace(state.take());
+                }
+                catch (...)
+                {
+                    auto error = std::current_exception();
+                    std::call_once(context->m_errorOnce, [&]{ context->m_error = error; });
+                }
+                context->complete();
+            });
+        };
+
+        [&]<std::size_t...I>(std::index_sequence<I...>)
+        {
+            (attach(std::integral_constant<std::size_t, I>{}, futures), ...);
+        }(std::index_sequence_for<Ts...>{});
+
+        return result;
+    }
+
+    /**
+     * Future which gets ready once the first of the given futures is ready
+     *
+     * @param futures   The futures to wait on: they are invalidated
+     * @return          The future of the index of the first ready one, along with its value (if any)
+     */
+    template <typename T>
+    auto when_any(std::vector<Future<T>> futures) -> Future<std::conditional_t<std::is_void_v<T>, std::size_t, std::pair<std::size_t, T>>>
+    {
+        using result_t = std::conditional_t<std::is_void_v<T>, std::size_t, std::pair<std::size_t, T>>;
+
+        struct Context
+        {
+            std::atomic<bool> m_done {false};
+            Promise<result_t> m_promise;
+        };
+
+        auto context = std::make_shared<Context>();
+        auto result = context->m_promise.get_future();
+
+        if (futures.empty())
+        {
+            context->m_promise.set_exception(std::make_exception_ptr(std::future_error(std::future_errc::no_state)));
+            return result;
+        }
+
+        for (std::size_t i = 0; i < futures.size(); ++i)
+        {
+            futures[i].onReady([context, i](details::SharedState<T>& state)
+            {
+                if (context->m_done.exchange(true, std::memory_order_acq_rel)) return; // not the first one
+
+                try
+                {
+                    if constexpr (std::is_void_v<T>)
+                    {
+                        (void)state.take();
+                        context->m_promise.set_value(i);
+                    }
+                    else
+                    {
+                        context->m_promise.set_value(i, state.take());
+                    }
+                }
+                catch (...)
+                {
+                    context->m_promise.set_exception(std::current_exception());
+                }
+            });
+        }
+
+        return result;
+    }
+}
+
+#endif /* DS_AOT_FUTURE_H_ */
@@ -0,0 +1,305 @@
+/*
+ * JobMetrics.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef AOT_JOBMETRICS_H_
+#define AOT_JOBMETRICS_H_
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+
+#include "ElapsedTime.h"
+
+namespace utils::aot::metrics
+{
+    using clock_t = std::chrono::steady_clock;
+    using time_point_t = clock_t::time_point;
+
+    /**
+     * The histogram snapshot: copy of the bucket counters, at the point in time
+     */
+    template <std::size_t Buckets, std::size_t SubBucketBits>
+    struct HistogramSnapshot
+    {
+        std::array<std::uint64_t, Buckets> m_counts {};
+        std::uint64_t m_count = 0;
+
+        /**
+         * @param percentile    In range [0, 100]
+         * @return              The upper bound (in nanoseconds) of the bucket into which
+         *                      the given percentile of the samples falls
+         */
+        std::uint64_t percentile(double percentile) const noexcept
+        {
+            if (0 == m_count) return 0;
+
+            const auto rank = static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(m_count - 1)) + 1;
+
+            std::uint64_t total = 0;
+            for (std::size_t i = 0; i < Buckets; ++i)
+            {
+                total += m_counts[i];
+                if (total >= rank) return upperBound(i);
+            }
+            return upperBound(Buckets - 1);
+        }
+
+        static constexpr std::uint64_t upperBound(std::size_t bucket) noexcept
+        {
+            constexpr std::size_t sub = std::size_t{1} << SubBucketBits;
+            if (bucket < sub) return bucket;
+
+            const auto shift = bucket / sub - 1;
+            const auto mantissa = sub | (bucket % sub);
+            return ((mantissa + 1) << shift) - 1;
+        }
+    };
+
+    /**
+     * Lock-free histogram of durations, in nanoseconds.
+     * HDR-style: the buckets are powers of 2, each split into 2^SubBucketBits linear sub-buckets,
+     * which bounds the relative error to 1/2^SubBucketBits over the whole range.
+     *
+     * @tparam SubBucketBits    Precision: the number of linear sub-buckets per power of 2, as exponent
+     */
+    template <std::size_t SubBucketBits = 2>
+    class Histogram final
+    {
+            static constexpr std::size_t sub = std::size_t{1} << SubBucketBits;
+
+        public:
+
+            static constexpr std::size_t buckets = (64 - SubBucketBits + 1) * sub;
+            using snapshot_t = HistogramSnapshot<buckets, SubBucketBits>;
+
+            void record(std::uint64_t nanoseconds) noexcept
+            {
+                m_counts[bucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            snapshot_t snapshot() const noexcept
+            {
+                snapshot_t snapshot;
+                for (std::size_t i = 0; i < buckets; ++i)
+                {
+                    snapshot.m_counts[i] = m_counts[i].load(std::memory_order_relaxed);
+                    snapshot.m_count += snapshot.m_counts[i];
+                }
+                return snapshot;
+            }
+
+            static constexpr std::size_t bucket(std::uint64_t value) noexcept
+            {
+                if (value < sub) return static_cast<std::size_t>(value);
+
+                const auto shift = static_cast<std::size_t>(std::bit_width(value)) - SubBucketBits - 1;
+                return (shift + 1) * sub + static_cast<std::size_t>((value >> shift) & (sub - 1));
+            }
+
+        private:
+
+            std::array<std::atomic<std::uint64_t>, buckets> m_counts {};
+    };
+
+    /**
+     * Metrics snapshot: the consistent enough view of the counters - each one is read atomically
+     */
+    struct Snapshot
+    {
+        using histogram_t = Histogram<>::snapshot_t;
+
+        std::uint64_t m_enqueued = 0;
+        std::uint64_t m_executed = 0;
+        std::int64_t m_depth = 0;           // pending jobs
+        std::int64_t m_maxDepth = 0;        // the high watermark
+
+        histogram_t m_latency;              // enqueue-to-start, in nanoseconds
+        histogram_t m_execution;            // execution time, in nanoseconds
+
+        std::chrono::nanoseconds m_uptime {};
+        std::chrono::nanoseconds m_busy {}; // total execution time
+
+        double jobsPerSecond() const noexcept
+        {
+            const auto seconds = std::chrono::duration<double>(m_uptime).count();
+            return (seconds > 0) ? static_cast<double>(m_executed) / seconds : 0.0;
+        }
+
+        /**
+         * @return The share of the uptime spent executing jobs: close to 1 for the saturated worker
+         */
+        double utilization() const noexcept
+        {
+            return (m_uptime.count() > 0) ? static_cast<double>(m_busy.count()) / static_cast<double>(m_uptime.count()) : 0.0;
+        }
+    };
+
+    /**
+     * The enqueue time points of the pending jobs, kept in the same order as the jobs themselves.
+     * Not thread-safe: guarded by the same lock as the jobs queue
+     */
+    class Stamps final
+    {
+        public:
+
+            void push() { m_stamps.push_back(clock_t::now()); }
+
+            time_point_t pop_front() noexcept
+            {
+                const auto tp = m_stamps.front();
+                m_stamps.pop_front();
+                return tp;
+            }
+
+            time_point_t pop_back() noexcept
+            {
+                const auto tp = m_stamps.back();
+                m_stamps.pop_back();
+                return tp;
+            }
+
+        private:
+
+            std::deque<time_point_t> m_stamps;
+    };
+
+    /**
+     * Queue and execution metrics of the single jobs queue/worker.
+     * All counters are lock-free (relaxed atomics): producers update only the enqueue side,
+     * and the worker the dequeue and execution side.
+     */
+    class JobMetrics final
+    {
+        public:
+
+            using stamps_t = Stamps;
+
+            static constexpr bool enabled = true;
+
+            void onEnqueue(std::size_t jobs = 1) noexcept
+            {
+                m_enqueued.fetch_add(jobs, std::memory_order_relaxed);
+
+                const auto depth = m_depth.fetch_add(static_cast<std::int64_t>(jobs), std::memory_order_relaxed)
+                                    + static_cast<std::int64_t>(jobs);
+
+                auto max = m_maxDepth.load(std::memory_order_relaxed);
+                while (depth > max && !m_maxDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed));
+            }
+
+            void onDequeue(time_point_t enqueued) noexcept
+            {
+                m_depth.fetch_sub(1, std::memory_order_relaxed);
+                m_latency.record(static_cast<std::uint64_t>((clock_t::now() - enqueued).count()));
+            }
+
+            /**
+             * Executes the job, measuring its execution time
+             *
+             * @param job   The job to execute
+             */
+            template <typename Job>
+            decltype(auto) execute(Job&& job)
+            {
+                struct Scope
+                {
+                    JobMetrics& m_metrics;
+                    utils::measure::ElapsedTime<clock_t, std::chrono::nanoseconds> m_time;
+
+                    ~Scope() { m_metrics.onExecuted(static_cast<std::uint64_t>(m_time.stop())); }
+
+                } scope {*this, {}};
+
+                scope.m_time.start();
+                return std::forward<Job>(job)();
+            }
+
+            Snapshot snapshot() const noexcept
+            {
+                Snapshot snapshot;
+
+                snapshot.m_enqueued = m_enqueued.load(std::memory_order_relaxed);
+                snapshot.m_executed = m_executed.load(std::memory_order_relaxed);
+                snapshot.m_depth = m_depth.load(std::memory_order_relaxed);
+                snapshot.m_maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+                snapshot.m_latency = m_latency.snapshot();
+                snapshot.m_execution = m_execution.snapshot();
+                snapshot.m_uptime = clock_t::now() - m_created;
+                snapshot.m_busy = std::chrono::nanoseconds(m_busy.load(std::memory_order_relaxed));
+
+                return snapshot;
+            }
+
+        private:
+
+            void onExecuted(std::uint64_t nanoseconds) noexcept
+            {
+                m_executed.fetch_add(1, std::memory_order_relaxed);
+                m_busy.fetch_add(nanoseconds, std::memory_order_relaxed);
+                m_execution.record(nanoseconds);
+            }
+
+        private:
+
+            const time_point_t m_created = clock_t::now();
+
+            // Producers side
+            alignas(64) std::atomic<std::uint64_t> m_enqueued {0};
+            std::atomic<std::int64_t> m_maxDepth {0};
+
+            std::atomic<std::int64_t> m_depth {0};
+
+            // Worker side
+            alignas(64) std::atomic<std::uint64_t> m_executed {0};
+            std::atomic<std::uint64_t> m_busy {0};
+
+            Histogram<> m_latency;
+            Histogram<> m_execution;
+    };
+
+    /**
+     * Disabled metrics: the same interface as JobMetrics, compiled away
+     */
+    class NoMetrics final
+    {
+        public:
+
+            struct stamps_t
+            {
+                void push() noexcept {}
+                time_point_t pop_front() noexcept { return {}; }
+                time_point_t pop_back() noexcept { return {}; }
+            };
+
+            static constexpr bool enabled = false;
+
+            void onEnqueue(std::size_t = 1) noexcept {}
+            void onDequeue(time_point_t) noexcept {}
+
+            template <typename Job>
+            decltype(auto) execute(Job&& job)
+            {
+                return std::forward<Job>(job)();
+            }
+
+            Snapshot snapshot() const noexcept { return {}; }
+    };
+
+    /**
+     * Metrics are opt-in: build with AOT_ENABLE_METRICS defined, to enable them
+     */
+#if defined(AOT_ENABLE_METRICS)
+    using metrics_t = JobMetrics;
+#else
+    using metrics_t = NoMetrics;
+#endif
+
+}
+
+#endif /* AOT_JOBMETRICS_H_ */
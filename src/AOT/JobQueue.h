@@ -14,6 +14,11 @@
 #include <functional>
 #include <future>
 #include <optional>
+#include <vector>
+#include <ranges>
+
+#include "JobMetrics.h"
+#include "WaitStrategy.h"
 
 namespace utils::aot
 {
@@ -46,6 +51,16 @@ namespace utils::aot
             using super = job_queue_t<R>;
             using super::super;//using base class (std::queue) c-tors
 
+            JobQueue() = default;
+
+            /**
+             * C-tor
+             *
+             * @param waitStrategy  The way how the consumer waits on the jobs: spinning, before being parked
+             */
+            explicit JobQueue(utils::WaitStrategy waitStrategy) noexcept : m_waitStrategy(waitStrategy)
+            {}
+
             ~JobQueue() = default; //user-defined destructor will prevent generating default - memberwise move operations
 
             // Copy operations discarded
@@ -77,6 +92,7 @@ namespace utils::aot
                      result = job.get_future();
                      value_type task { std::bind(std::move(job), std::forward<Args>(args)...)};
                      this->push(std::move(task));
+                     onEnqueue();
                 }
 
                 m_condition.notify_one();
@@ -92,6 +108,7 @@ namespace utils::aot
 
                      result = job.get_future();
                      this->push(std::move(job));
+                     onEnqueue();
                 }
 
                 m_condition.notify_one();
@@ -99,6 +116,37 @@ namespace utils::aot
                 return result;
             }
 
+            /**
+             * Enqueue the batch of tasks.
+             * The lock is taken, and the consumer signaled only once per batch.
+             *
+             * @param jobs  The range of tasks to enqueue: the tasks are moved from
+             * @return      The results of the tasks, in the same order
+             */
+            template <std::ranges::input_range Range>
+            requires std::same_as<std::ranges::range_value_t<Range>, value_type>
+            std::vector<std::future<R>> enqueue_bulk(Range&& jobs) noexcept
+            {
+                std::vector<std::future<R>> results;
+                if constexpr (std::ranges::sized_range<Range>) results.reserve(std::ranges::size(jobs));
+
+                {
+                     std::lock_guard<std::mutex> lock {m_mutex};
+
+                     for (auto& job : jobs)
+                     {
+                         results.push_back(job.get_future());
+                         this->push(std::move(job));
+                         m_stamps.push();
+                     }
+                     m_metrics.onEnqueue(results.size());
+                }
+
+                m_condition.notify_one();
+
+                return results;
+            }
+
             /**
              * Dequeue the job from the queue.
              * This is concurrent operation to enqueue - it will block
@@ -111,30 +159,78 @@ namespace utils::aot
             {
                 std::unique_lock<std::mutex> lock {m_mutex};
 
-                m_condition.wait(lock, [this]{return !this->empty() || m_stopDequeuing;});
+                m_waitStrategy.wait(m_condition, lock, [this]{return !this->empty() || m_stopDequeuing;});
 
                 if (m_stopDequeuing) return {};
 
                 auto job = std::move(this->front());
                 this->pop();
+                m_metrics.onDequeue(m_stamps.pop_front());
 
                 return job;
             }
 
+            /**
+             * Dequeue all pending jobs at once, under single lock.
+             * Blocks the same way as dequeue()
+             *
+             * @return  The pending tasks to be executed, or none-value in case that stop is signaled
+             */
+            std::optional<super> dequeue_all() noexcept
+            {
+                std::unique_lock<std::mutex> lock {m_mutex};
+
+                m_waitStrategy.wait(m_condition, lock, [this]{return !this->empty() || m_stopDequeuing;});
+
+                if (m_stopDequeuing) return {};
+
+                super jobs;
+                jobs.swap(*this);
+
+                for (auto n = jobs.size(); n > 0; --n)
+                {
+                    m_metrics.onDequeue(m_stamps.pop_front());
+                }
+
+                return jobs;
+            }
+
             /**
              * Force stopping dequeuing
              */
             void stop() noexcept
             {
-                m_stopDequeuing = true;
+                {
+                    std::lock_guard<std::mutex> lock {m_mutex};
+                    m_stopDequeuing = true;
+                }
 
                 m_condition.notify_one();
             }
 
+            /**
+             * @return The queue metrics, no-op unless AOT_ENABLE_METRICS is defined
+             */
+            metrics::metrics_t& metrics() noexcept { return m_metrics; }
+            const metrics::metrics_t& metrics() const noexcept { return m_metrics; }
+
+
+        private:
+
+            // Under the lock
+            void onEnqueue() noexcept
+            {
+                m_stamps.push();
+                m_metrics.onEnqueue();
+            }
 
         private:
 
             bool m_stopDequeuing = false;
+            const utils::WaitStrategy m_waitStrategy {};
+
+            [[no_unique_address]] metrics::metrics_t m_metrics {};
+            [[no_unique_address]] typename metrics::metrics_t::stamps_t m_stamps {};
 
             std::mutex m_mutex {};//neither copyable, nor movable
             std::condition_variable m_condition {};//neither copyable, nor movable
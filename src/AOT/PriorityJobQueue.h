@@ -0,0 +1,260 @@
+/*
+ * PriorityJobQueue.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef AOT_PRIORITYJOBQUEUE_H_
+#define AOT_PRIORITYJOBQUEUE_H_
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <vector>
+
+#include "JobQueue.h"
+#include "WaitStrategy.h"
+
+namespace utils::aot
+{
+    /**
+     * Job priority lanes: lower value - higher priority
+     */
+    using job_priority_t = enum class EJobPriority : std::uint8_t
+    {
+        high = 0,
+        normal,
+        low
+    };
+
+    /**
+     *  Thread-safe queue of the jobs, with the priority lanes and deadlines.
+     *
+     *  Alternative queue policy for AOThread, instead of the strictly FIFO JobQueue.
+     *  The jobs with the deadline are served first, in EDF (Earliest Deadline First) order.
+     *  The rest are served by the priority lanes: FIFO within the same lane.
+     *
+     *  Starvation guard: once the non-empty lane has been bypassed StarvationLimit times
+     *  in a row, in favor of the more urgent jobs, its oldest job is served next.
+     *
+     *  @see AOThread
+     *
+     *  @tparam R                   Callable object return type
+     *  @tparam StarvationLimit     Maximum number of bypasses of the pending lane, 0 - guard disabled
+     */
+    template <typename R, std::size_t StarvationLimit = 16>
+    class PriorityJobQueue final
+    {
+        public:
+
+            using value_type = job_t<R>;
+            using clock_t = std::chrono::steady_clock;
+            using deadline_t = clock_t::time_point;
+
+            PriorityJobQueue() = default;
+
+            /**
+             * C-tor
+             *
+             * @param waitStrategy  The way how the consumer waits on the jobs: spinning, before being parked
+             */
+            explicit PriorityJobQueue(utils::WaitStrategy waitStrategy) noexcept : m_waitStrategy(waitStrategy)
+            {}
+
+            ~PriorityJobQueue() = default;
+
+            // Copy operations discarded
+
+            PriorityJobQueue(const PriorityJobQueue&) = delete;
+            PriorityJobQueue& operator = (const PriorityJobQueue&) = delete;
+
+            /**
+             * Enqueue the task into the normal priority lane
+             *
+             * @param job   The callable object to enqueue
+             * @return      The result of the task, if any
+             */
+            std::future<R> enqueue(value_type&& job) noexcept
+            {
+                return enqueue(std::move(job), job_priority_t::normal);
+            }
+
+            /**
+             * Enqueue the task into the given priority lane
+             *
+             * @param job       The callable object to enqueue
+             * @param priority  The priority lane
+             * @return          The result of the task, if any
+             */
+            std::future<R> enqueue(value_type&& job, job_priority_t priority) noexcept
+            {
+                std::future<R> result;
+                {
+                     std::lock_guard<std::mutex> lock {m_mutex};
+
+                     result = job.get_future();
+                     m_lanes[static_cast<std::size_t>(priority)].push(std::move(job));
+                }
+
+                m_condition.notify_one();
+
+                return result;
+            }
+
+            /**
+             * Enqueue the task that should be executed by the given deadline.
+             * The deadline jobs are served ahead of the priority lanes, earliest deadline first.
+             *
+             * @note The deadline is not enforced: the expired job is still executed,
+             * as soon as possible
+             *
+             * @param deadline  The point in time by which the job should be executed
+             * @param job       The callable object to enqueue
+             * @return          The result of the task, if any
+             */
+            std::future<R> enqueue_by(deadline_t deadline, value_type&& job) noexcept
+            {
+                std::future<R> result;
+                {
+                     std::lock_guard<std::mutex> lock {m_mutex};
+
+                     result = job.get_future();
+                     m_deadlines.push(Deadline{deadline, m_sequence++, std::move(job)});
+                }
+
+                m_condition.notify_one();
+
+                return result;
+            }
+
+            /**
+             * Dequeue the most urgent job from the queue.
+             * It will block until either the queue is not empty, or stop dequeuing is signaled
+             *
+             * @return  The task to be executed, or none-value in case that stop is signaled
+             */
+            std::optional<value_type> dequeue() noexcept
+            {
+                std::unique_lock<std::mutex> lock {m_mutex};
+
+                m_waitStrategy.wait(m_condition, lock, [this]{return !empty() || m_stopDequeuing;});
+
+                if (m_stopDequeuing) return {};
+
+                return next();
+            }
+
+            /**
+             * Force stopping dequeuing
+             */
+            void stop() noexcept
+            {
+                {
+                    std::lock_guard<std::mutex> lock {m_mutex};
+                    m_stopDequeuing = true;
+                }
+
+                m_condition.notify_one();
+            }
+
+        private:
+
+            static constexpr std::size_t lanes = static_cast<std::size_t>(job_priority_t::low) + 1;
+
+            struct Deadline
+            {
+                deadline_t m_deadline;
+                std::uint64_t m_sequence; // FIFO for the same deadline
+                mutable value_type m_job; // priority_queue::top() is const
+
+                // std::priority_queue is max-heap: the earliest deadline on top
+                bool operator < (const Deadline& other) const noexcept
+                {
+                    return (m_deadline != other.m_deadline) ? m_deadline > other.m_deadline
+                                                            : m_sequence > other.m_sequence;
+                }
+            };
+
+            bool empty() const noexcept
+            {
+                if (!m_deadlines.empty()) return false;
+                for (const auto& lane : m_lanes)
+                {
+                    if (!lane.empty()) return false;
+                }
+                return true;
+            }
+
+            // Under the lock, with at least one pending job
+            value_type next() noexcept
+            {
+                std::size_t lane = lanes; // deadline queue
+
+                if constexpr (StarvationLimit > 0)
+                {
+                    for (std::size_t i = lanes; i-- > 0;) // the lowest priority lane, first
+                    {
+                        if (!m_lanes[i].empty() && m_bypassed[i] >= StarvationLimit)
+                        {
+                            lane = i;
+                            break;
+                        }
+                    }
+                }
+
+                if (lane == lanes && m_deadlines.empty())
+                {
+                    lane = 0;
+                    while (m_lanes[lane].empty()) ++lane;
+                }
+
+                account(lane);
+
+                if (lane == lanes)
+                {
+                    auto job = std::move(m_deadlines.top().m_job);
+                    m_deadlines.pop();
+                    return job;
+                }
+
+                auto job = std::move(m_lanes[lane].front());
+                m_lanes[lane].pop();
+                return job;
+            }
+
+            // Count the bypass of every pending lane, except the one that is served
+            void account([[maybe_unused]] std::size_t served) noexcept
+            {
+                if constexpr (StarvationLimit > 0)
+                {
+                    for (std::size_t i = 0; i < lanes; ++i)
+                    {
+                        if (i == served || m_lanes[i].empty()) m_bypassed[i] = 0;
+                        else ++m_bypassed[i];
+                    }
+                }
+            }
+
+        private:
+
+            std::array<std::queue<value_type>, lanes> m_lanes;
+            std::priority_queue<Deadline, std::vector<Deadline>> m_deadlines;
+            std::uint64_t m_sequence = 0;
+
+            std::array<std::size_t, lanes> m_bypassed {};
+
+            bool m_stopDequeuing = false;
+            const utils::WaitStrategy m_waitStrategy {};
+
+            std::mutex m_mutex {};//neither copyable, nor movable
+            std::condition_variable m_condition {};//neither copyable, nor movable
+    };
+}
+
+
+#endif /* AOT_PRIORITYJOBQUEUE_H_ */
@@ -0,0 +1,366 @@
+/*
+ * Task.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef DS_AOT_TASK_H_
+#define DS_AOT_TASK_H_
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "Future.h"
+#include "FramePool.h"
+
+namespace utils::aot
+{
+    /**
+     * Awaitable for switching the coroutine execution context.
+     * The coroutine is resumed within the executor (AOThread, ThreadPool) thread:
+     * the only cost of the hop is single posted job - no packaged_task/future shared state.
+     *
+     * @code
+     * Task<int> pipeline(AOThread& io, ThreadPool& pool)
+     * {
+     *      co_await schedule_on(io);
+     *      auto data = read();
+     *      co_await schedule_on(pool);
+     *      co_return process(data);
+     * }
+     * @endcode
+     *
+     * @tparam Executor The execution context
+     */
+    template <typename Executor>
+    class ScheduleOn final
+    {
+        public:
+
+            explicit ScheduleOn(Executor& exec) noexcept : m_exec(exec)
+            {}
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                if constexpr (executor<Executor>)
+                {
+                    m_exec.post([handle]{ handle.resume(); });
+                }
+                else // AOThread<void>: enqueues only std::packaged_task
+                {
+                    (void)m_exec.enqueue(std::packaged_task<void()>{[handle]{ handle.resume(); }});
+                }
+            }
+
+            void await_resume() const noexcept {}
+
+        private:
+
+            Executor& m_exec;
+    };
+
+    template <typename Executor>
+    requires executor<Executor>
+        || requires (Executor& exec) { exec.enqueue(std::packaged_task<void()>{}); }
+    ScheduleOn<Executor> schedule_on(Executor& exec) noexcept
+    {
+        return ScheduleOn<Executor>{exec};
+    }
+
+    template <typename T> class Task;
+
+    namespace details
+    {
+        // The frames: @see utils::PooledFrame
+        class TaskPromiseBase : public utils::PooledFrame
+        {
+            public:
+
+                struct FinalAwaiter
+                {
+                    bool await_ready() const noexcept { return false; }
+
+                    // Symmetric transfer: resume the awaiting coroutine, without growing the stack
+                    template <typename Promise>
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+                    {
+                        const auto continuation = handle.promise().m_continuation;
+                        return continuation ? continuation : std::noop_coroutine();
+                    }
+
+                    void await_resume() const noexcept {}
+                };
+
+                std::suspend_always initial_suspend() const noexcept { return {}; } // lazy: starts once awaited
+                FinalAwaiter final_suspend() const noexcept { return {}; }
+
+                void unhandled_exception() noexcept
+                {
+                    m_error = std::current_exception();
+                }
+
+                void setContinuation(std::coroutine_handle<> continuation) noexcept
+                {
+                    m_continuation = continuation;
+                }
+
+            protected:
+
+                void rethrow() const
+                {
+                    if (m_error) std::rethrow_exception(m_error);
+                }
+
+            private:
+
+                std::coroutine_handle<> m_continuation = nullptr;
+                std::exception_ptr m_error = nullptr;
+        };
+
+        template <typename T>
+        class TaskPromise final : public TaskPromiseBase
+        {
+            public:
+
+                Task<T> get_return_object() noexcept;
+
+                template <typename U>
+                requires std::convertible_to<U&&, T>
+                void return_value(U&& value)
+                {
+                    m_value.emplace(std::forward<U>(value));
+                }
+
+                T result()
+                {
+                    rethrow();
+                    return std::move(*m_value);
+                }
+
+            private:
+
+                std::optional<T> m_value;
+        };
+
+        template <>
+        class TaskPromise<void> final : public TaskPromiseBase
+        {
+            public:
+
+                Task<void> get_return_object() noexcept;
+
+                void return_void() const noexcept {}
+
+                void result()
+                {
+                    rethrow();
+                }
+        };
+
+        /**
+         * Fire-and-forget coroutine: the frame destroys itself once completed
+         */
+        struct Detached
+        {
+            struct promise_type : utils::PooledFrame
+            {
+                Detached get_return_object() const noexcept { return {}; }
+                std::suspend_never initial_suspend() const noexcept { return {}; }
+                std::suspend_never final_suspend() const noexcept { return {}; }
+                void return_void() const noexcept {}
+                void unhandled_exception() const noexcept { std::terminate(); }
+            };
+        };
+
+        /**
+         * Awaiting on the Future: the coroutine is resumed in the context
+         * of the thread that fulfills the promise
+         */
+        template <typename T>
+        struct FutureAwaiter
+        {
+            static FutureAwaiter from(Future<T>&& future) noexcept
+            {
+                return FutureAwaiter{std::move(future.m_pState)};
+            }
+
+            shared_state_ptr<T> m_pState;
+
+            bool await_ready() const
+            {
+                return m_pState->isReady();
+            }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                // @note: If the state got ready in the meantime, the coroutine is resumed in place
+                m_pState->setContinuation([handle]{ handle.resume(); });
+            }
+
+            T await_resume()
+            {
+                auto state = std::move(m_pState);
+                if constexpr (std::is_void_v<T>)
+                {
+                    (void)state->take();
+                }
+                else
+                {
+                    return state->take();
+                }
+            }
+        };
+    }
+
+    /**
+     * Lazy coroutine that produces the single value of type T.
+     * It starts once awaited (co_await), and on completion resumes the awaiting coroutine
+     * in the context in which it's been completed.
+     * Combined with schedule_on, builds the asynchronous pipelines across the
+     * AOThreads and the ThreadPool workers.
+     *
+     * The top-level task is started with spawn(), which returns the Future of its result.
+     *
+     * @tparam T    The result type
+     */
+    template <typename T = void>
+    class [[nodiscard]] Task final
+    {
+        public:
+
+            using promise_type = details::TaskPromise<T>;
+            using handle_t = std::coroutine_handle<promise_type>;
+
+            Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr))
+            {}
+
+            Task& operator = (Task&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    if (m_handle) m_handle.destroy();
+                    m_handle = std::exchange(other.m_handle, nullptr);
+                }
+                return *this;
+            }
+
+            Task(const Task&) = delete;
+            Task& operator = (const Task&) = delete;
+
+            ~Task()
+            {
+                if (m_handle) m_handle.destroy();
+            }
+
+            auto operator co_await() && noexcept
+            {
+                struct Awaiter
+                {
+                    handle_t m_handle;
+
+                    bool await_ready() const noexcept { return !m_handle || m_handle.done(); }
+
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+                    {
+                        m_handle.promise().setContinuation(continuation);
+                        return m_handle; // start the task
+                    }
+
+                    T await_resume()
+                    {
+                        return m_handle.promise().result();
+                    }
+                };
+
+                return Awaiter{m_handle};
+            }
+
+        private:
+
+            friend promise_type;
+
+            explicit Task(handle_t handle) noexcept : m_handle(handle)
+            {}
+
+        private:
+
+            handle_t m_handle = nullptr;
+    };
+
+    namespace details
+    {
+        template <typename T>
+        Task<T> TaskPromise<T>::get_return_object() noexcept
+        {
+            return Task<T>{Task<T>::handle_t::from_promise(*this)};
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() noexcept
+        {
+            return Task<void>{Task<void>::handle_t::from_promise(*this)};
+        }
+    }
+
+    /**
+     * Awaiting on the Future, within the coroutine
+     *
+     * @note Invalidates the future
+     */
+    template <typename T>
+    details::FutureAwaiter<T> operator co_await(Future<T>&& future) noexcept
+    {
+        return details::FutureAwaiter<T>::from(std::move(future));
+    }
+
+    /**
+     * Start the top-level task: it's executed in place, until the first suspension point
+     *
+     * @param task  The task to start
+     * @return      The future of the task result
+     */
+    template <typename T>
+    Future<T> spawn(Task<T> task)
+    {
+        Promise<T> promise;
+        auto future = promise.get_future();
+
+        [](Task<T> task, Promise<T> promise) -> details::Detached
+        {
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    co_await std::move(task);
+                    promise.set_value();
+                }
+                else
+                {
+                    promise.set_value(co_await std::move(task));
+                }
+            }
+            catch (...)
+            {
+                promise.set_exception(std::current_exception());
+            }
+        }(std::move(task), std::move(promise));
+
+        return future;
+    }
+
+    /**
+     * Start the task, and block until it's completed
+     */
+    template <typename T>
+    T sync_wait(Task<T> task)
+    {
+        return spawn(std::move(task)).get();
+    }
+}
+
+#endif /* DS_AOT_TASK_H_ */
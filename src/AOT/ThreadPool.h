@@ -0,0 +1,356 @@
+/*
+ * ThreadPool.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef DS_AOT_THREADPOOL_H_
+#define DS_AOT_THREADPOOL_H_
+
+#include <thread>
+#include <future>
+#include <condition_variable>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <type_traits>
+
+#include "AOThread_v2.h"
+#include "Future.h"
+#include "JobMetrics.h"
+#include "CpuTopology.h"
+
+namespace utils::aot
+{
+    /**
+     * Thread pool with the work stealing.
+     *
+     * Unlike AOThread - which serializes all jobs into single background thread,
+     * the pool provides the execution context of multiple workers.
+     * Each worker owns its own jobs queue (deque): the jobs enqueued from within the worker
+     * context are pushed into the local queue, and popped in LIFO order (cache locality).
+     * The jobs enqueued from the outside are distributed round-robin among the workers.
+     * When the worker runs out of jobs, it will try to steal the oldest job (FIFO) from
+     * the others, before it gets suspended.
+     *
+     * Optionally, the workers can be pinned to the given CPUs: i.e. one per physical core,
+     * @see CpuTopology::onePerCore. In that case, each worker queue is allocated on
+     * the NUMA node local to the worker CPU.
+     *
+     * @note The order of execution is not preserved - for that, use AOThread
+     */
+    class ThreadPool final
+    {
+        public:
+
+            explicit ThreadPool(std::size_t workers = std::thread::hardware_concurrency())
+            {
+                allocate(std::max<std::size_t>(workers, 1));
+            }
+
+            /**
+             * C-tor
+             *
+             * @param cpus  The CPU list: one worker per CPU, pinned to it
+             */
+            explicit ThreadPool(std::vector<int> cpus) : m_cpus(std::move(cpus))
+            {
+                allocate(std::max<std::size_t>(m_cpus.size(), 1));
+            }
+
+            ~ThreadPool()
+            {
+                stop();
+            }
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator = (const ThreadPool&) = delete;
+
+            template <typename Func>
+            auto enqueue(Func&& func)
+            {
+                using namespace std;
+
+                using result_t = invoke_result_t<Func>;
+                using task_t = packaged_task<result_t()>;
+
+                task_t task {std::forward<Func>(func)};
+                auto f = task.get_future();
+
+                push(FunctionWrapper(move(task)));
+
+                return f;
+            }
+
+            template <typename Func, typename...Args>
+            auto emplace_enqueue(Func&& func, Args&&...args)
+            {
+                using namespace std;
+
+                using result_t = invoke_result_t<Func&&, Args&&...>;
+                using task_t = packaged_task<result_t()>;
+
+                task_t task { bind(std::forward<Func>(func), std::forward<Args>(args)...)};
+                auto f = task.get_future();
+
+                push(FunctionWrapper(move(task)));
+
+                return f;
+            }
+
+            /**
+             * Enqueue the job, without the means to synchronize on its outcome
+             * (no std::packaged_task shared state)
+             *
+             * @note The job should not throw: there is no future to propagate the exception to
+             */
+            template <typename Func>
+            void post(Func&& func)
+            {
+                push(FunctionWrapper(std::forward<Func>(func)));
+            }
+
+            /**
+             * Enqueue the job, returning the future which supports continuations
+             * @see Future::then
+             *
+             * @param func  The job to enqueue
+             * @return      The future of the job result
+             */
+            template <typename Func>
+            auto submit(Func&& func)
+            {
+                using result_t = std::invoke_result_t<Func>;
+
+                Promise<result_t> promise;
+                auto future = promise.get_future();
+
+                post([func = std::forward<Func>(func), promise = std::move(promise)]() mutable
+                {
+                    try
+                    {
+                        if constexpr (std::is_void_v<result_t>)
+                        {
+                            func();
+                            promise.set_value();
+                        }
+                        else
+                        {
+                            promise.set_value(func());
+                        }
+                    }
+                    catch (...)
+                    {
+                        promise.set_exception(std::current_exception());
+                    }
+                });
+
+                return future;
+            }
+
+            bool start()
+            {
+                try
+                {
+                    m_workers.reserve(m_queues.size());
+                    for (std::size_t i = 0; i < m_queues.size(); ++i)
+                    {
+                        m_workers.push_back(make_thread<std::thread>(&ThreadPool::dequeue, this, i));
+                        if (i < m_cpus.size())
+                        {
+                            (void)utils::setAffinity(m_workers.back()->native_handle(), {m_cpus[i]});
+                        }
+                    }
+                    return true;
+                }
+                catch(...)
+                {
+                    stop();
+                    return false;
+                }
+            }
+
+            void stop()
+            {
+                if (m_workers.empty()) return;
+
+                {
+                    std::lock_guard<std::mutex> lock {m_lock};
+                    m_stopThreads = true;
+                }
+                m_condition.notify_all();
+
+                m_workers.clear(); // wait on threads to join
+            }
+
+            std::size_t size() const noexcept
+            {
+                return m_queues.size();
+            }
+
+            /**
+             * Per-worker metrics: the enqueue side (depth, latency) is accounted to the queue
+             * the job was pushed into, the execution side to the worker that executed it (thief).
+             * Empty snapshots, unless AOT_ENABLE_METRICS is defined
+             *
+             * @return The snapshots, indexed by the worker
+             */
+            std::vector<metrics::Snapshot> metrics() const
+            {
+                std::vector<metrics::Snapshot> snapshots;
+                snapshots.reserve(m_queues.size());
+                for (const auto& queue : m_queues)
+                {
+                    snapshots.push_back(queue->m_metrics.snapshot());
+                }
+                return snapshots;
+            }
+
+        private:
+
+            /**
+             * Per-worker jobs queue.
+             * Aligned to the cache line, to prevent false sharing between the workers
+             */
+            struct alignas(64) WorkerQueue
+            {
+                std::mutex m_lock;
+                std::deque<FunctionWrapper> m_jobs;
+
+                [[no_unique_address]] metrics::metrics_t m_metrics {};
+                [[no_unique_address]] metrics::metrics_t::stamps_t m_stamps {};
+            };
+
+            void allocate(std::size_t workers)
+            {
+                m_queues.reserve(workers);
+                for (std::size_t i = 0; i < workers; ++i)
+                {
+                    // The memory is bound to the worker CPU node, if any
+                    const int node = (i < m_cpus.size()) ? CpuTopology::nodeOf(m_cpus[i]) : -1;
+                    m_queues.push_back(numa::make_on_node<WorkerQueue>(node));
+                }
+            }
+
+            void push(FunctionWrapper&& job)
+            {
+                // The worker is the single consumer of its own queue, in LIFO order
+                const bool local = (t_pool == this);
+                const auto index = local ? t_index
+                                         : m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+                m_pending.fetch_add(1);
+                {
+                    auto& queue = *m_queues[index];
+                    std::lock_guard<std::mutex> lock {queue.m_lock};
+                    queue.m_jobs.push_back(std::move(job));
+                    queue.m_stamps.push();
+                    queue.m_metrics.onEnqueue();
+                }
+
+                if (m_sleeping.load() > 0)
+                {
+                    { std::lock_guard<std::mutex> lock {m_lock}; }
+                    m_condition.notify_one();
+                }
+            }
+
+            bool popLocal(std::size_t index, FunctionWrapper& job)
+            {
+                auto& queue = *m_queues[index];
+                std::lock_guard<std::mutex> lock {queue.m_lock};
+                if (queue.m_jobs.empty()) return false;
+
+                job = std::move(queue.m_jobs.back());
+                queue.m_jobs.pop_back();
+                queue.m_metrics.onDequeue(queue.m_stamps.pop_back());
+                return true;
+            }
+
+            bool steal(std::size_t index, FunctionWrapper& job)
+            {
+                const auto n = m_queues.size();
+                for (std::size_t i = 1; i < n; ++i)
+                {
+                    auto& queue = *m_queues[(index + i) % n];
+                    std::unique_lock<std::mutex> lock {queue.m_lock, std::try_to_lock};
+                    if (!lock || queue.m_jobs.empty()) continue;
+
+                    job = std::move(queue.m_jobs.front());
+                    queue.m_jobs.pop_front();
+                    queue.m_metrics.onDequeue(queue.m_stamps.pop_front());
+                    return true;
+                }
+                return false;
+            }
+
+            void dequeue(std::size_t index)
+            {
+                using namespace std;
+
+                t_pool = this;
+                t_index = index;
+
+                for(;;)
+                {
+                    FunctionWrapper job;
+
+                    if (popLocal(index, job) || steal(index, job))
+                    {
+                        m_pending.fetch_sub(1);
+
+                        try
+                        {
+                            m_queues[index]->m_metrics.execute(job);
+                        }
+                        catch (const bad_function_call& e)
+                        {
+                            cerr << e.what() << '\n';
+                        }
+                        catch (const exception& e) // posted job
+                        {
+                            cerr << e.what() << '\n';
+                        }
+                        continue;
+                    }
+
+                    unique_lock<std::mutex> lock {m_lock};
+                    m_sleeping.fetch_add(1);
+                    m_condition.wait(lock, [this]{ return m_stopThreads || m_pending.load() > 0;});
+                    m_sleeping.fetch_sub(1);
+
+                    if (m_stopThreads) break;
+                }
+
+                t_pool = nullptr;
+            }
+
+        private:
+
+            // Identifies the worker context: for enqueuing into the local queue
+            inline static thread_local const ThreadPool* t_pool = nullptr;
+            inline static thread_local std::size_t t_index = 0;
+
+            bool m_stopThreads = false;
+
+            std::atomic<std::ptrdiff_t> m_pending {0};  // jobs enqueued, but not yet taken
+            std::atomic<std::size_t> m_sleeping {0};    // suspended workers
+            std::atomic<std::size_t> m_next {0};        // round-robin distribution
+
+            // @note: Order of declaration is important!
+
+            std::mutex m_lock;
+            std::condition_variable m_condition;
+
+            std::vector<int> m_cpus;
+            std::vector<numa::node_ptr_t<WorkerQueue>> m_queues;
+
+            std::vector<thread_with_deleter_t<std::thread>> m_workers;
+    };
+}
+
+#endif /* DS_AOT_THREADPOOL_H_ */
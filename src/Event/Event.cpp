@@ -5,8 +5,16 @@
 
 #include "Event.h"
 
-Event::Event(bool autoReset) noexcept
+#include <algorithm> // std::remove
+#include <stdexcept>
+#include <bit>     // std::countr_zero
+
+namespace utils
+{
+
+Event::Event(bool autoReset, WaitStrategy waitStrategy) noexcept
     : m_autoReset(autoReset)
+    , m_waitStrategy(waitStrategy)
 {}
 
 Event::~Event() = default;
@@ -31,7 +39,8 @@ Event::event_wait_t Event::wait_for(std::chrono::milliseconds timeout)
     {
         m_waitingThreads.push_back(std::this_thread::get_id());
 
-        const bool signaled = m_event.wait_for(lock, timeout, [this] { return m_predicate; });
+        const bool signaled = m_waitStrategy.wait_for(m_event, lock, timeout, [this] { return m_predicate.load(); }
+                , [this] { return m_predicate.load(std::memory_order_relaxed); });
         outcome = signaled ? event_wait_t::signaled : event_wait_t::timeout;
 
         updateWaitingThreads(m_waitingThreads);
@@ -51,7 +60,8 @@ void Event::wait()
     {
         m_waitingThreads.push_back(std::this_thread::get_id());
 
-        m_event.wait(lock, [this] { return m_predicate; });
+        m_waitStrategy.wait(m_event, lock, [this] { return m_predicate.load(); }
+                , [this] { return m_predicate.load(std::memory_order_relaxed); });
 
         updateWaitingThreads(m_waitingThreads);
 
@@ -74,4 +84,189 @@ void Event::broadcast()
 {
     std::lock_guard lock{m_lock};
     m_predicate = false;
-}
\ No newline at end of file
+}
+
+namespace details
+{
+    /**
+     * The thread waiting on many events: what has been signaled since it last looked
+     */
+    struct MultiWaiter
+    {
+        std::mutex m_lock;
+        std::condition_variable m_wakeup;
+        std::uint64_t m_fired = 0; // the bit per event
+    };
+
+    struct MultiWait
+    {
+        static constexpr std::size_t max_events = 64;
+
+        using clock_t = std::chrono::steady_clock;
+
+        // Under the event lock
+        static void fire(const WaitLink& link)
+        {
+            {
+                std::lock_guard lock{link.m_waiter->m_lock};
+                link.m_waiter->m_fired |= std::uint64_t{1} << link.m_index;
+            }
+            link.m_waiter->m_wakeup.notify_one();
+        }
+
+        /**
+         * Take the signal, if still there - as the waiter woken up would do
+         */
+        static bool tryAcquire(Event& event)
+        {
+            std::lock_guard lock{event.m_lock};
+            if (!event.m_predicate) return false;
+
+            // Auto reset
+            if (event.m_autoReset && event.m_waitingThreads.empty()) event.m_predicate = false;
+            return true;
+        }
+
+        /**
+         * The waiter registered on all the events, for the scope of the wait: no allocation
+         */
+        class Registration final
+        {
+            public:
+
+                Registration(std::span<Event* const> events, MultiWaiter& waiter) : m_events(events)
+                {
+                    if (events.size() > max_events) throw std::invalid_argument("wait on many events: up to 64 of them");
+
+                    for (std::size_t i = 0; i < events.size(); ++i)
+                    {
+                        auto& link = m_links[i];
+                        link.m_waiter = &waiter;
+                        link.m_index = i;
+
+                        auto& event = *events[i];
+                        std::lock_guard lock{event.m_lock};
+                        link.m_next = std::exchange(event.m_links, &link);
+                        if (link.m_next) link.m_next->m_prev = &link;
+
+                        if (event.m_predicate) fire(link); // already signaled
+                    }
+                }
+
+                ~Registration()
+                {
+                    for (std::size_t i = 0; i < m_events.size(); ++i)
+                    {
+                        auto& link = m_links[i];
+                        auto& event = *m_events[i];
+
+                        std::lock_guard lock{event.m_lock};
+                        if (link.m_prev) link.m_prev->m_next = link.m_next;
+                        else event.m_links = link.m_next;
+                        if (link.m_next) link.m_next->m_prev = link.m_prev;
+                    }
+                }
+
+                Registration(const Registration&) = delete;
+                Registration& operator = (const Registration&) = delete;
+
+            private:
+
+                std::span<Event* const> m_events;
+                std::array<WaitLink, max_events> m_links {};
+        };
+
+        /**
+         * Wait until any of the events selected has been signaled since the last call
+         *
+         * @return The bits of the events signaled - taken over, or none on timeout
+         */
+        static std::uint64_t next(MultiWaiter& waiter, std::uint64_t selected, const clock_t::time_point* deadline)
+        {
+            std::unique_lock lock{waiter.m_lock};
+            const auto fired = [&] { return 0 != (waiter.m_fired & selected); };
+
+            if (deadline) (void)waiter.m_wakeup.wait_until(lock, *deadline, fired);
+            else waiter.m_wakeup.wait(lock, fired);
+
+            const auto taken = waiter.m_fired & selected;
+            waiter.m_fired &= ~taken; // signaled again - seen on the next call
+            return taken;
+        }
+
+        static std::uint64_t all(std::size_t count)
+        {
+            return count == max_events ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+        }
+
+        static std::optional<clock_t::time_point> deadline(optional_timeout_t timeout)
+        {
+            if (!timeout) return std::nullopt;
+            return clock_t::now() + *timeout;
+        }
+    };
+}  // namespace details
+
+void Event::setEvent(notify_f notifier)
+{
+    {
+        std::lock_guard lock{m_lock};
+        m_predicate = true;
+
+        for (auto* link = m_links; link; link = link->m_next) details::MultiWait::fire(*link);
+    }
+    std::invoke(notifier, m_event);
+}
+
+std::optional<std::size_t> wait_any(std::span<Event* const> events, optional_timeout_t timeout)
+{
+    using details::MultiWait;
+
+    if (events.empty()) return std::nullopt; // nothing would ever wake it up
+
+    const auto deadline = MultiWait::deadline(timeout);
+
+    details::MultiWaiter waiter;
+    const MultiWait::Registration registration {events, waiter};
+
+    const auto selected = MultiWait::all(events.size());
+    while (true)
+    {
+        auto fired = MultiWait::next(waiter, selected, deadline ? &*deadline : nullptr);
+        if (0 == fired) return std::nullopt; // timeout
+
+        // Taken by the other waiter meanwhile (auto reset): keep waiting
+        for (; fired; fired &= fired - 1)
+        {
+            const auto index = static_cast<std::size_t>(std::countr_zero(fired));
+            if (MultiWait::tryAcquire(*events[index])) return index;
+        }
+    }
+}
+
+Event::event_wait_t wait_all(std::span<Event* const> events, optional_timeout_t timeout)
+{
+    using details::MultiWait;
+
+    const auto deadline = MultiWait::deadline(timeout);
+
+    details::MultiWaiter waiter;
+    const MultiWait::Registration registration {events, waiter};
+
+    auto pending = MultiWait::all(events.size());
+    while (pending)
+    {
+        auto fired = MultiWait::next(waiter, pending, deadline ? &*deadline : nullptr);
+        if (0 == fired) return Event::event_wait_t::timeout;
+
+        for (; fired; fired &= fired - 1)
+        {
+            const auto index = static_cast<std::size_t>(std::countr_zero(fired));
+            if (MultiWait::tryAcquire(*events[index])) pending &= ~(std::uint64_t{1} << index);
+        }
+    }
+
+    return Event::event_wait_t::signaled;
+}
+
+}  // namespace utils
@@ -10,14 +10,40 @@
 // std library
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 #include <chrono>
 #include <functional> // std::invoke
 #include <vector>
 #include <thread>
-
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// utils
+#include "WaitStrategy.h"
 
 namespace utils
 {
+    namespace details
+    {
+        struct MultiWaiter;
+
+        // The node of the single waiter on many events: linked into each of them
+        struct WaitLink
+        {
+            WaitLink* m_prev = nullptr;
+            WaitLink* m_next = nullptr;
+            MultiWaiter* m_waiter = nullptr;
+            std::size_t m_index = 0;    // of the event, within the ones waited on
+        };
+
+        struct MultiWait;
+    }
 
     /**
      *  Implementation of the event synchronization primitive.
@@ -36,8 +62,10 @@ namespace utils
          *
          * @param autoReset In case that is set to true, will reset the event after being signaled
          * at consumer point, so that it can wait - block on the same event on the next recall
+         * @param waitStrategy The way how the consumer waits: spinning, before being blocked.
+         * By default, it blocks immediately
          */
-        explicit Event(bool autoReset) noexcept;
+        explicit Event(bool autoReset, WaitStrategy waitStrategy = WaitStrategy::blocking()) noexcept;
         ~Event();
 
         // Copy functions forbidden
@@ -83,26 +111,116 @@ namespace utils
 
       private:
 
+        friend struct details::MultiWait;
+
         using notify_f = void (std::condition_variable::*)(void);
-        void setEvent(notify_f notifier)
-        {
-            {
-                std::lock_guard lock{m_lock};
-                m_predicate = true;
-            }
-            std::invoke(notifier, m_event);
-        }
+        void setEvent(notify_f notifier);
 
       private:
         std::condition_variable m_event;  // not copyable nor movable
         std::mutex m_lock;  // not copyable nor movable
 
         const bool m_autoReset;
-        bool m_predicate = false;
+        const WaitStrategy m_waitStrategy;
+        std::atomic<bool> m_predicate {false}; // written under the lock: read without it, only as the spinning hint
 
         waiting_threads_t m_waitingThreads;
+        details::WaitLink* m_links = nullptr;   // the ones waiting on many events: @see wait_any
 
     };
+
+    using optional_timeout_t = std::optional<std::chrono::milliseconds>;
+
+    /**
+     * Wait on any of the events being signaled, or timeout expired.
+     * The thread is parked once, on its own: the events signaled wake it up directly.
+     *
+     * @param events    The events (up to 64) to wait on
+     * @param timeout   Timeout to wait: none, to wait infinitely
+     * @return          The index of the event signaled - taken (reset, if auto reset), or none on timeout.
+     *                  None right away, if there are no events to wait on
+     */
+    std::optional<std::size_t> wait_any(std::span<Event* const> events, optional_timeout_t timeout = {});
+
+    /**
+     * Wait on all the events being signaled, or timeout expired.
+     * Each of them is taken (reset, if auto reset) once observed signaled: not at the same time
+     *
+     * @param events    The events (up to 64) to wait on
+     * @param timeout   Timeout to wait: none, to wait infinitely
+     * @return          Indication of the operation outcome {@link Event#event_wait_t}
+     */
+    Event::event_wait_t wait_all(std::span<Event* const> events, optional_timeout_t timeout = {});
+
+    namespace details
+    {
+        template <typename T>
+        constexpr bool is_duration_v = false;
+
+        template <typename Rep, typename Period>
+        constexpr bool is_duration_v<std::chrono::duration<Rep, Period>> = true;
+
+        /*
+         * The events - by the lvalue references, and optionally the timeout as the last argument.
+         * Anything else (i.e. the span of events) is left to the span overloads
+         */
+        template <typename...Args>
+        constexpr bool is_wait_on_v = []
+        {
+            constexpr std::size_t count = sizeof...(Args);
+            std::size_t i = 0;
+            bool valid = true;
+            ((++i, valid = valid && (std::is_same_v<Args, Event&> ||
+                    (i == count && is_duration_v<std::remove_cvref_t<Args>>))), ...);
+
+            return valid && (std::is_same_v<Args, Event&> || ...);
+        }();
+
+        // The events, and optionally the timeout as the last argument
+        template <typename Func, typename...Args>
+        decltype(auto) waitOn(Func func, Args&&...args)
+        {
+            constexpr auto count = sizeof...(Args);
+            using last_t = std::decay_t<std::tuple_element_t<count - 1, std::tuple<Args...>>>;
+            auto argv = std::forward_as_tuple(args...);
+
+            if constexpr (is_duration_v<last_t>)
+            {
+                return [&]<std::size_t...I>(std::index_sequence<I...>)
+                {
+                    const std::array<Event*, count - 1> events {&std::get<I>(argv)...};
+                    return func(std::span<Event* const>{events}
+                        , std::chrono::duration_cast<std::chrono::milliseconds>(std::get<count - 1>(argv)));
+                }(std::make_index_sequence<count - 1>{});
+            }
+            else
+            {
+                const std::array<Event*, count> events {&args...};
+                return func(std::span<Event* const>{events}, optional_timeout_t{});
+            }
+        }
+    }
+
+    /**
+     * @code
+     * if (const auto fired = wait_any(dataReady, stop, reconfigure, 100ms)) { switch (*fired) ... }
+     * @endcode
+     */
+    template <typename...Args>
+    requires details::is_wait_on_v<Args...>
+    std::optional<std::size_t> wait_any(Args&&...args)
+    {
+        return details::waitOn([](std::span<Event* const> events, optional_timeout_t timeout) { return wait_any(events, timeout); }
+            , std::forward<Args>(args)...);
+    }
+
+    template <typename...Args>
+    requires details::is_wait_on_v<Args...>
+    Event::event_wait_t wait_all(Args&&...args)
+    {
+        return details::waitOn([](std::span<Event* const> events, optional_timeout_t timeout) { return wait_all(events, timeout); }
+            , std::forward<Args>(args)...);
+    }
 }  // namespace utils
 
 #endif  // EVENT_H
@@ -0,0 +1,168 @@
+//
+// FutexEvent.cpp
+//
+//  Created on: Oct 14, 2026
+//
+
+#include "FutexEvent.h"
+
+#include <cerrno>
+#include <climits>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace utils
+{
+
+namespace
+{
+    using clock_t = std::chrono::steady_clock;
+
+#if defined(__linux__)
+    /*
+     * The futex directly: the std::atomic wait can't time out, and its notify skips
+     * the system call unless the waiter was registered through it.
+     * The deadline is absolute, on CLOCK_MONOTONIC - the steady clock.
+     */
+    bool futexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected, const clock_t::time_point* deadline)
+    {
+        timespec abs {};
+        if (deadline)
+        {
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline->time_since_epoch()).count();
+            abs.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+            abs.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+        }
+
+        const auto result = ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word)
+                , FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, expected
+                , deadline ? &abs : nullptr, nullptr, FUTEX_BITSET_MATCH_ANY);
+
+        return !(result < 0 && ETIMEDOUT == errno); // woken, spuriously, or the word changed
+    }
+
+    void futexWake(std::atomic<std::uint32_t>& word, bool all) noexcept
+    {
+        (void)::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word)
+                , FUTEX_WAKE | FUTEX_PRIVATE_FLAG, all ? INT_MAX : 1, nullptr, nullptr, 0);
+    }
+
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+#else
+    // Portable: atomic wait - the timed one is polled, with the growing pause
+    bool futexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected, const clock_t::time_point* deadline)
+    {
+        using namespace std::chrono_literals;
+
+        if (!deadline)
+        {
+            word.wait(expected, std::memory_order_relaxed);
+            return true;
+        }
+
+        for (auto pause = 50us; word.load(std::memory_order_relaxed) == expected; pause = std::min<std::chrono::microseconds>(pause * 2, 1ms))
+        {
+            const auto now = clock_t::now();
+            if (now >= *deadline) return false;
+            std::this_thread::sleep_for(std::min<clock_t::duration>(pause, *deadline - now));
+        }
+        return true;
+    }
+
+    void futexWake(std::atomic<std::uint32_t>& word, bool all) noexcept
+    {
+        if (all) word.notify_all();
+        else word.notify_one();
+    }
+#endif
+}  // namespace
+
+FutexEvent::FutexEvent(bool autoReset, WaitStrategy waitStrategy) noexcept
+    : m_autoReset(autoReset)
+    , m_waitStrategy(waitStrategy)
+{}
+
+FutexEvent::event_wait_t FutexEvent::wait_for(std::chrono::milliseconds timeout)
+{
+    if (tryAcquire() || spin()) return event_wait_t::signaled; // no system call
+
+    const auto deadline = clock_t::now() + timeout;
+    return park(&deadline) ? event_wait_t::signaled : event_wait_t::timeout;
+}
+
+void FutexEvent::wait()
+{
+    if (tryAcquire() || spin()) return;
+
+    (void)park(nullptr);
+}
+
+void FutexEvent::notify()
+{
+    setEvent(false);
+}
+
+void FutexEvent::broadcast()
+{
+    setEvent(true);
+}
+
+[[maybe_unused]] void FutexEvent::reset()
+{
+    m_state.store(nonsignaled, std::memory_order_relaxed);
+}
+
+bool FutexEvent::spin() noexcept
+{
+    for (std::uint32_t i = 0; i < m_waitStrategy.m_spins + m_waitStrategy.m_yields; ++i)
+    {
+        if (i < m_waitStrategy.m_spins) cpu_relax();
+        else std::this_thread::yield();
+
+        if (tryAcquire()) return true;
+    }
+    return false;
+}
+
+bool FutexEvent::park(const clock_t::time_point* deadline)
+{
+    // Counted first, then the state checked: either this one sees the signal, or the notifier sees the waiter
+    m_waiters.fetch_add(1, std::memory_order_seq_cst);
+
+    bool acquired = false;
+    for (;;)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ((acquired = tryAcquire())) break;
+
+        // Parked, unless signaled in the meantime: the kernel compares the word
+        if (!futexWait(m_state, nonsignaled, deadline))
+        {
+            acquired = tryAcquire(); // signaled right at the timeout
+            break;
+        }
+    }
+
+    // Auto reset: by the last one to leave
+    if (1 == m_waiters.fetch_sub(1, std::memory_order_seq_cst) && m_autoReset && acquired)
+    {
+        std::uint32_t expected = signaled;
+        (void)m_state.compare_exchange_strong(expected, nonsignaled, std::memory_order_relaxed);
+    }
+
+    return acquired;
+}
+
+void FutexEvent::setEvent(bool all)
+{
+    m_state.store(signaled, std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_seq_cst) > 0) futexWake(m_state, all);
+}
+
+}  // namespace utils
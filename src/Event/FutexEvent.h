@@ -0,0 +1,124 @@
+//
+// FutexEvent.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FUTEX_EVENT_H
+#define FUTEX_EVENT_H
+
+
+// std library
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// utils
+#include "Event.h"
+#include "WaitStrategy.h"
+
+namespace utils
+{
+
+    /**
+     *  The lightweight implementation of the event synchronization primitive:
+     *  the same semantics as Event, on the single 32-bit word - the futex, without the lock.
+     *
+     *  Waiting on the event already signaled, or signaling the event nobody waits on,
+     *  is a single atomic operation: the system call is made only to park (wake up)
+     *  the waiting threads, for which they are counted. There is nothing allocated per wait.
+     */
+    class FutexEvent final
+    {
+      public:
+
+        using event_wait_t = Event::event_wait_t;
+
+        /**
+         * C-tor
+         *
+         * @param autoReset In case that is set to true, the event is reset by the consumer
+         * that got it signaled: the other ones keep waiting on the next signal
+         * @param waitStrategy The way how the consumer waits: spinning, before being parked.
+         * By default, it parks immediately
+         */
+        explicit FutexEvent(bool autoReset, WaitStrategy waitStrategy = WaitStrategy::blocking()) noexcept;
+        ~FutexEvent() = default;
+
+        // Copy functions forbidden
+
+        FutexEvent(const FutexEvent&) = delete;
+        FutexEvent& operator=(const FutexEvent&) = delete;
+
+        // Move operations forbidden
+
+        FutexEvent(FutexEvent&&) = delete;
+        FutexEvent& operator=(FutexEvent&&) = delete;
+
+        /**
+         * Wait on the event being signaled, or timeout expired
+         *
+         * @param timeout Timeout in milliseconds to wait
+         * @return Indication of the operation outcome {@link Event#event_wait_t}
+         */
+        event_wait_t wait_for(std::chrono::milliseconds timeout);
+
+        /**
+         * Wait infinitely on event being signaled
+         */
+        void wait();
+
+        /**
+         * Notify - wake up the single thread
+         */
+        void notify();
+
+        /**
+         * Notify - wake up the all waiting threads
+         *
+         * @note As with Event, if the event is auto reset - all the threads waiting get it signaled:
+         * the last one to leave resets it
+         */
+        void broadcast();
+
+        /**
+         * Manually reset event - in case of the auto reset is false.
+         */
+        [[maybe_unused]] void reset();
+
+      private:
+
+        using clock_t = std::chrono::steady_clock;
+
+        /*
+         * Take the signal. As with Event, the auto reset is left to the last parked waiter,
+         * so that the broadcast releases all of them: the signal is consumed here only
+         * when nobody is parked
+         */
+        bool tryAcquire() noexcept
+        {
+            if (signaled != m_state.load(std::memory_order_acquire)) return false;
+            if (!m_autoReset || m_waiters.load(std::memory_order_seq_cst) > 0) return true;
+
+            std::uint32_t expected = signaled;
+            return m_state.compare_exchange_strong(expected, nonsignaled, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
+        bool spin() noexcept;
+        bool park(const clock_t::time_point* deadline);
+        void setEvent(bool all);
+
+      private:
+
+        static constexpr std::uint32_t nonsignaled = 0;
+        static constexpr std::uint32_t signaled = 1;
+
+        std::atomic<std::uint32_t> m_state {nonsignaled};  // the futex word
+        std::atomic<std::uint32_t> m_waiters {0};          // the threads parked (or about to)
+
+        const bool m_autoReset;
+        const WaitStrategy m_waitStrategy;
+    };
+}  // namespace utils
+
+#endif  // FUTEX_EVENT_H
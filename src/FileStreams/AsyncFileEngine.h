@@ -0,0 +1,576 @@
+//
+// AsyncFileEngine.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FILE_ASYNCFILEENGINE_H_
+#define FILE_ASYNCFILEENGINE_H_
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define FILE_HAS_IO_URING 1
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "Future.h"
+#include "AOThread.h"
+
+namespace utils::file
+{
+    /**
+     * The file descriptor, shared by the stream and its operations in flight: closed once the last
+     * of them is done, so that the number is not reused for another file while still in use
+     */
+    class FileDescriptor final
+    {
+        public:
+
+            explicit FileDescriptor(int fd) noexcept : m_fd(fd)
+            {}
+
+            ~FileDescriptor()
+            {
+                if (m_fd >= 0) (void)::close(m_fd);
+            }
+
+            FileDescriptor(const FileDescriptor&) = delete;
+            FileDescriptor& operator = (const FileDescriptor&) = delete;
+
+            int get() const noexcept
+            {
+                return m_fd;
+            }
+
+        private:
+
+            const int m_fd;
+    };
+
+    using fd_t = std::shared_ptr<const FileDescriptor>;
+
+    /**
+     * Asynchronous file I/O engine: the positional reads and writes, on any number of files,
+     * completed through the futures that support continuations.
+     * @see utils::aot::Future::then
+     *
+     * The operations are independent: there is no ordering among them, and the buffer must stay valid
+     * until the operation is completed. As with pread/pwrite, the result is the number of bytes
+     * transferred (which may be less than requested), while the failure is reported as std::system_error.
+     */
+    class AsyncFileEngine
+    {
+        public:
+
+            using result_t = utils::aot::Future<std::size_t>;
+
+            virtual ~AsyncFileEngine() = default;
+
+            AsyncFileEngine(const AsyncFileEngine&) = delete;
+            AsyncFileEngine& operator = (const AsyncFileEngine&) = delete;
+
+            /**
+             * @param fd            The file descriptor: kept open until the operation is completed
+             * @param buffer        The destination
+             * @param offset        The file offset
+             * @param bufferIndex   The registered buffer that contains the destination, if any
+             */
+            virtual result_t read(const fd_t& fd, std::span<std::byte> buffer, std::uint64_t offset, int bufferIndex = -1) = 0;
+
+            /**
+             * @param fd            The file descriptor: kept open until the operation is completed
+             * @param buffer        The source
+             * @param offset        The file offset
+             * @param bufferIndex   The registered buffer that contains the source, if any
+             */
+            virtual result_t write(const fd_t& fd, std::span<const std::byte> buffer, std::uint64_t offset, int bufferIndex = -1) = 0;
+
+            /**
+             * Register the buffers (i.e: for the io_uring, they are pinned and mapped once,
+             * rather than for each operation). Replaces the previously registered ones.
+             *
+             * @param buffers   The buffers, referred by their index afterwards
+             * @return          Indication of the operation outcome
+             */
+            virtual bool registerBuffers(std::span<const std::span<std::byte>> buffers) = 0;
+
+            /**
+             * @return Indication whether the engine is the io_uring, or the fallback
+             */
+            virtual bool isUring() const noexcept = 0;
+
+            /**
+             * Create the engine: the io_uring, if it's supported by the kernel (and allowed).
+             * Otherwise - the thread pool fallback, with the warning on stderr
+             *
+             * @param queueDepth    The maximum number of operations in flight, for the io_uring
+             * @param workers       The number of threads, for the fallback
+             */
+            static std::unique_ptr<AsyncFileEngine> create(unsigned queueDepth = 256, std::size_t workers = 4);
+
+            /**
+             * @return The engine shared within the process
+             */
+            static AsyncFileEngine& instance()
+            {
+                static const std::unique_ptr<AsyncFileEngine> engine = create();
+                return *engine;
+            }
+
+        protected:
+
+            AsyncFileEngine() = default;
+
+            static std::system_error toError(int error)
+            {
+                return std::system_error{error, std::generic_category(), "Async file I/O"};
+            }
+    };
+
+    /**
+     * The fallback: the blocking pread/pwrite, on the pool of the worker threads (round-robin)
+     */
+    class ThreadPoolFileEngine final : public AsyncFileEngine
+    {
+        public:
+
+            explicit ThreadPoolFileEngine(std::size_t workers = 4)
+            {
+                m_workers.reserve(std::max<std::size_t>(workers, 1));
+                for (std::size_t i = 0; i < std::max<std::size_t>(workers, 1); ++i)
+                {
+                    m_workers.push_back(std::make_unique<worker_t>("file-io-" + std::to_string(i)
+                            , utils::ThreadWrapper::schedule_policy_t::sh_policy_normal
+                            , 0
+                            , utils::aot::dequeue_policy_t::drain));
+                }
+            }
+
+            result_t read(const fd_t& fd, std::span<std::byte> buffer, std::uint64_t offset, int) override
+            {
+                return submit([fd, buffer, offset]
+                {
+                    return ::pread(fd->get(), buffer.data(), buffer.size(), static_cast<off_t>(offset));
+                });
+            }
+
+            result_t write(const fd_t& fd, std::span<const std::byte> buffer, std::uint64_t offset, int) override
+            {
+                return submit([fd, buffer, offset]
+                {
+                    return ::pwrite(fd->get(), buffer.data(), buffer.size(), static_cast<off_t>(offset));
+                });
+            }
+
+            bool registerBuffers(std::span<const std::span<std::byte>>) override
+            {
+                return true; // the plain memory: nothing to register
+            }
+
+            bool isUring() const noexcept override
+            {
+                return false;
+            }
+
+        private:
+
+            using worker_t = utils::aot::AOThread<void>;
+
+            template <typename Op>
+            result_t submit(Op&& op)
+            {
+                utils::aot::Promise<std::size_t> promise;
+                auto future = promise.get_future();
+
+                auto& worker = m_workers[m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size()];
+                (void)worker->enqueue(utils::aot::job_t<void>{[op = std::forward<Op>(op), promise = std::move(promise)]() mutable
+                {
+                    for (;;)
+                    {
+                        const auto n = op();
+                        if (n >= 0)
+                        {
+                            promise.set_value(static_cast<std::size_t>(n));
+                            return;
+                        }
+                        if (EINTR != errno)
+                        {
+                            promise.set_exception(std::make_exception_ptr(toError(errno)));
+                            return;
+                        }
+                    }
+                }});
+
+                return future;
+            }
+
+        private:
+
+            std::vector<std::unique_ptr<worker_t>> m_workers;
+            std::atomic<std::size_t> m_next {0};
+    };
+
+#if defined(FILE_HAS_IO_URING) && defined(__NR_io_uring_setup)
+
+    /**
+     * The io_uring engine, over the raw syscalls (no liburing):
+     * the operations are submitted from the caller thread, without blocking,
+     * and the completions are reaped by the single background thread - for all files.
+     *
+     * @note The continuations attached with the inline executor are executed within
+     * the completion thread: the heavy ones should be posted to another executor
+     * @note IORING_OP_READ/WRITE are required (Linux 5.6): otherwise, the c-tor throws
+     */
+    class UringFileEngine final : public AsyncFileEngine
+    {
+        public:
+
+            /**
+             * C-tor
+             *
+             * @param entries   The submission queue size
+             * @note It will throw std::system_error in case that the io_uring can't be set up
+             */
+            explicit UringFileEngine(unsigned entries)
+            {
+                io_uring_params params {};
+                m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, std::max(entries, 1u), &params));
+                if (m_fd < 0) throw toError(errno);
+
+                try
+                {
+                    map(params);
+                    probe();
+                }
+                catch (...)
+                {
+                    unmap();
+                    ::close(m_fd);
+                    throw;
+                }
+
+                m_completion = std::thread([this]{ reap(); });
+            }
+
+            ~UringFileEngine() override
+            {
+                {
+                    // Let the operations in flight complete, and wake up the completion thread
+                    std::unique_lock<std::mutex> lock {m_lock};
+                    m_space.wait(lock, [this]{ return 0 == m_inflight; });
+
+                    io_uring_sqe sqe {};
+                    sqe.opcode = IORING_OP_NOP;
+                    sqe.user_data = 0; // the stop sentinel
+                    if (const int error = submit(lock, sqe); 0 != error)
+                    {
+                        // The completion thread can't be woken up: leave it (and the ring) behind, rather than hang
+                        (void)fprintf(stderr, "<Error> io_uring shutdown: %s\n", strerror(error));
+                        m_completion.detach();
+                        return;
+                    }
+                }
+
+                m_completion.join();
+
+                unmap();
+                ::close(m_fd);
+            }
+
+            result_t read(const fd_t& fd, std::span<std::byte> buffer, std::uint64_t offset, int bufferIndex = -1) override
+            {
+                return prepare(fd, buffer.data(), buffer.size(), offset, bufferIndex, IORING_OP_READ_FIXED, IORING_OP_READ);
+            }
+
+            result_t write(const fd_t& fd, std::span<const std::byte> buffer, std::uint64_t offset, int bufferIndex = -1) override
+            {
+                return prepare(fd, buffer.data(), buffer.size(), offset, bufferIndex, IORING_OP_WRITE_FIXED, IORING_OP_WRITE);
+            }
+
+            bool registerBuffers(std::span<const std::span<std::byte>> buffers) override
+            {
+                std::vector<iovec> iov;
+                iov.reserve(buffers.size());
+                for (const auto& buffer : buffers) iov.push_back({buffer.data(), buffer.size()});
+
+                std::lock_guard<std::mutex> lock {m_lock};
+
+                if (m_registered) (void)::syscall(__NR_io_uring_register, m_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+                m_registered = !iov.empty()
+                        && 0 == ::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, iov.data(), static_cast<unsigned>(iov.size()));
+
+                return m_registered || iov.empty();
+            }
+
+            bool isUring() const noexcept override
+            {
+                return true;
+            }
+
+        private:
+
+            struct Request
+            {
+                utils::aot::Promise<std::size_t> m_promise;
+                fd_t m_fd; // open until completed
+            };
+
+            template <typename T>
+            static std::atomic_ref<T> atomic(T* p) noexcept
+            {
+                return std::atomic_ref<T>{*p};
+            }
+
+            template <typename T>
+            T* at(void* base, std::uint32_t offset) const noexcept
+            {
+                return reinterpret_cast<T*>(static_cast<std::uint8_t*>(base) + offset);
+            }
+
+            void map(const io_uring_params& params)
+            {
+                m_sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                m_cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+                const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (single) m_sqSize = m_cqSize = std::max(m_sqSize, m_cqSize);
+
+                m_pSq = ::mmap(nullptr, m_sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+                if (MAP_FAILED == m_pSq) { m_pSq = nullptr; throw toError(errno); }
+
+                m_pCq = single ? m_pSq : ::mmap(nullptr, m_cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+                if (MAP_FAILED == m_pCq) { m_pCq = nullptr; throw toError(errno); }
+
+                m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                void* sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+                if (MAP_FAILED == sqes) throw toError(errno);
+                m_pSqes = static_cast<io_uring_sqe*>(sqes);
+
+                m_sqHead = at<unsigned>(m_pSq, params.sq_off.head);
+                m_sqTail = at<unsigned>(m_pSq, params.sq_off.tail);
+                m_sqMask = *at<unsigned>(m_pSq, params.sq_off.ring_mask);
+                m_sqArray = at<unsigned>(m_pSq, params.sq_off.array);
+
+                m_cqHead = at<unsigned>(m_pCq, params.cq_off.head);
+                m_cqTail = at<unsigned>(m_pCq, params.cq_off.tail);
+                m_cqMask = *at<unsigned>(m_pCq, params.cq_off.ring_mask);
+                m_cqes = at<io_uring_cqe>(m_pCq, params.cq_off.cqes);
+
+                // No more in flight than the completion queue holds: no overflow
+                m_capacity = std::min(params.sq_entries, params.cq_entries);
+            }
+
+            // The READ/WRITE opcodes are newer than the io_uring itself: check them upfront
+            void probe()
+            {
+                constexpr unsigned ops = 256;
+                std::vector<std::byte> storage(sizeof(io_uring_probe) + ops * sizeof(io_uring_probe_op));
+                auto* pProbe = reinterpret_cast<io_uring_probe*>(storage.data());
+
+                if (0 != ::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PROBE, pProbe, ops)) throw toError(errno);
+
+                const auto supported = [pProbe](unsigned op)
+                {
+                    return op <= pProbe->last_op && (pProbe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+                };
+                if (!supported(IORING_OP_READ) || !supported(IORING_OP_WRITE)) throw toError(EOPNOTSUPP);
+            }
+
+            void unmap() noexcept
+            {
+                if (m_pSqes) ::munmap(m_pSqes, m_sqesSize);
+                if (m_pCq && m_pCq != m_pSq) ::munmap(m_pCq, m_cqSize);
+                if (m_pSq) ::munmap(m_pSq, m_sqSize);
+                m_pSqes = nullptr;
+                m_pCq = m_pSq = nullptr;
+            }
+
+            result_t prepare(const fd_t& fd, const void* data, std::size_t size, std::uint64_t offset
+                    , int bufferIndex, std::uint8_t fixedOp, std::uint8_t op)
+            {
+                auto request = std::make_unique<Request>();
+                auto future = request->m_promise.get_future();
+                request->m_fd = fd;
+
+                io_uring_sqe sqe {};
+                sqe.fd = fd->get();
+                sqe.off = offset;
+                sqe.addr = reinterpret_cast<std::uint64_t>(data);
+                sqe.len = static_cast<std::uint32_t>(std::min<std::size_t>(size, 0x7ffff000)); // as for read/write
+                sqe.user_data = reinterpret_cast<std::uint64_t>(request.get());
+
+                std::unique_lock<std::mutex> lock {m_lock};
+
+                if (bufferIndex >= 0 && m_registered)
+                {
+                    sqe.opcode = fixedOp;
+                    sqe.buf_index = static_cast<std::uint16_t>(bufferIndex);
+                }
+                else
+                {
+                    sqe.opcode = op;
+                }
+
+                // Back pressure: at most the capacity in flight
+                m_space.wait(lock, [this]{ return m_inflight < m_capacity; });
+
+                if (const int error = submit(lock, sqe); 0 != error)
+                {
+                    request->m_promise.set_exception(std::make_exception_ptr(toError(error)));
+                    return future;
+                }
+                (void)request.release(); // owned by the ring, until completed
+
+                return future;
+            }
+
+            /*
+             * Submit the entry: retried until the kernel consumes it (i.e: on the partial submission).
+             * On the failure, the entry is taken back from the ring - nothing is left behind,
+             * since the kernel consumes the entries only within the submitting call, under the lock
+             *
+             * @return 0, or the error
+             */
+            int submit(std::unique_lock<std::mutex>&, const io_uring_sqe& sqe)
+            {
+                const auto tail = *m_sqTail; // written only by the submitter, under the lock
+                const auto index = tail & m_sqMask;
+
+                m_pSqes[index] = sqe;
+                m_sqArray[index] = index;
+                atomic(m_sqTail).store(tail + 1, std::memory_order_release);
+                ++m_inflight;
+
+                for (;;)
+                {
+                    const auto pending = tail + 1 - atomic(m_sqHead).load(std::memory_order_acquire);
+                    if (0 == pending) return 0;
+
+                    const auto ret = ::syscall(__NR_io_uring_enter, m_fd, pending, 0, 0, nullptr, 0);
+                    if (ret >= 0 || EINTR == errno || EAGAIN == errno || EBUSY == errno) continue;
+
+                    const int error = errno;
+                    atomic(m_sqTail).store(tail, std::memory_order_release);
+                    --m_inflight;
+                    m_space.notify_one();
+
+                    return error;
+                }
+            }
+
+            /*
+             * The completion thread
+             */
+            void reap() noexcept
+            {
+                bool stop = false;
+                while (!stop)
+                {
+                    const auto ret = ::syscall(__NR_io_uring_enter, m_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                    if (ret < 0 && EINTR != errno)
+                    {
+                        (void)fprintf(stderr, "<Error> io_uring_enter: %s\n", strerror(errno));
+                    }
+
+                    auto head = *m_cqHead; // written only by this thread
+                    const auto tail = atomic(m_cqTail).load(std::memory_order_acquire);
+                    (void)atomic(m_sqTail).load(std::memory_order_acquire); // pairs with the submission: the requests are visible
+
+                    std::size_t completed = 0;
+                    for (; head != tail; ++head, ++completed)
+                    {
+                        const auto& cqe = m_cqes[head & m_cqMask];
+                        if (0 == cqe.user_data)
+                        {
+                            stop = true;
+                            continue;
+                        }
+
+                        std::unique_ptr<Request> request {reinterpret_cast<Request*>(cqe.user_data)};
+                        if (cqe.res < 0) request->m_promise.set_exception(std::make_exception_ptr(toError(-cqe.res)));
+                        else request->m_promise.set_value(static_cast<std::size_t>(cqe.res));
+                    }
+                    atomic(m_cqHead).store(head, std::memory_order_release);
+
+                    if (completed > 0)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock {m_lock};
+                            m_inflight -= completed;
+                        }
+                        m_space.notify_all();
+                    }
+                }
+            }
+
+        private:
+
+            int m_fd = -1;
+
+            void* m_pSq = nullptr;
+            void* m_pCq = nullptr;
+            io_uring_sqe* m_pSqes = nullptr;
+            std::size_t m_sqSize = 0;
+            std::size_t m_cqSize = 0;
+            std::size_t m_sqesSize = 0;
+
+            unsigned* m_sqHead = nullptr;
+            unsigned* m_sqTail = nullptr;
+            unsigned* m_sqArray = nullptr;
+            unsigned m_sqMask = 0;
+
+            unsigned* m_cqHead = nullptr;
+            unsigned* m_cqTail = nullptr;
+            io_uring_cqe* m_cqes = nullptr;
+            unsigned m_cqMask = 0;
+
+            std::mutex m_lock; // the submission side
+            std::condition_variable m_space;
+            std::size_t m_inflight = 0;
+            std::size_t m_capacity = 0;
+            bool m_registered = false;
+
+            std::thread m_completion; // the last one: starts once everything else is initialized
+    };
+
+#endif
+
+    inline std::unique_ptr<AsyncFileEngine> AsyncFileEngine::create(unsigned queueDepth, std::size_t workers)
+    {
+#if defined(FILE_HAS_IO_URING) && defined(__NR_io_uring_setup)
+        try
+        {
+            return std::make_unique<UringFileEngine>(queueDepth);
+        }
+        catch (const std::exception& e)
+        {
+            (void)fprintf(stderr, "<Warning> io_uring unavailable (%s): falling back to the thread pool\n", e.what());
+        }
+#else
+        (void)queueDepth;
+#endif
+        return std::make_unique<ThreadPoolFileEngine>(workers);
+    }
+}
+
+#endif /* FILE_ASYNCFILEENGINE_H_ */
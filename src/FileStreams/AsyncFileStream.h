@@ -0,0 +1,177 @@
+//
+// AsyncFileStream.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FILE_ASYNCFILESTREAM_H_
+#define FILE_ASYNCFILESTREAM_H_
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <system_error>
+
+#include "FileStream.h"
+#include "AsyncFileEngine.h"
+
+namespace utils::file
+{
+    /**
+     * File stream with the asynchronous, positional reads and writes: through the AsyncFileEngine
+     * - the io_uring, or the thread pool fallback.
+     * Many operations (on many files) can be in flight at once, without a thread per file.
+     *
+     * @code
+     * AsyncBinaryFileStream file {path, std::ios_base::in | std::ios_base::out};
+     * file.async_read(0, buffer).then([](std::size_t bytes) { ... });
+     * @endcode
+     *
+     * @note The buffers must stay valid until the operation is completed.
+     * The offsets are in the number of elements, while the results - in bytes
+     *
+     * @tparam T    The data type
+     */
+    template <class T>
+    class AsyncFileStream final : public FileStream
+    {
+        public:
+
+            using data_t = T;
+            using result_t = AsyncFileEngine::result_t;
+
+            /**
+             * C-tor
+             *
+             * @param path      The file path
+             * @param mode      in, out, trunc, app: the file is created for out
+             * @param engine    The I/O engine
+             */
+            AsyncFileStream(const std::filesystem::path& path
+                    , std::ios_base::openmode mode
+                    , AsyncFileEngine& engine = AsyncFileEngine::instance()) noexcept :
+                        m_engine(engine)
+            {
+                const int fd = ::open(path.c_str(), toFlags(mode), 0644);
+                if (fd < 0)
+                {
+                    m_openError = errno;
+                    return;
+                }
+
+                try
+                {
+                    m_fd = std::make_shared<const FileDescriptor>(fd);
+                }
+                catch (const std::bad_alloc&)
+                {
+                    (void)::close(fd);
+                    m_openError = ENOMEM;
+                    return;
+                }
+
+                struct stat st {};
+                if (0 == ::fstat(fd, &st)) m_end.store(static_cast<std::uint64_t>(st.st_size), std::memory_order_relaxed);
+            }
+
+            // The descriptor is closed once the operations in flight are completed
+            ~AsyncFileStream() override = default;
+
+            bool isOpen() const override
+            {
+                return nullptr != m_fd;
+            }
+
+            std::size_t size() const override
+            {
+                struct stat st {};
+                return (isOpen() && 0 == ::fstat(m_fd->get(), &st)) ? static_cast<std::size_t>(st.st_size) : 0;
+            }
+
+            /**
+             * @param offset    The file offset: number of elements
+             * @param data      The destination
+             * @param buffer    The registered buffer that contains the destination, if any
+             * @return          The future of the number of bytes read: failed right away, if the file is not open
+             */
+            result_t async_read(std::uint64_t offset, std::span<data_t> data, int buffer = -1)
+            {
+                if (!isOpen()) return openFailed();
+                return m_engine.read(m_fd, std::as_writable_bytes(data), offset * sizeof(data_t), buffer);
+            }
+
+            /**
+             * @param offset    The file offset: number of elements
+             * @param data      The source
+             * @param buffer    The registered buffer that contains the source, if any
+             * @return          The future of the number of bytes written: failed right away, if the file is not open
+             */
+            result_t async_write(std::uint64_t offset, std::span<const data_t> data, int buffer = -1)
+            {
+                if (!isOpen()) return openFailed();
+                return m_engine.write(m_fd, std::as_bytes(data), offset * sizeof(data_t), buffer);
+            }
+
+            /**
+             * The write at the end of the file: the space is reserved upfront, so the concurrent
+             * appends don't overlap - although they may complete in any order
+             *
+             * @param data      The source
+             * @param buffer    The registered buffer that contains the source, if any
+             * @return          The future of the number of bytes written
+             */
+            result_t async_append(std::span<const data_t> data, int buffer = -1)
+            {
+                if (!isOpen()) return openFailed();
+
+                const auto offset = m_end.fetch_add(data.size_bytes(), std::memory_order_relaxed);
+                return m_engine.write(m_fd, std::as_bytes(data), offset, buffer);
+            }
+
+            AsyncFileEngine& engine() const noexcept
+            {
+                return m_engine;
+            }
+
+        private:
+
+            // Not submitted at all: failed with the reason the file couldn't be opened
+            result_t openFailed() const
+            {
+                return utils::aot::make_exceptional_future<std::size_t>(
+                        std::make_exception_ptr(std::system_error{m_openError, std::generic_category(), "Async file I/O: open"}));
+            }
+
+            static int toFlags(std::ios_base::openmode mode) noexcept
+            {
+                const bool in = (mode & std::ios_base::in) != 0;
+                const bool out = (mode & (std::ios_base::out | std::ios_base::app)) != 0;
+
+                int flags = O_CLOEXEC | ((in && out) ? O_RDWR : out ? O_WRONLY : O_RDONLY);
+                if (out) flags |= O_CREAT;
+                if (mode & std::ios_base::trunc) flags |= O_TRUNC;
+
+                return flags;
+            }
+
+        private:
+
+            AsyncFileEngine& m_engine;
+            fd_t m_fd = nullptr; // shared with the operations in flight
+            int m_openError = 0;
+            std::atomic<std::uint64_t> m_end {0}; // for the appends: in bytes
+    };
+
+    // Strong (named) type - type alias
+    using AsyncBinaryFileStream = AsyncFileStream<uint8_t>;
+}
+
+#endif /* FILE_ASYNCFILESTREAM_H_ */
@@ -0,0 +1,236 @@
+//
+// ChunkedInputFileStream.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FILE_CHUNKEDINPUTFILESTREAM_H_
+#define FILE_CHUNKEDINPUTFILESTREAM_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "FileStream.h"
+#include "AOThread.h"
+
+namespace utils::file
+{
+    /**
+     * Input file stream, read in the fixed-size chunks: for processing the files larger than RAM,
+     * in the constant memory.
+     *
+     * The background thread reads ahead into the small pool of buffers, so that the next chunk
+     * is (ideally) already in memory when the consumer asks for it.
+     * The buffers are recycled: the one handed over to the consumer goes back to the read-ahead
+     * as the consumer moves on - no allocation in the steady state.
+     *
+     * @code
+     * ChunkedBinaryInputFileStream file {path, 1 << 20};
+     * for (auto chunk : file) // std::span<const uint8_t>
+     * {
+     *     parse(chunk);
+     * }
+     * @endcode
+     *
+     * @note Each iteration starts from the beginning of the file, and only one iteration
+     * can be active at the time. The read errors are rethrown (std::runtime_error) to the consumer.
+     *
+     * @tparam T    The data type
+     */
+    template <class T>
+    class ChunkedInputFileStream final : public InputFileStream<T>
+    {
+        public:
+
+            using data_t = T;
+            using chunk_t = typename InputFileStream<T>::chunk_t;
+            using view_t = std::span<const data_t>;
+
+            /**
+             * C-tor
+             *
+             * @param path      The file path
+             * @param chunkSize The chunk size: number of elements
+             * @param buffers   The number of buffers: the chunk being consumed, plus the chunks read ahead
+             */
+            ChunkedInputFileStream(const std::filesystem::path& path, std::size_t chunkSize, std::size_t buffers = 3) noexcept :
+                InputFileStream<T>(path, std::ios_base::binary)
+                , m_chunkSize(std::max<std::size_t>(chunkSize, 1))
+                , m_buffers(std::max<std::size_t>(buffers, 2))
+            {}
+
+            ~ChunkedInputFileStream() override
+            {
+                stop();
+            }
+
+            class iterator;
+
+            /**
+             * Rewind the file, and start reading ahead
+             *
+             * @return The iterator to the first chunk
+             */
+            iterator begin()
+            {
+                stop();
+
+                m_pThread = std::make_unique<thread_t>("file-read-ahead"
+                        , utils::ThreadWrapper::schedule_policy_t::sh_policy_normal
+                        , 0
+                        , utils::aot::dequeue_policy_t::drain);
+                m_eof = false;
+
+                this->m_file.clear();
+                this->m_file.seekg(0);
+
+                for (std::size_t i = 1; i < m_buffers; ++i) readAhead(chunk_t{}); // the last one: recycled by the first increment
+
+                iterator it {this};
+                ++it; // the first chunk
+                return it;
+            }
+
+            std::default_sentinel_t end() const noexcept
+            {
+                return std::default_sentinel;
+            }
+
+            std::size_t chunkSize() const noexcept
+            {
+                return m_chunkSize;
+            }
+
+            /**
+             * The input range iterator: the chunk is valid until the iterator is incremented
+             */
+            class iterator
+            {
+                public:
+
+                    using iterator_concept = std::input_iterator_tag;
+                    using value_type = view_t;
+                    using difference_type = std::ptrdiff_t;
+
+                    iterator() = default;
+
+                    iterator(iterator&&) noexcept = default;
+                    iterator& operator = (iterator&&) noexcept = default;
+
+                    const view_t& operator*() const noexcept
+                    {
+                        return m_view;
+                    }
+
+                    iterator& operator++()
+                    {
+                        // Recycle the consumed buffer, and take the next one read ahead
+                        m_buffer = m_pStream->next(std::move(m_buffer));
+                        m_view = view_t{m_buffer.data(), m_buffer.size()};
+                        if (m_buffer.empty()) m_pStream = nullptr;
+
+                        return *this;
+                    }
+
+                    void operator++(int)
+                    {
+                        ++*this;
+                    }
+
+                    friend bool operator == (const iterator& it, std::default_sentinel_t) noexcept
+                    {
+                        return nullptr == it.m_pStream;
+                    }
+
+                private:
+
+                    friend class ChunkedInputFileStream;
+
+                    explicit iterator(ChunkedInputFileStream* pStream) noexcept : m_pStream(pStream)
+                    {}
+
+                    ChunkedInputFileStream* m_pStream = nullptr;
+                    chunk_t m_buffer;
+                    view_t m_view;
+            };
+
+        private:
+
+            using thread_t = utils::aot::AOThread<chunk_t>;
+
+            /*
+             * Read the next chunk within the background thread, into the recycled buffer.
+             * The reads are executed in order, and the file stream is accessed only from the
+             * background thread while the iteration is active.
+             */
+            void readAhead(chunk_t&& buffer)
+            {
+                m_pending.push_back(m_pThread->enqueue(utils::aot::job_t<chunk_t>{[this, buffer = std::move(buffer)]() mutable
+                {
+                    buffer.resize(m_chunkSize);
+                    if (m_eof)
+                    {
+                        buffer.clear();
+                        return std::move(buffer);
+                    }
+
+                    auto& file = this->m_file;
+                    file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(m_chunkSize * sizeof(data_t)));
+                    if (file.bad()) throw std::runtime_error(strerror(errno));
+
+                    const auto bytes = static_cast<std::size_t>(file.gcount());
+                    buffer.resize(bytes / sizeof(data_t));
+                    if (file.eof()) m_eof = true;
+
+                    return std::move(buffer);
+                }}));
+            }
+
+            chunk_t next(chunk_t&& consumed)
+            {
+                if (m_pending.empty()) return {};
+
+                auto result = std::move(m_pending.front());
+                m_pending.pop_front();
+
+                auto buffer = result.get(); // rethrows the read error
+                if (buffer.empty())
+                {
+                    stop();
+                    return buffer;
+                }
+
+                readAhead(std::move(consumed));
+                return buffer;
+            }
+
+            void stop() noexcept
+            {
+                m_pThread.reset(); // completes the pending reads
+                m_pending.clear();
+            }
+
+        private:
+
+            const std::size_t m_chunkSize;
+            const std::size_t m_buffers;
+
+            std::unique_ptr<thread_t> m_pThread;
+            std::deque<std::future<chunk_t>> m_pending;
+            bool m_eof = false; // accessed only from within the background thread, while active
+    };
+
+    // Strong (named) type - type alias
+    using ChunkedBinaryInputFileStream = ChunkedInputFileStream<uint8_t>;
+}
+
+#endif /* FILE_CHUNKEDINPUTFILESTREAM_H_ */
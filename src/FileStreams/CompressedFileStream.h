@@ -0,0 +1,416 @@
+//
+// CompressedFileStream.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FILE_COMPRESSEDFILESTREAM_H_
+#define FILE_COMPRESSEDFILESTREAM_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "FileStream.h"
+#include "BinaryOutputFileStream.h"
+#include "LzCodec.h"
+
+namespace utils::file
+{
+    /*
+     * Framed format of the compressed binary file (little endian):
+     *
+     *  file   := "LZB1" block* [index]
+     *  block  := magic:"LZBK" raw size:u32 payload size:u32 payload
+     *            - the high bit of the payload size is set for the block stored as it is (incompressible)
+     *  index  := "LZBI" count:u32 (file offset:u64 raw offset:u64)* index offset:u64 "LZBT"
+     *
+     * The index is written on close. Without it (i.e: the logging process has crashed),
+     * the blocks are found by walking the block headers.
+     */
+    namespace frame
+    {
+        inline constexpr char file_magic[4] = {'L', 'Z', 'B', '1'};
+        inline constexpr char block_magic[4] = {'L', 'Z', 'B', 'K'};
+        inline constexpr char index_magic[4] = {'L', 'Z', 'B', 'I'};
+        inline constexpr char trailer_magic[4] = {'L', 'Z', 'B', 'T'};
+
+        inline constexpr std::size_t block_header_size = 12;
+        inline constexpr std::size_t trailer_size = 12;
+        inline constexpr std::uint32_t stored_flag = 0x80000000u;
+        inline constexpr std::size_t max_block_size = 4u << 20;
+
+        struct IndexEntry
+        {
+            std::uint64_t m_fileOffset;
+            std::uint64_t m_rawOffset;
+        };
+
+        template <typename T>
+        void put(std::uint8_t*& p, T value) noexcept
+        {
+            for (std::size_t i = 0; i < sizeof(T); ++i) *p++ = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+
+        template <typename T>
+        T get(const std::uint8_t* p) noexcept
+        {
+            T value = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i) value |= static_cast<T>(static_cast<T>(p[i]) << (8 * i));
+            return value;
+        }
+    }
+
+    /**
+     * Compression stage for the binary logs: each written chunk (i.e, the flushed FileLogger cache)
+     * is compressed into the block of its own, within the thread calling write - the logging thread.
+     * The compressed data is written through the underlying stream: i.e, the DirectOutputFileStream.
+     *
+     * @see CompressedInputFileStream for reading back
+     */
+    class CompressedOutputFileStream final : public OutputFileStream<uint8_t>
+    {
+        public:
+
+            explicit CompressedOutputFileStream(std::unique_ptr<OutputFileStream<uint8_t>> stream) :
+                m_pStream(std::move(stream))
+            {
+                if (!isOpen()) return;
+
+                m_frame.assign(std::begin(frame::file_magic), std::end(frame::file_magic));
+                writeFrame();
+            }
+
+            explicit CompressedOutputFileStream(const std::filesystem::path& path) :
+                CompressedOutputFileStream(std::make_unique<BinaryOutputFileStream>(path, std::ios_base::binary | std::ios_base::trunc))
+            {}
+
+            ~CompressedOutputFileStream() override
+            {
+                try
+                {
+                    writeIndex();
+                }
+                catch (...)
+                {
+                    // without the index, the reader walks the block headers
+                }
+            }
+
+            bool isOpen() const override
+            {
+                return m_pStream && m_pStream->isOpen();
+            }
+
+            /**
+             * @return The compressed size: bytes written so far
+             */
+            std::size_t size() const override
+            {
+                return m_offset;
+            }
+
+            /**
+             * @return The raw (uncompressed) size: bytes written so far
+             */
+            std::uint64_t rawSize() const noexcept
+            {
+                return m_rawOffset;
+            }
+
+            using OutputFileStream<uint8_t>::write; // the chunk overloads: forwarded to the range
+
+            void write(view_t data) override
+            {
+                compress(data.data(), data.size());
+            }
+
+        private:
+
+            void compress(const uint8_t* data, std::size_t size)
+            {
+                if (!isOpen()) return;
+
+                for (std::size_t pos = 0; pos < size; pos += frame::max_block_size)
+                {
+                    compressBlock(data + pos, std::min(frame::max_block_size, size - pos));
+                }
+            }
+
+            void compressBlock(const uint8_t* data, std::size_t size)
+            {
+                // The frame buffer is reused: header and payload, in single write
+                m_frame.resize(frame::block_header_size + lz::bound(size));
+                uint8_t* payload = m_frame.data() + frame::block_header_size;
+
+                auto payloadSize = lz::compress(data, size, payload);
+                std::uint32_t flags = 0;
+                if (payloadSize >= size) // incompressible: store it as it is
+                {
+                    std::memcpy(payload, data, size);
+                    payloadSize = size;
+                    flags = frame::stored_flag;
+                }
+                m_frame.resize(frame::block_header_size + payloadSize);
+
+                uint8_t* p = m_frame.data();
+                std::memcpy(p, frame::block_magic, sizeof(frame::block_magic));
+                p += sizeof(frame::block_magic);
+                frame::put(p, static_cast<std::uint32_t>(size));
+                frame::put(p, static_cast<std::uint32_t>(payloadSize) | flags);
+
+                m_index.push_back({m_offset, m_rawOffset});
+                m_rawOffset += size;
+
+                writeFrame();
+            }
+
+            void writeIndex()
+            {
+                if (!isOpen()) return;
+
+                const auto indexOffset = m_offset;
+
+                m_frame.resize(8 + m_index.size() * 16 + frame::trailer_size);
+                uint8_t* p = m_frame.data();
+
+                std::memcpy(p, frame::index_magic, sizeof(frame::index_magic));
+                p += sizeof(frame::index_magic);
+                frame::put(p, static_cast<std::uint32_t>(m_index.size()));
+                for (const auto& entry : m_index)
+                {
+                    frame::put(p, entry.m_fileOffset);
+                    frame::put(p, entry.m_rawOffset);
+                }
+
+                frame::put(p, indexOffset);
+                std::memcpy(p, frame::trailer_magic, sizeof(frame::trailer_magic));
+
+                writeFrame();
+            }
+
+            void writeFrame()
+            {
+                m_pStream->write(m_frame);
+                m_offset += m_frame.size();
+            }
+
+        private:
+
+            std::unique_ptr<OutputFileStream<uint8_t>> m_pStream;
+
+            chunk_t m_frame;
+            std::vector<frame::IndexEntry> m_index;
+
+            std::uint64_t m_offset = 0;
+            std::uint64_t m_rawOffset = 0;
+    };
+
+    /**
+     * Reader of the compressed binary logs: with the random access to the blocks
+     */
+    class CompressedInputFileStream final : public InputFileStream<uint8_t>
+    {
+        public:
+
+            /**
+             * C-tor
+             * Loads the block index
+             *
+             * @note It will throw std::runtime_error in case that the file is not
+             * in the compressed format
+             */
+            explicit CompressedInputFileStream(const std::filesystem::path& path) :
+                InputFileStream<uint8_t>(path, std::ios_base::binary)
+            {
+                if (!isOpen()) throw std::runtime_error(strerror(errno));
+
+                m_fileSize = FileStream::size();
+
+                uint8_t magic[sizeof(frame::file_magic)];
+                if (!readAt(0, magic, sizeof(magic)) || std::memcmp(magic, frame::file_magic, sizeof(magic)) != 0)
+                {
+                    throw std::runtime_error("Not a compressed file");
+                }
+
+                if (!loadIndex()) scanBlocks();
+            }
+
+            /**
+             * @return The number of blocks
+             */
+            std::size_t blocks() const noexcept
+            {
+                return m_index.size();
+            }
+
+            /**
+             * @return The raw (uncompressed) size of the content
+             */
+            std::uint64_t rawSize() const noexcept
+            {
+                return m_rawSize;
+            }
+
+            /**
+             * @param rawOffset The offset within the raw content
+             * @return          The index of the block containing it
+             */
+            std::optional<std::size_t> findBlock(std::uint64_t rawOffset) const noexcept
+            {
+                if (rawOffset >= m_rawSize) return {};
+
+                const auto it = std::upper_bound(m_index.begin(), m_index.end(), rawOffset
+                        , [](std::uint64_t offset, const auto& entry) { return offset < entry.m_rawOffset; });
+
+                return static_cast<std::size_t>(std::distance(m_index.begin(), it) - 1);
+            }
+
+            /**
+             * Seek to the block, and decompress it
+             *
+             * @param block The block index
+             * @return      The raw content of the block
+             */
+            chunk_t readBlock(std::size_t block)
+            {
+                if (block >= m_index.size()) throw std::out_of_range("Block index out of range!");
+
+                const auto [rawSize, payloadSize, stored] = readHeader(m_index[block].m_fileOffset);
+
+                m_payload.resize(payloadSize);
+                if (!readAt(m_index[block].m_fileOffset + frame::block_header_size, m_payload.data(), payloadSize))
+                {
+                    throw std::runtime_error("Truncated block");
+                }
+
+                if (stored) return m_payload;
+
+                chunk_t raw(rawSize);
+                if (!lz::decompress(m_payload.data(), m_payload.size(), raw.data(), raw.size()))
+                {
+                    throw std::runtime_error("Corrupted block");
+                }
+
+                return raw;
+            }
+
+            chunk_t readAll() override
+            {
+                chunk_t content;
+                content.reserve(m_rawSize);
+
+                for (std::size_t block = 0; block < m_index.size(); ++block)
+                {
+                    const auto raw = readBlock(block);
+                    content.insert(content.end(), raw.begin(), raw.end());
+                }
+
+                return content;
+            }
+
+        private:
+
+            struct Header
+            {
+                std::uint32_t m_rawSize;
+                std::uint32_t m_payloadSize;
+                bool m_stored;
+            };
+
+            bool readAt(std::uint64_t offset, uint8_t* data, std::size_t size)
+            {
+                if (offset + size > m_fileSize) return false;
+
+                m_file.clear();
+                m_file.seekg(static_cast<std::streamoff>(offset));
+                return static_cast<bool>(m_file.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size)));
+            }
+
+            Header readHeader(std::uint64_t offset)
+            {
+                uint8_t header[frame::block_header_size];
+                if (!readAt(offset, header, sizeof(header)) || std::memcmp(header, frame::block_magic, sizeof(frame::block_magic)) != 0)
+                {
+                    throw std::runtime_error("Corrupted block header");
+                }
+
+                const auto rawSize = frame::get<std::uint32_t>(header + 4);
+                const auto payload = frame::get<std::uint32_t>(header + 8);
+                const bool stored = (payload & frame::stored_flag) != 0;
+
+                return {rawSize, payload & ~frame::stored_flag, stored};
+            }
+
+            bool loadIndex()
+            {
+                uint8_t trailer[frame::trailer_size];
+                if (m_fileSize < sizeof(frame::file_magic) + 8 + frame::trailer_size
+                        || !readAt(m_fileSize - frame::trailer_size, trailer, sizeof(trailer))
+                        || std::memcmp(trailer + 8, frame::trailer_magic, sizeof(frame::trailer_magic)) != 0) return false;
+
+                const auto indexOffset = frame::get<std::uint64_t>(trailer);
+
+                uint8_t head[8];
+                if (!readAt(indexOffset, head, sizeof(head)) || std::memcmp(head, frame::index_magic, sizeof(frame::index_magic)) != 0) return false;
+
+                const auto count = frame::get<std::uint32_t>(head + 4);
+                if (indexOffset + 8 + std::uint64_t{count} * 16 + frame::trailer_size != m_fileSize) return false;
+
+                std::vector<uint8_t> entries(std::size_t{count} * 16);
+                if (!readAt(indexOffset + 8, entries.data(), entries.size())) return false;
+
+                m_index.resize(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    m_index[i].m_fileOffset = frame::get<std::uint64_t>(entries.data() + 16 * i);
+                    m_index[i].m_rawOffset = frame::get<std::uint64_t>(entries.data() + 16 * i + 8);
+                }
+
+                m_rawSize = count > 0 ? m_index.back().m_rawOffset + readHeader(m_index.back().m_fileOffset).m_rawSize : 0;
+                return true;
+            }
+
+            // Without the index: walk the block headers, up to the first incomplete block
+            void scanBlocks()
+            {
+                std::uint64_t offset = sizeof(frame::file_magic);
+                std::uint64_t rawOffset = 0;
+
+                while (offset + frame::block_header_size <= m_fileSize)
+                {
+                    Header header;
+                    try
+                    {
+                        header = readHeader(offset);
+                    }
+                    catch (const std::exception&)
+                    {
+                        break;
+                    }
+
+                    const auto next = offset + frame::block_header_size + header.m_payloadSize;
+                    if (next > m_fileSize) break;
+
+                    m_index.push_back({offset, rawOffset});
+                    rawOffset += header.m_rawSize;
+                    offset = next;
+                }
+
+                m_rawSize = rawOffset;
+            }
+
+        private:
+
+            std::uint64_t m_fileSize = 0;
+            std::uint64_t m_rawSize = 0;
+            std::vector<frame::IndexEntry> m_index;
+            chunk_t m_payload;
+    };
+}
+
+#endif /* FILE_COMPRESSEDFILESTREAM_H_ */
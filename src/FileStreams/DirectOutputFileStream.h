@@ -0,0 +1,194 @@
+//
+// DirectOutputFileStream.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FILE_DIRECTOUTPUTFILESTREAM_H_
+#define FILE_DIRECTOUTPUTFILESTREAM_H_
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include "FileStream.h"
+
+namespace utils::file
+{
+    /**
+     * Binary output file stream with the direct (unbuffered) I/O: for the high-rate BLOB logging.
+     *
+     * The data is staged into the page-aligned buffer, and written in the full aligned blocks,
+     * bypassing both the fstream internal buffering and the page cache (O_DIRECT).
+     * The last, partial block is padded on close, and the file is truncated back to its logical size.
+     *
+     * In case that the file system doesn't support the direct I/O (i.e: tmpfs), it falls back
+     * to the buffered writes of the same aligned blocks, dropping the written pages from the
+     * page cache afterwards.
+     *
+     * @note The file is always truncated on open
+     */
+    class DirectOutputFileStream final : public OutputFileStream<uint8_t>
+    {
+        public:
+
+            static constexpr std::size_t alignment = 4096;
+
+            /**
+             * C-tor
+             *
+             * @param path          The file path
+             * @param bufferSize    The staging buffer size: rounded up to the alignment
+             */
+            explicit DirectOutputFileStream(const std::filesystem::path& path, std::size_t bufferSize = 1 << 20) noexcept :
+                m_capacity(std::max(alignment, (bufferSize + alignment - 1) / alignment * alignment))
+            {
+                void* buffer = nullptr;
+                if (0 != ::posix_memalign(&buffer, alignment, m_capacity)) return;
+                m_pBuffer.reset(static_cast<uint8_t*>(buffer));
+
+                constexpr int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+
+                m_fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+                m_direct = (m_fd >= 0);
+                if (!m_direct && EINVAL == errno)
+                {
+                    m_fd = ::open(path.c_str(), flags, 0644);
+                }
+            }
+
+            ~DirectOutputFileStream() override
+            {
+                close();
+            }
+
+            bool isOpen() const override
+            {
+                return m_fd >= 0;
+            }
+
+            /**
+             * @return The logical size of the file: bytes written so far
+             */
+            std::size_t size() const override
+            {
+                return m_size;
+            }
+
+            /**
+             * @return Indication whether the page cache is bypassed
+             */
+            bool isDirect() const noexcept
+            {
+                return m_direct;
+            }
+
+            using OutputFileStream<uint8_t>::write; // the chunk overloads: forwarded to the range
+
+            void write(view_t data) override
+            {
+                append(data.data(), data.size());
+            }
+
+        private:
+
+            struct Free
+            {
+                void operator()(uint8_t* ptr) const noexcept { std::free(ptr); }
+            };
+
+            void append(const uint8_t* data, std::size_t size)
+            {
+                if (!isOpen()) return;
+
+                while (size > 0)
+                {
+                    const auto n = std::min(size, m_capacity - m_used);
+                    std::memcpy(m_pBuffer.get() + m_used, data, n);
+
+                    m_used += n;
+                    m_size += n;
+                    data += n;
+                    size -= n;
+
+                    if (m_used == m_capacity)
+                    {
+                        writeBlocks(m_capacity);
+                        m_used = 0;
+                    }
+                }
+            }
+
+            void writeBlocks(std::size_t size)
+            {
+                const uint8_t* data = m_pBuffer.get();
+                const auto offset = static_cast<off_t>(m_offset);
+
+                while (size > 0)
+                {
+                    const auto written = ::pwrite(m_fd, data, size, static_cast<off_t>(m_offset));
+                    if (written < 0)
+                    {
+                        if (EINTR == errno) continue;
+                        throw std::runtime_error(strerror(errno));
+                    }
+
+                    data += written;
+                    size -= static_cast<std::size_t>(written);
+                    m_offset += static_cast<std::size_t>(written);
+                }
+
+                if (!m_direct)
+                {
+                    (void)::posix_fadvise(m_fd, offset, static_cast<off_t>(m_offset) - offset, POSIX_FADV_DONTNEED);
+                }
+            }
+
+            void close() noexcept
+            {
+                if (!isOpen()) return;
+
+                try
+                {
+                    if (m_used > 0)
+                    {
+                        // Pad the partial block, and cut off the padding afterwards
+                        const auto padded = (m_used + alignment - 1) / alignment * alignment;
+                        std::memset(m_pBuffer.get() + m_used, 0, padded - m_used);
+
+                        writeBlocks(padded);
+                        m_used = 0;
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    // best effort: the staged tail is lost
+                }
+
+                (void)::ftruncate(m_fd, static_cast<off_t>(m_size));
+                (void)::close(m_fd);
+                m_fd = -1;
+            }
+
+        private:
+
+            const std::size_t m_capacity;
+            std::unique_ptr<uint8_t, Free> m_pBuffer;
+
+            int m_fd = -1;
+            bool m_direct = false;
+
+            std::size_t m_used = 0;     // staged bytes
+            std::size_t m_offset = 0;   // physical file offset: always aligned
+            std::size_t m_size = 0;     // logical file size
+    };
+}
+
+#endif /* FILE_DIRECTOUTPUTFILESTREAM_H_ */
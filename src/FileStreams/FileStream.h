@@ -12,6 +12,7 @@
 
 #include <fstream>
 #include <filesystem>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -42,9 +43,9 @@ namespace utils::file
                 FileStream(const FileStream& ) = delete;
                 FileStream& operator = (const FileStream& ) = delete;
 
-                bool isOpen() const;
+                virtual bool isOpen() const;
 
-                std::size_t size() const;
+                virtual std::size_t size() const;
 
                 /**
                  * D-tor
@@ -53,6 +54,14 @@ namespace utils::file
                  */
                 virtual ~FileStream();
 
+            protected:
+
+                /**
+                 * For the streams that manage the file medium on their own,
+                 * i.e: rotating, or direct (unbuffered) I/O
+                 */
+                FileStream() noexcept = default;
+
             protected:
 
                 mutable std::fstream m_file;
@@ -75,6 +84,8 @@ namespace utils::file
 
                 using data_t = T;
                 using chunk_t = std::vector<data_t>;
+                using view_t = std::span<const data_t>;
+                using gather_t = std::span<const view_t>;
 
                 virtual void write(const chunk_t& data)
                 {
@@ -86,6 +97,32 @@ namespace utils::file
                     writeData(std::move(data));
                 }
 
+                /**
+                 * Write the contiguous range (i.e: array, sub-range, ring buffer block),
+                 * without copying it into the chunk first
+                 *
+                 * @param data  The data to be written
+                 */
+                virtual void write(view_t data)
+                {
+                    m_file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size_bytes()));
+                }
+
+                /**
+                 * Gather write: the ranges are written in order, as a whole.
+                 * The streams over the file descriptor map it to writev: single syscall
+                 *
+                 * @param data  The ranges to be written
+                 */
+                virtual void write(gather_t data)
+                {
+                    for (const auto& range : data) write(range);
+                }
+
+            protected:
+
+                OutputFileStream() noexcept = default;
+
             private:
 
                     template <class Data>
@@ -93,11 +130,13 @@ namespace utils::file
                                                        std::is_constructible_v<chunk_t, Data> ||
                                                        std::is_convertible_v<Data, chunk_t>;
 
-                    template<class Data, typename = std::enable_if_t<compatible>>
+                    template<class Data>
                     void writeData(Data&& data)
                     {
+                        static_assert(compatible<Data>, "Data is not compatible with the chunk type!");
+
                         auto&& rdata = std::forward<Data>(data);//universal reference
-                        m_file.write(reinterpret_cast<const char*>(&rdata[0]), rdata.size());
+                        write(view_t{rdata.data(), rdata.size()});
                     }
 
         };//class OutputFileStream<T>
@@ -126,6 +165,8 @@ namespace utils::file
                  * Read entire file into memory
                  * @note It will throw std::runtime_error in case that operation on
                  * the input file stream (std::ifstream) is somehow failed
+                 * @see MappedInputFile for the large files: the zero-copy view, instead
+                 * @see ChunkedInputFileStream for the files larger than RAM: the chunks read ahead
                  */
                 virtual chunk_t readAll();
 
@@ -0,0 +1,218 @@
+//
+// LzCodec.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FILE_LZCODEC_H_
+#define FILE_LZCODEC_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace utils::file::lz
+{
+    /*
+     * Fast LZ77-class block codec (the LZ4 block layout):
+     *
+     *  sequence := token [literal length ext] literals [offset:u16 LE] [match length ext]
+     *  token    := (literal length: 4 bits) | (match length - 4: 4 bits)
+     *  ext      := 255, 255, ..., <last byte < 255> - added to the 4-bit value 15
+     *
+     * The last sequence has literals only. The matches are greedy, found through the single-entry
+     * hash table, within the 64KB window: the speed over the ratio - for the background compression
+     * of the binary logs.
+     */
+    inline constexpr std::size_t min_match = 4;
+    inline constexpr std::size_t max_offset = 65535;
+
+    /**
+     * @param size  The raw data size
+     * @return      The worst case compressed size: for the incompressible data
+     */
+    constexpr std::size_t bound(std::size_t size) noexcept
+    {
+        return size + size / 255 + 16;
+    }
+
+    namespace details
+    {
+        inline constexpr int hash_log = 12;
+
+        inline std::uint32_t read32(const std::uint8_t* p) noexcept
+        {
+            std::uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline std::uint32_t hash(std::uint32_t sequence) noexcept
+        {
+            return (sequence * 2654435761u) >> (32 - hash_log);
+        }
+
+        inline std::uint8_t* writeLength(std::uint8_t* op, std::size_t length) noexcept
+        {
+            for (; length >= 255; length -= 255) *op++ = 255;
+            *op++ = static_cast<std::uint8_t>(length);
+            return op;
+        }
+
+        inline std::uint8_t* writeSequence(std::uint8_t* op
+                , const std::uint8_t* literals, std::size_t literalLength
+                , std::size_t offset, std::size_t matchLength) noexcept
+        {
+            std::uint8_t* token = op++;
+
+            *token = static_cast<std::uint8_t>(std::min<std::size_t>(literalLength, 15) << 4);
+            if (literalLength >= 15) op = writeLength(op, literalLength - 15);
+
+            if (literalLength > 0) std::memcpy(op, literals, literalLength);
+            op += literalLength;
+
+            if (matchLength > 0) // not the last sequence
+            {
+                *op++ = static_cast<std::uint8_t>(offset);
+                *op++ = static_cast<std::uint8_t>(offset >> 8);
+
+                const auto length = matchLength - min_match;
+                *token |= static_cast<std::uint8_t>(std::min<std::size_t>(length, 15));
+                if (length >= 15) op = writeLength(op, length - 15);
+            }
+
+            return op;
+        }
+
+        inline bool readLength(const std::uint8_t*& ip, const std::uint8_t* end, std::size_t& length) noexcept
+        {
+            std::uint8_t byte = 255;
+            while (byte == 255)
+            {
+                if (ip >= end) return false;
+                byte = *ip++;
+                length += byte;
+            }
+            return true;
+        }
+    }
+
+    /**
+     * Compress the block
+     *
+     * @param src   The raw data
+     * @param size  The raw data size
+     * @param dst   The output: at least bound(size) bytes
+     * @return      The compressed size
+     */
+    inline std::size_t compress(const std::uint8_t* src, std::size_t size, std::uint8_t* dst) noexcept
+    {
+        using namespace details;
+
+        std::array<std::uint32_t, 1u << hash_log> table {};
+
+        std::uint8_t* op = dst;
+        std::size_t anchor = 0;
+
+        if (size > 12)
+        {
+            const std::size_t limit = size - 12;        // the last match starts before
+            const std::size_t matchLimit = size - 5;    // the last literals
+
+            std::size_t ip = 0;
+            while (ip < limit)
+            {
+                const auto sequence = read32(src + ip);
+                auto& entry = table[hash(sequence)];
+                const std::size_t candidate = entry;
+                entry = static_cast<std::uint32_t>(ip);
+
+                if (candidate < ip && ip - candidate <= max_offset && read32(src + candidate) == sequence)
+                {
+                    std::size_t length = min_match;
+                    while (ip + length < matchLimit && src[candidate + length] == src[ip + length]) ++length;
+
+                    op = writeSequence(op, src + anchor, ip - anchor, ip - candidate, length);
+
+                    ip += length;
+                    anchor = ip;
+
+                    if (ip < limit) table[hash(read32(src + ip - 2))] = static_cast<std::uint32_t>(ip - 2);
+                }
+                else
+                {
+                    ip += 1 + ((ip - anchor) >> 6); // skip faster over the incompressible data
+                }
+            }
+        }
+
+        op = writeSequence(op, src + anchor, size - anchor, 0, 0);
+
+        return static_cast<std::size_t>(op - dst);
+    }
+
+    /**
+     * Decompress the block
+     *
+     * @param src       The compressed data
+     * @param size      The compressed size
+     * @param dst       The output
+     * @param rawSize   The raw data size
+     * @return          Indication of the operation outcome: false for the corrupted data
+     */
+    inline bool decompress(const std::uint8_t* src, std::size_t size, std::uint8_t* dst, std::size_t rawSize) noexcept
+    {
+        using namespace details;
+
+        const std::uint8_t* ip = src;
+        const std::uint8_t* const end = src + size;
+        std::size_t op = 0;
+
+        while (ip < end)
+        {
+            const auto token = *ip++;
+
+            std::size_t literals = token >> 4;
+            if (15 == literals && !readLength(ip, end, literals)) return false;
+            if (literals > static_cast<std::size_t>(end - ip) || literals > rawSize - op) return false;
+
+            if (literals > 0) std::memcpy(dst + op, ip, literals);
+            ip += literals;
+            op += literals;
+
+            if (ip == end) break; // the last sequence
+
+            if (end - ip < 2) return false;
+            const std::size_t offset = ip[0] | (static_cast<std::size_t>(ip[1]) << 8);
+            ip += 2;
+            if (0 == offset || offset > op) return false;
+
+            std::size_t length = token & 15;
+            if (15 == length && !readLength(ip, end, length)) return false;
+            length += min_match;
+            if (length > rawSize - op) return false;
+
+            // Byte by byte: the match may overlap the output
+            const std::uint8_t* match = dst + op - offset;
+            for (std::size_t i = 0; i < length; ++i) dst[op + i] = match[i];
+            op += length;
+        }
+
+        return op == rawSize;
+    }
+
+    /**
+     * @param src   The raw data
+     * @return      The compressed block
+     */
+    inline std::vector<std::uint8_t> compress(const std::vector<std::uint8_t>& src)
+    {
+        std::vector<std::uint8_t> dst(bound(src.size()));
+        dst.resize(compress(src.data(), src.size(), dst.data()));
+        return dst;
+    }
+}
+
+#endif /* FILE_LZCODEC_H_ */
@@ -0,0 +1,249 @@
+//
+// MappedInputFile.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FILE_MAPPEDINPUTFILE_H_
+#define FILE_MAPPEDINPUTFILE_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utils::file
+{
+    /**
+     * The access pattern hint, for the kernel read-ahead (madvise)
+     */
+    enum class access_t
+    {
+         normal
+        ,sequential         // aggressive read-ahead, the pages are dropped behind
+        ,random             // no read-ahead
+        ,willneed           // prefetch
+    };
+
+    /**
+     * Read-only, zero-copy view of the whole file: as the alternative to InputFileStream<T>::readAll,
+     * for parsing the large files in place - without the copy, and without the memory spike.
+     *
+     * The file is mapped, and the pages are loaded on demand.
+     * In case that the file can't be mapped (i.e: pipe, procfs, or the mmap failure),
+     * it's read into memory instead - with the warning on stderr, since that's the full copy.
+     *
+     * @note It will throw std::runtime_error in case that the file can't be opened, nor read
+     *
+     * @tparam T    The data type: the trailing bytes that don't make the whole T are not part of the view
+     */
+    template <class T>
+    class MappedInputFile final
+    {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable!");
+            static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "T is over-aligned for the fallback copy!");
+
+        public:
+
+            using data_t = T;
+            using view_t = std::span<const data_t>;
+
+            /**
+             * C-tor
+             *
+             * @param path      The file path
+             * @param access    The access pattern hint
+             */
+            explicit MappedInputFile(const std::filesystem::path& path, access_t access = access_t::sequential)
+            {
+                const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0) throw std::runtime_error(path.string() + ": " + strerror(errno));
+
+                try
+                {
+                    map(fd, path, access);
+                }
+                catch (...)
+                {
+                    ::close(fd);
+                    throw;
+                }
+
+                ::close(fd); // the mapping stays valid
+            }
+
+            ~MappedInputFile()
+            {
+                unmap();
+            }
+
+            MappedInputFile(const MappedInputFile&) = delete;
+            MappedInputFile& operator = (const MappedInputFile&) = delete;
+
+            MappedInputFile(MappedInputFile&& other) noexcept :
+                m_pBase(std::exchange(other.m_pBase, nullptr))
+                , m_size(std::exchange(other.m_size, 0))
+                , m_fallback(std::move(other.m_fallback))
+            {}
+
+            MappedInputFile& operator = (MappedInputFile&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    unmap();
+                    m_pBase = std::exchange(other.m_pBase, nullptr);
+                    m_size = std::exchange(other.m_size, 0);
+                    m_fallback = std::move(other.m_fallback);
+                }
+                return *this;
+            }
+
+            /**
+             * @return The file content
+             */
+            view_t data() const noexcept
+            {
+                const void* base = m_pBase ? m_pBase : static_cast<const void*>(m_fallback.data());
+                return view_t{static_cast<const data_t*>(base), m_size / sizeof(data_t)};
+            }
+
+            /**
+             * @return The file size in bytes
+             */
+            std::size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            /**
+             * @return Indication whether the view is the mapping, or the copy
+             */
+            bool isMapped() const noexcept
+            {
+                return nullptr != m_pBase;
+            }
+
+            /**
+             * Change the access pattern hint for the part of the file: no-op for the copy
+             *
+             * @param access    The access pattern hint
+             * @param offset    The offset of the first element
+             * @param count     The number of elements
+             */
+            void advise(access_t access, std::size_t offset = 0, std::size_t count = static_cast<std::size_t>(-1)) const noexcept
+            {
+                if (!isMapped()) return;
+
+                const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+                const auto first = std::min(offset * sizeof(data_t), m_size);
+                const auto end = (count >= (m_size - first) / sizeof(data_t)) ? m_size : first + count * sizeof(data_t);
+                const auto begin = first / page * page; // page-aligned
+                if (end <= begin) return;
+
+                (void)::madvise(m_pBase + begin, end - begin, toAdvice(access));
+            }
+
+        private:
+
+            void map(int fd, const std::filesystem::path& path, access_t access)
+            {
+                struct stat st {};
+                if (0 == ::fstat(fd, &st) && S_ISREG(st.st_mode))
+                {
+                    m_size = static_cast<std::size_t>(st.st_size);
+                    if (0 == m_size) // empty, or the pseudo file (i.e: procfs) of the unknown size
+                    {
+                        read(fd, path);
+                        if (m_size > 0) (void)fprintf(stderr, "<Warning> %s: pseudo file, read %zu bytes into memory\n", path.c_str(), m_size);
+                        return;
+                    }
+
+                    void* addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (MAP_FAILED != addr)
+                    {
+                        m_pBase = static_cast<std::uint8_t*>(addr);
+                        (void)::madvise(m_pBase, m_size, toAdvice(access));
+                        return;
+                    }
+
+                    (void)fprintf(stderr, "<Warning> %s: mmap failed (%s), reading %zu bytes into memory\n"
+                            , path.c_str(), strerror(errno), m_size);
+                }
+                else
+                {
+                    (void)fprintf(stderr, "<Warning> %s: not a regular file, reading into memory\n", path.c_str());
+                }
+
+                read(fd, path);
+            }
+
+            /*
+             * The fallback: read until EOF, since the size of the special files is unknown upfront
+             */
+            void read(int fd, const std::filesystem::path& path)
+            {
+                m_fallback.clear();
+
+                std::size_t total = 0;
+                for (;;)
+                {
+                    if (m_fallback.size() - total < 4096) m_fallback.resize(std::max<std::size_t>(m_fallback.size() * 2, 64 * 1024));
+
+                    const auto n = ::read(fd, m_fallback.data() + total, m_fallback.size() - total);
+                    if (n == 0) break;
+                    if (n < 0)
+                    {
+                        if (EINTR == errno) continue;
+                        throw std::runtime_error(path.string() + ": " + strerror(errno));
+                    }
+                    total += static_cast<std::size_t>(n);
+                }
+
+                m_fallback.resize(total);
+                m_fallback.shrink_to_fit();
+                m_size = total;
+            }
+
+            void unmap() noexcept
+            {
+                if (m_pBase) ::munmap(m_pBase, m_size);
+                m_pBase = nullptr;
+            }
+
+            static int toAdvice(access_t access) noexcept
+            {
+                switch (access)
+                {
+                    case access_t::sequential:  return MADV_SEQUENTIAL;
+                    case access_t::random:      return MADV_RANDOM;
+                    case access_t::willneed:    return MADV_WILLNEED;
+                    default:                    return MADV_NORMAL;
+                }
+            }
+
+        private:
+
+            std::uint8_t* m_pBase = nullptr;
+            std::size_t m_size = 0;
+            std::vector<std::uint8_t> m_fallback;  // the copy: for the files that can't be mapped
+    };
+
+    // Strong (named) type - type alias
+    using MappedBinaryInputFile = MappedInputFile<uint8_t>;
+}
+
+#endif /* FILE_MAPPEDINPUTFILE_H_ */
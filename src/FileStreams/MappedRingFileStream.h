@@ -0,0 +1,361 @@
+//
+// MappedRingFileStream.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FILE_MAPPEDRINGFILESTREAM_H_
+#define FILE_MAPPEDRINGFILESTREAM_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FileStream.h"
+
+namespace utils::file
+{
+    /**
+     * Fixed-size file, mapped into memory and used as the circular buffer: for the crash forensics.
+     * The content is in the page cache as soon as it's copied, so it survives the process crash
+     * without any write() syscall.
+     *
+     * The writers reserve the space with the atomic fetch-add on the total byte count,
+     * kept in the header page of the file together with the committed byte count,
+     * and copy the data straight into the mapping.
+     * On reopen, the writing continues where it stopped: the previous content is overwritten
+     * only as the ring wraps.
+     *
+     * @note The last (reserved - committed) bytes may be incomplete, after the crash.
+     * The ring should be large enough not to be lapped while the message is being copied:
+     * the writers don't wait for each other, so the overrun data are overwritten.
+     */
+    class MappedRing final
+    {
+        public:
+
+            static constexpr std::size_t header_size = 4096; // the data are page-aligned
+
+            /**
+             * C-tor
+             * Create (or reopen) the ring file, and map it
+             *
+             * @param path      The file path
+             * @param capacity  The ring capacity, in bytes
+             */
+            MappedRing(const std::filesystem::path& path, std::size_t capacity) noexcept
+            {
+                const auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+                if (fd < 0) return;
+
+                const auto fileSize = header_size + capacity;
+                if (capacity > 0 && 0 == ::ftruncate(fd, static_cast<off_t>(fileSize)))
+                {
+                    void* addr = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    if (MAP_FAILED != addr)
+                    {
+                        m_pBase = static_cast<std::uint8_t*>(addr);
+                        m_mappedSize = fileSize;
+                        m_capacity = capacity;
+
+                        initialize();
+                    }
+                }
+
+                ::close(fd); // the mapping stays valid
+            }
+
+            ~MappedRing()
+            {
+                if (m_pBase) ::munmap(m_pBase, m_mappedSize);
+            }
+
+            MappedRing(const MappedRing&) = delete;
+            MappedRing& operator = (const MappedRing&) = delete;
+
+            /**
+             * @param path      The file path
+             * @param capacity  The ring capacity, for the first one opened
+             * @return          The ring shared by all writers on the same file, within the process
+             */
+            static std::shared_ptr<MappedRing> shared(const std::filesystem::path& path, std::size_t capacity)
+            {
+                static std::mutex lock;
+                static std::unordered_map<std::string, std::weak_ptr<MappedRing>> rings;
+
+                std::lock_guard<std::mutex> guard {lock};
+
+                auto& weak = rings[std::filesystem::absolute(path).string()];
+                auto ring = weak.lock();
+                if (!ring)
+                {
+                    ring = std::make_shared<MappedRing>(path, capacity);
+                    weak = ring;
+                }
+                return ring;
+            }
+
+            bool isOpen() const noexcept
+            {
+                return nullptr != m_pBase;
+            }
+
+            std::size_t capacity() const noexcept
+            {
+                return m_capacity;
+            }
+
+            /**
+             * @return The size of the content: up to the capacity
+             */
+            std::size_t size() const noexcept
+            {
+                return static_cast<std::size_t>(std::min<std::uint64_t>(reserved().load(std::memory_order_acquire), m_capacity));
+            }
+
+            /**
+             * Lock-free write: reserve the space, and copy the data into the mapping.
+             * In case that the data is larger than the ring, only its tail is preserved
+             *
+             * @param data  The data
+             * @param size  The size in bytes
+             */
+            void write(const void* data, std::size_t size) noexcept
+            {
+                if (!isOpen() || 0 == size) return;
+
+                auto src = static_cast<const std::uint8_t*>(data);
+                if (size > m_capacity)
+                {
+                    src += size - m_capacity;
+                    size = m_capacity;
+                }
+
+                const auto pos = reserved().fetch_add(size, std::memory_order_relaxed);
+                copy(pos, src, size);
+
+                committed().fetch_add(size, std::memory_order_release);
+            }
+
+            /**
+             * Gather write: the ranges are reserved at once, so that they end up contiguous in the ring
+             *
+             * @param ranges    The data ranges
+             */
+            template <class T>
+            void write(std::span<const std::span<const T>> ranges) noexcept
+            {
+                if (!isOpen()) return;
+
+                std::size_t size = 0;
+                for (const auto& range : ranges) size += range.size_bytes();
+                if (0 == size) return;
+
+                if (size > m_capacity) // only the tail is preserved anyway
+                {
+                    for (const auto& range : ranges) write(range.data(), range.size_bytes());
+                    return;
+                }
+
+                auto pos = reserved().fetch_add(size, std::memory_order_relaxed);
+                for (const auto& range : ranges)
+                {
+                    copy(pos, range.data(), range.size_bytes());
+                    pos += range.size_bytes();
+                }
+
+                committed().fetch_add(size, std::memory_order_release);
+            }
+
+            /**
+             * Schedule the write-back of the mapping (i.e: for the power loss), without waiting
+             */
+            void sync() const noexcept
+            {
+                if (isOpen()) (void)::msync(m_pBase, m_mappedSize, MS_ASYNC);
+            }
+
+            /**
+             * @return The content, in chronological order: the oldest bytes first
+             */
+            std::vector<std::uint8_t> snapshot() const
+            {
+                if (!isOpen()) return {};
+                return linearize(m_pBase + header_size, m_capacity, reserved().load(std::memory_order_acquire));
+            }
+
+            /**
+             * For the forensics: read the ring file left behind, without opening it for writing
+             *
+             * @param path  The ring file path
+             * @return      The content, in chronological order
+             */
+            static std::vector<std::uint8_t> read(const std::filesystem::path& path)
+            {
+                std::ifstream file {path, std::ios_base::binary};
+                if (!file) throw std::runtime_error(strerror(errno));
+
+                std::vector<std::uint8_t> content {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+                Header header;
+                if (content.size() < header_size) throw std::runtime_error("Not a ring file");
+                std::memcpy(&header, content.data(), sizeof(header));
+                // No capacity, or not the one of the mapping (checked without the sum: it could wrap)
+                if (std::memcmp(header.m_magic, magic, sizeof(magic)) != 0
+                        || 0 == header.m_capacity
+                        || header.m_capacity != content.size() - header_size)
+                {
+                    throw std::runtime_error("Not a ring file");
+                }
+
+                return linearize(content.data() + header_size, header.m_capacity, header.m_reserved);
+            }
+
+        private:
+
+            static constexpr char magic[8] = {'M', 'R', 'I', 'N', 'G', '0', '1', '\0'};
+
+            struct Header
+            {
+                char m_magic[8];
+                std::uint64_t m_capacity;
+                alignas(64) std::uint64_t m_reserved;    // the total bytes reserved: the wrap position is (reserved % capacity)
+                alignas(64) std::uint64_t m_committed;   // the total bytes copied
+            };
+
+            Header& header() const noexcept
+            {
+                return *reinterpret_cast<Header*>(m_pBase);
+            }
+
+            std::atomic_ref<std::uint64_t> reserved() const noexcept
+            {
+                return std::atomic_ref<std::uint64_t>{header().m_reserved};
+            }
+
+            std::atomic_ref<std::uint64_t> committed() const noexcept
+            {
+                return std::atomic_ref<std::uint64_t>{header().m_committed};
+            }
+
+            void copy(std::uint64_t pos, const void* data, std::size_t size) noexcept
+            {
+                if (0 == size) return;
+
+                auto src = static_cast<const std::uint8_t*>(data);
+                const auto offset = static_cast<std::size_t>(pos % m_capacity);
+                const auto first = std::min(size, m_capacity - offset);
+
+                std::memcpy(m_pBase + header_size + offset, src, first);
+                std::memcpy(m_pBase + header_size, src + first, size - first);
+            }
+
+            void initialize() noexcept
+            {
+                auto& h = header();
+                if (std::memcmp(h.m_magic, magic, sizeof(magic)) == 0 && h.m_capacity == m_capacity)
+                {
+                    // Reopened: drop the incomplete tail of the previous run
+                    h.m_reserved = h.m_committed = std::min(h.m_reserved, h.m_committed);
+                    return;
+                }
+
+                std::memset(m_pBase, 0, header_size);
+                h.m_capacity = m_capacity;
+                std::memcpy(h.m_magic, magic, sizeof(magic)); // the last one: marks the valid header
+            }
+
+            static std::vector<std::uint8_t> linearize(const std::uint8_t* data, std::size_t capacity, std::uint64_t reserved)
+            {
+                const auto used = static_cast<std::size_t>(std::min<std::uint64_t>(reserved, capacity));
+                const auto start = static_cast<std::size_t>((reserved - used) % capacity);
+                const auto first = std::min(used, capacity - start);
+
+                std::vector<std::uint8_t> content;
+                content.reserve(used);
+                content.insert(content.end(), data + start, data + start + first);
+                content.insert(content.end(), data, data + (used - first));
+
+                return content;
+            }
+
+        private:
+
+            std::uint8_t* m_pBase = nullptr;
+            std::size_t m_mappedSize = 0;
+            std::size_t m_capacity = 0;
+    };
+
+    /**
+     * OutputFileStream over the memory-mapped ring: i.e, as the FileLogger medium
+     * that keeps the last N bytes of the log
+     *
+     * @tparam T    The data type
+     */
+    template <class T>
+    class MappedRingFileStream final : public OutputFileStream<T>
+    {
+        public:
+
+            using chunk_t = typename OutputFileStream<T>::chunk_t;
+            using view_t = typename OutputFileStream<T>::view_t;
+            using gather_t = typename OutputFileStream<T>::gather_t;
+
+            /**
+             * C-tor
+             *
+             * @param path      The ring file path
+             * @param capacity  The ring capacity, in bytes
+             */
+            MappedRingFileStream(const std::filesystem::path& path, std::size_t capacity) :
+                m_pRing(MappedRing::shared(path, capacity))
+            {}
+
+            bool isOpen() const override
+            {
+                return m_pRing->isOpen();
+            }
+
+            std::size_t size() const override
+            {
+                return m_pRing->size();
+            }
+
+            using OutputFileStream<T>::write; // the chunk overloads: forwarded to the range
+
+            void write(view_t data) override
+            {
+                m_pRing->write(data.data(), data.size_bytes());
+            }
+
+            void write(gather_t data) override
+            {
+                m_pRing->write(data);
+            }
+
+            MappedRing& ring() const noexcept
+            {
+                return *m_pRing;
+            }
+
+        private:
+
+            std::shared_ptr<MappedRing> m_pRing;
+    };
+}
+
+#endif /* FILE_MAPPEDRINGFILESTREAM_H_ */
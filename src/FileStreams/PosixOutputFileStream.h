@@ -0,0 +1,146 @@
+//
+// PosixOutputFileStream.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FILE_POSIXOUTPUTFILESTREAM_H_
+#define FILE_POSIXOUTPUTFILESTREAM_H_
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "FileStream.h"
+
+namespace utils::file
+{
+    /**
+     * Output file stream over the file descriptor, without the user-space buffering:
+     * each write is the syscall, and the gather write maps to the single writev.
+     * i.e: for the FileLogger, that already buffers on its own
+     *
+     * @note It will throw std::runtime_error in case that the write fails
+     *
+     * @tparam T    The data type
+     */
+    template <class T>
+    class PosixOutputFileStream final : public OutputFileStream<T>
+    {
+        public:
+
+            using view_t = typename OutputFileStream<T>::view_t;
+            using gather_t = typename OutputFileStream<T>::gather_t;
+
+            /**
+             * C-tor
+             *
+             * @param path      The file path
+             * @param append    Indication whether to append to the existing file, or truncate it
+             */
+            explicit PosixOutputFileStream(const std::filesystem::path& path, bool append = false) noexcept :
+                m_fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC), 0644))
+            {
+                if (append && m_fd >= 0)
+                {
+                    const auto end = ::lseek(m_fd, 0, SEEK_END);
+                    m_size = (end > 0) ? static_cast<std::size_t>(end) : 0;
+                }
+            }
+
+            ~PosixOutputFileStream() override
+            {
+                if (m_fd >= 0) (void)::close(m_fd);
+            }
+
+            bool isOpen() const override
+            {
+                return m_fd >= 0;
+            }
+
+            std::size_t size() const override
+            {
+                return m_size;
+            }
+
+            using OutputFileStream<T>::write; // the chunk overloads: forwarded to the range
+
+            void write(view_t data) override
+            {
+                const view_t ranges[] = {data};
+                write(gather_t{ranges});
+            }
+
+            void write(gather_t data) override
+            {
+                if (!isOpen()) return;
+
+                std::array<iovec, batch> iov;
+                std::size_t next = 0;   // the next range, to be added to the batch
+                std::size_t offset = 0; // bytes of it already written
+
+                while (next < data.size())
+                {
+                    std::size_t count = 0;
+                    for (auto i = next; i < data.size() && count < batch; ++i)
+                    {
+                        const auto skip = (i == next) ? offset : 0;
+                        const auto bytes = data[i].size_bytes() - skip;
+                        if (0 == bytes) continue;
+
+                        iov[count].iov_base = const_cast<char*>(reinterpret_cast<const char*>(data[i].data()) + skip);
+                        iov[count].iov_len = bytes;
+                        ++count;
+                    }
+                    if (0 == count) break;
+
+                    const auto written = ::writev(m_fd, iov.data(), static_cast<int>(count));
+                    if (written < 0)
+                    {
+                        if (EINTR == errno) continue;
+                        throw std::runtime_error(strerror(errno));
+                    }
+                    m_size += static_cast<std::size_t>(written);
+
+                    // Advance past the written bytes: the partial write resumes within the range
+                    auto remaining = static_cast<std::size_t>(written);
+                    while (next < data.size())
+                    {
+                        const auto left = data[next].size_bytes() - offset;
+                        if (remaining < left)
+                        {
+                            offset += remaining;
+                            break;
+                        }
+
+                        remaining -= left;
+                        offset = 0;
+                        ++next;
+                    }
+                }
+            }
+
+        private:
+
+#if defined(IOV_MAX)
+            static constexpr std::size_t batch = std::min<std::size_t>(IOV_MAX, 64);
+#else
+            static constexpr std::size_t batch = 16;
+#endif
+
+            int m_fd = -1;
+            std::size_t m_size = 0;
+    };
+
+    // Strong (named) type - type alias
+    using PosixBinaryOutputFileStream = PosixOutputFileStream<uint8_t>;
+}
+
+#endif /* FILE_POSIXOUTPUTFILESTREAM_H_ */
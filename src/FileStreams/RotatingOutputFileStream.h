@@ -0,0 +1,346 @@
+//
+// RotatingOutputFileStream.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef FILE_ROTATINGOUTPUTFILESTREAM_H_
+#define FILE_ROTATINGOUTPUTFILESTREAM_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "FileStream.h"
+#include "AOThread.h"
+
+namespace utils::file
+{
+    /**
+     * When to switch to the next file: the zero value disables the criterion
+     */
+    struct RotationPolicy
+    {
+        std::size_t m_maxSize = 0;                  // bytes per file
+        std::chrono::seconds m_maxAge {0};          // the age of the file, checked on write
+        std::size_t m_maxFiles = 0;                 // the number of files to keep, including the active one
+    };
+
+    /**
+     * Output file stream with the rotation by size and/or by time.
+     *
+     * For the path "dir/trace.log", the files are "dir/trace.0.log", "dir/trace.1.log", ...
+     * continuing after the highest sequence number found in the directory.
+     *
+     * The next file is always pre-created within the background (housekeeping) thread,
+     * together with removing the oldest files - so that the rotation itself is only
+     * the swap of the streams, and never stalls the writer. Until the next file is there
+     * (i.e: the pre-creation failed, and is retried), the active one grows past the limits.
+     *
+     * The actual file stream is created through the factory: i.e, the DirectOutputFileStream
+     * for the BLOB logging.
+     *
+     * @tparam T    The data type
+     */
+    template <class T>
+    class RotatingOutputFileStream final : public OutputFileStream<T>
+    {
+        public:
+
+            using stream_t = OutputFileStream<T>;
+            using stream_ptr_t = std::unique_ptr<stream_t>;
+            using chunk_t = typename stream_t::chunk_t;
+            using view_t = typename stream_t::view_t;
+            using gather_t = typename stream_t::gather_t;
+            using factory_t = std::function<stream_ptr_t(const std::filesystem::path&)>;
+
+            /**
+             * C-tor
+             * Opens the first file
+             *
+             * @param path      The file path, used as the pattern for the rotated files
+             * @param policy    The rotation policy
+             * @param factory   The file stream factory
+             */
+            RotatingOutputFileStream(std::filesystem::path path
+                    , RotationPolicy policy
+                    , factory_t factory = defaultFactory()) :
+                m_directory(path.has_parent_path() ? path.parent_path() : std::filesystem::path{"."})
+                , m_stem(path.stem().string())
+                , m_extension(path.extension().string())
+                , m_policy(policy)
+                , m_factory(std::move(factory))
+                , m_sequence(lastSequence() + 1)
+                , m_pHousekeeping(std::make_unique<housekeeping_t>("rotation"
+                        , utils::ThreadWrapper::schedule_policy_t::sh_policy_normal
+                        , 0))
+            {
+                activate(m_factory(fileName(m_sequence)));
+                precreate();
+            }
+
+            ~RotatingOutputFileStream() override
+            {
+                m_pCurrent.reset();
+
+                // Discard the pre-created file, if it's not used
+                if (m_next.valid())
+                {
+                    try
+                    {
+                        m_next.get().reset();
+                    }
+                    catch (...)
+                    {}
+
+                    std::error_code ec;
+                    const auto next = fileName(m_sequence + 1);
+                    if (std::filesystem::is_regular_file(next, ec) && 0 == std::filesystem::file_size(next, ec))
+                    {
+                        std::filesystem::remove(next, ec);
+                    }
+                }
+
+                m_pHousekeeping.reset();
+            }
+
+            bool isOpen() const override
+            {
+                return m_pCurrent && m_pCurrent->isOpen();
+            }
+
+            /**
+             * @return The size of the active file
+             */
+            std::size_t size() const override
+            {
+                return m_written;
+            }
+
+            /**
+             * @return The path of the active file
+             */
+            std::filesystem::path current() const
+            {
+                return fileName(m_sequence);
+            }
+
+            void write(const chunk_t& data) override
+            {
+                const auto bytes = data.size() * sizeof(T);
+                rotateIfNeeded(bytes);
+
+                if (!m_pCurrent) return;
+                m_pCurrent->write(data);
+                m_written += bytes;
+            }
+
+            void write(chunk_t&& data) override
+            {
+                const auto bytes = data.size() * sizeof(T);
+                rotateIfNeeded(bytes);
+
+                if (!m_pCurrent) return;
+                m_pCurrent->write(std::move(data));
+                m_written += bytes;
+            }
+
+            void write(view_t data) override
+            {
+                const auto bytes = data.size_bytes();
+                rotateIfNeeded(bytes);
+
+                if (!m_pCurrent) return;
+                m_pCurrent->write(data);
+                m_written += bytes;
+            }
+
+            /**
+             * The ranges are never split across the files
+             */
+            void write(gather_t data) override
+            {
+                std::size_t bytes = 0;
+                for (const auto& range : data) bytes += range.size_bytes();
+                rotateIfNeeded(bytes);
+
+                if (!m_pCurrent) return;
+                m_pCurrent->write(data);
+                m_written += bytes;
+            }
+
+            static factory_t defaultFactory()
+            {
+                return [](const std::filesystem::path& path)
+                {
+                    return std::make_unique<stream_t>(path, std::ios_base::binary | std::ios_base::trunc);
+                };
+            }
+
+        private:
+
+            using clock_t = std::chrono::steady_clock;
+            using housekeeping_t = utils::aot::AOThread<stream_ptr_t>;
+
+            static constexpr std::chrono::seconds retry_period {1}; // of the failed pre-creation
+
+            std::filesystem::path fileName(std::uint64_t sequence) const
+            {
+                return m_directory / (m_stem + '.' + std::to_string(sequence) + m_extension);
+            }
+
+            /*
+             * The existing files of the pattern: func(path, sequence number)
+             */
+            template <typename Func>
+            void forEachFile(Func&& func) const
+            {
+                std::error_code ec;
+                for (const auto& entry : std::filesystem::directory_iterator(m_directory, ec))
+                {
+                    const auto name = entry.path().filename().string();
+                    const auto prefix = m_stem + '.';
+                    if (name.size() <= prefix.size() + m_extension.size()
+                            || name.compare(0, prefix.size(), prefix) != 0
+                            || name.compare(name.size() - m_extension.size(), m_extension.size(), m_extension) != 0) continue;
+
+                    const auto number = name.substr(prefix.size(), name.size() - prefix.size() - m_extension.size());
+                    if (number.find_first_not_of("0123456789") != std::string::npos) continue;
+
+                    try
+                    {
+                        func(entry.path(), static_cast<std::uint64_t>(std::stoull(number)));
+                    }
+                    catch (...)
+                    {}
+                }
+            }
+
+            /*
+             * The highest sequence number of the existing files: to continue after it,
+             * rather than overwriting the logs of the previous run
+             */
+            std::int64_t lastSequence() const
+            {
+                std::int64_t last = -1;
+                forEachFile([&last](const std::filesystem::path&, std::uint64_t sequence)
+                {
+                    last = std::max(last, static_cast<std::int64_t>(sequence));
+                });
+
+                return last;
+            }
+
+            /*
+             * Remove all the files older than the ones to keep: not only the one rotated out,
+             * so that they don't pile up once the limit is lowered (i.e. across the runs)
+             */
+            void removeObsolete(std::uint64_t active) const
+            {
+                if (0 == m_policy.m_maxFiles || active < m_policy.m_maxFiles) return;
+
+                const auto oldest = active - m_policy.m_maxFiles + 1; // the oldest one kept
+                std::vector<std::filesystem::path> obsolete;
+                forEachFile([&obsolete, oldest](const std::filesystem::path& path, std::uint64_t sequence)
+                {
+                    if (sequence < oldest) obsolete.push_back(path);
+                });
+
+                std::error_code ec;
+                for (const auto& path : obsolete) std::filesystem::remove(path, ec);
+            }
+
+            bool expired() const
+            {
+                return m_policy.m_maxAge.count() > 0 && clock_t::now() - m_opened >= m_policy.m_maxAge;
+            }
+
+            void rotateIfNeeded(std::size_t bytes)
+            {
+                if (0 == m_written) return; // never rotate the empty file
+
+                const bool full = m_policy.m_maxSize > 0 && m_written + bytes > m_policy.m_maxSize;
+                if (!full && !expired()) return;
+
+                // Never blocks: until the next file is there, keep writing into the active one
+                if (!m_next.valid())
+                {
+                    if (clock_t::now() >= m_retry) precreate();
+                    return;
+                }
+                if (std::future_status::ready != m_next.wait_for(std::chrono::seconds{0})) return;
+
+                stream_ptr_t next;
+                try
+                {
+                    next = m_next.get();
+                }
+                catch (const std::exception& e)
+                {
+                    (void)fprintf(stderr, "<Error> %s: %s\n", fileName(m_sequence + 1).c_str(), e.what());
+                }
+                catch (...)
+                {
+                    (void)fprintf(stderr, "<Error> %s: unknown error\n", fileName(m_sequence + 1).c_str());
+                }
+
+                if (!next || !next->isOpen())
+                {
+                    // Keep writing into the active file, and try again a bit later: not for each write
+                    m_retry = clock_t::now() + retry_period;
+                    return;
+                }
+
+                ++m_sequence;
+                activate(std::move(next));
+                precreate();
+            }
+
+            void activate(stream_ptr_t stream)
+            {
+                m_pCurrent = std::move(stream); // the previous one is closed
+                m_written = 0;
+                m_opened = clock_t::now();
+            }
+
+            void precreate()
+            {
+                const auto next = fileName(m_sequence + 1);
+
+                m_next = m_pHousekeeping->enqueue(utils::aot::job_t<stream_ptr_t>{[this, next, active = m_sequence]
+                {
+                    removeObsolete(active);
+                    return m_factory(next);
+                }});
+            }
+
+        private:
+
+            const std::filesystem::path m_directory;
+            const std::string m_stem;
+            const std::string m_extension;
+
+            const RotationPolicy m_policy;
+            const factory_t m_factory;
+
+            std::uint64_t m_sequence;
+
+            stream_ptr_t m_pCurrent;
+            std::size_t m_written = 0;
+            clock_t::time_point m_opened;
+
+            std::future<stream_ptr_t> m_next;
+            clock_t::time_point m_retry;
+            std::unique_ptr<housekeeping_t> m_pHousekeeping;
+    };
+}
+
+#endif /* FILE_ROTATINGOUTPUTFILESTREAM_H_ */
@@ -0,0 +1,111 @@
+/*
+ * StripedMutex.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef LOCK_STRIPEDMUTEX_H_
+#define LOCK_STRIPEDMUTEX_H_
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "../commons/Hash.h"
+
+namespace utils::lock
+{
+    /**
+     * Striped class-level mutex
+     *
+     * Instead of the single mutex for all instances of the Host class (@see CLMutex) - the fixed number
+     * of them, each on its own cache line. The instance (or the caller-given key) is mapped to one stripe:
+     * the unrelated instances rarely serialize, the same one always does.
+     *
+     * @code
+     * using lock_t = utils::lock::CLStripedMutex<Host>;
+     *
+     * std::lock_guard lock {lock_t::instance().stripe(this)};  // this instance
+     * std::lock_guard lock {lock_t::instance()};               // all instances: the rare global section
+     * @endcode
+     *
+     * @note Don't take the lock-all while holding the stripe: the order is all the stripes, in order.
+     *       For the two stripes at once, use std::scoped_lock (they may be the same one: compare first).
+     *
+     * @tparam Host     The host class for which the mutex will provide class-level protection
+     * @tparam Stripes  The number of mutexes: the power of two
+     * @tparam Mutex    The mutex type
+     */
+    template <class Host, std::size_t Stripes = 16, typename Mutex = std::mutex>
+    class CLStripedMutex final
+    {
+        static_assert(Stripes > 1 && std::has_single_bit(Stripes), "CLStripedMutex: the number of stripes is to be a power of two");
+
+        public:
+
+            using mutex_type = Mutex;
+            static constexpr std::size_t stripes = Stripes;
+
+            static CLStripedMutex& instance()
+            {
+                static CLStripedMutex clMutex;//Scott Meyers singleton pattern
+                return clMutex;
+            }
+
+            CLStripedMutex(const CLStripedMutex&) = delete;
+            CLStripedMutex& operator=(const CLStripedMutex&) = delete;
+
+            /**
+             * @param address   The instance to be protected
+             * @return          The stripe of the instance
+             */
+            Mutex& stripe(const void* address) noexcept
+            {
+                // The objects are aligned: the lowest bits carry no information
+                return m_stripes[index(reinterpret_cast<std::uintptr_t>(address) >> 4)].m_mutex;
+            }
+
+            /**
+             * @param key   The caller-given key: e.g. the id of the instances to be serialized together
+             * @return      The stripe of the key
+             */
+            Mutex& stripe(std::size_t key) noexcept
+            {
+                return m_stripes[index(key)].m_mutex;
+            }
+
+            // Lock-all (BasicLockable): for std::lock_guard. Stripe by stripe, always in the same order
+
+            void lock()
+            {
+                for (auto& stripe : m_stripes) stripe.m_mutex.lock();
+            }
+
+            void unlock() noexcept
+            {
+                for (auto& stripe : m_stripes) stripe.m_mutex.unlock();
+            }
+
+        private:
+
+            CLStripedMutex() = default;
+
+            static std::size_t index(std::uint64_t key) noexcept
+            {
+                return fibonacci_index<Stripes>(key);
+            }
+
+            struct alignas(64) Stripe
+            {
+                Mutex m_mutex;
+            };
+
+            std::array<Stripe, Stripes> m_stripes;
+    };
+}
+
+
+
+#endif /* LOCK_STRIPEDMUTEX_H_ */
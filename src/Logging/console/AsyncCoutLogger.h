@@ -0,0 +1,150 @@
+//
+// AsyncCoutLogger.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef LOGGING_ASYNCCOUTLOGGER_H_
+#define LOGGING_ASYNCCOUTLOGGER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Logging sink
+#include "AsyncSink.h"
+
+// Logging
+#include "Logger.h"
+#include "LoggingHelper.h"
+#include "CoutLogger.h"
+
+
+namespace utils::log
+{
+    namespace details
+    {
+        /**
+         * Logging record: formatted at the producer side, outside of any lock
+         */
+        struct Record
+        {
+            std::chrono::steady_clock::time_point m_timestamp;
+            log_verbosity_t m_verbosity;
+            std::string m_text;
+        };
+
+        /**
+         * Asynchronous console backend: the records are merged (in timestamp order) by the drainer
+         * of the AsyncSink and written to stdout/stderr in large batches: with one write per stream, per batch.
+         *
+         * The producer never blocks on the console I/O: if its ring is full, the record is dropped
+         * (and reported) - except for the errors, for which the producer waits until there is a free slot.
+         */
+        class AsyncConsole final
+        {
+            public:
+
+                static AsyncConsole& instance()
+                {
+                    static AsyncConsole console;//Scott Meyers singleton pattern
+                    return console;
+                }
+
+                AsyncConsole(const AsyncConsole&) = delete;
+                AsyncConsole& operator = (const AsyncConsole&) = delete;
+
+                /**
+                 * Producer side: enqueue the record into the calling thread ring
+                 *
+                 * @param verbosity The record verbosity level
+                 * @param text      The formatted text
+                 */
+                void write(log_verbosity_t verbosity, std::string&& text) noexcept
+                {
+                    m_sink.push(Record {std::chrono::steady_clock::now(), verbosity, std::move(text)}
+                            , log_verbosity_t::LOG_LEVEL_ERROR == verbosity);
+                }
+
+                /**
+                 * Block until all records enqueued so far are written
+                 */
+                void flush()
+                {
+                    m_sink.flush();
+                }
+
+            private:
+
+                AsyncConsole() = default;
+
+                // The drainer thread only
+                void write(std::vector<Record>& batch)
+                {
+                    std::stable_sort(batch.begin(), batch.end()
+                            , [](const auto& lhs, const auto& rhs) { return lhs.m_timestamp < rhs.m_timestamp; });
+
+                    for (auto& record : batch)
+                    {
+                        auto& stream = (log_verbosity_t::LOG_LEVEL_ERROR == record.m_verbosity) ? m_err : m_out;
+                        stream += record.m_text;
+                    }
+
+                    if (!m_out.empty()) { std::fwrite(m_out.data(), 1, m_out.size(), stdout); std::fflush(stdout); }
+                    if (!m_err.empty()) { std::fwrite(m_err.data(), 1, m_err.size(), stderr); }
+
+                    m_out.clear();
+                    m_err.clear();
+                }
+
+            private:
+
+                std::string m_out;
+                std::string m_err;
+
+                AsyncSink<Record> m_sink {"AsyncConsole", [this](std::vector<Record>& batch) { write(batch); }}; // the last one
+        };
+    }
+
+    /**
+     * @brief Asynchronous logging to the std::cout (std::cerr for errors).
+     * The message is formatted within the logging thread, without any lock held,
+     * and handed over to the background drainer through the per-thread lock-free ring.
+     *
+     * @see CoutLogger: the synchronous version
+     */
+    class AsyncCoutLogger final : public LoggerBase<AsyncCoutLogger>
+    {
+        public:
+            using super = LoggerBase<AsyncCoutLogger>;
+            using super::super; // Using base class c-tor(s): to provide the logging tag
+
+
+            template <typename T>
+            void logImplWithTag(log_verbosity_t verbosity, string_t<T>&& msg) const
+            {
+                if (log_verbosity_t::LOG_LEVEL_ERROR != verbosity && verbosity < LOG_LEVEL) return;
+
+                const std::string& text = msg;
+
+                std::string record;
+                record.reserve(tag().size() + text.size() + 5);
+                record.append("<").append(tag()).append(">: ").append(text).append("\n");
+
+                details::AsyncConsole::instance().write(verbosity, std::move(record));
+            }
+
+            /**
+             * Block until all messages logged so far (from any thread) are written
+             */
+            static void flush()
+            {
+                details::AsyncConsole::instance().flush();
+            }
+    };// AsyncCoutLogger
+
+}//namespace utils::log
+
+#endif /* LOGGING_ASYNCCOUTLOGGER_H_ */
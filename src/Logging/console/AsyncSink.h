@@ -0,0 +1,263 @@
+//
+// AsyncSink.h
+//
+//  Created on: Oct 15, 2026
+//
+
+#ifndef LOGGING_ASYNCSINK_H_
+#define LOGGING_ASYNCSINK_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Lock-free ring
+#include "SpscQueue.h"
+
+
+namespace utils::log::details
+{
+    /**
+     * Asynchronous logging sink.
+     *
+     * Each logging thread writes the records into its own lock-free SPSC ring, registered on the first use.
+     * The single background drainer collects the records from all rings and hands them over
+     * to the writer in batches: the writer is called only from the drainer thread.
+     *
+     * The producer never blocks on the I/O: if its ring is full, the record is dropped
+     * (and reported) - except for the mandatory ones, for which the producer waits until there is a free slot.
+     *
+     * @note The rings are owned per thread, per record type: one sink instance per record type
+     *
+     * @tparam Record   The record type: nothrow movable
+     * @tparam Capacity The capacity of the per-thread ring, power of 2
+     */
+    template <typename Record, std::size_t Capacity = 1024>
+    class AsyncSink final
+    {
+            using ring_t = utils::SpscQueue<Record, Capacity>;
+
+            struct Ring
+            {
+                ring_t m_records;
+                std::atomic<bool> m_closed {false}; // the producer thread exited
+            };
+
+            /*
+             * Thread-local ring ownership: marks the ring as closed on the thread exit,
+             * so that the drainer can release it, once drained
+             */
+            struct RingHolder
+            {
+                std::shared_ptr<Ring> m_pRing = nullptr;
+
+                ~RingHolder()
+                {
+                    if (m_pRing) m_pRing->m_closed.store(true, std::memory_order_release);
+                }
+            };
+
+        public:
+
+            using writer_f = std::function<void (std::vector<Record>&)>;
+
+            /**
+             * C-tor: starts the drainer
+             *
+             * @param name      The sink name, for the dropped records report
+             * @param writer    The batch writer: the batch is in the push order, per thread
+             */
+            AsyncSink(std::string name, writer_f writer)
+                : m_name(std::move(name)), m_writer(std::move(writer)), m_drainer(&AsyncSink::drain, this)
+            {}
+
+            ~AsyncSink()
+            {
+                stop();
+            }
+
+            AsyncSink(const AsyncSink&) = delete;
+            AsyncSink& operator = (const AsyncSink&) = delete;
+
+            /**
+             * Producer side: enqueue the record into the calling thread ring
+             *
+             * @param record    The record
+             * @param mandatory Wait for a free slot, instead of dropping the record
+             */
+            void push(Record&& record, bool mandatory) noexcept
+            {
+                auto& ring = local().m_records;
+                if (!ring.try_push(std::move(record)))
+                {
+                    if (!mandatory)
+                    {
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    while (!ring.try_push(std::move(record)))
+                    {
+                        wakeUp();
+                        std::this_thread::yield();
+                    }
+                }
+
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (m_parked.load(std::memory_order_relaxed)) wakeUp();
+            }
+
+            /**
+             * Block until all records enqueued so far are written
+             */
+            void flush()
+            {
+                const auto requested = m_flushRequested.fetch_add(1, std::memory_order_acq_rel) + 1;
+                wakeUp();
+
+                for (auto done = m_flushed.load(std::memory_order_acquire); done < requested; done = m_flushed.load(std::memory_order_acquire))
+                {
+                    m_flushed.wait(done, std::memory_order_acquire);
+                }
+            }
+
+            /**
+             * Write out the pending records and stop the drainer: for the owner, which needs
+             * the writer to be done before releasing its resources
+             */
+            void stop()
+            {
+                m_stop.store(true, std::memory_order_release);
+                wakeUp();
+
+                if (m_drainer.joinable()) m_drainer.join();
+            }
+
+        private:
+
+            Ring& local()
+            {
+                thread_local RingHolder holder;
+                if (!holder.m_pRing)
+                {
+                    holder.m_pRing = std::make_shared<Ring>();
+
+                    std::lock_guard<std::mutex> lock {m_lock};
+                    m_rings.push_back(holder.m_pRing);
+                }
+                return *holder.m_pRing;
+            }
+
+            void wakeUp() noexcept
+            {
+                m_signal.fetch_add(1, std::memory_order_release);
+                m_signal.notify_one();
+            }
+
+            void drain()
+            {
+                std::vector<std::shared_ptr<Ring>> rings;
+                std::vector<Record> batch;
+
+                for (;;)
+                {
+                    const auto signal = m_signal.load(std::memory_order_acquire);
+                    const auto flushRequested = m_flushRequested.load(std::memory_order_acquire);
+                    const bool stop = m_stop.load(std::memory_order_acquire);
+
+                    {
+                        std::lock_guard<std::mutex> lock {m_lock};
+                        rings = m_rings;
+                    }
+
+                    for (const auto& ring : rings)
+                    {
+                        ring->m_records.consume_all([&batch](Record&& record) { batch.push_back(std::move(record)); });
+                    }
+
+                    const bool written = !batch.empty();
+                    if (written)
+                    {
+                        m_writer(batch);
+                        batch.clear();
+                    }
+
+                    if (const auto dropped = m_dropped.exchange(0, std::memory_order_relaxed); dropped > 0)
+                    {
+                        std::fprintf(stderr, "<%s>: %zu record(s) dropped\n", m_name.c_str(), dropped);
+                    }
+
+                    release(rings);
+
+                    if (flushRequested > m_flushed.load(std::memory_order_relaxed))
+                    {
+                        m_flushed.store(flushRequested, std::memory_order_release);
+                        m_flushed.notify_all();
+                    }
+
+                    if (stop) break;
+
+                    if (written) continue;
+
+                    // Nothing written: park, and re-check to prevent the lost wake-up
+
+                    m_parked.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if (!pending() && m_flushRequested.load(std::memory_order_acquire) == flushRequested && !m_stop.load(std::memory_order_acquire))
+                    {
+                        m_signal.wait(signal, std::memory_order_acquire);
+                    }
+                    m_parked.store(false, std::memory_order_relaxed);
+                }
+            }
+
+            bool pending()
+            {
+                std::lock_guard<std::mutex> lock {m_lock};
+                return std::any_of(m_rings.begin(), m_rings.end(), [](const auto& ring) { return !ring->m_records.empty(); });
+            }
+
+            // Release the rings of the exited threads, once drained
+            void release(std::vector<std::shared_ptr<Ring>>& rings)
+            {
+                rings.clear();
+
+                std::lock_guard<std::mutex> lock {m_lock};
+                m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [](const auto& ring)
+                {
+                    return ring->m_closed.load(std::memory_order_acquire) && ring->m_records.empty();
+                }), m_rings.end());
+            }
+
+        private:
+
+            const std::string m_name;
+            const writer_f m_writer;
+
+            std::mutex m_lock; // guards only the rings registry
+            std::vector<std::shared_ptr<Ring>> m_rings;
+
+            std::atomic<std::size_t> m_dropped {0};
+
+            std::atomic<bool> m_stop {false};
+            std::atomic<bool> m_parked {false};
+            std::atomic<std::uint32_t> m_signal {0};
+
+            std::atomic<std::uint64_t> m_flushRequested {0};
+            std::atomic<std::uint64_t> m_flushed {0};
+
+            std::thread m_drainer; // the last one: starts once everything else is initialized
+    };
+
+}//namespace utils::log::details
+
+#endif /* LOGGING_ASYNCSINK_H_ */
@@ -9,7 +9,7 @@
 #include <iostream>
 
 //Class-level lock
-#include "ClassMutex.h"
+#include "ClassLevelMutex.h"
 
 // Logging
 #include "Logger.h"
@@ -38,9 +38,14 @@ namespace utils::log
             {
                 using namespace std;
 
-                typename utils::locking::ClassLevelLock<CoutLogger>::Lock lock{};//class level lock
+                // Filter out, before formatting
+                if (log_verbosity_t::LOG_LEVEL_ERROR != verbosity && verbosity < LOG_LEVEL) return;
 
-                auto s = utils::string_format("<%s>: %s\n", tag().c_str(), std::forward<T>(msg).c_str());
+                // Format outside of the critical section: into the thread-local buffer, without allocation
+                const std::string& text = msg;
+                const auto s = utils::string_view_format("<%s>: %s\n", tag().c_str(), text.c_str());
+
+                std::lock_guard<utils::lock::CLMutex<CoutLogger>> lock {utils::lock::CLMutex<CoutLogger>::instance()};//class level lock
 
                 switch(verbosity)
                 {
@@ -48,10 +53,7 @@ namespace utils::log
                         cerr << s;
                     break;
                     default:
-                        if (verbosity >= LOG_LEVEL)
-                        {
-                            cout << s;
-                        }
+                        cout << s;
                     break;
                 }
             }
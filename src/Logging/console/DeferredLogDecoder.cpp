@@ -0,0 +1,138 @@
+//
+// DeferredLogDecoder.cpp
+//
+//  Created on: Oct 14, 2026
+//
+//  Offline decoder of the binary log, written by the DeferredLogger binary sink.
+//  Usage: DeferredLogDecoder <binary log> [min verbosity: 0-4]
+//
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DeferredLogger.h"
+
+using namespace utils::log;
+using namespace utils::log::deferred;
+
+namespace
+{
+    template <typename T>
+    bool read(std::istream& in, T& value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    bool read(std::istream& in, std::string& value, std::size_t length)
+    {
+        value.resize(length);
+        return static_cast<bool>(in.read(value.data(), static_cast<std::streamsize>(length)));
+    }
+
+    struct Format
+    {
+        std::string m_signature;
+        std::string m_format;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <binary log> [min verbosity: 0-4]\n";
+        return 1;
+    }
+
+    std::ifstream in {argv[1], std::ios::binary};
+    if (!in)
+    {
+        std::cerr << "Failed to open: " << argv[1] << '\n';
+        return 1;
+    }
+
+    std::string magic;
+    if (!read(in, magic, 6) || magic != "DLOG1\n")
+    {
+        std::cerr << "Not a deferred binary log: " << argv[1] << '\n';
+        return 1;
+    }
+
+    const int minLevel = (argc > 2) ? std::atoi(argv[2]) : 0;
+
+    std::unordered_map<std::uint32_t, Format> formats;
+    std::unordered_map<std::uint16_t, std::string> tags;
+    std::vector<std::byte> args;
+
+    char type = 0;
+    while (read(in, type))
+    {
+        switch (type)
+        {
+            case 'F':
+            {
+                std::uint32_t id = 0;
+                std::uint8_t sigLength = 0;
+                std::uint16_t fmtLength = 0;
+
+                Format format;
+                if (!read(in, id) || !read(in, sigLength) || !read(in, format.m_signature, sigLength)
+                        || !read(in, fmtLength) || !read(in, format.m_format, fmtLength)) break;
+
+                formats[id] = std::move(format);
+                continue;
+            }
+            case 'T':
+            {
+                std::uint16_t id = 0;
+                std::uint16_t length = 0;
+                std::string tag;
+                if (!read(in, id) || !read(in, length) || !read(in, tag, length)) break;
+
+                tags[id] = std::move(tag);
+                continue;
+            }
+            case 'E':
+            {
+                std::uint64_t timestamp = 0;
+                std::uint32_t id = 0;
+                std::uint16_t tag = 0;
+                std::uint8_t verbosity = 0;
+                std::uint16_t size = 0;
+
+                if (!read(in, timestamp) || !read(in, id) || !read(in, tag) || !read(in, verbosity) || !read(in, size)) break;
+
+                args.resize(size);
+                if (!in.read(reinterpret_cast<char*>(args.data()), size)) break;
+
+                if (verbosity < minLevel) continue;
+
+                const auto format = formats.find(id);
+                if (format == formats.end())
+                {
+                    std::cerr << "<Error> Unknown format id: " << id << '\n';
+                    continue;
+                }
+
+                auto& out = (utils::toUType(log_verbosity_t::LOG_LEVEL_ERROR) == verbosity) ? std::cerr : std::cout;
+                out << '<' << tags[tag] << ">: "
+                    << formatBySignature(format->second.m_format, format->second.m_signature, args.data(), args.size())
+                    << '\n';
+                continue;
+            }
+            default:
+                std::cerr << "<Error> Corrupted log: unknown record type\n";
+                return 1;
+        }
+
+        std::cerr << "<Error> Truncated log\n";
+        return 1;
+    }
+
+    return 0;
+}
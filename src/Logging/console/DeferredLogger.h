@@ -0,0 +1,649 @@
+//
+// DeferredLogger.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef LOGGING_DEFERREDLOGGER_H_
+#define LOGGING_DEFERREDLOGGER_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Logging sink
+#include "AsyncSink.h"
+
+// Logging
+#include "Logger.h"
+#include "LoggingHelper.h"
+#include "CoutLogger.h"
+
+
+namespace utils::log::deferred
+{
+    /**
+     * Compile-time string: the format string as non-type template parameter
+     */
+    template <std::size_t N>
+    struct FixedString
+    {
+        constexpr FixedString(const char (&str)[N]) noexcept
+        {
+            std::copy_n(str, N, m_data);
+        }
+
+        char m_data[N] {};
+    };
+
+    /*
+     * Wire (normalized) types of the arguments, as they are passed to the printf-like formatting:
+     * the signature character identifies the wire type in the binary log, for the offline decoding
+     */
+    template <typename T, typename = void>
+    struct wire;
+
+    template <typename T>
+    struct wire<T, std::enable_if_t<std::is_enum_v<T>>> : wire<std::underlying_type_t<T>> {};
+
+    template <typename T>
+    struct wire<T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T> && (sizeof(T) <= 4)>>
+    { using type = int; static constexpr char signature = 'i'; };
+
+    template <typename T>
+    struct wire<T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T> && (sizeof(T) == 8)>>
+    { using type = long long; static constexpr char signature = 'l'; };
+
+    template <typename T>
+    struct wire<T, std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T> && (sizeof(T) <= 4)>>
+    { using type = unsigned; static constexpr char signature = 'u'; };
+
+    template <typename T>
+    struct wire<T, std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T> && (sizeof(T) == 8)>>
+    { using type = unsigned long long; static constexpr char signature = 'm'; };
+
+    template <typename T>
+    struct wire<T, std::enable_if_t<std::is_same_v<T, float> || std::is_same_v<T, double>>>
+    { using type = double; static constexpr char signature = 'd'; };
+
+    template <typename T>
+    struct wire<T, std::enable_if_t<is_string<T> && !std::is_arithmetic_v<T>>>
+    { using type = std::string; static constexpr char signature = 's'; };
+
+    template <typename T>
+    struct wire<T*, std::enable_if_t<!is_string<T*>>>
+    { using type = const void*; static constexpr char signature = 'p'; };
+
+    template <typename T>
+    using wire_t = typename wire<std::decay_t<T>>::type;
+
+    inline constexpr std::size_t max_args_size = 96; // bytes: the longer arguments are moved to the heap
+    inline constexpr std::size_t max_record_size = UINT16_MAX; // bytes: the longer strings are truncated, and marked
+
+    /**
+     * The single deferred record: the arguments are kept in their binary form.
+     * The arguments that don't fit into the entry itself are kept in the owned heap buffer
+     */
+    struct Entry
+    {
+        std::uint64_t m_timestamp;      // nanoseconds, steady clock
+        std::uint32_t m_id;             // format id
+        std::uint16_t m_tag;            // tag id
+        std::uint16_t m_size;           // size of the arguments, in bytes
+        log_verbosity_t m_verbosity;
+        std::array<std::byte, max_args_size> m_args;
+        std::unique_ptr<std::byte[]> m_pOverflow;
+
+        std::byte* args() noexcept { return m_pOverflow ? m_pOverflow.get() : m_args.data(); }
+        const std::byte* args() const noexcept { return m_pOverflow ? m_pOverflow.get() : m_args.data(); }
+    };
+
+    using decoder_f = std::string (*)(const char* format, const std::byte* args, std::size_t size);
+
+    /**
+     * Per call site static information: registered once, on the first call
+     */
+    struct FormatInfo
+    {
+        const char* m_format;
+        std::string m_signature;
+        decoder_f m_decoder;
+    };
+
+    namespace details
+    {
+        // The minimal footprint of the argument: the string takes at least its length prefix
+        template <typename W>
+        inline constexpr std::size_t wire_size_v = std::is_same_v<W, std::string> ? sizeof(std::uint16_t) : sizeof(W);
+
+        // The exact footprint of the argument
+        template <typename T>
+        std::size_t wire_size(const T& value) noexcept
+        {
+            if constexpr (std::is_same_v<wire_t<T>, std::string>) return sizeof(std::uint16_t) + std::string_view{value}.size();
+            else return sizeof(wire_t<T>);
+        }
+
+        inline constexpr std::string_view truncated_marker = "[...]";
+
+        class Writer
+        {
+            public:
+
+                /**
+                 * C-tor: the arguments, which don't fit into the entry, go to the heap buffer
+                 *
+                 * @param entry     The record to be written
+                 * @param size      The exact footprint of all arguments
+                 * @param reserved  The minimal footprint of all arguments: the room kept for
+                 *                  the ones not written yet, so that a long string can't push them out
+                 */
+                Writer(Entry& entry, std::size_t size, std::size_t reserved) noexcept
+                    : m_entry(entry), m_capacity(max_args_size), m_reserved(reserved)
+                {
+                    if (size <= max_args_size) return;
+
+                    const auto capacity = std::min(size, max_record_size);
+                    m_entry.m_pOverflow.reset(new (std::nothrow) std::byte[capacity]);
+                    if (m_entry.m_pOverflow) m_capacity = capacity;
+                }
+
+                template <typename T>
+                void write(const T& value) noexcept
+                {
+                    using w_t = wire_t<T>;
+                    m_reserved -= std::min(m_reserved, wire_size_v<w_t>);
+                    if constexpr (std::is_same_v<w_t, std::string>)
+                    {
+                        const std::string_view s {value};
+                        const auto free = m_capacity - m_entry.m_size;
+                        const auto taken = sizeof(std::uint16_t) + m_reserved;
+                        const auto length = static_cast<std::uint16_t>(std::min<std::size_t>(s.size(), free > taken ? free - taken : 0));
+                        raw(&length, sizeof(length));
+                        if (length == s.size() || length < truncated_marker.size())
+                        {
+                            raw(s.data(), length);
+                        }
+                        else // Still too long (or out of memory): make the truncation visible
+                        {
+                            raw(s.data(), length - truncated_marker.size());
+                            raw(truncated_marker.data(), truncated_marker.size());
+                        }
+                    }
+                    else
+                    {
+                        const w_t w = (w_t)(value);
+                        raw(&w, sizeof(w));
+                    }
+                }
+
+            private:
+
+                void raw(const void* data, std::size_t size) noexcept
+                {
+                    size = std::min(size, m_capacity - m_entry.m_size);
+                    std::memcpy(m_entry.args() + m_entry.m_size, data, size);
+                    m_entry.m_size = static_cast<std::uint16_t>(m_entry.m_size + size);
+                }
+
+            private:
+
+                Entry& m_entry;
+                std::size_t m_capacity;
+                std::size_t m_reserved;
+        };
+
+        class Reader
+        {
+            public:
+
+                Reader(const std::byte* data, std::size_t size) noexcept : m_data(data), m_size(size)
+                {}
+
+                template <typename W>
+                W read() noexcept
+                {
+                    if constexpr (std::is_same_v<W, std::string>)
+                    {
+                        std::uint16_t length = 0;
+                        raw(&length, sizeof(length));
+                        std::string s(std::min<std::size_t>(length, m_size - m_pos), '\0');
+                        raw(s.data(), s.size());
+                        return s;
+                    }
+                    else
+                    {
+                        W w {};
+                        raw(&w, sizeof(w));
+                        return w;
+                    }
+                }
+
+            private:
+
+                void raw(void* data, std::size_t size) noexcept
+                {
+                    size = std::min(size, m_size - m_pos);
+                    std::memcpy(data, m_data + m_pos, size);
+                    m_pos += size;
+                }
+
+            private:
+
+                const std::byte* m_data;
+                std::size_t m_size;
+                std::size_t m_pos = 0;
+        };
+
+        template <typename W>
+        decltype(auto) pass(const W& value) noexcept
+        {
+            if constexpr (std::is_same_v<W, std::string>) return value.c_str();
+            else return value;
+        }
+
+        /**
+         * Type-safe decoder, generated per call site
+         */
+        template <typename...Args>
+        std::string decode(const char* format, const std::byte* args, std::size_t size)
+        {
+            Reader reader {args, size};
+            std::tuple<wire_t<Args>...> values {reader.template read<wire_t<Args>>()...}; // braced: evaluated in order
+
+            return std::apply([format](const auto&...values)
+            {
+                return utils::string_format(format, pass(values)...);
+            }, values);
+        }
+    }
+
+    /**
+     * Registry of the format strings and the logging tags: append-only
+     */
+    class Registry final
+    {
+        public:
+
+            static Registry& instance()
+            {
+                static Registry registry;//Scott Meyers singleton pattern
+                return registry;
+            }
+
+            std::uint32_t addFormat(FormatInfo info)
+            {
+                std::lock_guard<std::mutex> lock {m_lock};
+                m_formats.push_back(std::move(info));
+                return static_cast<std::uint32_t>(m_formats.size() - 1);
+            }
+
+            std::uint16_t addTag(const std::string& tag)
+            {
+                std::lock_guard<std::mutex> lock {m_lock};
+                const auto it = std::find(m_tags.begin(), m_tags.end(), tag);
+                if (it != m_tags.end()) return static_cast<std::uint16_t>(it - m_tags.begin());
+
+                m_tags.push_back(tag);
+                return static_cast<std::uint16_t>(m_tags.size() - 1);
+            }
+
+            // Stable references: std::deque doesn't move the elements on push_back
+            const FormatInfo& format(std::uint32_t id)
+            {
+                std::lock_guard<std::mutex> lock {m_lock};
+                return m_formats.at(id);
+            }
+
+            const std::string& tag(std::uint16_t id)
+            {
+                std::lock_guard<std::mutex> lock {m_lock};
+                return m_tags.at(id);
+            }
+
+        private:
+
+            Registry() = default;
+
+        private:
+
+            std::mutex m_lock;
+            std::deque<FormatInfo> m_formats;
+            std::deque<std::string> m_tags;
+    };
+
+    /**
+     * Deferred logging backend.
+     *
+     * The logging threads write the binary entries into their own lock-free SPSC rings.
+     * The background drainer either decodes them into the text - the same as CoutLogger output,
+     * or writes them as they are to the binary log file, for the offline decoding.
+     * @see DeferredLogDecoder.cpp
+     *
+     * Binary log format (native byte order):
+     *  "DLOG1\n"
+     *  'F' id:u32 signature-length:u8 signature format-length:u16 format  - the format definition, before first use
+     *  'T' id:u16 length:u16 tag                                           - the tag definition, before first use
+     *  'E' timestamp:u64 id:u32 tag:u16 verbosity:u8 size:u16 args          - the entry
+     */
+    class Backend final
+    {
+        public:
+
+            static Backend& instance()
+            {
+                static Backend backend;//Scott Meyers singleton pattern
+                return backend;
+            }
+
+            ~Backend()
+            {
+                m_sink.stop(); // the writer is done with the file
+                if (m_pFile) std::fclose(m_pFile);
+            }
+
+            Backend(const Backend&) = delete;
+            Backend& operator = (const Backend&) = delete;
+
+            /**
+             * Switch to the binary sink: the entries are written without formatting
+             *
+             * @param path  The binary log file path
+             * @return      Indication of the operation outcome: true on success
+             */
+            bool setBinarySink(const std::string& path)
+            {
+                std::FILE* pFile = std::fopen(path.c_str(), "wb");
+                if (!pFile) return false;
+
+                std::fputs("DLOG1\n", pFile);
+
+                std::lock_guard<std::mutex> lock {m_sinkLock};
+                if (m_pFile) std::fclose(m_pFile);
+                m_pFile = pFile;
+                m_definedFormats.clear();
+                m_definedTags.clear();
+
+                return true;
+            }
+
+            /**
+             * Producer side: hand over the entry, without blocking.
+             * If the ring is full, the entry is dropped (and reported) - except for the errors
+             */
+            void push(Entry&& entry) noexcept
+            {
+                const bool mandatory = log_verbosity_t::LOG_LEVEL_ERROR == entry.m_verbosity;
+                m_sink.push(std::move(entry), mandatory);
+            }
+
+            /**
+             * Block until all entries pushed so far are written
+             */
+            void flush()
+            {
+                m_sink.flush();
+            }
+
+        private:
+
+            Backend() = default;
+
+            // The drainer thread only
+            void write(std::vector<Entry>& batch)
+            {
+                std::stable_sort(batch.begin(), batch.end()
+                        , [](const auto& lhs, const auto& rhs) { return lhs.m_timestamp < rhs.m_timestamp; });
+
+                auto& registry = Registry::instance();
+
+                std::lock_guard<std::mutex> lock {m_sinkLock};
+
+                if (m_pFile)
+                {
+                    for (const auto& entry : batch) writeBinary(registry, entry);
+                    std::fflush(m_pFile);
+                    return;
+                }
+
+                // Text: the same as CoutLogger
+                std::string out;
+                std::string err;
+                for (const auto& entry : batch)
+                {
+                    const auto& info = registry.format(entry.m_id);
+
+                    auto& stream = (log_verbosity_t::LOG_LEVEL_ERROR == entry.m_verbosity) ? err : out;
+                    stream.append("<").append(registry.tag(entry.m_tag)).append(">: ");
+                    try
+                    {
+                        stream.append(info.m_decoder(info.m_format, entry.args(), entry.m_size));
+                    }
+                    catch (const std::exception& e)
+                    {
+                        stream.append("<Error> ").append(e.what());
+                    }
+                    stream.append("\n");
+                }
+
+                if (!out.empty()) { std::fwrite(out.data(), 1, out.size(), stdout); std::fflush(stdout); }
+                if (!err.empty()) { std::fwrite(err.data(), 1, err.size(), stderr); }
+            }
+
+            void writeBinary(Registry& registry, const Entry& entry)
+            {
+                if (entry.m_id >= m_definedFormats.size()) m_definedFormats.resize(entry.m_id + 1, false);
+                if (!m_definedFormats[entry.m_id])
+                {
+                    const auto& info = registry.format(entry.m_id);
+                    const auto sigLength = static_cast<std::uint8_t>(info.m_signature.size());
+                    const auto fmtLength = static_cast<std::uint16_t>(std::strlen(info.m_format));
+
+                    raw("F", 1);
+                    raw(&entry.m_id, sizeof(entry.m_id));
+                    raw(&sigLength, sizeof(sigLength));
+                    raw(info.m_signature.data(), sigLength);
+                    raw(&fmtLength, sizeof(fmtLength));
+                    raw(info.m_format, fmtLength);
+
+                    m_definedFormats[entry.m_id] = true;
+                }
+
+                if (entry.m_tag >= m_definedTags.size()) m_definedTags.resize(entry.m_tag + 1, false);
+                if (!m_definedTags[entry.m_tag])
+                {
+                    const auto& tag = registry.tag(entry.m_tag);
+                    const auto length = static_cast<std::uint16_t>(tag.size());
+
+                    raw("T", 1);
+                    raw(&entry.m_tag, sizeof(entry.m_tag));
+                    raw(&length, sizeof(length));
+                    raw(tag.data(), length);
+
+                    m_definedTags[entry.m_tag] = true;
+                }
+
+                const auto verbosity = utils::toUType(entry.m_verbosity);
+
+                raw("E", 1);
+                raw(&entry.m_timestamp, sizeof(entry.m_timestamp));
+                raw(&entry.m_id, sizeof(entry.m_id));
+                raw(&entry.m_tag, sizeof(entry.m_tag));
+                raw(&verbosity, sizeof(verbosity));
+                raw(&entry.m_size, sizeof(entry.m_size));
+                raw(entry.args(), entry.m_size);
+            }
+
+            void raw(const void* data, std::size_t size)
+            {
+                (void)std::fwrite(data, 1, size, m_pFile);
+            }
+
+        private:
+
+            std::mutex m_sinkLock;
+            std::FILE* m_pFile = nullptr;
+            std::vector<bool> m_definedFormats;
+            std::vector<bool> m_definedTags;
+
+            utils::log::details::AsyncSink<Entry> m_sink {"DeferredLogger", [this](std::vector<Entry>& batch) { write(batch); }}; // the last one
+    };
+
+    /**
+     * Offline formatting, driven by the signature of the wire types:
+     * for the decoder tool, which has no access to the type-safe decoders
+     *
+     * @param format    The printf-like format
+     * @param signature The wire types of the arguments
+     * @param args      The arguments, in binary form
+     * @param size      The size of the arguments
+     * @return          The formatted text
+     */
+    inline std::string formatBySignature(std::string_view format, std::string_view signature, const std::byte* args, std::size_t size)
+    {
+        details::Reader reader {args, size};
+
+        std::string text;
+        std::size_t next = 0;
+
+        for (std::size_t i = 0; i < format.size(); ++i)
+        {
+            if (format[i] != '%')
+            {
+                text += format[i];
+                continue;
+            }
+
+            if (i + 1 < format.size() && format[i + 1] == '%')
+            {
+                text += '%';
+                ++i;
+                continue;
+            }
+
+            const auto end = format.find_first_of("diouxXeEfFgGaAcsp", i + 1);
+            if (end == std::string_view::npos || next >= signature.size())
+            {
+                text += format.substr(i);
+                break;
+            }
+
+            const std::string spec {format.substr(i, end - i + 1)};
+            i = end;
+
+            char buffer[512];
+            int n = 0;
+            switch (signature[next++])
+            {
+                case 'i': n = std::snprintf(buffer, sizeof(buffer), spec.c_str(), reader.read<int>()); break;
+                case 'l': n = std::snprintf(buffer, sizeof(buffer), spec.c_str(), reader.read<long long>()); break;
+                case 'u': n = std::snprintf(buffer, sizeof(buffer), spec.c_str(), reader.read<unsigned>()); break;
+                case 'm': n = std::snprintf(buffer, sizeof(buffer), spec.c_str(), reader.read<unsigned long long>()); break;
+                case 'd': n = std::snprintf(buffer, sizeof(buffer), spec.c_str(), reader.read<double>()); break;
+                case 'p': n = std::snprintf(buffer, sizeof(buffer), spec.c_str(), reader.read<const void*>()); break;
+                case 's': n = std::snprintf(buffer, sizeof(buffer), spec.c_str(), reader.read<std::string>().c_str()); break;
+                default: break;
+            }
+            if (n > 0) text.append(buffer, std::min<std::size_t>(static_cast<std::size_t>(n), sizeof(buffer) - 1));
+        }
+
+        return text;
+    }
+
+    /**
+     * @brief Deferred logger: on the hot path, only the format id and the raw argument bytes
+     * are captured. The formatting happens on the background thread (or offline).
+     *
+     * @code
+     * DeferredLogger logger {"app"};
+     * logger.logDeferred<log_verbosity_t::LOG_LEVEL_INFO, "value: %d, name: %s">(value, name);
+     * @endcode
+     *
+     * The arguments are limited to arithmetic types, enums, pointers and strings:
+     * the strings are copied: into the entry, or into its heap buffer when they don't fit
+     * (the ones longer than 64K are truncated, with the "[...]" marker).
+     * The verbosity below LOGGING_MIN_LEVEL is compiled out, and the runtime level is checked
+     * before anything is captured.
+     */
+    class DeferredLogger final : public LoggerBase<DeferredLogger>
+    {
+        public:
+
+            using super = LoggerBase<DeferredLogger>;
+
+            explicit DeferredLogger(std::string tag) noexcept : super(std::move(tag))
+            {}
+
+            template <log_verbosity_t Verbosity, FixedString Format, typename...Args>
+            void logDeferred(Args&&...args) const noexcept
+            {
+                if constexpr (Verbosity >= log_min_level)
+                {
+                    if (!isEnabled(Verbosity)) return;
+                    if (log_verbosity_t::LOG_LEVEL_ERROR != Verbosity && Verbosity < LOG_LEVEL) return; // CoutLogger filter
+
+                    static const std::uint32_t id = Registry::instance().addFormat(FormatInfo{
+                            Format.m_data
+                            , std::string{wire<std::decay_t<Args>>::signature...}
+                            , &details::decode<Args...>});
+
+                    Entry entry;
+                    entry.m_timestamp = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+                    entry.m_id = id;
+                    entry.m_tag = m_tagId;
+                    entry.m_size = 0;
+                    entry.m_verbosity = Verbosity;
+
+                    details::Writer writer {entry
+                        , (std::size_t{0} + ... + details::wire_size(args))
+                        , (std::size_t{0} + ... + details::wire_size_v<wire_t<Args>>)};
+                    (writer.write(args), ...);
+
+                    Backend::instance().push(std::move(entry));
+                }
+            }
+
+            // LoggerBase interface: the message is already formatted
+            template <typename T>
+            void logImplWithTag(log_verbosity_t verbosity, string_t<T>&& msg) const
+            {
+                const std::string& text = msg;
+                switch (verbosity)
+                {
+                    case log_verbosity_t::LOG_LEVEL_TRACE:   logDeferred<log_verbosity_t::LOG_LEVEL_TRACE, "%s">(text); break;
+                    case log_verbosity_t::LOG_LEVEL_DEBUG:   logDeferred<log_verbosity_t::LOG_LEVEL_DEBUG, "%s">(text); break;
+                    case log_verbosity_t::LOG_LEVEL_INFO:    logDeferred<log_verbosity_t::LOG_LEVEL_INFO, "%s">(text); break;
+                    case log_verbosity_t::LOG_LEVEL_WARNING: logDeferred<log_verbosity_t::LOG_LEVEL_WARNING, "%s">(text); break;
+                    case log_verbosity_t::LOG_LEVEL_ERROR:   logDeferred<log_verbosity_t::LOG_LEVEL_ERROR, "%s">(text); break;
+                }
+            }
+
+            /**
+             * Block until all messages logged so far (from any thread) are written
+             */
+            static void flush()
+            {
+                Backend::instance().flush();
+            }
+
+        private:
+
+            const std::uint16_t m_tagId = Registry::instance().addTag(tag());
+    };// DeferredLogger
+
+}//namespace utils::log::deferred
+
+#endif /* LOGGING_DEFERREDLOGGER_H_ */
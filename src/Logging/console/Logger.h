@@ -9,8 +9,9 @@
 #include <string>
 #include <memory>
 #include <stdexcept>
+#include <atomic>
 
-#include "commons.h"
+#include "Commons.h"
 
 
 namespace utils::log
@@ -25,6 +26,16 @@ namespace utils::log
             ,LOG_LEVEL_ERROR
     };
 
+/*
+ * The minimum compiled-in verbosity level, as the underlying value of log_verbosity_t.
+ * i.e, for release builds: -DLOGGING_MIN_LEVEL=2 (LOG_LEVEL_INFO)
+ */
+#ifndef LOGGING_MIN_LEVEL
+#define LOGGING_MIN_LEVEL 0
+#endif
+
+    inline constexpr log_verbosity_t log_min_level = static_cast<log_verbosity_t>(LOGGING_MIN_LEVEL);
+
     class Logger
     {
         public:
@@ -60,9 +71,31 @@ namespace utils::log
                 return m_tag;
             }
 
+            /**
+             * @brief Runtime filter: cheap enough to be checked before any formatting
+             *
+             * @param verbosity The verbosity level
+             * @return Indication whether the message of the given verbosity will be logged
+             */
+            bool isEnabled(log_verbosity_t verbosity) const noexcept
+            {
+                return verbosity >= m_level.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Set the runtime minimum verbosity level
+             *
+             * @param verbosity The verbosity level
+             */
+            void setLevel(log_verbosity_t verbosity) noexcept
+            {
+                m_level.store(verbosity, std::memory_order_relaxed);
+            }
+
         private:
 
             const std::string m_tag;
+            std::atomic<log_verbosity_t> m_level {log_verbosity_t::LOG_LEVEL_TRACE};
     };
 
 
@@ -111,12 +144,14 @@ namespace utils::log
             // Logger interface implementation: lvalue reference
             void log(log_verbosity_t verbosity, const std::string& msg) override
             {
+                if (!isEnabled(verbosity)) return;
                 impl().logImplWithTag(verbosity, msg);//Derived class specific implementation
             }
 
             // Logger interface implementation: rvalue reference
             void log(log_verbosity_t verbosity, std::string&& msg) override
             {
+                if (!isEnabled(verbosity)) return;
                 impl().logImplWithTag(verbosity, std::move(msg));//Derived class specific implementation
             }
 
@@ -133,6 +168,8 @@ namespace utils::log
                     , const std::string& format
                     , Args&&...args) const
             {
+                if (!isEnabled(verbosity)) return; // before formatting
+
                 try
                 {
                     //In case of the wrong formatting, the string_format can throw an exception
@@ -9,9 +9,11 @@
 #include <utility>
 #include <memory>
 #include <sstream>
+#include <type_traits>
 
 #include "Logger.h"
 #include "LoggingHelper.h"
+#include "RateLimiter.h"
 
 
 
@@ -22,9 +24,15 @@ namespace utils::log
      * @brief Wrapper around the logger implementation
      * Provides the helper methods for different verbosity levels
      *
+     * The levels below MinLevel are compiled out: the corresponding logXxx calls are no-ops,
+     * and with the helper macros - their arguments are not even evaluated.
+     * The levels above are additionally filtered at runtime, before any formatting takes place.
+     * @see LoggerWithTag::setLevel
+     *
      * @tparam LoggerImpl The concrete logger implementation type
+     * @tparam MinLevel The minimum compiled-in verbosity level: LOGGING_MIN_LEVEL, by default
      */
-    template <class LoggerImpl>
+    template <class LoggerImpl, log_verbosity_t MinLevel = log_min_level>
     class LoggerWrapper final
     {
             static_assert(std::is_base_of_v<LoggerBase<LoggerImpl>, LoggerImpl>, "Invalid logger type!");
@@ -43,6 +51,7 @@ namespace utils::log
             template <typename...Args>
             explicit LoggerWrapper(std::string tag, Args&&...args) noexcept:
                 m_pLogger(LoggerBase<logger_t>::createLogger(tag, std::forward<Args>(args)...))
+                , m_pLimiter(RateLimiter::forTag(tag))
             {}
 
 
@@ -58,38 +67,81 @@ namespace utils::log
             LoggerWrapper(const LoggerWrapper&) = delete;
             LoggerWrapper& operator = (const LoggerWrapper&) = delete;
 
+            /**
+             * @brief The compile-time filter
+             *
+             * @param verbosity The verbosity level
+             * @return Indication whether the given verbosity level is compiled-in
+             */
+            static constexpr bool enabled(log_verbosity_t verbosity) noexcept
+            {
+                return verbosity >= MinLevel;
+            }
+
+            /**
+             * @brief The compile-time and runtime filters, combined
+             *
+             * @param verbosity The verbosity level
+             * @return Indication whether the message of the given verbosity level will be logged
+             */
+            bool isEnabled(log_verbosity_t verbosity) const noexcept
+            {
+                return enabled(verbosity) && m_pLogger && m_pLogger->isEnabled(verbosity);
+            }
+
+            /**
+             * @brief Set the runtime minimum verbosity level
+             *
+             * @param verbosity The verbosity level
+             */
+            void setLevel(log_verbosity_t verbosity) noexcept
+            {
+                if (m_pLogger) m_pLogger->setLevel(verbosity);
+            }
+
+            /**
+             * @brief The flood protection: rate limiting and sampling per verbosity level,
+             * shared by all loggers with the same tag.
+             * The admission is checked after the verbosity filter, before any formatting.
+             *
+             * @return The tag rate limiter, for the configuration
+             */
+            RateLimiter& rateLimiter() const noexcept
+            {
+                return *m_pLimiter;
+            }
+
 
             // Trace level
 
             template <typename T>
             void logTrace(string_t<T>&& msg) const
             {
-                log(log_verbosity_t::LOG_LEVEL_TRACE, std::forward<T>(msg));
+                log<log_verbosity_t::LOG_LEVEL_TRACE>(std::forward<T>(msg));
             }
 
             template <typename T>
             void logTraceWithFunc(const char* func, string_t<T>&& msg) const
             {
-                logWithFunc(log_verbosity_t::LOG_LEVEL_TRACE, func, std::forward<T>(msg));
+                logWithFunc<log_verbosity_t::LOG_LEVEL_TRACE>(func, std::forward<T>(msg));
             }
 
             template <typename...Args>
             void logTraceArgsWithFunc(const char* func, Args&&...args) const
             {
-                logArgsWithFunc(log_verbosity_t::LOG_LEVEL_TRACE, func, std::forward<Args>(args)...);
+                logArgsWithFunc<log_verbosity_t::LOG_LEVEL_TRACE>(func, std::forward<Args>(args)...);
             }
 
             template <typename...Args>
             void logTraceFormatted(const std::string& format, Args&&...args) const
             {
-                logFormatted(log_verbosity_t::LOG_LEVEL_TRACE, format, std::forward<Args>(args)...);
+                logFormatted<log_verbosity_t::LOG_LEVEL_TRACE>(format, std::forward<Args>(args)...);
             }
 
             template <typename...Args>
             void logTraceFormattedWithFunc(const char* func, const std::string& format, Args&&...args) const
             {
-                logFormattedWithFunc(log_verbosity_t::LOG_LEVEL_TRACE
-                        , func
+                logFormattedWithFunc<log_verbosity_t::LOG_LEVEL_TRACE>(func
                         , format
                         , std::forward<Args>(args)...);
             }
@@ -100,33 +152,32 @@ namespace utils::log
             template <typename T>
             void logDebug(string_t<T>&& msg) const
             {
-                log(log_verbosity_t::LOG_LEVEL_DEBUG, std::forward<T>(msg));
+                log<log_verbosity_t::LOG_LEVEL_DEBUG>(std::forward<T>(msg));
             }
 
             template <typename T>
             void logDebugWithFunc(const char* func, string_t<T>&& msg) const
             {
-                logWithFunc(log_verbosity_t::LOG_LEVEL_DEBUG, func, std::forward<T>(msg));
+                logWithFunc<log_verbosity_t::LOG_LEVEL_DEBUG>(func, std::forward<T>(msg));
             }
 
             template <typename...Args>
             void logDebugArgsWithFunc(const char* func, Args&&...args) const
             {
-                logArgsWithFunc(log_verbosity_t::LOG_LEVEL_DEBUG, func, std::forward<Args>(args)...);
+                logArgsWithFunc<log_verbosity_t::LOG_LEVEL_DEBUG>(func, std::forward<Args>(args)...);
             }
 
             template <typename...Args>
             void logDebugFormatted(const std::string& format, Args&&...args) const
             {
-                logFormatted(log_verbosity_t::LOG_LEVEL_DEBUG, format, std::forward<Args>(args)...);
+                logFormatted<log_verbosity_t::LOG_LEVEL_DEBUG>(format, std::forward<Args>(args)...);
             }
 
             template <typename...Args>
             void logDebugFormattedWithFunc(const char* func
                     , const std::string& format, Args&&...args) const
             {
-                logFormattedWithFunc(log_verbosity_t::LOG_LEVEL_DEBUG
-                        , func
+                logFormattedWithFunc<log_verbosity_t::LOG_LEVEL_DEBUG>(func
                         , format
                         , std::forward<Args>(args)...);
             }
@@ -138,32 +189,31 @@ namespace utils::log
             template <typename T>
             void logInfo(string_t<T>&& msg) const
             {
-                log(log_verbosity_t::LOG_LEVEL_INFO, std::forward<T>(msg));
+                log<log_verbosity_t::LOG_LEVEL_INFO>(std::forward<T>(msg));
             }
 
             template <typename T>
             void logInfoWithFunc(const char* func, string_t<T>&& msg) const
             {
-                logWithFunc(log_verbosity_t::LOG_LEVEL_INFO, func, std::forward<T>(msg));
+                logWithFunc<log_verbosity_t::LOG_LEVEL_INFO>(func, std::forward<T>(msg));
             }
 
             template <typename...Args>
             void logInfoArgsWithFunc(const char* func, Args&&...args) const
             {
-                logArgsWithFunc(log_verbosity_t::LOG_LEVEL_INFO, func, std::forward<Args>(args)...);
+                logArgsWithFunc<log_verbosity_t::LOG_LEVEL_INFO>(func, std::forward<Args>(args)...);
             }
 
             template <typename...Args>
             void logInfoFormatted(const std::string& format, Args&&...args) const
             {
-                logFormatted(log_verbosity_t::LOG_LEVEL_INFO, format, std::forward<Args>(args)...);
+                logFormatted<log_verbosity_t::LOG_LEVEL_INFO>(format, std::forward<Args>(args)...);
             }
 
             template <typename...Args>
             void logInfoFormattedWithFunc(const char* func, const std::string& format, Args&&...args) const
             {
-                logFormattedWithFunc(log_verbosity_t::LOG_LEVEL_INFO
-                        , func
+                logFormattedWithFunc<log_verbosity_t::LOG_LEVEL_INFO>(func
                         , format
                         , std::forward<Args>(args)...);
             }
@@ -175,34 +225,32 @@ namespace utils::log
             template <typename T>
             void logWarning(string_t<T>&& msg) const
             {
-                log(log_verbosity_t::LOG_LEVEL_WARNING, std::forward<T>(msg));
+                log<log_verbosity_t::LOG_LEVEL_WARNING>(std::forward<T>(msg));
             }
 
             template <typename T>
             void logWarningWithFunc(const char* func, string_t<T>&& msg) const
             {
-                logWithFunc(log_verbosity_t::LOG_LEVEL_WARNING, func, std::forward<T>(msg));
+                logWithFunc<log_verbosity_t::LOG_LEVEL_WARNING>(func, std::forward<T>(msg));
             }
 
             template <typename...Args>
             void logWarningArgsWithFunc(const char* func, Args&&...args) const
             {
-                logArgsWithFunc(log_verbosity_t::LOG_LEVEL_WARNING
-                        , func
+                logArgsWithFunc<log_verbosity_t::LOG_LEVEL_WARNING>(func
                         , std::forward<Args>(args)...);
             }
 
             template <typename...Args>
             void logWarningFormatted(const std::string& format, Args&&...args) const
             {
-                logFormatted(log_verbosity_t::LOG_LEVEL_WARNING, format, std::forward<Args>(args)...);
+                logFormatted<log_verbosity_t::LOG_LEVEL_WARNING>(format, std::forward<Args>(args)...);
             }
 
             template <typename...Args>
             void logWarningFormattedWithFunc(const char* func, const std::string& format, Args&&...args) const
             {
-                logFormattedWithFunc(log_verbosity_t::LOG_LEVEL_WARNING
-                        , func
+                logFormattedWithFunc<log_verbosity_t::LOG_LEVEL_WARNING>(func
                         , format
                         , std::forward<Args>(args)...);
             }
@@ -213,32 +261,31 @@ namespace utils::log
             template <typename T>
             void logError(string_t<T>&& msg) const
             {
-                log(log_verbosity_t::LOG_LEVEL_ERROR, std::forward<T>(msg));
+                log<log_verbosity_t::LOG_LEVEL_ERROR>(std::forward<T>(msg));
             }
 
             template <typename T>
             void logErrorWithFunc(const char* func, string_t<T>&& msg) const
             {
-                logWithFunc(log_verbosity_t::LOG_LEVEL_ERROR, func, std::forward<T>(msg));
+                logWithFunc<log_verbosity_t::LOG_LEVEL_ERROR>(func, std::forward<T>(msg));
             }
 
             template <typename...Args>
             void logErrorArgsWithFunc(const char* func, Args&&...args) const
             {
-                logArgsWithFunc(log_verbosity_t::LOG_LEVEL_ERROR, func, std::forward<Args>(args)...);
+                logArgsWithFunc<log_verbosity_t::LOG_LEVEL_ERROR>(func, std::forward<Args>(args)...);
             }
 
             template <typename...Args>
             void logErrorFormatted(const std::string& format, Args&&...args) const
             {
-                logFormatted(log_verbosity_t::LOG_LEVEL_ERROR, format, std::forward<Args>(args)...);
+                logFormatted<log_verbosity_t::LOG_LEVEL_ERROR>(format, std::forward<Args>(args)...);
             }
 
             template <typename...Args>
             void logErrorFormattedWithFunc(const char* func, const std::string& format, Args&&...args) const
             {
-                logFormattedWithFunc(log_verbosity_t::LOG_LEVEL_ERROR
-                        , func
+                logFormattedWithFunc<log_verbosity_t::LOG_LEVEL_ERROR>(func
                         , format
                         , std::forward<Args>(args)...);
             }
@@ -249,16 +296,19 @@ namespace utils::log
             /**
              * @brief Logging the given message
              *
+             * @tparam Verbosity The message verbosity level
              * @tparam T stringify type
-             * @param verbosity The message verbosity level
              * @param msg The logging message
              */
-            template <typename T>
-            void log(log_verbosity_t verbosity, string_t<T>&& msg) const
+            template <log_verbosity_t Verbosity, typename T>
+            void log(string_t<T>&& msg) const
             {
-                if (m_pLogger)
+                if constexpr (enabled(Verbosity))
                 {
-                    m_pLogger->log(verbosity, std::forward<T>(msg));
+                    if (isEnabled(Verbosity) && admit(Verbosity))
+                    {
+                        m_pLogger->log(Verbosity, std::forward<T>(msg));
+                    }
                 }
             }
 
@@ -266,20 +316,23 @@ namespace utils::log
              * @brief Logging the message, prepend with the caller name
              *
              *
+             * @tparam Verbosity The logging verbosity level
              * @tparam T The stringify type
-             * @param verbosity The logging verbosity level
              * @param func The name of the caller function (__file__)
              * @param msg The logging message
              */
-            template <typename T>
-            void logWithFunc(log_verbosity_t verbosity, const char* func, string_t<T>&& msg) const
+            template <log_verbosity_t Verbosity, typename T>
+            void logWithFunc(const char* func, string_t<T>&& msg) const
             {
-                if (m_pLogger)
+                if constexpr (enabled(Verbosity))
                 {
-                    std::ostringstream s;
-                    s << "[" << func << "] " << std::forward<T>(msg);
+                    if (isEnabled(Verbosity) && admit(Verbosity))
+                    {
+                        std::ostringstream s;
+                        s << "[" << func << "] " << std::forward<T>(msg);
 
-                    m_pLogger->log(verbosity, s.str());
+                        m_pLogger->log(Verbosity, s.str());
+                    }
                 }
             }
 
@@ -302,63 +355,88 @@ namespace utils::log
              *
              * @note This is intended to use with appropriate macro
              *
+             * @tparam Verbosity The logging verbosity level
              * @tparam Args The variadic arguments types
-             * @param verbosity The logging verbosity level
              * @param func The caller name (__func__)
              * @param args The variadic arguments list, to be logged
              */
-            template <typename...Args>
-            void logArgsWithFunc(log_verbosity_t verbosity, const char* func, Args&&...args) const
+            template <log_verbosity_t Verbosity, typename...Args>
+            void logArgsWithFunc(const char* func, Args&&...args) const
             {
-                if (m_pLogger)
+                if constexpr (enabled(Verbosity))
                 {
-                    std::ostringstream s;
-                    s << "[" << func << "] ";
-
-                    if constexpr (sizeof...(args))
+                    if (isEnabled(Verbosity) && admit(Verbosity))
                     {
-                        (s << ... << GetOptional{}(str(std::forward<Args>(args))));
-                    }
+                        std::ostringstream s;
+                        s << "[" << func << "] ";
 
-                    m_pLogger->log(verbosity, s.str());
+                        if constexpr (sizeof...(args))
+                        {
+                            (s << ... << GetOptional{}(str(std::forward<Args>(args))));
+                        }
+
+                        m_pLogger->log(Verbosity, s.str());
+                    }
                 }
             }
 
             /**
              * @brief Logging the formatted message
              *
+             * @tparam Verbosity The logging verbosity level
              * @tparam Args The variadic arguments types
-             * @param verbosity The logging verbosity level
              * @param format The message format
              * @param args The message arbitrary number of arguments
              */
-            template <typename...Args>
-            void logFormatted(log_verbosity_t verbosity, const std::string& format, Args&&...args) const
+            template <log_verbosity_t Verbosity, typename...Args>
+            void logFormatted(const std::string& format, Args&&...args) const
             {
-                if (m_pLogger)
+                if constexpr (enabled(Verbosity))
                 {
-                    m_pLogger->logFormatted(verbosity, format, std::forward<Args>(args)...);
+                    if (isEnabled(Verbosity) && admit(Verbosity))
+                    {
+                        m_pLogger->logFormatted(Verbosity, format, std::forward<Args>(args)...);
+                    }
                 }
             }
 
-            template <typename...Args>
-            void logFormattedWithFunc(log_verbosity_t verbosity
-                    , const char * func
+            template <log_verbosity_t Verbosity, typename...Args>
+            void logFormattedWithFunc(const char * func
                     , const std::string& format
                     , Args&&...args) const
             {
-                if (m_pLogger)
+                if constexpr (enabled(Verbosity))
                 {
-                    std::ostringstream s;
-                    s << "[" << func << "] " << format;
+                    if (isEnabled(Verbosity) && admit(Verbosity))
+                    {
+                        std::ostringstream s;
+                        s << "[" << func << "] " << format;
 
-                    m_pLogger->logFormatted(verbosity, s.str(), std::forward<Args>(args)...);
+                        m_pLogger->logFormatted(Verbosity, s.str(), std::forward<Args>(args)...);
+                    }
                 }
             }
 
+            /**
+             * @brief The rate limiter admission, reporting the summary of the suppressed
+             * messages periodically
+             */
+            bool admit(log_verbosity_t verbosity) const
+            {
+                const bool admitted = m_pLimiter->admit(verbosity);
+
+                if (auto summary = m_pLimiter->takeSummary())
+                {
+                    m_pLogger->log(log_verbosity_t::LOG_LEVEL_WARNING, std::move(*summary));
+                }
+
+                return admitted;
+            }
+
         private:
 
             std::unique_ptr<LoggerBase<logger_t>> m_pLogger;
+            std::shared_ptr<RateLimiter> m_pLimiter;
 
     };//LoggerWrapper
 
@@ -373,30 +451,43 @@ namespace utils::log
  *
  */
 
-#define TRACE_MSG(msg)                  getLogger().logTraceWithFunc(__func__, msg)
-#define TRACE_FUNC()                    getLogger().logTraceArgsWithFunc(__func__)
-#define TRACE_ARGS(...)                 getLogger().logTraceArgsWithFunc(__func__, __VA_ARGS__)
-#define TRACE_FMT(format, ...)          getLogger().logTraceFormattedWithFunc(__func__, format, __VA_ARGS__)
-
-#define DEBUG_MSG(msg)                  getLogger().logDebugWithFunc(__func__, msg)
-#define DEBUG_FUNC()                    getLogger().logDebugArgsWithFunc(__func__)
-#define DEBUG_ARGS(...)                 getLogger().logDebugArgsWithFunc(__func__, __VA_ARGS__)
-#define DEBUG_FMT(format, ...)          getLogger().logDebugFormattedWithFunc(__func__, format, __VA_ARGS__)
-
-#define INFO_MSG(msg)                   getLogger().logInfoWithFunc(__func__, msg)
-#define INFO_FUNC()                     getLogger().logInfoArgsWithFunc(__func__)
-#define INFO_ARGS(...)                  getLogger().logInfoArgsWithFunc(__func__, __VA_ARGS__)
-#define INFO_FMT(format, ...)           getLogger().logInfoFormattedWithFunc(__func__, format, __VA_ARGS__)
-
-#define WARN_MSG(msg)                   getLogger().logWarningWithFunc(__func__, msg)
-#define WARN_FUNC()                     getLogger().logWarningArgsWithFunc(__func__)
-#define WARN_ARGS(...)                  getLogger().logWarningArgsWithFunc(__func__, __VA_ARGS__)
-#define WARN_FMT(format, ...)           getLogger().logWarningFormattedWithFunc(__func__, format, __VA_ARGS__)
-
-#define ERROR_MSG(msg)                  getLogger().logErrorWithFunc(__func__, msg)
-#define ERROR_FUNC()                    getLogger().logErrorArgsWithFunc(__func__)
-#define ERROR_ARGS(...)                 getLogger().logErrorArgsWithFunc(__func__, __VA_ARGS__)
-#define ERROR_FMT(format, ...)          getLogger().logErrorFormattedWithFunc(__func__, format, __VA_ARGS__)
+/*
+ * Compile-time and runtime filter: the logging call (including its arguments)
+ * is not evaluated, unless the level is enabled
+ */
+#define LOG_IF_ENABLED(level, call)                                                         \
+    do                                                                                      \
+    {                                                                                       \
+        if constexpr (std::remove_cvref_t<decltype(getLogger())>::enabled(level))           \
+        {                                                                                   \
+            if (getLogger().isEnabled(level)) getLogger().call;                             \
+        }                                                                                   \
+    } while (false)
+
+#define TRACE_MSG(msg)          LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_TRACE, logTraceWithFunc(__func__, msg))
+#define TRACE_FUNC()            LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_TRACE, logTraceArgsWithFunc(__func__))
+#define TRACE_ARGS(...)         LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_TRACE, logTraceArgsWithFunc(__func__, __VA_ARGS__))
+#define TRACE_FMT(format, ...)  LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_TRACE, logTraceFormattedWithFunc(__func__, format, __VA_ARGS__))
+
+#define DEBUG_MSG(msg)          LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_DEBUG, logDebugWithFunc(__func__, msg))
+#define DEBUG_FUNC()            LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_DEBUG, logDebugArgsWithFunc(__func__))
+#define DEBUG_ARGS(...)         LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_DEBUG, logDebugArgsWithFunc(__func__, __VA_ARGS__))
+#define DEBUG_FMT(format, ...)  LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_DEBUG, logDebugFormattedWithFunc(__func__, format, __VA_ARGS__))
+
+#define INFO_MSG(msg)           LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_INFO, logInfoWithFunc(__func__, msg))
+#define INFO_FUNC()             LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_INFO, logInfoArgsWithFunc(__func__))
+#define INFO_ARGS(...)          LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_INFO, logInfoArgsWithFunc(__func__, __VA_ARGS__))
+#define INFO_FMT(format, ...)   LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_INFO, logInfoFormattedWithFunc(__func__, format, __VA_ARGS__))
+
+#define WARN_MSG(msg)           LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_WARNING, logWarningWithFunc(__func__, msg))
+#define WARN_FUNC()             LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_WARNING, logWarningArgsWithFunc(__func__))
+#define WARN_ARGS(...)          LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_WARNING, logWarningArgsWithFunc(__func__, __VA_ARGS__))
+#define WARN_FMT(format, ...)   LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_WARNING, logWarningFormattedWithFunc(__func__, format, __VA_ARGS__))
+
+#define ERROR_MSG(msg)          LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_ERROR, logErrorWithFunc(__func__, msg))
+#define ERROR_FUNC()            LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_ERROR, logErrorArgsWithFunc(__func__))
+#define ERROR_ARGS(...)         LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_ERROR, logErrorArgsWithFunc(__func__, __VA_ARGS__))
+#define ERROR_FMT(format, ...)  LOG_IF_ENABLED(utils::log::log_verbosity_t::LOG_LEVEL_ERROR, logErrorFormattedWithFunc(__func__, format, __VA_ARGS__))
 
 }//namespace utils::log
 
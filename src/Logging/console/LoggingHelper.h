@@ -64,7 +64,7 @@ namespace utils::log
             {
                 if constexpr (std::is_enum_v<std::decay_t<T>>) // for enum (scoped) classes
                 {
-                    return std::to_string(utils::convertEnum(std::forward<T>(value)));
+                    return std::to_string(utils::toUType(std::forward<T>(value)));
                 }
                 else
                 {
@@ -8,49 +8,249 @@
 #ifndef LOGGING_MERGE_H_
 #define LOGGING_MERGE_H_
 
+#include <future>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include "Logger.h"
 #include "LoggingHelper.h"
+#include "AOThread.h"
 
 
 namespace utils::log
 {
+    /**
+     * Decorator for the slow logging medium (i.e: file, network): the policy gets
+     * its own background thread, so that it can't add the latency to the other mediums,
+     * nor to the caller.
+     * The records are logged in the order received, and the policy itself is accessed
+     * only from within its own thread.
+     *
+     * @tparam Policy   The logging medium: provides log(log_verbosity_t, const std::string&)
+     */
+    template <class Policy>
+    class AsyncSink final
+    {
+        public:
+
+            using policy_t = Policy;
+            using record_t = std::shared_ptr<const std::string>;
+
+            AsyncSink() : AsyncSink(std::string{"log-sink"})
+            {}
+
+            /**
+             * C-tor
+             *
+             * @param name  The sink thread name
+             * @param args  The policy c-tor arguments
+             */
+            template <typename...Args>
+            explicit AsyncSink(std::string name, Args&&...args) :
+                m_pPolicy(std::make_unique<Policy>(std::forward<Args>(args)...))
+                , m_pThread(std::make_unique<thread_t>(std::move(name)
+                        , utils::ThreadWrapper::schedule_policy_t::sh_policy_normal
+                        , 0
+                        , utils::aot::dequeue_policy_t::drain))
+            {}
+
+            ~AsyncSink()
+            {
+                stop();
+            }
+
+            AsyncSink(AsyncSink&&) noexcept = default;
+
+            AsyncSink& operator = (AsyncSink&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    stop(); // the old thread is done with the old policy, before it is replaced
+                    m_pPolicy = std::move(other.m_pPolicy);
+                    m_pThread = std::move(other.m_pThread);
+                }
+
+                return *this;
+            }
+
+            /**
+             * Enqueue the record: shared with the other mediums, without copying
+             */
+            void log(log_verbosity_t verbosity, record_t record)
+            {
+                (void)m_pThread->enqueue(utils::aot::job_t<void>{[pPolicy = m_pPolicy.get(), verbosity, record = std::move(record)]
+                {
+                    pPolicy->log(verbosity, *record);
+                }});
+            }
+
+            /**
+             * Block until all records enqueued so far are logged
+             */
+            void flush()
+            {
+                if (m_pThread) // not moved from
+                {
+                    m_pThread->enqueue(utils::aot::job_t<void>{[]{}}).wait();
+                }
+            }
+
+        private:
+
+            // Log the pending records, before the thread and then the policy are destroyed
+            void stop() noexcept
+            {
+                try
+                {
+                    flush();
+                }
+                catch (...)
+                {}
+
+                m_pThread.reset();
+            }
+
+            using thread_t = utils::aot::AOThread<void>;
+
+            std::unique_ptr<Policy> m_pPolicy;
+            std::unique_ptr<thread_t> m_pThread;
+    };
+
+    template <class T>
+    struct is_async_sink : std::false_type {};
+
+    template <class Policy>
+    struct is_async_sink<AsyncSink<Policy>> : std::true_type {};
 
     /**
-     * For parallel logging on different logging mediums	
-    */
+     * For parallel logging on different logging mediums.
+     *
+     * The message is formatted once, and the same record is handed over to every medium:
+     * the fan-out is unrolled at compile time.
+     * The synchronous mediums log in the caller context, while the ones wrapped into
+     * AsyncSink - within their own background thread.
+     *
+     * @code
+     * LoggingMerge<ConsolePolicy, AsyncSink<FilePolicy>> logger;
+     * logger.logFormatted(log_verbosity_t::LOG_LEVEL_INFO, "value: %d", value);
+     * @endcode
+     *
+     * @tparam Policies The logging mediums: each provides log(log_verbosity_t, const std::string&)
+     */
     template<class...Policies>
-    class LoggingMerge final : public Policies...
+    class LoggingMerge final
     {
         public:
 
             using policy_t = std::tuple<Policies...>;
 
-            LoggingMerge(): m_policies{Policies{}...}//default, parameterless c-tors
+            LoggingMerge() = default;//default, parameterless c-tors
+
+            explicit LoggingMerge(Policies&&...policies) : m_policies{std::move(policies)...}
             {}
 
-            template <typename T, string_t<T>>
+            template <typename T, typename = std::enable_if_t<is_string<T>>>
+            void log(log_verbosity_t verbosity, T&& msg)
+            {
+                if constexpr (hasAsync)
+                {
+                    fanOut(verbosity, std::make_shared<const std::string>(std::forward<T>(msg)));
+                }
+                else
+                {
+                    const std::string& record = msg; // no copy, for the string
+                    fanOut(verbosity, record);
+                }
+            }
+
+            /**
+             * Log to the single medium
+             *
+             * @tparam Policy   The medium index
+             */
+            template <std::size_t Policy, typename T, typename = std::enable_if_t<is_string<T>>>
             void log(log_verbosity_t verbosity, T&& msg)
             {
-                for (auto i = 0; i < nPolicies; ++i)
+                static_assert(Policy < nPolicies, "Policy index out of range!");
+
+                auto& policy = std::get<Policy>(m_policies);
+                if constexpr (is_async_sink<std::tuple_element_t<Policy, policy_t>>::value)
+                {
+                    policy.log(verbosity, std::make_shared<const std::string>(std::forward<T>(msg)));
+                }
+                else
+                {
+                    policy.log(verbosity, std::forward<T>(msg));
+                }
+            }
+
+            /**
+             * Format the message once, and log it to all mediums
+             *
+             * @param verbosity The verbosity level
+             * @param format    The logging message format
+             * @param args      The parameter pack
+             */
+            template <typename...Args>
+            void logFormatted(log_verbosity_t verbosity, const std::string& format, Args&&...args)
+            {
+                try
                 {
-                    std::get<i>(m_policies).log(verbosity, std::forward<T>(msg));
+                    log(verbosity, utils::string_format(format, std::forward<Args>(args)...));
                 }
+                catch (const std::exception& e)
+                {
+                    (void)fprintf(stderr, "<Error> %s", e.what());
+                }
+            }
+
+            /**
+             * Block until all records are logged by the asynchronous mediums
+             */
+            void flush()
+            {
+                std::apply([](auto&...policy)
+                {
+                    ([&policy]
+                    {
+                        if constexpr (is_async_sink<std::decay_t<decltype(policy)>>::value) policy.flush();
+                    }(), ...);
+                }, m_policies);
+            }
+
+            template <std::size_t Policy>
+            auto& get() noexcept
+            {
+                return std::get<Policy>(m_policies);
             }
 
-            template <typename T, string_t<T>>
-            void log(std::size_t policy, log_verbosity_t verbosity, T&& msg)
+        private:
+
+            template <typename Record>
+            void fanOut(log_verbosity_t verbosity, const Record& record)
             {
-                if (policy >= nPolicies) throw std::out_of_range("Policy index out of range!");
-                
-                std::get<policy>(m_policies).log(verbosity, std::forward<T>(msg));
+                std::apply([verbosity, &record](auto&...policy)
+                {
+                    (dispatch(policy, verbosity, record), ...);
+                }, m_policies);
+            }
+
+            template <class Policy, typename Record>
+            static void dispatch(Policy& policy, log_verbosity_t verbosity, const Record& record)
+            {
+                if constexpr (is_async_sink<Policy>::value) policy.log(verbosity, record);//shared record
+                else if constexpr (hasAsync) policy.log(verbosity, *record);
+                else policy.log(verbosity, record);
             }
 
         private:
 
             inline static constexpr std::size_t nPolicies = sizeof...(Policies);
+            inline static constexpr bool hasAsync = (is_async_sink<Policies>::value || ...);
+
             policy_t m_policies;
     };
 }
@@ -0,0 +1,92 @@
+//
+// MappedRingLogger.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef LOGGING_MAPPEDRINGLOGGER_H_
+#define LOGGING_MAPPEDRINGLOGGER_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+// Logging
+#include "Logger.h"
+#include "LoggingHelper.h"
+#include "CoutLogger.h"
+
+// File streams
+#include "MappedRingFileStream.h"
+
+
+namespace utils::log
+{
+    /**
+     * @brief Logging into the memory-mapped ring file: the flight recorder.
+     * The last N bytes of the log survive the process crash, with no syscall per message.
+     *
+     * All loggers on the same file share the same ring, and the writers don't lock:
+     * the message is formatted into the thread-local buffer, and copied into the mapping at once.
+     * @see utils::file::MappedRing::read for reading the ring file back
+     *
+     * @code
+     * auto logger = MappedRingLogger::createLogger("Service", "/var/tmp/service.ring", 4 << 20);
+     * @endcode
+     */
+    class MappedRingLogger final : public LoggerBase<MappedRingLogger>
+    {
+        public:
+
+            using super = LoggerBase<MappedRingLogger>;
+
+            /**
+             * C-tor
+             *
+             * @param tag       The logging tag
+             * @param path      The ring file path
+             * @param capacity  The ring capacity in bytes: for the first logger on the given file
+             */
+            MappedRingLogger(std::string tag, const std::filesystem::path& path, std::size_t capacity) noexcept :
+                super(std::move(tag))
+            {
+                try
+                {
+                    m_pRing = utils::file::MappedRing::shared(path, capacity);
+                }
+                catch (const std::exception& e)
+                {
+                    (void)fprintf(stderr, "<Error> Ring file %s: %s\n", path.c_str(), e.what());
+                }
+            }
+
+            template <typename T>
+            void logImplWithTag(log_verbosity_t verbosity, string_t<T>&& msg) const
+            {
+                // Filter out, before formatting
+                if (log_verbosity_t::LOG_LEVEL_ERROR != verbosity && verbosity < LOG_LEVEL) return;
+                if (!m_pRing) return;
+
+                const std::string& text = msg;
+                const auto s = utils::string_view_format("<%s>: %s\n", tag().c_str(), text.c_str());
+
+                m_pRing->write(s.data(), s.size());
+            }
+
+            /**
+             * @return The shared ring: i.e, for the snapshot
+             */
+            const std::shared_ptr<utils::file::MappedRing>& ring() const noexcept
+            {
+                return m_pRing;
+            }
+
+        private:
+
+            std::shared_ptr<utils::file::MappedRing> m_pRing;
+    };// MappedRingLogger
+
+}//namespace utils::log
+
+#endif /* LOGGING_MAPPEDRINGLOGGER_H_ */
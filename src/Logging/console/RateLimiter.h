@@ -0,0 +1,229 @@
+//
+// RateLimiter.h
+//
+//  Created on: Oct 14, 2026
+//
+
+#ifndef LOGGING_RATELIMITER_H_
+#define LOGGING_RATELIMITER_H_
+
+#include <time.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "Commons.h"
+#include "Logger.h"
+
+
+namespace utils::log
+{
+    /**
+     * @brief Per-tag flood protection: the token-bucket rate limiting and 1-in-N sampling,
+     * configured per verbosity level.
+     *
+     * The admission is lock-free: the token bucket is implemented as GCRA (generic cell rate
+     * algorithm) - the single "theoretical arrival time" per level, updated with CAS.
+     * The suppressed messages are only counted, and reported with the periodic summary.
+     *
+     * The limiter is shared by all loggers with the same tag.
+     * @see RateLimiter::forTag
+     */
+    class RateLimiter final
+    {
+            static constexpr std::size_t levels = utils::toUType(log_verbosity_t::LOG_LEVEL_ERROR) + 1;
+
+        public:
+
+            RateLimiter() noexcept : m_lastSummary(clock())
+            {}
+
+            RateLimiter(const RateLimiter&) = delete;
+            RateLimiter& operator = (const RateLimiter&) = delete;
+
+            /**
+             * @param tag   The logging tag
+             * @return      The limiter shared by all loggers with the given tag
+             */
+            static std::shared_ptr<RateLimiter> forTag(const std::string& tag)
+            {
+                static std::mutex lock;
+                static std::unordered_map<std::string, std::weak_ptr<RateLimiter>> limiters;
+
+                std::lock_guard<std::mutex> guard {lock};
+
+                auto& weak = limiters[tag];
+                auto limiter = weak.lock();
+                if (!limiter)
+                {
+                    limiter = std::make_shared<RateLimiter>();
+                    weak = limiter;
+                }
+                return limiter;
+            }
+
+            /**
+             * @brief Token bucket: at most burst messages at once, refilled with the given rate
+             *
+             * @param verbosity     The verbosity level
+             * @param perSecond     The sustained rate: messages per second, 0 - unlimited
+             * @param burst         The bucket size
+             */
+            void setRateLimit(log_verbosity_t verbosity, double perSecond, std::uint32_t burst = 1) noexcept
+            {
+                auto& level = m_levels[utils::toUType(verbosity)];
+
+                const auto interval = (perSecond > 0) ? static_cast<std::uint64_t>(1e9 / perSecond) : 0;
+                level.m_tolerance.store(interval * std::max<std::uint32_t>(burst, 1), std::memory_order_relaxed);
+                level.m_interval.store(interval, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Sampling: log only each n-th message
+             *
+             * @param verbosity The verbosity level
+             * @param n         The sampling period: 0 or 1 - all messages
+             */
+            void setSampling(log_verbosity_t verbosity, std::uint32_t n) noexcept
+            {
+                m_levels[utils::toUType(verbosity)].m_sampling.store(std::max<std::uint32_t>(n, 1), std::memory_order_relaxed);
+            }
+
+            /**
+             * @param interval  The minimum interval between the summaries of suppressed messages
+             */
+            void setSummaryInterval(std::chrono::milliseconds interval) noexcept
+            {
+                m_summaryInterval.store(static_cast<std::uint64_t>(std::chrono::nanoseconds{interval}.count()), std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief The admission check: before any formatting takes place
+             *
+             * @param verbosity The verbosity level
+             * @return Indication whether the message should be logged
+             */
+            bool admit(log_verbosity_t verbosity) noexcept
+            {
+                auto& level = m_levels[utils::toUType(verbosity)];
+
+                if (const auto n = level.m_sampling.load(std::memory_order_relaxed); n > 1
+                        && level.m_sampled.fetch_add(1, std::memory_order_relaxed) % n != 0)
+                {
+                    return suppress(level);
+                }
+
+                const auto interval = level.m_interval.load(std::memory_order_relaxed);
+                if (0 == interval) return true;
+
+                const auto tolerance = level.m_tolerance.load(std::memory_order_relaxed);
+                const auto now = clock();
+
+                auto tat = level.m_tat.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    const auto next = std::max(tat, now) + interval;
+                    if (next - now > tolerance) return suppress(level); // the bucket is empty
+
+                    if (level.m_tat.compare_exchange_weak(tat, next, std::memory_order_relaxed)) return true;
+                }
+            }
+
+            /**
+             * @return The summary of the messages suppressed since the last one:
+             * in case that there are any, and the summary interval has elapsed
+             */
+            std::optional<std::string> takeSummary()
+            {
+                if (!m_pending.load(std::memory_order_relaxed)) return {};
+
+                const auto now = clock();
+                auto last = m_lastSummary.load(std::memory_order_relaxed);
+                if (now - last < m_summaryInterval.load(std::memory_order_relaxed)) return {};
+
+                // Only one thread reports
+                if (!m_lastSummary.compare_exchange_strong(last, now, std::memory_order_relaxed)) return {};
+                m_pending.store(false, std::memory_order_relaxed);
+
+                static constexpr const char* names[levels] = {"trace", "debug", "info", "warning", "error"};
+
+                std::string details;
+                std::uint64_t total = 0;
+                for (std::size_t i = 0; i < levels; ++i)
+                {
+                    const auto suppressed = m_levels[i].m_suppressed.exchange(0, std::memory_order_relaxed);
+                    if (0 == suppressed) continue;
+
+                    total += suppressed;
+                    details.append(" ").append(names[i]).append("=").append(std::to_string(suppressed));
+                }
+
+                if (0 == total) return {};
+                return "<rate limit> suppressed " + std::to_string(total) + " message(s):" + details;
+            }
+
+            /**
+             * @param verbosity The verbosity level
+             * @return The number of messages suppressed since the last summary
+             */
+            std::uint64_t suppressed(log_verbosity_t verbosity) const noexcept
+            {
+                return m_levels[utils::toUType(verbosity)].m_suppressed.load(std::memory_order_relaxed);
+            }
+
+        private:
+
+            struct alignas(64) Level // own cache line: the levels are updated independently
+            {
+                std::atomic<std::uint32_t> m_sampling {1};
+                std::atomic<std::uint64_t> m_sampled {0};
+
+                std::atomic<std::uint64_t> m_interval {0};  // ns per token: 0 - unlimited
+                std::atomic<std::uint64_t> m_tolerance {0}; // ns: burst * interval
+                std::atomic<std::uint64_t> m_tat {0};       // theoretical arrival time
+
+                std::atomic<std::uint64_t> m_suppressed {0};
+            };
+
+            bool suppress(Level& level) noexcept
+            {
+                level.m_suppressed.fetch_add(1, std::memory_order_relaxed);
+                if (!m_pending.load(std::memory_order_relaxed)) m_pending.store(true, std::memory_order_relaxed);
+                return false;
+            }
+
+            /*
+             * Coarse monotonic clock: the resolution of the scheduler tick is enough
+             * for the rate limiting, at the fraction of the cost
+             */
+            static std::uint64_t clock() noexcept
+            {
+#if defined(CLOCK_MONOTONIC_COARSE)
+                timespec ts;
+                ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+                return static_cast<std::uint64_t>(ts.tv_sec) * 1'000'000'000ull + static_cast<std::uint64_t>(ts.tv_nsec);
+#else
+                return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+            }
+
+        private:
+
+            std::array<Level, levels> m_levels {};
+
+            std::atomic<bool> m_pending {false};
+            std::atomic<std::uint64_t> m_lastSummary;
+            std::atomic<std::uint64_t> m_summaryInterval {10'000'000'000ull}; // 10s
+    };
+}
+
+#endif /* LOGGING_RATELIMITER_H_ */
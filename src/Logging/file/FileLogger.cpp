@@ -3,9 +3,12 @@
 // Copyright (c) 2021. All rights reserved!
 //
 
+#include <algorithm>
 #include <future>
+#include <iterator>
 
 #include "FileLogger.h"
+#include "../../measuring/TraceScope.h"
 
 using namespace utils::log;
 
@@ -17,10 +20,19 @@ FileLogger<Data>::FileLogger(std::size_t cache
         , std::string name
         , utils::ThreadWrapper::schedule_policy_t scheduling
         , utils::ThreadWrapper::priority_t priority
-        ): m_pLogFile(std::move(file))
-    , m_plogThread(std::make_unique<loggin_thread_t>(name, scheduling, priority))
+        , std::size_t buffers
+        ): m_cacheSize(cache)
+    , m_pLogFile(std::move(file))
+    , m_plogThread(std::make_unique<loggin_thread_t>(name, scheduling, priority, utils::aot::dequeue_policy_t::drain))
 {
     m_logBuffer.reserve(cache);
+
+    // At least double buffering: the active one, and the one being written
+    m_freeBuffers.resize(std::max<std::size_t>(buffers, 2) - 1);
+    for (auto& buffer : m_freeBuffers)
+    {
+        buffer.reserve(cache);
+    }
 }
 
 
@@ -32,63 +44,96 @@ FileLogger<Data>::~FileLogger()
 
 
 template <typename Data>
-bool FileLogger<Data>::checkAvailableCache(std::size_t required)
+bool FileLogger<Data>::checkAvailableCache(std::size_t required) const
 {
-    const auto availableCache = m_logBuffer.capacity() - m_logBuffer.size();
+    const auto availableCache = m_cacheSize - m_logBuffer.size();
     return availableCache >= required;
 }
 
 
 template <typename Data>
-std::future<void> FileLogger<Data>::flushCacheAndWrite(cache_t<Data>&& data)
+void FileLogger<Data>::write2File(cache_t<Data>&& data, bool recycle)
 {
-    task_t job { [this, d=std::move(data)] {
-        // Flush cache to file
-        m_pLogFile->write(m_logBuffer);
-
-        // Preserve data to cache
-        m_logBuffer.clear();
-        m_logBuffer.insert(m_logBuffer.end(), d.begin(), d.end());
+    // The caller holds the lock
+    const bool idle = m_pending.empty();
+    m_pending.push_back({std::move(data), recycle});
 
-    }};
+    if (!idle) return;//the write is already scheduled: it will pick this one too
 
-    return m_plogThread->enqueue(std::move(job));
+    task_t job { [this] { writePending(); }};
+    (void)m_plogThread->enqueue(std::move(job));
 }
 
 
 template <typename Data>
-std::future<void> FileLogger<Data>::write2Cache(cache_t<Data>&& data)
+void FileLogger<Data>::writePending()
 {
-    task_t job { [this, d = std::move(data)] {
+#if defined(MEASURE_ENABLE_TRACING)
+    // Writing the trace: not traced itself - the whole logging thread
+    if (utils::measure::trace::Tracer::instance().isSink(dynamic_cast<const void*>(this))) utils::measure::trace::Tracer::mute();
+#endif
+    TRACE_SCOPE("FileLogger::write");
+
+    std::vector<pending_t> pending;
+    {
+        std::lock_guard<std::mutex> lock {m_lock};
+        pending.swap(m_pending);
+    }
 
-        m_logBuffer.insert(m_logBuffer.end()
-                , d.begin()
-                , d.end()
-                );
-    }};
+    // All buffers swapped out in the meantime: in the single gather write
+    std::vector<typename utils::file::OutputFileStream<Data>::view_t> ranges;
+    ranges.reserve(pending.size());
+    for (const auto& p : pending) ranges.emplace_back(p.m_data);
 
-    return m_plogThread->enqueue(std::move(job));
+    m_pLogFile->write(typename utils::file::OutputFileStream<Data>::gather_t{ranges});
+
+    for (auto& p : pending)
+    {
+        if (p.m_recycle) releaseBuffer(std::move(p.m_data));//back to the pool, preserving the capacity
+    }
 }
 
 
 template <typename Data>
-std::future<void> FileLogger<Data>::flushCache()
+void FileLogger<Data>::swapBuffer(std::unique_lock<std::mutex>& lock, std::size_t required)
 {
-    task_t job { [this] {
-        // Flush cache to file
-        m_pLogFile->write(m_logBuffer);
-    }};
+    // Back pressure: all buffers are waiting to be written
+    m_bufferReleased.wait(lock, [this, required]{ return !m_freeBuffers.empty() || checkAvailableCache(required); });
+
+    if (checkAvailableCache(required)) return;//swapped out by another producer in the meantime
+
+    // Swap out the full buffer to the logging thread, and continue with the free one
+    cache_t<Data> full = std::move(m_freeBuffers.back());
+    m_freeBuffers.pop_back();
+    full.swap(m_logBuffer);
+
+    write2File(std::move(full), true);
+}
 
-    return m_plogThread->enqueue(std::move(job));
+
+template <typename Data>
+void FileLogger<Data>::releaseBuffer(cache_t<Data>&& buffer)
+{
+    buffer.clear();
+    {
+        std::lock_guard<std::mutex> lock {m_lock};
+        m_freeBuffers.push_back(std::move(buffer));
+    }
+    m_bufferReleased.notify_one();
 }
 
 
 template <typename Data>
 void FileLogger<Data>::flushCacheAndStop()
 {
-    auto flushed = flushCache();
+    {
+        std::lock_guard<std::mutex> lock {m_lock};
+        write2File(std::move(m_logBuffer), false);
+    }
 
-    flushed.get();//wait until the cache is flushed to file
+    // Wait until the cache is flushed to file (and all buffers swapped out before)
+    task_t job { [this] { writePending(); }};
+    m_plogThread->enqueue(std::move(job)).get();
 
     // Signal logging thread exit, and wait
 
@@ -103,15 +148,30 @@ void FileLogger<Data>::flushCacheAndStop()
 template <typename Data>
 void FileLogger<Data>::log(cache_t<Data>&& data)
 {
-    if (!checkAvailableCache(data.size()))//don't allow the reallocation of the cache
+    std::unique_lock<std::mutex> lock {m_lock};
+
+    if (data.size() > m_cacheSize)//doesn't fit into any buffer: write it as it is, without copying
     {
-        (void)flushCacheAndWrite(std::move(data));//write cache to file and preserve the data afterwards
+        if (!m_logBuffer.empty())
+        {
+            swapBuffer(lock, m_cacheSize);
+        }
+
+        write2File(std::move(data), false);
         return;
     }
 
-    // Enough slots - write into cache
+    if (!checkAvailableCache(data.size()))//don't allow the reallocation of the cache
+    {
+        swapBuffer(lock, data.size());
+    }
+
+    // Enough slots - append into the active buffer
 
-    (void)write2Cache(std::move(data));
+    m_logBuffer.insert(m_logBuffer.end()
+            , std::make_move_iterator(data.begin())
+            , std::make_move_iterator(data.end())
+            );
 }
 
 
@@ -11,6 +11,8 @@
 #include <vector>
 #include <type_traits>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
 
 #include "DataLogger.h"
 
@@ -31,6 +33,18 @@ namespace utils::log
          * Designed having in mind logging binary data (uint8_t), or
          * std::string messages.
          * Should work for an arbitrary data type.
+         *
+         * N-way buffering: the producers append the data directly into the active buffer,
+         * and the full buffer is swapped out to the logging thread, which writes it
+         * into the file - while the producers keep appending into the next, free buffer.
+         * The producer blocks only in case that all buffers are waiting to be written.
+         * The buffers swapped out in the meantime are written at once, with the gather write.
+         *
+         * The output file medium is injected: i.e, the RotatingOutputFileStream for the rotation
+         * by size/time, over the DirectOutputFileStream for the BLOB logging that bypasses the page cache.
+         * With the CompressedOutputFileStream, each flushed cache is compressed within the logging thread.
+         * With the MappedRingFileStream, only the last N bytes are kept - in the memory-mapped file
+         * that survives the process crash.
          */
 
         template <typename Data>
@@ -44,13 +58,14 @@ namespace utils::log
                         , std::string name
                         , utils::ThreadWrapper::schedule_policy_t scheduling
                         , utils::ThreadWrapper::priority_t priority
+                        , std::size_t buffers = 2
                 );
 
                 ~FileLogger() override;
 
                 /**
-                 * The logging task will be serialize into background
-                 * thread
+                 * The data is appended into the active buffer.
+                 * Only the full buffer is serialized into background thread
                  * @param data  The logging data
                  */
                 void log(cache_t<Data>&& data) override;
@@ -59,16 +74,30 @@ namespace utils::log
 
                 // Helper methods
 
-                bool checkAvailableCache(std::size_t required);
-                std::future<void> write2Cache(cache_t<Data>&& data);
-                std::future<void> flushCacheAndWrite(cache_t<Data>&& data);
-                std::future<void> flushCache();
+                bool checkAvailableCache(std::size_t required) const;
+                void write2File(cache_t<Data>&& data, bool recycle);
+                void writePending();
+                void swapBuffer(std::unique_lock<std::mutex>& lock, std::size_t required);
+                void releaseBuffer(cache_t<Data>&& buffer);
                 void flushCacheAndStop();
 
             private:
 
+                const std::size_t m_cacheSize;
+
+                std::mutex m_lock;
+                std::condition_variable m_bufferReleased;
+
+                cache_t<Data> m_logBuffer;//the active buffer
+                std::vector<cache_t<Data>> m_freeBuffers;
+
+                struct pending_t
+                {
+                    cache_t<Data> m_data;
+                    bool m_recycle;
+                };
+                std::vector<pending_t> m_pending;//swapped out, waiting to be written: in order
 
-                cache_t<Data> m_logBuffer;
                 std::unique_ptr<utils::file::OutputFileStream<Data>> m_pLogFile;
 
                 using task_t = utils::aot::job_t<void>;
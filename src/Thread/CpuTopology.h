@@ -0,0 +1,401 @@
+/*
+ * CpuTopology.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef THREAD_CPUTOPOLOGY_H_
+#define THREAD_CPUTOPOLOGY_H_
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+
+// Std library
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace utils
+{
+    /**
+     * Placement of the single logical CPU, within the machine topology
+     */
+    struct CpuInfo
+    {
+        int m_cpu = 0;      // logical CPU (kernel id)
+        int m_socket = 0;   // physical package
+        int m_core = 0;     // physical core: unique within the socket
+        int m_node = 0;     // NUMA node
+        int m_l2 = 0;       // L2 domain: the lowest CPU sharing the same L2 cache
+        int m_l3 = 0;       // L3 domain: the lowest CPU sharing the same L3 cache
+        bool m_primary = true; // the first SMT sibling of the physical core
+    };
+
+    namespace topology
+    {
+        inline std::optional<std::string> readLine(const std::string& path)
+        {
+            std::ifstream file {path};
+            std::string line;
+            if (!file || !std::getline(file, line)) return {};
+            return line;
+        }
+
+        inline std::optional<int> readInt(const std::string& path)
+        {
+            const auto line = readLine(path);
+            if (!line) return {};
+            try
+            {
+                return std::stoi(*line);
+            }
+            catch (...)
+            {
+                return {};
+            }
+        }
+
+        /**
+         * Parse the kernel CPU list format, i.e: "0-3,8,10-11"
+         *
+         * @param list  The CPU list
+         * @return      The CPUs, in ascending order
+         */
+        inline std::vector<int> parseCpuList(const std::string& list)
+        {
+            std::vector<int> cpus;
+
+            std::size_t pos = 0;
+            while (pos < list.size())
+            {
+                const auto end = std::min(list.find(',', pos), list.size());
+                const auto range = list.substr(pos, end - pos);
+                pos = end + 1;
+
+                try
+                {
+                    const auto dash = range.find('-');
+                    const int first = std::stoi(range.substr(0, dash));
+                    const int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+                    for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+                }
+                catch (...)
+                {
+                    // skip malformed entry
+                }
+            }
+
+            std::sort(cpus.begin(), cpus.end());
+            return cpus;
+        }
+    } // namespace topology
+
+    /**
+     * CPU topology discovery: sockets, physical cores, SMT siblings, shared caches and NUMA nodes.
+     * Based on the Linux sysfs (/sys/devices/system/cpu, /sys/devices/system/node).
+     *
+     * In case that sysfs is not available, the topology is flat: every logical CPU
+     * is physical core of its own, on the single socket and the NUMA node.
+     */
+    class CpuTopology final
+    {
+        public:
+
+            static CpuTopology discover()
+            {
+                using namespace topology;
+
+                const std::string root = "/sys/devices/system/cpu/";
+
+                std::vector<int> online;
+                if (const auto list = readLine(root + "online")) online = parseCpuList(*list);
+                if (online.empty())
+                {
+                    for (int cpu = 0; cpu < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); ++cpu)
+                    {
+                        online.push_back(cpu);
+                    }
+                }
+
+                CpuTopology topology;
+                topology.m_cpus.reserve(online.size());
+
+                for (const int cpu : online)
+                {
+                    const auto dir = root + "cpu" + std::to_string(cpu) + '/';
+
+                    CpuInfo info;
+                    info.m_cpu = cpu;
+                    info.m_socket = readInt(dir + "topology/physical_package_id").value_or(0);
+                    info.m_core = readInt(dir + "topology/core_id").value_or(cpu);
+                    info.m_node = nodeOf(cpu);
+                    info.m_l2 = info.m_l3 = cpu;
+
+                    if (const auto siblings = readLine(dir + "topology/thread_siblings_list"))
+                    {
+                        const auto smt = parseCpuList(*siblings);
+                        info.m_primary = smt.empty() || smt.front() == cpu;
+                    }
+
+                    // Unified, or data caches
+                    for (int index = 0; ; ++index)
+                    {
+                        const auto cache = dir + "cache/index" + std::to_string(index) + '/';
+                        const auto level = readInt(cache + "level");
+                        if (!level) break;
+
+                        const auto type = readLine(cache + "type").value_or("");
+                        if ("Instruction" == type) continue;
+
+                        const auto shared = parseCpuList(readLine(cache + "shared_cpu_list").value_or(""));
+                        const int domain = shared.empty() ? cpu : shared.front();
+
+                        if (2 == *level) info.m_l2 = domain;
+                        else if (3 == *level) info.m_l3 = domain;
+                    }
+
+                    topology.m_cpus.push_back(info);
+                }
+
+                return topology;
+            }
+
+            const std::vector<CpuInfo>& cpus() const noexcept
+            {
+                return m_cpus;
+            }
+
+            std::size_t sockets() const
+            {
+                return count(&CpuInfo::m_socket);
+            }
+
+            std::size_t nodes() const
+            {
+                return count(&CpuInfo::m_node);
+            }
+
+            std::size_t physicalCores() const
+            {
+                return static_cast<std::size_t>(std::count_if(m_cpus.begin(), m_cpus.end()
+                        , [](const auto& info) { return info.m_primary; }));
+            }
+
+            /**
+             * The CPU list for pinning the workers one per physical core (no SMT siblings).
+             * Grouped by the NUMA node, so that the neighbor workers - which steal from each other,
+             * are on the same node.
+             *
+             * @param node  Restrict to the given NUMA node, if any
+             * @return      The CPU list
+             */
+            std::vector<int> onePerCore(std::optional<int> node = std::nullopt) const
+            {
+                std::vector<CpuInfo> primary;
+                std::copy_if(m_cpus.begin(), m_cpus.end(), std::back_inserter(primary)
+                        , [node](const auto& info) { return info.m_primary && (!node || info.m_node == *node); });
+
+                std::stable_sort(primary.begin(), primary.end()
+                        , [](const auto& lhs, const auto& rhs) { return lhs.m_node < rhs.m_node; });
+
+                std::vector<int> cpus;
+                cpus.reserve(primary.size());
+                for (const auto& info : primary) cpus.push_back(info.m_cpu);
+
+                return cpus;
+            }
+
+            /**
+             * The CPUs sharing the same cache with the given CPU, including itself
+             *
+             * @param cpu   The logical CPU
+             * @param level The cache level: 2 or 3
+             * @return      The CPU list, empty in case of unknown CPU
+             */
+            std::vector<int> sharingCache(int cpu, int level) const
+            {
+                std::vector<int> cpus;
+
+                const auto info = find(cpu);
+                if (!info) return cpus;
+
+                const auto domain = (2 == level) ? &CpuInfo::m_l2 : &CpuInfo::m_l3;
+                for (const auto& other : m_cpus)
+                {
+                    if (other.*domain == (*info).*domain) cpus.push_back(other.m_cpu);
+                }
+
+                return cpus;
+            }
+
+            /**
+             * The pair of CPUs for the producer-consumer threads: on the different physical cores
+             * of the same cache domain - so that the hand-off doesn't leave the shared cache
+             *
+             * @param level The cache level: 2 or 3
+             * @return      The pair of CPUs, or none-value in case that there is no such pair
+             */
+            std::optional<std::pair<int, int>> cachePair(int level = 3) const
+            {
+                for (const auto& first : m_cpus)
+                {
+                    if (!first.m_primary) continue;
+                    for (const int cpu : sharingCache(first.m_cpu, level))
+                    {
+                        const auto second = find(cpu);
+                        if (second && second->m_primary && second->m_cpu != first.m_cpu)
+                        {
+                            return std::make_pair(first.m_cpu, second->m_cpu);
+                        }
+                    }
+                }
+                return {};
+            }
+
+            std::optional<CpuInfo> find(int cpu) const
+            {
+                const auto it = std::find_if(m_cpus.begin(), m_cpus.end()
+                        , [cpu](const auto& info) { return info.m_cpu == cpu; });
+                if (it == m_cpus.end()) return {};
+                return *it;
+            }
+
+            /**
+             * @param cpu   The logical CPU
+             * @return      The NUMA node the CPU belongs to: 0, if unknown
+             */
+            static int nodeOf(int cpu)
+            {
+                using namespace topology;
+
+                for (const int node : parseCpuList(readLine("/sys/devices/system/node/online").value_or("0")))
+                {
+                    const auto cpus = parseCpuList(readLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist").value_or(""));
+                    if (std::binary_search(cpus.begin(), cpus.end(), cpu)) return node;
+                }
+                return 0;
+            }
+
+        private:
+
+            std::size_t count(int CpuInfo::* field) const
+            {
+                std::set<int> values;
+                for (const auto& info : m_cpus) values.insert(info.*field);
+                return std::max<std::size_t>(values.size(), 1);
+            }
+
+        private:
+
+            std::vector<CpuInfo> m_cpus;
+    };
+
+    /**
+     * Pin the thread to the given set of CPUs
+     *
+     * @param handle    The native thread handle
+     * @param cpus      The CPU list
+     * @return          Indication of the operation outcome: true on success
+     */
+    inline bool setAffinity(pthread_t handle, const std::vector<int>& cpus)
+    {
+        if (cpus.empty()) return false;
+
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        for (const int cpu : cpus)
+        {
+            if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+            CPU_SET(cpu, &cpuset);
+        }
+
+        return 0 == pthread_setaffinity_np(handle, sizeof(cpu_set_t), &cpuset);
+    }
+
+    namespace numa
+    {
+        /**
+         * Allocate the memory on the given NUMA node.
+         * The pages are mapped, and bound (preferred policy) to the node before the first touch.
+         * In case that binding fails (no NUMA support), the memory is allocated following
+         * the default (first-touch) policy
+         *
+         * @param size  The size in bytes
+         * @param node  The NUMA node
+         * @return      The page-aligned memory, or nullptr
+         */
+        inline void* allocate(std::size_t size, int node) noexcept
+        {
+            void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (MAP_FAILED == addr) return nullptr;
+
+            if (node >= 0 && node < static_cast<int>(8 * sizeof(unsigned long)))
+            {
+                const unsigned long mask = 1UL << node;
+                (void)::syscall(SYS_mbind, addr, size, MPOL_PREFERRED, &mask, 8 * sizeof(mask), 0);
+            }
+
+            return addr;
+        }
+
+        inline void deallocate(void* addr, std::size_t size) noexcept
+        {
+            if (addr) ::munmap(addr, size);
+        }
+
+        template <typename T>
+        struct NodeDeleter
+        {
+            void operator()(T* ptr) const noexcept
+            {
+                if (ptr)
+                {
+                    ptr->~T();
+                    deallocate(ptr, sizeof(T));
+                }
+            }
+        };
+
+        template <typename T>
+        using node_ptr_t = std::unique_ptr<T, NodeDeleter<T>>;
+
+        /**
+         * Construct the object in the memory local to the given NUMA node
+         *
+         * @param node  The NUMA node
+         * @param args  The c-tor arguments
+         * @return      The owning pointer
+         */
+        template <typename T, typename...Args>
+        node_ptr_t<T> make_on_node(int node, Args&&...args)
+        {
+            static_assert(alignof(T) <= 4096, "Over-aligned type for the page allocation");
+
+            void* addr = allocate(sizeof(T), node);
+            if (!addr) throw std::bad_alloc{};
+
+            try
+            {
+                return node_ptr_t<T>(new (addr) T(std::forward<Args>(args)...));
+            }
+            catch (...)
+            {
+                deallocate(addr, sizeof(T));
+                throw;
+            }
+        }
+    } // namespace numa
+}
+
+#endif /* THREAD_CPUTOPOLOGY_H_ */
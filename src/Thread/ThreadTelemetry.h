@@ -0,0 +1,302 @@
+/*
+ * ThreadTelemetry.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef THREAD_THREADTELEMETRY_H_
+#define THREAD_THREADTELEMETRY_H_
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// Std library
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace utils
+{
+    /**
+     * How the thread is actually doing: sampled from the kernel.
+     * The counters are cumulative, since the thread start: @see since() - for the interval.
+     *
+     * - cpu time:      the thread CPU-time clock
+     * - switches:      voluntary (blocked, yielded), involuntary (preempted) - /proc/self/task/<tid>/status
+     * - migrations:    moved to another CPU - /proc/self/task/<tid>/sched (with CONFIG_SCHED_DEBUG, otherwise 0)
+     * - run queue:     the time spent runnable, but waiting for the CPU, over the number of time slices -
+     *                  /proc/self/task/<tid>/schedstat (with CONFIG_SCHEDSTATS, otherwise 0).
+     *                  For SCHED_FIFO/RR threads, that's the observed scheduling latency.
+     */
+    struct ThreadStats
+    {
+        pid_t m_tid = 0;
+        std::string m_name;
+        int m_policy = SCHED_OTHER;
+        int m_priority = 0;
+        int m_cpu = -1;                         // the last one it ran on
+
+        std::chrono::nanoseconds m_cpuTime {0};
+        std::uint64_t m_voluntarySwitches = 0;
+        std::uint64_t m_involuntarySwitches = 0;
+        std::uint64_t m_migrations = 0;
+        std::chrono::nanoseconds m_runQueueWait {0};
+        std::uint64_t m_timeSlices = 0;
+
+        bool realtime() const noexcept
+        {
+            return SCHED_FIFO == m_policy || SCHED_RR == m_policy;
+        }
+
+        /**
+         * @return The mean scheduling latency: the wait for the CPU, per time slice
+         */
+        std::chrono::nanoseconds schedulingLatency() const noexcept
+        {
+            return m_timeSlices ? m_runQueueWait / static_cast<std::int64_t>(m_timeSlices) : std::chrono::nanoseconds{0};
+        }
+
+        /**
+         * @param earlier   The earlier sample of the same thread
+         * @return          The counters over the interval: i.e. for verifying that the real-time thread
+         *                  was not preempted, or migrated under the load
+         */
+        ThreadStats since(const ThreadStats& earlier) const
+        {
+            ThreadStats delta = *this;
+            delta.m_cpuTime -= earlier.m_cpuTime;
+            delta.m_voluntarySwitches -= earlier.m_voluntarySwitches;
+            delta.m_involuntarySwitches -= earlier.m_involuntarySwitches;
+            delta.m_migrations -= earlier.m_migrations;
+            delta.m_runQueueWait -= earlier.m_runQueueWait;
+            delta.m_timeSlices -= earlier.m_timeSlices;
+            return delta;
+        }
+    };
+
+    namespace telemetry
+    {
+        /**
+         * @param path  The procfs file: "key: value" per line
+         * @param key   The key
+         * @return      The value, if there is the key
+         */
+        inline std::optional<std::uint64_t> readField(const std::string& path, std::string_view key)
+        {
+            std::ifstream in {path};
+            for (std::string line; std::getline(in, line); )
+            {
+                if (!line.starts_with(key)) continue;
+
+                const auto pos = line.find_first_of("0123456789", key.size());
+                if (std::string::npos == pos) return std::nullopt;
+                return std::stoull(line.substr(pos));
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @param tid   The kernel thread id
+         * @return      The thread CPU-time clock: MAKE_THREAD_CPUCLOCK(tid, CPUCLOCK_SCHED) of the kernel,
+         *              which (unlike pthread_getcpuclockid) doesn't need the thread to be alive
+         */
+        inline clockid_t cpuClock(pid_t tid) noexcept
+        {
+            return static_cast<clockid_t>((~static_cast<unsigned>(tid) << 3) | 6);
+        }
+
+        /**
+         * Sample the thread: by the kernel thread id only, so it may exit meanwhile
+         *
+         * @param tid   The kernel thread id
+         * @return      The stats, or none-value in case that the thread exited
+         */
+        inline std::optional<ThreadStats> sample(pid_t tid)
+        {
+            using namespace std::chrono;
+
+            const auto task = "/proc/self/task/" + std::to_string(tid);
+
+            ThreadStats stats;
+            stats.m_tid = tid;
+
+            std::ifstream comm {task + "/comm"};
+            if (!comm) return std::nullopt; // no task directory: exited
+            std::getline(comm, stats.m_name);
+
+            if (const int policy = sched_getscheduler(tid); policy >= 0) stats.m_policy = policy;
+            else if (ESRCH == errno) return std::nullopt;
+
+            sched_param param {};
+            if (0 == sched_getparam(tid, &param)) stats.m_priority = param.sched_priority;
+
+            timespec ts {};
+            if (0 == clock_gettime(cpuClock(tid), &ts))
+            {
+                stats.m_cpuTime = seconds{ts.tv_sec} + nanoseconds{ts.tv_nsec};
+            }
+
+            stats.m_voluntarySwitches = readField(task + "/status", "voluntary_ctxt_switches").value_or(0);
+            stats.m_involuntarySwitches = readField(task + "/status", "nonvoluntary_ctxt_switches").value_or(0);
+            stats.m_migrations = readField(task + "/sched", "se.nr_migrations").value_or(0);
+
+            // run time, the run queue wait - in nanoseconds, and the number of time slices
+            if (std::ifstream in {task + "/schedstat"}; in)
+            {
+                std::uint64_t run = 0, wait = 0, slices = 0;
+                if (in >> run >> wait >> slices)
+                {
+                    stats.m_runQueueWait = nanoseconds{wait};
+                    stats.m_timeSlices = slices;
+                }
+            }
+
+            // The last CPU: the 39th field, after the name - which may contain spaces
+            if (std::ifstream in {task + "/stat"}; in)
+            {
+                std::string stat {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+                if (const auto end = stat.rfind(')'); std::string::npos != end)
+                {
+                    std::istringstream fields {stat.substr(end + 2)};
+                    std::string field;
+                    for (int i = 3; i <= 39 && (fields >> field); ++i)
+                    {
+                        if (39 == i) stats.m_cpu = std::stoi(field);
+                    }
+                }
+            }
+
+            return stats;
+        }
+    }
+
+    /**
+     * Registry of the live threads: the ThreadWrapper threads register themselves,
+     * for the lifetime of the thread function.
+     *
+     * @code
+     * for (const auto& stats : ThreadRegistry::instance().sample())
+     * {
+     *      if (stats.realtime() && stats.m_involuntarySwitches) ...
+     * }
+     * @endcode
+     */
+    class ThreadRegistry final
+    {
+        struct Entry
+        {
+            pthread_t m_handle;
+            pid_t m_tid;
+        };
+
+        public:
+
+            static ThreadRegistry& instance()
+            {
+                static ThreadRegistry registry;//Scott Meyers singleton pattern
+                return registry;
+            }
+
+            ThreadRegistry(const ThreadRegistry&) = delete;
+            ThreadRegistry& operator=(const ThreadRegistry&) = delete;
+
+            /**
+             * RAII: within the registered thread itself
+             */
+            class Registration final
+            {
+                public:
+                    Registration() : m_registry(ThreadRegistry::instance())
+                    {
+                        std::lock_guard<std::mutex> lock {m_registry.m_lock};
+                        m_registry.m_threads.push_back({pthread_self(), static_cast<pid_t>(::syscall(SYS_gettid))});
+                    }
+
+                    ~Registration()
+                    {
+                        const auto self = pthread_self();
+
+                        std::lock_guard<std::mutex> lock {m_registry.m_lock};
+                        std::erase_if(m_registry.m_threads, [self](const auto& entry) { return pthread_equal(entry.m_handle, self); });
+                    }
+
+                    Registration(const Registration&) = delete;
+                    Registration& operator=(const Registration&) = delete;
+
+                private:
+                    ThreadRegistry& m_registry;
+            };
+
+            /**
+             * The procfs is read without the lock: the threads start and exit meanwhile,
+             * and the ones exited are left out
+             *
+             * @return The stats of all live threads
+             */
+            std::vector<ThreadStats> sample() const
+            {
+                std::vector<Entry> threads;
+                {
+                    std::lock_guard<std::mutex> lock {m_lock};
+                    threads = m_threads;
+                }
+
+                std::vector<ThreadStats> stats;
+                stats.reserve(threads.size());
+                for (const auto& entry : threads)
+                {
+                    if (auto sampled = telemetry::sample(entry.m_tid)) stats.push_back(std::move(*sampled));
+                }
+
+                return stats;
+            }
+
+            /**
+             * @param handle    The thread handle
+             * @return          The stats, if the thread is registered - and alive
+             */
+            std::optional<ThreadStats> sample(pthread_t handle) const
+            {
+                pid_t tid = 0;
+                {
+                    std::lock_guard<std::mutex> lock {m_lock};
+
+                    const auto it = std::find_if(m_threads.cbegin(), m_threads.cend(), [handle](const auto& entry) { return pthread_equal(entry.m_handle, handle); });
+                    if (it == m_threads.cend()) return std::nullopt;
+
+                    tid = it->m_tid;
+                }
+
+                return telemetry::sample(tid);
+            }
+
+            std::size_t size() const
+            {
+                std::lock_guard<std::mutex> lock {m_lock};
+                return m_threads.size();
+            }
+
+        private:
+
+            ThreadRegistry() = default;
+
+        private:
+
+            mutable std::mutex m_lock;
+            std::vector<Entry> m_threads;
+    };
+}  // namespace utils
+
+#endif /* THREAD_THREADTELEMETRY_H_ */
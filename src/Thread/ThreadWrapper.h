@@ -22,6 +22,9 @@
 #include <cstring>
 #include <functional>
 
+// Telemetry: the registry of the live threads
+#include "ThreadTelemetry.h"
+
 // JNIEnv
 #if __has_include(<jni.h>)
     #include <jni.h>
@@ -152,7 +155,8 @@ namespace utils
      * Wrapper around the std::thread implementation.
      *
      * Extended with ability to specify the thread priority (along with
-     * the scheduling policy), name and thread affinity
+     * the scheduling policy), name and thread affinity - and to report
+     * how the thread is actually doing: @see telemetry(), ThreadRegistry
      */
     class ThreadWrapper final : public std::thread
     {
@@ -162,7 +166,29 @@ namespace utils
         inline static constexpr std::size_t MAX_SIZE_BYTES = 16;  //@note linux limitation!
 
         using super = std::thread;
-        using super::super;  // use base class c-tors
+
+        ThreadWrapper() noexcept = default;
+
+        /**
+         * As std::thread: the thread is registered within ThreadRegistry,
+         * for the lifetime of the thread function
+         *
+         * @param func Thread function
+         * @param args Thread function arguments
+         */
+        template <typename Func, typename... Args>
+            requires (!std::is_same_v<std::remove_cvref_t<Func>, ThreadWrapper>
+                    && std::is_invocable_v<std::decay_t<Func>, std::decay_t<Args>...>)
+        explicit ThreadWrapper(Func&& func, Args&&... args)
+            : super(
+                [](auto&& func_, auto&&... args_)
+                {
+                    ThreadRegistry::Registration registration;
+                    std::invoke(std::move(func_), std::move(args_)...);
+                },
+                std::forward<Func>(func),
+                std::forward<Args>(args)...)
+        {}
 
         using schedule_policy_t = enum class ESchedule : int
             {
@@ -275,6 +301,14 @@ namespace utils
 
         inline std::optional<std::string> getName() { return getName(native_handle()); }
 
+        /**
+         * Sample the CPU time, the context switches, the migrations and the scheduling latency
+         * @see ThreadStats
+         *
+         * @return The stats, if the thread function is still running
+         */
+        inline std::optional<ThreadStats> telemetry() { return ThreadRegistry::instance().sample(native_handle()); }
+
         inline bool setAffinity(std::optional<int> core)
         {
             const auto num_cpus = std::thread::hardware_concurrency();
@@ -427,7 +461,7 @@ namespace utils
     template <typename... Args>
     [[maybe_unused]] auto make_thread_ptr(Args&&... args) noexcept -> thread_ptr_t
     {
-        if constexpr ((std::is_constructible_v<ThreadWrapper, Args&&> && ...))
+        if constexpr (std::is_constructible_v<ThreadWrapper, Args&&...>)
         {
             return thread_ptr_t(new (std::nothrow) ThreadWrapper(std::forward<Args>(args)...), thread_deleter_t{});
         }
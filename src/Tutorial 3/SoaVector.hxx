@@ -0,0 +1,353 @@
+/*
+ * SoaVector.hxx
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef TUPLES_SOAVECTOR_HXX_
+#define TUPLES_SOAVECTOR_HXX_
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace test::tuples
+{
+    /**
+     * Struct-of-arrays container: the fields of the record, given as the parameters pack,
+     * are kept each in its own contiguous array - std::tuple<std::vector<Fields>...>.
+     *
+     * The loops that touch only one or two fields of the wide record stream through
+     * the columns they need (@see column()), and nothing else is brought into the cache:
+     * the column scan over std::span is also the plain loop over the array, which the compiler
+     * can vectorize.
+     *
+     * The row is still there, as the tuple of references into the columns (the same way
+     * the Setter captures the fields): it can be decomposed with the structured bindings,
+     * assigned to, or given to the Setter.
+     *
+     * @code
+     * soa_vector<int, double, std::string> trades;
+     * trades.emplace_back(1, 99.5, "ABC");
+     *
+     * double sum = 0;
+     * for (auto price : trades.column<1>()) sum += price;
+     *
+     * for (auto [id, price, symbol] : trades) price *= 2; // by the references
+     * @endcode
+     *
+     * @note The row proxy is not the value: use row() for the copy.
+     *       The references (and the column spans) are invalidated the same way as for std::vector.
+     */
+    template <typename...Fields>
+    class soa_vector
+    {
+        static_assert(sizeof...(Fields) > 0, "soa_vector: at least one field");
+        static_assert((!std::is_same_v<Fields, bool> && ...), "soa_vector: std::vector<bool> is not contiguous - use char, or std::uint8_t");
+        static_assert((std::is_same_v<Fields, std::decay_t<Fields>> && ...), "soa_vector: the fields are to be the value types");
+
+        static constexpr std::size_t N = sizeof...(Fields);
+
+        template <std::size_t I>
+        using field_t = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+        // The index of the field of the given type: it is to be unique
+        template <typename T>
+        static constexpr std::size_t index_of()
+        {
+            constexpr bool matches[] = {std::is_same_v<T, Fields>...};
+
+            std::size_t index = N;
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                if (matches[i])
+                {
+                    index = i;
+                    ++count;
+                }
+            }
+            return 1 == count ? index : N;
+        }
+
+        public:
+
+            using value_type = std::tuple<Fields...>;
+            using reference = std::tuple<Fields&...>;
+            using const_reference = std::tuple<const Fields&...>;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+
+            /**
+             * Random access iterator over the rows: the position within the container.
+             * Dereferenced, it gives the row proxy (the tuple of references), by value.
+             *
+             * @note Until C++23 (the common reference of the tuples), the const_iterator
+             *       doesn't satisfy std::random_access_iterator: fine with the classic algorithms, not with std::ranges
+             */
+            template <bool Const>
+            class basic_iterator
+            {
+                using container_t = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+                public:
+
+                    using iterator_category = std::random_access_iterator_tag;
+                    using iterator_concept = std::random_access_iterator_tag;
+                    using value_type = soa_vector::value_type;
+                    using difference_type = std::ptrdiff_t;
+                    using reference = std::conditional_t<Const, soa_vector::const_reference, soa_vector::reference>;
+                    using pointer = void;
+
+                    basic_iterator() = default;
+                    basic_iterator(container_t* container, std::size_t pos) noexcept : m_container(container), m_pos(pos)
+                    {}
+
+                    // iterator -> const_iterator
+                    template <bool C = Const, typename = std::enable_if_t<C>>
+                    basic_iterator(const basic_iterator<false>& other) noexcept : m_container(other.m_container), m_pos(other.m_pos)
+                    {}
+
+                    reference operator*() const { return (*m_container)[m_pos]; }
+                    reference operator[](difference_type n) const { return (*m_container)[m_pos + n]; }
+
+                    basic_iterator& operator++() noexcept { ++m_pos; return *this; }
+                    basic_iterator operator++(int) noexcept { auto it = *this; ++m_pos; return it; }
+                    basic_iterator& operator--() noexcept { --m_pos; return *this; }
+                    basic_iterator operator--(int) noexcept { auto it = *this; --m_pos; return it; }
+
+                    basic_iterator& operator+=(difference_type n) noexcept { m_pos += n; return *this; }
+                    basic_iterator& operator-=(difference_type n) noexcept { m_pos -= n; return *this; }
+
+                    friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+                    friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+                    friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+
+                    friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs) noexcept
+                    {
+                        return static_cast<difference_type>(lhs.m_pos) - static_cast<difference_type>(rhs.m_pos);
+                    }
+
+                    friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept
+                    {
+                        return lhs.m_pos == rhs.m_pos;
+                    }
+
+                    friend auto operator<=>(const basic_iterator& lhs, const basic_iterator& rhs) noexcept
+                    {
+                        return lhs.m_pos <=> rhs.m_pos;
+                    }
+
+                    // The row index: i.e. for the column access within the loop
+                    std::size_t index() const noexcept { return m_pos; }
+
+                private:
+
+                    friend class basic_iterator<!Const>;
+
+                    container_t* m_container = nullptr;
+                    std::size_t m_pos = 0;
+            };
+
+            using iterator = basic_iterator<false>;
+            using const_iterator = basic_iterator<true>;
+
+            soa_vector() = default;
+
+            explicit soa_vector(size_type count)
+            {
+                resize(count);
+            }
+
+            // Capacity
+
+            size_type size() const noexcept { return std::get<0>(m_columns).size(); }
+            bool empty() const noexcept { return std::get<0>(m_columns).empty(); }
+            size_type capacity() const noexcept { return std::get<0>(m_columns).capacity(); }
+
+            void reserve(size_type count)
+            {
+                std::apply([count](auto&...column) { (column.reserve(count), ...); }, m_columns);
+            }
+
+            void resize(size_type count)
+            {
+                std::apply([count](auto&...column) { (column.resize(count), ...); }, m_columns);
+            }
+
+            void clear() noexcept
+            {
+                std::apply([](auto&...column) { (column.clear(), ...); }, m_columns);
+            }
+
+            void shrink_to_fit()
+            {
+                std::apply([](auto&...column) { (column.shrink_to_fit(), ...); }, m_columns);
+            }
+
+            // Modifiers
+
+            /**
+             * Append the row: each value into its own column
+             */
+            template <typename...Args, typename = std::enable_if_t<sizeof...(Args) == N &&
+                                                                   (std::is_constructible_v<Fields, Args&&> && ...)>>
+            reference emplace_back(Args&&...args)
+            {
+                emplace_back(std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+                return back();
+            }
+
+            void push_back(const value_type& row)
+            {
+                std::apply([this](const auto&...values) { emplace_back(values...); }, row);
+            }
+
+            void push_back(value_type&& row)
+            {
+                std::apply([this](auto&...values) { emplace_back(std::move(values)...); }, row);
+            }
+
+            void pop_back()
+            {
+                std::apply([](auto&...column) { (column.pop_back(), ...); }, m_columns);
+            }
+
+            /**
+             * Remove the row, by moving the last one into its place: O(1), but doesn't preserve the order
+             *
+             * @param pos   The row index
+             */
+            void swap_remove(size_type pos)
+            {
+                const auto last = size() - 1;
+                if (pos != last)
+                {
+                    std::apply([pos, last](auto&...column) { ((column[pos] = std::move(column[last])), ...); }, m_columns);
+                }
+                pop_back();
+            }
+
+            void swap(soa_vector& other) noexcept
+            {
+                m_columns.swap(other.m_columns);
+            }
+
+            // Row access: the tuple of references
+
+            reference operator[](size_type pos) noexcept
+            {
+                return row_at(pos, std::index_sequence_for<Fields...>{});
+            }
+
+            const_reference operator[](size_type pos) const noexcept
+            {
+                return row_at(pos, std::index_sequence_for<Fields...>{});
+            }
+
+            reference front() noexcept { return (*this)[0]; }
+            const_reference front() const noexcept { return (*this)[0]; }
+
+            reference back() noexcept { return (*this)[size() - 1]; }
+            const_reference back() const noexcept { return (*this)[size() - 1]; }
+
+            /**
+             * @param pos   The row index
+             * @return      The copy of the row: gathered from all columns
+             */
+            value_type row(size_type pos) const
+            {
+                return value_type{(*this)[pos]};
+            }
+
+            // Column access
+
+            template <std::size_t I>
+            std::span<field_t<I>> column() noexcept
+            {
+                static_assert(I < N, "soa_vector: the column index is out of range");
+                return std::span<field_t<I>>{std::get<I>(m_columns)};
+            }
+
+            template <std::size_t I>
+            std::span<const field_t<I>> column() const noexcept
+            {
+                static_assert(I < N, "soa_vector: the column index is out of range");
+                return std::span<const field_t<I>>{std::get<I>(m_columns)};
+            }
+
+            /**
+             * The column of the given type: the type is to be unique among the fields
+             */
+            template <typename T>
+            std::span<T> column() noexcept
+            {
+                static_assert(index_of<T>() < N, "soa_vector: no unique field of the given type - use the index");
+                return column<index_of<T>()>();
+            }
+
+            template <typename T>
+            std::span<const T> column() const noexcept
+            {
+                static_assert(index_of<T>() < N, "soa_vector: no unique field of the given type - use the index");
+                return column<index_of<T>()>();
+            }
+
+            // Iterators
+
+            iterator begin() noexcept { return iterator{this, 0}; }
+            iterator end() noexcept { return iterator{this, size()}; }
+
+            const_iterator begin() const noexcept { return const_iterator{this, 0}; }
+            const_iterator end() const noexcept { return const_iterator{this, size()}; }
+
+            const_iterator cbegin() const noexcept { return begin(); }
+            const_iterator cend() const noexcept { return end(); }
+
+        private:
+
+            template <std::size_t...I, typename...Args>
+            void emplace_back(std::index_sequence<I...>, Args&&...args)
+            {
+                // Keep the columns of the same length: roll back, if any of the constructions throws
+                std::size_t appended = 0;
+                try
+                {
+                    ((std::get<I>(m_columns).emplace_back(std::forward<Args>(args)), ++appended), ...);
+                }
+                catch (...)
+                {
+                    ((I < appended ? std::get<I>(m_columns).pop_back() : void()), ...);
+                    throw;
+                }
+            }
+
+            template <std::size_t...I>
+            reference row_at(size_type pos, std::index_sequence<I...>) noexcept
+            {
+                return reference{std::get<I>(m_columns)[pos]...};
+            }
+
+            template <std::size_t...I>
+            const_reference row_at(size_type pos, std::index_sequence<I...>) const noexcept
+            {
+                return const_reference{std::get<I>(m_columns)[pos]...};
+            }
+
+        private:
+
+            std::tuple<std::vector<Fields>...> m_columns;
+    };
+
+    template <typename...Fields>
+    void swap(soa_vector<Fields...>& lhs, soa_vector<Fields...>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif /* TUPLES_SOAVECTOR_HXX_ */
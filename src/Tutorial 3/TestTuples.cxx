@@ -9,9 +9,11 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <numeric>
 
 #include "TestTuples.hxx"
 #include "Setter.hxx"
+#include "SoaVector.hxx"
 
 
 #define CHECK_ENUM(x) case (x) : return #x
@@ -141,5 +143,50 @@ namespace test::tuples
 
         return 0;
     }
-}
 
+    int testSoaVector()
+    {
+        // The wide record: id, price, quantity, symbol
+        soa_vector<int, double, long, std::string> trades;
+        trades.reserve(4);
+
+        trades.emplace_back(1, 101.5, 100L, "ABC");
+        trades.emplace_back(2, 99.25, 250L, "XYZ");
+        trades.push_back({3, 100.0, 50L, "ABC"});
+
+        std::cout << "\nColumn scan:\n\n";
+
+        // Only the price and the quantity columns are touched
+        const auto prices = trades.column<1>();
+        const auto quantities = trades.column<long>();
+        const double notional = std::transform_reduce(prices.begin(), prices.end(), quantities.begin(), 0.0);
+
+        std::cout << "notional=" << notional << '\n';
+
+        std::cout << "\nRows, by the references:\n\n";
+
+        for (auto [id, price, quantity, symbol] : trades)
+        {
+            if ("ABC" == symbol) price *= 1.01;
+            std::cout << "id=" << id << ", price=" << price << ", quantity=" << quantity << ", symbol=" << symbol << '\n';
+        }
+
+        std::cout << "\nUniversal setter, over the row:\n\n";
+
+        {
+            auto row = trades[1];
+            Setter<int, double, long, std::string> setter {row};
+            setter.set<1>(98.75)
+              .set<3>("XYZ.N")
+              ;
+
+            setter.print2Console();
+        }
+
+        trades.swap_remove(0);
+        const auto [id, price, quantity, symbol] = trades.row(0);
+        std::cout << "\nAfter swap_remove: size=" << trades.size() << ", first id=" << id << ", symbol=" << symbol << '\n';
+
+        return 0;
+    }
+}
@@ -12,6 +12,7 @@
 namespace test::tuples
 {
     int testTuples();
+    int testSoaVector();
 }
 
 
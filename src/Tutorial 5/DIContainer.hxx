@@ -9,31 +9,50 @@
 #define DI_DICONTAINER_HXX_
 
 // std library
-#include <any>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <queue>
+#include <thread>
 #include <typeinfo>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 // Application
 #include "DIFactory.hxx"
 
 namespace utils::di
 {
+    /**
+     * The services the implementation depends on: injected through its constructor,
+     * as the leading arguments - the shared instances (std::shared_ptr<Dependency>)
+     *
+     * diContainer->add<Client, ClientImpl>(depends_on<Service1, Service2>{}, args...);
+     */
+    template <typename...Dependencies>
+    struct depends_on {};
+
     /**
      * IOC implementation
      * <p>
      * DI container as injector. It holds:
      * - dependency objects (services) in case that they will be shared between clients
      * - factories, in case that the client will rather holds the new instance of the dependency
+     * <p>
+     * The shared instance is created lazily - on the first request, once per service, thread-safe:
+     * after that, it's only the atomic load. Or eagerly, in parallel: @see DIContainer#warmup
+     *
+     * @note The services are to be added at startup: before being requested
      */
     class DIContainer final
     {
         public:
 
-            using factories_map = std::unordered_map<std::type_index, std::any>;
-            using instances_map = std::unordered_map<std::type_index, std::any>;
-
             ~DIContainer() = default;
 
             DIContainer(const DIContainer&) = delete;
@@ -66,6 +85,15 @@ namespace utils::di
             template <typename DIService, typename DIServiceImpl, typename...Args>
             void add(Args&&...args);
 
+            /**
+             * The same, with the service implementation depending on the other services:
+             * resolved from the container, and passed the first to the service implementation c-tor
+             *
+             * @tparam Dependencies     The services interfaces
+             */
+            template <typename DIService, typename DIServiceImpl, typename...Dependencies, typename...Args>
+            void add(depends_on<Dependencies...>, Args&&...args);
+
             /**
              * Client must not be aware of the service implementation.
              * Therefore, at client side, the concrete service implementation will be retrieved,
@@ -79,35 +107,186 @@ namespace utils::di
             template <typename DIService>
             std::optional<std::shared_ptr<DIService>> get(bool shared);
 
+            /**
+             * Create all the shared instances, in the order of their dependencies:
+             * the ones independent of each other - in parallel, on the given executor
+             *
+             * @param executor  The execution context: post(job) - e.g. utils::aot::ThreadPool.
+             *                  The caller creates the services as well, so it may be one of its workers
+             * @throws std::runtime_error - if the dependency is not registered, or they are cyclic;
+             *         or the first exception thrown by the service constructor
+             */
+            template <typename Executor>
+            void warmup(Executor& executor);
+
         private:
             DIContainer() = default;
 
+            /**
+             * Type-erased service: the factory, and the shared instance - created once
+             */
+            struct IService
+            {
+                virtual ~IService() = default;
+                virtual void create() = 0;
+
+                std::vector<std::type_index> m_dependencies;
+            };
+
+            template <typename DIService>
+            class Service;
+
+            template <typename DIService>
+            void add(std::vector<std::type_index> dependencies, std::unique_ptr<IFactory<DIService>> factory);
+
+            template <typename DIService>
+            std::shared_ptr<DIService> resolve();
+
         private:
-            factories_map m_diFactories;
-            instances_map m_diServices;
+            using services_map = std::unordered_map<std::type_index, std::unique_ptr<IService>>;
+
+            services_map m_diServices;
     };
 
 
-    template <typename DIService, typename DIServiceImpl, typename...Args>
-    inline void DIContainer::add(Args&&...args)
+    template <typename DIService>
+    class DIContainer::Service final : public IService
+    {
+        public:
+
+            explicit Service(std::unique_ptr<IFactory<DIService>> factory) noexcept : m_factory(std::move(factory))
+            {}
+
+            // When new instance is required
+            IFactory<DIService>& factory() noexcept
+            {
+                return *m_factory;
+            }
+
+            // When shared instance is required: created on the first request
+            const std::shared_ptr<DIService>& instance()
+            {
+                if (!m_created.load(std::memory_order_acquire)) create();
+                return m_instance;
+            }
+
+            void create() override
+            {
+                // Created meanwhile by this thread is the cycle: A -> B -> A
+                if (m_creator.load(std::memory_order_relaxed) == std::this_thread::get_id())
+                {
+                    throw std::runtime_error("DI: Cyclic service dependencies!");
+                }
+
+                std::lock_guard<std::mutex> lock {m_lock};
+                if (m_created.load(std::memory_order_relaxed)) return;
+
+                m_creator.store(std::this_thread::get_id(), std::memory_order_relaxed);
+                try
+                {
+                    m_instance = std::shared_ptr<DIService>(m_factory->create());
+                }
+                catch (...)
+                {
+                    m_creator.store({}, std::memory_order_relaxed);
+                    throw; // retried on the next request
+                }
+                m_creator.store({}, std::memory_order_relaxed);
+                m_created.store(true, std::memory_order_release);
+            }
+
+        private:
+            std::unique_ptr<IFactory<DIService>> m_factory;
+            std::shared_ptr<DIService> m_instance;
+            std::atomic<bool> m_created {false};
+            std::atomic<std::thread::id> m_creator {};
+            std::mutex m_lock;
+    };
+
+
+    namespace details
+    {
+        /**
+         * The factory of the service implementation, with the dependencies
+         * resolved on each creation: @see DIFactory
+         */
+        template <typename DIServiceInterface, typename DIService, typename Resolver, typename...Args>
+        class DependentFactory final : public IFactory<DIServiceInterface>
+        {
+            static_assert(std::is_base_of_v<DIServiceInterface, DIService>, "DI: Invalid service implementation!");
+
+            public:
+
+                explicit DependentFactory(Resolver resolver, Args&&...args) :
+                    m_resolver(std::move(resolver))
+                    , m_args(std::make_tuple(std::forward<Args>(args)...))
+                {}
+
+                std::unique_ptr<DIServiceInterface> create() override
+                {
+                    return std::apply(
+                        [this](auto&&...args)
+                        {
+                            return std::apply([&args...](auto&&...dependencies)
+                            {
+                                return factory<DIService>(std::move(dependencies)..., args...);
+                            }, m_resolver());
+                        }
+                        , m_args);
+                }
+
+            private:
+                Resolver m_resolver; // -> std::tuple<std::shared_ptr<Dependencies>...>
+                std::tuple<std::decay_t<Args>...> m_args;
+        };
+    }
+
+
+    template <typename DIService>
+    inline void DIContainer::add(std::vector<std::type_index> dependencies, std::unique_ptr<IFactory<DIService>> factory)
     {
         using namespace std;
 
         const auto id = type_index(typeid(DIService));
 
-        const auto it = m_diFactories.find(id);
-        if (it != m_diFactories.end()) throw std::runtime_error("DI: Service factory already specified!");
+        const auto it = m_diServices.find(id);
+        if (it != m_diServices.end()) throw std::runtime_error("DI: Service factory already specified!");
 
-        auto factory = make_factory<DIService, DIServiceImpl>(std::forward<Args>(args)...);
         if (!factory) throw std::runtime_error("DI: Service factory not created!");
 
-        // Save instance - when shared instance is required
+        auto service = make_unique<Service<DIService>>(std::move(factory));
+        service->m_dependencies = std::move(dependencies);
+        m_diServices.emplace(id, std::move(service));
+    }
 
-        m_diServices[id] = std::any(std::shared_ptr<DIService>(factory->create()));
 
-        // Save service factory - when new instance is required
+    template <typename DIService, typename DIServiceImpl, typename...Args>
+    inline void DIContainer::add(Args&&...args)
+    {
+        add<DIService>({}, make_factory<DIService, DIServiceImpl>(std::forward<Args>(args)...));
+    }
 
-        m_diFactories[id] = std::any(std::shared_ptr<IFactory<DIService>>(std::move(factory)));
+
+    template <typename DIService, typename DIServiceImpl, typename...Dependencies, typename...Args>
+    inline void DIContainer::add(depends_on<Dependencies...>, Args&&...args)
+    {
+        using namespace std;
+
+        auto resolver = [this] { return make_tuple(resolve<Dependencies>()...); };
+        using factory_t = details::DependentFactory<DIService, DIServiceImpl, decltype(resolver), Args...>;
+
+        add<DIService>({type_index(typeid(Dependencies))...},
+                       unique_ptr<IFactory<DIService>>(new (nothrow) factory_t(std::move(resolver), std::forward<Args>(args)...)));
+    }
+
+
+    template <typename DIService>
+    inline std::shared_ptr<DIService> DIContainer::resolve()
+    {
+        const auto it = m_diServices.find(std::type_index(typeid(DIService)));
+        if (it == m_diServices.end()) throw std::runtime_error("DI: Service dependency not found!");
+
+        return static_cast<Service<DIService>&>(*it->second).instance();
     }
 
 
@@ -119,35 +298,178 @@ namespace utils::di
         // C++ "reflection": Service interface as key to find the associated implementation
         const auto id = type_index(typeid(DIService));
 
+        const auto it = m_diServices.find(id);
+        if (it == m_diServices.end())
+        {
+            cerr << (shared ? "DI: Service implementation not found!\n" : "DI: Service factory not found!\n");
+            return nullopt;
+        }
+
+        // The type is given by the key
+        auto& service = static_cast<Service<DIService>&>(*it->second);
+
         /*
          * If the shared instance of the service implementation is required,
-         * grab from the container the matching one
+         * grab from the container the matching one - created on the first request
          */
-        if (shared)
+        if (shared) return service.instance();
+
+        // Otherwise, return the new instance of the service implementation
+
+        return service.factory().create();
+    }
+
+
+    template <typename Executor>
+    inline void DIContainer::warmup(Executor& executor)
+    {
+        using namespace std;
+
+        if (m_diServices.empty()) return;
+
+        // The graph: the services depending on each one, and the number of its dependencies not created yet
+        struct Node
+        {
+            IService* m_service = nullptr;
+            vector<size_t> m_dependents;
+            atomic<size_t> m_pending {0};
+        };
+
+        // Shared with the jobs posted: the ones started late, after the caller is done, find nothing left
+        struct State
+        {
+            explicit State(size_t size) : m_nodes(size), m_left(size) {}
+
+            vector<Node> m_nodes;
+            mutex m_lock;
+            condition_variable m_changed;
+            queue<size_t> m_ready; // the services with all dependencies created
+            size_t m_left;
+            exception_ptr m_error;
+        };
+
+        const auto state = make_shared<State>(m_diServices.size());
+        auto& nodes = state->m_nodes;
+        unordered_map<type_index, size_t> indices;
+        for (auto& [id, service] : m_diServices)
         {
-            if (const auto it = m_diServices.find(id); it != m_diServices.end())
+            nodes[indices.size()].m_service = service.get();
+            indices.emplace(id, indices.size());
+        }
+
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            for (const auto& dependency : nodes[i].m_service->m_dependencies)
+            {
+                const auto it = indices.find(dependency);
+                if (it == indices.end()) throw std::runtime_error("DI: Service dependency not found!");
+
+                nodes[it->second].m_dependents.push_back(i);
+                nodes[i].m_pending.fetch_add(1, memory_order_relaxed);
+            }
+        }
+
+        // Topological order: all the services are reached, unless there is the cycle
+        {
+            vector<size_t> pending (nodes.size());
+            queue<size_t> ready;
+            for (size_t i = 0; i < nodes.size(); ++i)
             {
-                return std::any_cast<std::shared_ptr<DIService>>(it->second);
+                pending[i] = nodes[i].m_pending.load(memory_order_relaxed);
+                if (0 == pending[i]) ready.push(i);
             }
-            else
+
+            size_t reached = 0;
+            for (; !ready.empty(); ready.pop(), ++reached)
             {
-                cerr << "DI: Service implementation not found!\n";
-                return nullopt;
+                for (const auto dependent : nodes[ready.front()].m_dependents)
+                {
+                    if (0 == --pending[dependent]) ready.push(dependent);
+                }
             }
+            if (reached != nodes.size()) throw std::runtime_error("DI: Cyclic service dependencies!");
         }
 
-        // Otherwise, return the new instance of the service implementation
+        // Each one is queued once its dependencies are created, and the job posted for it.
+        // The caller takes them as well: so that it completes even if called from within the executor itself
+        struct Jobs
+        {
+            static optional<size_t> pop(State& state)
+            {
+                lock_guard<mutex> guard {state.m_lock};
+                if (state.m_ready.empty()) return nullopt;
+
+                const auto i = state.m_ready.front();
+                state.m_ready.pop();
+                return i;
+            }
 
-        if (const auto it = m_diFactories.find(id); it != m_diFactories.end())
+            static void post(Executor& executor, const shared_ptr<State>& state, size_t count)
+            {
+                for (size_t n = 0; n < count; ++n)
+                {
+                    executor.post([&executor, state]
+                    {
+                        if (const auto i = pop(*state)) build(executor, state, *i);
+                    });
+                }
+            }
+
+            static void build(Executor& executor, const shared_ptr<State>& state, size_t i)
+            {
+                try
+                {
+                    state->m_nodes[i].m_service->create();
+                }
+                catch (...)
+                {
+                    lock_guard<mutex> guard {state->m_lock};
+                    if (!state->m_error) state->m_error = current_exception();
+                }
+
+                size_t ready = 0;
+                {
+                    lock_guard<mutex> guard {state->m_lock};
+                    for (const auto dependent : state->m_nodes[i].m_dependents)
+                    {
+                        if (1 == state->m_nodes[dependent].m_pending.fetch_sub(1, memory_order_acq_rel))
+                        {
+                            state->m_ready.push(dependent);
+                            ++ready;
+                        }
+                    }
+                }
+                post(executor, state, ready); // before being counted: the caller is still there
+
+                lock_guard<mutex> guard {state->m_lock};
+                --state->m_left;
+                state->m_changed.notify_all();
+            }
+        };
+
+        size_t ready = 0;
+        for (size_t i = 0; i < nodes.size(); ++i)
         {
-            const auto& factory = std::any_cast<const std::shared_ptr<IFactory<DIService>>&>(it->second);
-            return factory->create();
+            if (0 == nodes[i].m_pending.load(memory_order_relaxed))
+            {
+                state->m_ready.push(i);
+                ++ready;
+            }
         }
-        else
+        Jobs::post(executor, state, ready);
+
+        for (;;)
         {
-            cerr << "DI: Service factory not found!\n";
-            return nullopt;
+            {
+                unique_lock<mutex> guard {state->m_lock};
+                state->m_changed.wait(guard, [&state] { return !state->m_ready.empty() || 0 == state->m_left; });
+                if (0 == state->m_left) break;
+            }
+
+            if (const auto i = Jobs::pop(*state)) Jobs::build(executor, state, *i);
         }
+
+        if (state->m_error) rethrow_exception(state->m_error);
     }
 }
 
@@ -0,0 +1,181 @@
+/*
+ * DIRegistry.hxx
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef DI_DIREGISTRY_HXX_
+#define DI_DIREGISTRY_HXX_
+
+// std library
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <vector>
+
+// Application
+#include "DIFactory.hxx"
+
+namespace utils::di
+{
+    namespace details
+    {
+        /**
+         * The dense index of the service type: assigned once, on the first use - the same in all the registries
+         */
+        class ServiceIndex final
+        {
+            public:
+
+                template <typename DIService>
+                static std::size_t of() noexcept
+                {
+                    static const std::size_t index = s_next.fetch_add(1, std::memory_order_relaxed);
+                    return index;
+                }
+
+            private:
+
+                static inline std::atomic<std::size_t> s_next {0};
+        };
+    }
+
+    /**
+     * DI container as the registry of the slots, indexed by the service type: @see DIContainer
+     * <p>
+     * The lookup is the array load - instead of hashing the std::type_index, and casting the std::any.
+     * Once all the services are added (at startup), the registry can be frozen: from then on, it's read-only,
+     * and the lookup is lock-free. Before that, the lookup is synchronized with the services being added.
+     */
+    class DIRegistry final
+    {
+        public:
+
+            ~DIRegistry() = default;
+
+            DIRegistry(const DIRegistry&) = delete;
+            DIRegistry& operator=(const DIRegistry&) = delete;
+
+            /**
+             * DI registry will be created through this gateway
+             *
+             * @return The reference to the DI registry
+             */
+            static std::unique_ptr<DIRegistry> make_di_registry()
+            {
+                return std::unique_ptr<DIRegistry>(new (std::nothrow) DIRegistry());
+            }
+
+            /**
+             * @see DIContainer::add
+             * @throws std::runtime_error - if once frozen
+             */
+            template <typename DIService, typename DIServiceImpl, typename...Args>
+            void add(Args&&...args);
+
+            /**
+             * @see DIContainer::get
+             */
+            template <typename DIService>
+            std::optional<std::shared_ptr<DIService>> get(bool shared) const;
+
+            /**
+             * No more services are to be added: the lookup goes lock-free.
+             * Taken under the lock, so that an add() already in progress completes first
+             */
+            void freeze()
+            {
+                std::unique_lock lock {m_lock};
+                m_frozen.store(true, std::memory_order_release);
+            }
+
+            bool frozen() const noexcept
+            {
+                return m_frozen.load(std::memory_order_acquire);
+            }
+
+        private:
+            DIRegistry() = default;
+
+            /**
+             * Type-erased: the index tells the type
+             */
+            struct Slot
+            {
+                std::shared_ptr<void> m_instance;   // DIService
+                std::shared_ptr<void> m_factory;    // IFactory<DIService>
+            };
+
+            template <typename DIService>
+            std::optional<std::shared_ptr<DIService>> lookup(bool shared) const;
+
+        private:
+            std::vector<Slot> m_slots;
+            std::atomic<bool> m_frozen {false};
+            mutable std::shared_mutex m_lock;
+    };
+
+
+    template <typename DIService, typename DIServiceImpl, typename...Args>
+    inline void DIRegistry::add(Args&&...args)
+    {
+        using namespace std;
+
+        const auto index = details::ServiceIndex::of<DIService>();
+
+        auto factory = make_factory<DIService, DIServiceImpl>(std::forward<Args>(args)...);
+        if (!factory) throw std::runtime_error("DI: Service factory not created!");
+
+        std::shared_ptr<DIService> instance (factory->create());
+
+        unique_lock lock {m_lock};
+        if (frozen()) throw std::runtime_error("DI: Registry frozen!");
+
+        if (index >= m_slots.size()) m_slots.resize(index + 1);
+
+        auto& slot = m_slots[index];
+        if (slot.m_factory) throw std::runtime_error("DI: Service factory already specified!");
+
+        slot.m_instance = std::move(instance);
+        slot.m_factory = std::shared_ptr<IFactory<DIService>>(std::move(factory));
+    }
+
+
+    template <typename DIService>
+    inline std::optional<std::shared_ptr<DIService>> DIRegistry::get(bool shared) const
+    {
+        if (frozen()) return lookup<DIService>(shared);
+
+        std::shared_lock lock {m_lock};
+        return lookup<DIService>(shared);
+    }
+
+
+    template <typename DIService>
+    inline std::optional<std::shared_ptr<DIService>> DIRegistry::lookup(bool shared) const
+    {
+        using namespace std;
+
+        const auto index = details::ServiceIndex::of<DIService>();
+        const Slot* const slot = (index < m_slots.size()) ? &m_slots[index] : nullptr;
+
+        if (!slot || !slot->m_factory)
+        {
+            cerr << (shared ? "DI: Service implementation not found!\n" : "DI: Service factory not found!\n");
+            return nullopt;
+        }
+
+        // Shared instance: the owner is the same, the pointer is the one of the matching type
+        if (shared) return std::shared_ptr<DIService>(slot->m_instance, static_cast<DIService*>(slot->m_instance.get()));
+
+        return static_cast<IFactory<DIService>*>(slot->m_factory.get())->create();
+    }
+}
+
+
+#endif /* DI_DIREGISTRY_HXX_ */
@@ -79,6 +79,42 @@ namespace test::di
     };
 
 
+    struct Service3
+    {
+         virtual ~Service3() = default;
+         virtual void route(const std::string& destination) = 0;
+        protected:
+         Service3() = default;
+    };
+
+
+    /**
+     * Depends on the other services: injected through the c-tor
+     */
+    class NavigatorService final : public Service3
+    {
+        public:
+            NavigatorService(std::shared_ptr<Service1> console, std::shared_ptr<Service2> locator, float zoom) noexcept :
+                m_console(std::move(console))
+                , m_locator(std::move(locator))
+                , m_zoom(zoom)
+            {}
+
+            ~NavigatorService() override = default;
+
+            void route(const std::string& destination) override
+            {
+                m_console->provide("Routing to: " + destination);
+                m_locator->coordinate(m_zoom * 10.f, m_zoom * 20.f);
+            }
+
+        private:
+            std::shared_ptr<Service1> m_console;
+            std::shared_ptr<Service2> m_locator;
+            float m_zoom;
+    };
+
+
     class Client2
     {
         public:
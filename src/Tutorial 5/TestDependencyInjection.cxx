@@ -5,7 +5,14 @@
  *  Author: <a href="mailto:damirlj@yahoo.com">Damir Ljubic</a>
  */
 
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../AOT/ThreadPool.h"
+
 #include "DIContainer.hxx"
+#include "DIRegistry.hxx"
 #include "TestCases.hxx"
 #include "ClientWithVariant.hxx"
 #include "TestDependencyInjection.hxx"
@@ -64,4 +71,119 @@ namespace test::di
 
         return 0;
     }
+
+    int testDIRegistry()
+    {
+        using namespace std;
+        using namespace utils::di;
+
+        auto diRegistry = DIRegistry::make_di_registry();
+        auto diContainer = DIContainer::make_di_container();
+        if (!diRegistry || !diContainer) return 1;
+
+        try
+        {
+            // The same API as the container
+            diRegistry->add<Service1, ConsoleService>();
+            diRegistry->add<Service2, LocatorService>(std::string("GNSS"));
+            diContainer->add<Service2, LocatorService>(std::string("GNSS"));
+        }
+        catch(const exception& e)
+        {
+            cerr << e.what() << '\n'; // unit test
+            return 2;
+        }
+
+        // Startup is over: lock-free from now on
+        diRegistry->freeze();
+        try
+        {
+            diRegistry->add<Service1, ConsoleService>();
+            return 3;
+        }
+        catch(const exception& e)
+        {
+            cout << e.what() << '\n'; // expected
+        }
+
+        const auto service1 = diRegistry->get<Service1>(true);
+        Client1 client1(service1.has_value() ? *service1 : nullptr);
+        client1("Alex");
+
+        const auto service2 = diRegistry->get<Service2>(false);
+        Client2 client2;
+        client2.setService(service2.has_value() ? *service2 : nullptr);
+        client2(283.37f, 112.11f);
+
+        // The lookup on the request path: the shared instance
+        const auto measure = [](auto& di)
+        {
+            constexpr int lookups = 1'000'000;
+
+            std::size_t found = 0;
+            const auto start = chrono::steady_clock::now();
+            for (int i = 0; i < lookups; ++i) found += di.template get<Service2>(true).has_value();
+            const chrono::duration<double, std::nano> elapsed = chrono::steady_clock::now() - start;
+
+            return (found == lookups) ? elapsed.count() / lookups : -1.0;
+        };
+
+        cout << "lookup: container " << measure(*diContainer) << " ns, registry " << measure(*diRegistry) << " ns\n";
+
+        return 0;
+    }
+
+    int testDIWarmup()
+    {
+        using namespace std;
+        using namespace utils::di;
+
+        // Lazy: the first ones requesting it concurrently - created once
+        {
+            auto diContainer = DIContainer::make_di_container();
+            if (!diContainer) return 1;
+            diContainer->add<Service2, LocatorService>(std::string("GNSS"));
+
+            vector<shared_ptr<Service2>> services (4);
+            {
+                vector<jthread> clients;
+                for (auto& service : services)
+                {
+                    clients.emplace_back([&diContainer, &service] { service = diContainer->get<Service2>(true).value_or(nullptr); });
+                }
+            }
+
+            for (const auto& service : services)
+            {
+                if (!service || service != services.front()) return 2;
+            }
+        }
+
+        // Eager: in the order of the dependencies - the independent ones in parallel
+        auto diContainer = DIContainer::make_di_container();
+        if (!diContainer) return 1;
+
+        utils::aot::ThreadPool pool {2};
+        if (!pool.start()) return 3;
+
+        try
+        {
+            diContainer->add<Service3, NavigatorService>(depends_on<Service1, Service2>{}, 1.5f);
+            diContainer->add<Service1, ConsoleService>();
+            diContainer->add<Service2, LocatorService>(std::string("GNSS"));
+
+            diContainer->warmup(pool);
+        }
+        catch(const exception& e)
+        {
+            cerr << e.what() << '\n'; // unit test
+            return 4;
+        }
+
+        const auto navigator = diContainer->get<Service3>(true);
+        if (!navigator || !*navigator) return 5;
+        (*navigator)->route("Belgrade");
+
+        return 0;
+    }
 }
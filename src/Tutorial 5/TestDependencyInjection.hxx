@@ -20,6 +20,18 @@ namespace test::di
      * @return Error indication, 0 - on success
      */
     int testDI();
+
+    /**
+     * The registry of the slots: @see DIRegistry
+     * @return Error indication, 0 - on success
+     */
+    int testDIRegistry();
+
+    /**
+     * The shared instances: created lazily, or eagerly - in parallel
+     * @return Error indication, 0 - on success
+     */
+    int testDIWarmup();
 }
 
 
@@ -10,6 +10,8 @@
 
 #include <mutex>
 
+#include "LockStats.h"
+
 namespace utils::locking
 {
     /**
@@ -50,6 +52,7 @@ namespace utils::locking
                     }
 
                     lock_type& locker() { return m_mutex; }
+                    LockStats& stats() { return m_stats; }
 
                     Initializer(const Initializer&) = delete;
                     Initializer& operator=(const Initializer&) = delete;
@@ -61,6 +64,7 @@ namespace utils::locking
                     Initializer() = default;
                 private:
                     mutable lock_type m_mutex;
+                    LockStats m_stats;
             };
 
         public:
@@ -82,7 +86,7 @@ namespace utils::locking
                     Lock()
                     {
                         auto& initializer = Initializer::get();
-                        initializer.locker().lock();
+                        initializer.stats().lock(initializer.locker());
                     }
 
                     /**
@@ -99,6 +103,9 @@ namespace utils::locking
                         initializer.locker().unlock();
                     }
             };//Lock
+
+            // @see LockStats: empty, unless LOCKING_ENABLE_STATS is defined
+            static LockStatsSnapshot stats() noexcept { return Initializer::get().stats().snapshot(); }
     };//
 }//namespace
 
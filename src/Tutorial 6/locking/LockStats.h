@@ -0,0 +1,128 @@
+/*
+ * LockStats.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef LOCKING_LOCKSTATS_H_
+#define LOCKING_LOCKSTATS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace utils::locking
+{
+    /**
+     * The lock usage, for choosing the locking policy from the data:
+     * - acquisitions:  all of them
+     * - contended:     the ones that had to wait (the lock was taken), or retry - @see SeqLock
+     * - waited:        the time spent waiting on those
+     */
+    struct LockStatsSnapshot
+    {
+        std::uint64_t m_acquisitions = 0;
+        std::uint64_t m_contended = 0;
+        std::chrono::nanoseconds m_waited {0};
+
+        double contention() const noexcept
+        {
+            return m_acquisitions ? static_cast<double>(m_contended) / m_acquisitions : 0.0;
+        }
+
+        LockStatsSnapshot& operator += (const LockStatsSnapshot& other) noexcept
+        {
+            m_acquisitions += other.m_acquisitions;
+            m_contended += other.m_contended;
+            m_waited += other.m_waited;
+            return *this;
+        }
+    };
+
+    /**
+     * Instrumentation is opt-in: build with LOCKING_ENABLE_STATS defined, to enable it.
+     * Otherwise, the lock is taken directly - and the snapshot is empty.
+     *
+     * The uncontended acquisition costs the try-lock only, the contended one is timed.
+     */
+#if defined(LOCKING_ENABLE_STATS)
+    class LockStats final
+    {
+        public:
+
+            template <typename Mutex>
+            void lock(Mutex& mutex)
+            {
+                if (mutex.try_lock()) return record(false, {});
+
+                const auto start = clock_t::now();
+                mutex.lock();
+                record(true, clock_t::now() - start);
+            }
+
+            template <typename Mutex>
+            void lock_shared(Mutex& mutex)
+            {
+                if (mutex.try_lock_shared()) return record(false, {});
+
+                const auto start = clock_t::now();
+                mutex.lock_shared();
+                record(true, clock_t::now() - start);
+            }
+
+            void record(bool contended, std::chrono::nanoseconds waited) noexcept
+            {
+                m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+                if (!contended) return;
+
+                m_contended.fetch_add(1, std::memory_order_relaxed);
+                m_waited.fetch_add(static_cast<std::uint64_t>(waited.count()), std::memory_order_relaxed);
+            }
+
+            LockStatsSnapshot snapshot() const noexcept
+            {
+                return {m_acquisitions.load(std::memory_order_relaxed),
+                        m_contended.load(std::memory_order_relaxed),
+                        std::chrono::nanoseconds{m_waited.load(std::memory_order_relaxed)}};
+            }
+
+            static constexpr bool enabled = true;
+
+        private:
+            using clock_t = std::chrono::steady_clock;
+
+            std::atomic<std::uint64_t> m_acquisitions {0};
+            std::atomic<std::uint64_t> m_contended {0};
+            std::atomic<std::uint64_t> m_waited {0}; // nanoseconds
+    };
+#else
+    class LockStats final
+    {
+        public:
+
+            template <typename Mutex>
+            void lock(Mutex& mutex)
+            {
+                mutex.lock();
+            }
+
+            template <typename Mutex>
+            void lock_shared(Mutex& mutex)
+            {
+                mutex.lock_shared();
+            }
+
+            void record(bool, std::chrono::nanoseconds) noexcept
+            {}
+
+            LockStatsSnapshot snapshot() const noexcept
+            {
+                return {};
+            }
+
+            static constexpr bool enabled = false;
+    };
+#endif
+}
+
+#endif /* LOCKING_LOCKSTATS_H_ */
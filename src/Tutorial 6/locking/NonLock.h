@@ -8,6 +8,8 @@
 #ifndef AIRPLAYSERVICE_NONLOCK_H
 #define AIRPLAYSERVICE_NONLOCK_H
 
+#include "LockStats.h"
+
 namespace utils::locking
 {
     /**
@@ -23,6 +25,9 @@ namespace utils::locking
                 explicit Lock(const NonLock& ){}
                 ~Lock() = default;
             };
+
+            // Nothing to measure
+            LockStatsSnapshot stats() const noexcept { return {}; }
     };
 }
 #endif //AIRPLAYSERVICE_NONLOCK_H
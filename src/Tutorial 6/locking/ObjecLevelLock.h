@@ -10,6 +10,8 @@
 
 #include <mutex>
 
+#include "LockStats.h"
+
 namespace utils::locking
 {
     /**
@@ -65,7 +67,7 @@ namespace utils::locking
                      */
                     explicit Lock(const ObjectLevelLock& lock) noexcept: m_objectLock(lock)
                     {
-                        m_objectLock.m_lock.lock();
+                        m_objectLock.m_stats.lock(m_objectLock.m_lock);
                     }
                     ~Lock()
                     {
@@ -74,8 +76,13 @@ namespace utils::locking
             private:
                 const ObjectLevelLock& m_objectLock;
         };
+
+            // @see LockStats: empty, unless LOCKING_ENABLE_STATS is defined
+            LockStatsSnapshot stats() const noexcept { return m_stats.snapshot(); }
+
         private:
             mutable lock_type m_lock;
+            mutable LockStats m_stats;
 
    };
 }
@@ -0,0 +1,188 @@
+/*
+ * SeqLock.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef LOCKING_SEQLOCK_H_
+#define LOCKING_SEQLOCK_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "LockStats.h"
+#include "SpinLock.h"
+
+namespace utils::locking
+{
+    /**
+     * Policy-based design.
+     * Sequence lock, over the small trivially copyable state: the readers never block the writer,
+     * nor each other - they copy the state out, and retry if it was written meanwhile.
+     * The writers are serialized (spin mutex), and mark the state being written by the odd sequence.
+     *
+     * The state is kept as the atomic words (relaxed), so that the torn read is not the data race.
+     *
+     * usage:
+     * template <typename LockingPolicy>
+     * class Host : private LockingPolicy // SeqLock<Position>
+     * {
+     *      public:
+     *             Position get() const { return this->load(); }
+     *             void move(int dx)
+     *             {
+     *                  this->update([dx](Position& position) { position.x += dx; });
+     *             }
+     * };
+     *
+     * @tparam State    The state: copied on each read - the few words
+     */
+    template <typename State>
+    class SeqLock
+    {
+        static_assert(std::is_trivially_copyable_v<State>, "SeqLock: the state is to be trivially copyable");
+
+        public:
+
+            SeqLock() noexcept : SeqLock(State{})
+            {}
+
+            explicit SeqLock(const State& state) noexcept
+            {
+                write(state);
+            }
+
+            ~SeqLock() = default;
+
+            SeqLock(const SeqLock&) = delete;
+            SeqLock& operator=(const SeqLock& ) = delete;
+
+            /**
+             * The writer: exclusive, the state is written by write() meanwhile
+             */
+            class Lock final
+            {
+                public:
+                    explicit Lock(SeqLock& lock) noexcept : m_seqLock(lock)
+                    {
+                        m_seqLock.m_writeStats.lock(m_seqLock.m_writer);
+
+                        // Odd: being written - the stores of the state are not to be reordered before
+                        m_seqLock.m_sequence.store(m_seqLock.m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                        std::atomic_thread_fence(std::memory_order_release);
+                    }
+
+                    ~Lock()
+                    {
+                        m_seqLock.m_sequence.store(m_seqLock.m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+                        m_seqLock.m_writer.unlock();
+                    }
+
+                    Lock(const Lock&) = delete;
+                    Lock& operator=(const Lock&) = delete;
+
+                private:
+                    SeqLock& m_seqLock;
+            };
+
+            /**
+             * @return The consistent copy of the state
+             */
+            State load() const noexcept
+            {
+                std::array<std::uint64_t, words> copy;
+                std::chrono::steady_clock::time_point start {};
+
+                for (bool retried = false; ; retried = true)
+                {
+                    const auto before = m_sequence.load(std::memory_order_acquire);
+                    if (0 == (before & 1))
+                    {
+                        for (std::size_t i = 0; i < words; ++i) copy[i] = m_state[i].load(std::memory_order_relaxed);
+
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        if (before == m_sequence.load(std::memory_order_relaxed))
+                        {
+                            m_readStats.record(retried, retried ? std::chrono::steady_clock::now() - start : std::chrono::nanoseconds{});
+                            break;
+                        }
+                    }
+
+                    if (LockStats::enabled && !retried) start = std::chrono::steady_clock::now();
+                    cpu_relax();
+                }
+
+                State state;
+                std::memcpy(static_cast<void*>(&state), copy.data(), sizeof(State));
+                return state;
+            }
+
+            /**
+             * @param state The new state
+             */
+            void store(const State& state) noexcept
+            {
+                Lock lock {*this};
+                write(state);
+            }
+
+            /**
+             * Read-modify-write
+             * @param func  The callable: with the State&
+             */
+            template <typename Func>
+            void update(Func&& func)
+            {
+                Lock lock {*this};
+
+                auto state = read();
+                func(state);
+                write(state);
+            }
+
+            LockStatsSnapshot readStats() const noexcept { return m_readStats.snapshot(); }
+            LockStatsSnapshot writeStats() const noexcept { return m_writeStats.snapshot(); }
+
+            LockStatsSnapshot stats() const noexcept
+            {
+                auto stats = readStats();
+                return stats += writeStats();
+            }
+
+        protected:
+
+            // Under the Lock: the state as is
+            State read() const noexcept
+            {
+                std::array<std::uint64_t, words> copy;
+                for (std::size_t i = 0; i < words; ++i) copy[i] = m_state[i].load(std::memory_order_relaxed);
+
+                State state;
+                std::memcpy(static_cast<void*>(&state), copy.data(), sizeof(State));
+                return state;
+            }
+
+            // Under the Lock
+            void write(const State& state) noexcept
+            {
+                std::array<std::uint64_t, words> copy {};
+                std::memcpy(copy.data(), &state, sizeof(State));
+                for (std::size_t i = 0; i < words; ++i) m_state[i].store(copy[i], std::memory_order_relaxed);
+            }
+
+        private:
+            static constexpr std::size_t words = (sizeof(State) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+            std::array<std::atomic<std::uint64_t>, words> m_state {};
+            std::atomic<std::uint64_t> m_sequence {0};
+            TTASMutex m_writer;
+            mutable LockStats m_readStats;
+            LockStats m_writeStats;
+    };
+}
+
+#endif /* LOCKING_SEQLOCK_H_ */
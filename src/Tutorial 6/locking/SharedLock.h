@@ -0,0 +1,108 @@
+/*
+ * SharedLock.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef LOCKING_SHAREDLOCK_H_
+#define LOCKING_SHAREDLOCK_H_
+
+#include <shared_mutex>
+
+#include "LockStats.h"
+
+namespace utils::locking
+{
+    /**
+     * Policy-based design.
+     * Object level reader-writer locking: for the read-mostly host classes.
+     * The readers share the lock, the writer holds it exclusively.
+     *
+     * usage:
+     * template <typename LockingPolicy>
+     * class Host : private LockingPolicy
+     * {
+     *      public:
+     *             std::string get() const
+     *             {
+     *                  typename LockingPolicy::ReadLock lock{*this};
+     *                  ...
+     *             }
+     *             void set(...)
+     *             {
+     *                  typename LockingPolicy::WriteLock lock{*this}; // or Lock: as with other policies
+     *                  ...
+     *             }
+     * };
+     */
+    class SharedLock
+    {
+        public:
+            using lock_type = std::shared_mutex;
+
+            SharedLock() = default;
+            ~SharedLock() = default;
+
+            SharedLock(const SharedLock&) = delete;
+            SharedLock& operator=(const SharedLock& ) = delete;
+
+            class ReadLock final
+            {
+                public:
+                    explicit ReadLock(const SharedLock& lock) : m_sharedLock(lock)
+                    {
+                        m_sharedLock.m_readStats.lock_shared(m_sharedLock.m_lock);
+                    }
+
+                    ~ReadLock()
+                    {
+                        m_sharedLock.m_lock.unlock_shared();
+                    }
+
+                    ReadLock(const ReadLock&) = delete;
+                    ReadLock& operator=(const ReadLock&) = delete;
+
+                private:
+                    const SharedLock& m_sharedLock;
+            };
+
+            class WriteLock final
+            {
+                public:
+                    explicit WriteLock(const SharedLock& lock) : m_sharedLock(lock)
+                    {
+                        m_sharedLock.m_writeStats.lock(m_sharedLock.m_lock);
+                    }
+
+                    ~WriteLock()
+                    {
+                        m_sharedLock.m_lock.unlock();
+                    }
+
+                    WriteLock(const WriteLock&) = delete;
+                    WriteLock& operator=(const WriteLock&) = delete;
+
+                private:
+                    const SharedLock& m_sharedLock;
+            };
+
+            // The common interface of the locking policies: exclusive
+            using Lock = WriteLock;
+
+            LockStatsSnapshot readStats() const noexcept { return m_readStats.snapshot(); }
+            LockStatsSnapshot writeStats() const noexcept { return m_writeStats.snapshot(); }
+
+            LockStatsSnapshot stats() const noexcept
+            {
+                auto stats = readStats();
+                return stats += writeStats();
+            }
+
+        private:
+            mutable lock_type m_lock;
+            mutable LockStats m_readStats;
+            mutable LockStats m_writeStats;
+    };
+}
+
+#endif /* LOCKING_SHAREDLOCK_H_ */
@@ -0,0 +1,106 @@
+/*
+ * SpinLock.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef LOCKING_SPINLOCK_H_
+#define LOCKING_SPINLOCK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "LockStats.h"
+#include "../../commons/WaitStrategy.h"
+
+namespace utils::locking
+{
+    /**
+     * Test and test-and-set spin mutex: while taken, the waiting threads spin on the load (the cache line is
+     * shared) - not on the exchange, bouncing the line between the cores. After the given number of spins,
+     * the time slice is given up: not to burn the CPU the lock holder may be waiting for (hybrid).
+     *
+     * For the critical sections of the nanoseconds: otherwise, parking the thread is cheaper.
+     */
+    class TTASMutex final
+    {
+        public:
+
+            explicit TTASMutex(std::uint32_t spins = 1024) noexcept : m_spins(spins)
+            {}
+
+            TTASMutex(const TTASMutex&) = delete;
+            TTASMutex& operator=(const TTASMutex&) = delete;
+
+            void lock() noexcept
+            {
+                for (std::uint32_t i = 0; !try_lock(); )
+                {
+                    while (m_locked.load(std::memory_order_relaxed))
+                    {
+                        if (++i < m_spins) cpu_relax();
+                        else std::this_thread::yield();
+                    }
+                }
+            }
+
+            bool try_lock() noexcept
+            {
+                return !m_locked.load(std::memory_order_relaxed) && !m_locked.exchange(true, std::memory_order_acquire);
+            }
+
+            void unlock() noexcept
+            {
+                m_locked.store(false, std::memory_order_release);
+            }
+
+        private:
+            std::atomic<bool> m_locked {false};
+            const std::uint32_t m_spins;
+    };
+
+    /**
+     * Policy-based design.
+     * Object level locking, with the spin mutex: @see ObjectLevelLock, TTASMutex
+     */
+    class SpinLock
+    {
+        public:
+            using lock_type = TTASMutex;
+
+            SpinLock() = default;
+            ~SpinLock() = default;
+
+            SpinLock(const SpinLock&) = delete;
+            SpinLock& operator=(const SpinLock& ) = delete;
+
+            class Lock final
+            {
+                public:
+                    explicit Lock(const SpinLock& lock) noexcept : m_spinLock(lock)
+                    {
+                        m_spinLock.m_stats.lock(m_spinLock.m_lock);
+                    }
+
+                    ~Lock()
+                    {
+                        m_spinLock.m_lock.unlock();
+                    }
+
+                    Lock(const Lock&) = delete;
+                    Lock& operator=(const Lock&) = delete;
+
+                private:
+                    const SpinLock& m_spinLock;
+            };
+
+            LockStatsSnapshot stats() const noexcept { return m_stats.snapshot(); }
+
+        private:
+            mutable lock_type m_lock;
+            mutable LockStats m_stats;
+    };
+}
+
+#endif /* LOCKING_SPINLOCK_H_ */
@@ -0,0 +1,167 @@
+/*
+ * StripedLock.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef LOCKING_STRIPEDLOCK_H_
+#define LOCKING_STRIPEDLOCK_H_
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "../../commons/Hash.h"
+#include "LockStats.h"
+
+namespace utils::locking
+{
+    /**
+     * Policy-based design.
+     * Striped class-level lock: instead of the single mutex shared by all instances (@see ClassLevelLock),
+     * the fixed number of them - each on its own cache line. The instance is mapped to one of them by its address
+     * (or by the caller-given key): the unrelated instances rarely serialize, and the host stays the same.
+     *
+     * usage:
+     *
+     * template <typename LockingPolicy>
+     * class Host : private LockingPolicy
+     * {
+     *      public:
+     *              void f()
+     *              {
+     *                 typename LockingPolicy::Lock lock{*this}; // the stripe of this instance
+     *                 ...
+     *              }
+     *
+     *              static void g()
+     *              {
+     *                 typename LockingPolicy::AllLock lock{};   // all instances: the rare global section
+     *                 ...
+     *              }
+     * };
+     *
+     * @note Don't take the AllLock while holding the Lock: it takes all the stripes, in order
+     * @tparam Stripes  How many stripes the instances are spread over
+     */
+    template <std::size_t Stripes = 16>
+    class StripedLock
+    {
+        static_assert(Stripes > 1 && std::has_single_bit(Stripes), "StripedLock: the number of stripes is to be a power of two");
+
+        private:
+
+            class Initializer
+            {
+                public:
+
+                    using lock_type = std::mutex;
+
+                    struct alignas(64) Stripe
+                    {
+                        lock_type m_mutex;
+                        LockStats m_stats;
+                    };
+
+                    static Initializer& get()
+                    {
+                        static Initializer initializer;
+                        return initializer;
+                    }
+
+                    Stripe& stripe(std::size_t index) { return m_stripes[index]; }
+                    std::array<Stripe, Stripes>& stripes() { return m_stripes; }
+
+                    Initializer(const Initializer&) = delete;
+                    Initializer& operator=(const Initializer&) = delete;
+
+                    Initializer(Initializer&& ) = delete;
+                    Initializer& operator=(Initializer&&) = delete;
+
+                private:
+                    Initializer() = default;
+                private:
+                    std::array<Stripe, Stripes> m_stripes;
+            };
+
+            static std::size_t index(std::uint64_t key) noexcept
+            {
+                return fibonacci_index<Stripes>(key);
+            }
+
+        public:
+
+            static constexpr std::size_t stripes = Stripes;
+
+            /**
+             * The common interface for all locking policies: @see ClassLevelLock::Lock
+             */
+            class Lock final
+            {
+                public:
+
+                    // The objects are aligned: the lowest bits carry no information
+                    explicit Lock(const StripedLock& host) : Lock(index(reinterpret_cast<std::uintptr_t>(&host) >> 4), 0)
+                    {}
+
+                    /**
+                     * @param key   The caller-given key: e.g. the id of the instances to be serialized together
+                     */
+                    explicit Lock(std::size_t key) : Lock(index(key), 0)
+                    {}
+
+                    ~Lock()
+                    {
+                        m_stripe.m_mutex.unlock();
+                    }
+
+                    Lock(const Lock&) = delete;
+                    Lock& operator=(const Lock&) = delete;
+
+                private:
+
+                    Lock(std::size_t index, int) : m_stripe(Initializer::get().stripe(index))
+                    {
+                        m_stripe.m_stats.lock(m_stripe.m_mutex);
+                    }
+
+                private:
+                    typename Initializer::Stripe& m_stripe;
+            };//Lock
+
+            /**
+             * All the stripes: for the sections over all instances
+             */
+            class AllLock final
+            {
+                public:
+                    AllLock()
+                    {
+                        for (auto& stripe : Initializer::get().stripes()) stripe.m_stats.lock(stripe.m_mutex);
+                    }
+
+                    explicit AllLock(const StripedLock& ) : AllLock()
+                    {}
+
+                    ~AllLock()
+                    {
+                        for (auto& stripe : Initializer::get().stripes()) stripe.m_mutex.unlock();
+                    }
+
+                    AllLock(const AllLock&) = delete;
+                    AllLock& operator=(const AllLock&) = delete;
+            };//AllLock
+
+            // @see LockStats: empty, unless LOCKING_ENABLE_STATS is defined
+            static LockStatsSnapshot stats() noexcept
+            {
+                LockStatsSnapshot stats {};
+                for (auto& stripe : Initializer::get().stripes()) stats += stripe.m_stats.snapshot();
+                return stats;
+            }
+    };//
+}//namespace
+
+#endif /* LOCKING_STRIPEDLOCK_H_ */
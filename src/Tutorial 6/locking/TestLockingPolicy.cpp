@@ -18,6 +18,10 @@
 #include "NonLock.h"
 #include "ObjecLevelLock.h"
 #include "ClassLevelLock.h"
+#include "SharedLock.h"
+#include "SpinLock.h"
+#include "SeqLock.h"
+#include "StripedLock.h"
 
 
 #include "TestLockingPolicy.h"
@@ -198,6 +202,229 @@ namespace
 }
 
 
+/**
+ * The read-mostly host: the readers share the lock,
+ * if the policy has one (ReadLock) - otherwise, the exclusive one
+ *
+ * @tparam LockingPolicy
+ */
+template <class LockingPolicy>
+class Settings : private LockingPolicy
+{
+    public:
+
+        std::size_t get() const
+        {
+            if constexpr (requires { typename LockingPolicy::ReadLock; })
+            {
+                typename LockingPolicy::ReadLock lock {*this};
+                return m_value;
+            }
+            else
+            {
+                typename LockingPolicy::Lock lock {*this};
+                return m_value;
+            }
+        }
+
+        void set(std::size_t value)
+        {
+            typename LockingPolicy::Lock lock {*this};
+            m_value = value;
+        }
+
+        using LockingPolicy::stats;
+
+    private:
+        std::size_t m_value = 0;
+};
+
+/**
+ * The small state, read by many: sequence lock
+ */
+struct Position
+{
+    double m_x = 0.0;
+    double m_y = 0.0;
+    double m_z = 0.0;
+};
+
+class Tracker : private utils::locking::SeqLock<Position>
+{
+    public:
+
+        Position get() const { return this->load(); }
+
+        void move(double dx)
+        {
+            // The invariant: all the coordinates are the same
+            this->update([dx](Position& position){ position.m_x += dx; position.m_y += dx; position.m_z += dx; });
+        }
+
+        using SeqLock::readStats;
+        using SeqLock::writeStats;
+};
+
+
+namespace
+{
+    std::ostream& operator << (std::ostream& out, const utils::locking::LockStatsSnapshot& stats)
+    {
+        return out << "acquisitions: " << stats.m_acquisitions
+                   << ", contended: " << stats.m_contended << " (" << stats.contention() * 100 << "%)"
+                   << ", waited: " << std::chrono::duration_cast<std::chrono::microseconds>(stats.m_waited).count() << "us";
+    }
+
+    /**
+     * Read-mostly workload: one write per the given number of reads.
+     * Compare the policies by the time - and the contention stats (build with LOCKING_ENABLE_STATS)
+     */
+    template <class LockingPolicy>
+    void testReadMostly(const char* name, std::size_t readsPerWrite = 100)
+    {
+        using namespace std;
+
+        Settings<LockingPolicy> settings;
+
+        vector<thread> threads;
+        constexpr size_t numOfThreads = 4;
+        constexpr size_t numOfOps = 100'000;
+
+        const auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < numOfThreads; ++i)
+        {
+            threads.emplace_back(
+                    [&settings, readsPerWrite]
+                    {
+                        size_t sum = 0;
+                        for (size_t j = 0; j < numOfOps; ++j)
+                        {
+                            if (0 == j % readsPerWrite) settings.set(j);
+                            else sum += settings.get();
+                        }
+                        if (sum == 1) cout << '\n'; // keep the reads
+                    }
+            );
+        }
+
+        std::for_each(threads.begin(), threads.end(), [](auto& thread){
+            thread.join();
+        });
+
+        const auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+        cout << name << ": " << elapsed.count() << "ms, " << settings.stats() << '\n';
+    }
+
+    void testReadMostlyPolicies()
+    {
+        using namespace utils::locking;
+
+        testReadMostly<ObjectLevelLock>("ObjectLevelLock");
+        testReadMostly<SharedLock>("SharedLock");
+        testReadMostly<SpinLock>("SpinLock");
+    }
+
+    /**
+     * Many instances, each thread with its own ones: the class-level lock serializes them all,
+     * the striped one - only those on the same stripe
+     */
+    template <class LockingPolicy>
+    void testManyObjects(const char* name)
+    {
+        using namespace std;
+
+        constexpr size_t numOfThreads = 4;
+        constexpr size_t numOfObjects = 64;
+        constexpr size_t numOfOps = 100'000;
+
+        vector<Settings<LockingPolicy>> settings(numOfObjects);
+        vector<thread> threads;
+
+        const auto before = settings.front().stats();
+        const auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < numOfThreads; ++i)
+        {
+            threads.emplace_back(
+                    [&settings, i]
+                    {
+                        for (size_t j = 0; j < numOfOps; ++j)
+                        {
+                            auto& object = settings[(j * numOfThreads + i) % numOfObjects];
+                            object.set(object.get() + 1);
+                        }
+                    }
+            );
+        }
+
+        std::for_each(threads.begin(), threads.end(), [](auto& thread){
+            thread.join();
+        });
+
+        const auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+        auto stats = settings.front().stats();
+        stats.m_acquisitions -= before.m_acquisitions;
+        stats.m_contended -= before.m_contended;
+        stats.m_waited -= before.m_waited;
+        cout << name << ": " << elapsed.count() << "ms, " << stats << '\n';
+    }
+
+    void testStripedLock()
+    {
+        using namespace utils::locking;
+
+        testManyObjects<ClassLevelLock>("ClassLevelLock");
+        testManyObjects<StripedLock<16>>("StripedLock<16>");
+
+        {
+            StripedLock<16>::AllLock lock {}; // the global section: none of the instances is used meanwhile
+            std::cout << "StripedLock<16>: all " << StripedLock<16>::stripes << " stripes locked\n";
+        }
+    }
+
+    /**
+     * Sequence lock: the readers never see the torn state
+     *
+     * @return Indication whether none of the reads was torn
+     */
+    bool testSeqLock()
+    {
+        using namespace std;
+
+        Tracker tracker;
+        atomic<bool> done = false;
+        atomic<size_t> torn = 0;
+
+        vector<thread> readers;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            readers.emplace_back(
+                    [&]
+                    {
+                        while (!done.load(memory_order_relaxed))
+                        {
+                            const auto position = tracker.get();
+                            if (position.m_x != position.m_y || position.m_y != position.m_z) ++torn;
+                        }
+                    }
+            );
+        }
+
+        for (size_t j = 0; j < 100'000; ++j) tracker.move(1.0);
+        done = true;
+
+        std::for_each(readers.begin(), readers.end(), [](auto& thread){
+            thread.join();
+        });
+
+        cout << "SeqLock: x = " << tracker.get().m_x << ", torn reads: " << torn << '\n';
+        cout << "    reads - " << tracker.readStats() << '\n';
+        cout << "    writes - " << tracker.writeStats() << '\n';
+
+        return 0 == torn;
+    }
+}
+
+
 namespace utils::locking
 {
     /*
@@ -212,7 +439,9 @@ namespace utils::locking
     {
         testClassLevelLock();
         //testObjectLevelLock();
+        testReadMostlyPolicies();
+        testStripedLock();
 
-        return 0;
+        return testSeqLock() ? 0 : 1;
     }
 }
@@ -17,6 +17,10 @@
 #include <initializer_list>
 #include <memory>
 #include <algorithm>
+#include <vector>
+
+#include "../../commons/TypePartitioned.h"
+#include "../../AOT/ThreadPool.h"
 
 
 
@@ -78,5 +82,29 @@ namespace test::ep
 
         return 0;
     }
-}
 
+    int testPartitioned()
+    {
+        std::vector<Type1> types1 (8);
+        std::vector<Type2> types2 (8, Type2{"Alex", 7});
+        for (std::size_t i = 0; i < types1.size(); ++i) types1[i] = Type1{static_cast<int>(i)};
+
+        /*
+         * Grouped by the wrapper type: calling log() on the concrete (final) one,
+         * instead of through the Logging interface - the compiler devirtualizes it
+         */
+        utils::TypePartitioned<LoggingImpl<Type1, ConsoleLogger>, LoggingImpl<Type2, ConsoleLogger>> loggers;
+        for (const auto& type : types1) loggers.emplace<LoggingImpl<Type1, ConsoleLogger>>(type, logger);
+        for (const auto& type : types2) loggers.emplace<LoggingImpl<Type2, ConsoleLogger>>(type, logger);
+
+        loggers.for_each([](const auto& typeLogger) { typeLogger.log(); });
+
+        // The partitions in parallel: the logger is synchronized
+        utils::aot::ThreadPool pool {1};
+        if (!pool.start()) return 1;
+
+        loggers.for_each(pool, [](const auto& typeLogger) { typeLogger.log(); });
+
+        return 0;
+    }
+}
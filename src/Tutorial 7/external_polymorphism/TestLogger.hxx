@@ -11,6 +11,9 @@
 namespace test::ep
 {
     int test();
+
+    // Grouped by the type: @see utils::TypePartitioned
+    int testPartitioned();
 }
 
 
@@ -0,0 +1,195 @@
+/*
+ * SboVehicle.hxx
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef TUTORIAL_TYPE_ERASURE_TYPE_ERASURE_SBOVEHICLE_HXX_
+#define TUTORIAL_TYPE_ERASURE_TYPE_ERASURE_SBOVEHICLE_HXX_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "DrivingType.hxx"
+
+namespace test::erasure
+{
+    /**
+     * The same as Vehicle, with the value semantics of the built-in types:
+     * - the erased object is stored within the enclosing one (small buffer), rather than on the heap:
+     *   the containers of the vehicles are contiguous
+     * - the behavior is dispatched through the table of the function pointers - one per erased type,
+     *   built at compile time: instead of the inheritance (no VehicleConcept, no virtual clone)
+     * - copying constructs the erased object in place, moving doesn't allocate either
+     *
+     * The types that don't fit (or are not nothrow-movable) are still supported: held on the heap,
+     * moved by taking over the pointer.
+     *
+     * @tparam Capacity     The small buffer size
+     * @tparam Alignment    The small buffer alignment
+     */
+    template <std::size_t Capacity = 64, std::size_t Alignment = alignof(std::max_align_t)>
+    class SboVehicle final
+    {
+        private:
+
+            /**
+             * Set of behavioral affordances: the manually built vtable
+             */
+            struct VTable
+            {
+                bool inlined;                                       // or the pointer to the object on the heap
+                void (*drive)(const void* self, drive_type type);
+                void (*configure)(void* self);
+                void (*copy)(void* to, const void* from);           // constructs into the raw buffer
+                void (*move)(void* to, void* from) noexcept;        // the same, leaving "from" to be destroyed
+                void (*destroy)(void* self) noexcept;
+            };
+
+            /**
+             * The erased type and its configurator: @see Vehicle::VehicleConceptImpl
+             */
+            template <typename VehicleType, typename Configurator>
+            struct Model
+            {
+                VehicleType m_vehicle;
+                Configurator m_configurator;
+            };
+
+            template <typename T>
+            static constexpr bool fits = sizeof(T) <= Capacity && alignof(T) <= Alignment && std::is_nothrow_move_constructible_v<T>;
+
+            // In place: the buffer is the object
+            template <typename T>
+            static constexpr VTable inlineTable {
+                true,
+                [](const void* self, drive_type type) { static_cast<const T*>(self)->m_vehicle.drive(type); },
+                [](void* self) { auto* model = static_cast<T*>(self); model->m_configurator(model->m_vehicle); },
+                [](void* to, const void* from) { ::new (to) T(*static_cast<const T*>(from)); },
+                [](void* to, void* from) noexcept { ::new (to) T(std::move(*static_cast<T*>(from))); },
+                [](void* self) noexcept { std::destroy_at(static_cast<T*>(self)); }
+            };
+
+            // On the heap: the buffer holds the pointer to the object
+            template <typename T>
+            static constexpr VTable heapTable {
+                false,
+                [](const void* self, drive_type type) { (*static_cast<T* const*>(self))->m_vehicle.drive(type); },
+                [](void* self) { auto* model = *static_cast<T**>(self); model->m_configurator(model->m_vehicle); },
+                [](void* to, const void* from) { ::new (to) T*(new T(**static_cast<T* const*>(from))); },
+                [](void* to, void* from) noexcept { ::new (to) T*(std::exchange(*static_cast<T**>(from), nullptr)); },
+                [](void* self) noexcept { delete *static_cast<T**>(self); }
+            };
+
+        public:
+
+            static_assert(Capacity >= sizeof(void*) && Alignment >= alignof(void*), "SboVehicle: the buffer is to hold the pointer at least");
+
+            // Templated c-tor of enclosing class as customization point
+
+            template <typename VehicleType, typename Configurator>
+            SboVehicle(VehicleType&& vehicle, Configurator&& configurator)
+            {
+                using model_t = Model<std::decay_t<VehicleType>, std::decay_t<Configurator>>;
+
+                if constexpr (fits<model_t>)
+                {
+                    ::new (m_buffer) model_t{std::forward<VehicleType>(vehicle), std::forward<Configurator>(configurator)};
+                    m_vtable = &inlineTable<model_t>;
+                }
+                else
+                {
+                    ::new (m_buffer) model_t*(new model_t{std::forward<VehicleType>(vehicle), std::forward<Configurator>(configurator)});
+                    m_vtable = &heapTable<model_t>;
+                }
+            }
+
+            ~SboVehicle()
+            {
+                reset();
+            }
+
+            // For supporting value semantics: no clone, the erased object is copied in place
+
+            SboVehicle(const SboVehicle& other)
+            {
+                if (!other.m_vtable) return;
+
+                other.m_vtable->copy(m_buffer, other.m_buffer);
+                m_vtable = other.m_vtable; // once copied: the copy may throw
+            }
+
+            SboVehicle& operator = (const SboVehicle& other)
+            {
+                if (this != &other)
+                {
+                    SboVehicle copy {other}; // strong guarantee: the copy may throw
+                    *this = std::move(copy);
+                }
+                return *this;
+            }
+
+            SboVehicle(SboVehicle&& other) noexcept : m_vtable(other.m_vtable)
+            {
+                if (m_vtable) moveFrom(other);
+            }
+
+            SboVehicle& operator = (SboVehicle&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    m_vtable = other.m_vtable;
+                    if (m_vtable) moveFrom(other);
+                }
+                return *this;
+            }
+
+            // Non-virtual interface of the enclosing class
+
+            void drive(drive_type type) const
+            {
+                if (m_vtable) m_vtable->drive(m_buffer, type);
+            }
+
+            void configure()
+            {
+                if (m_vtable) m_vtable->configure(m_buffer);
+            }
+
+            // Indication whether the erased object is stored within
+            bool isInline() const noexcept
+            {
+                return m_vtable && m_vtable->inlined;
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return m_vtable != nullptr;
+            }
+
+        private:
+
+            // The moved-from one is left empty
+            void moveFrom(SboVehicle& other) noexcept
+            {
+                m_vtable->move(m_buffer, other.m_buffer);
+                other.reset();
+            }
+
+            void reset() noexcept
+            {
+                if (m_vtable) std::exchange(m_vtable, nullptr)->destroy(m_buffer);
+            }
+
+        private:
+            alignas(Alignment) std::byte m_buffer[Capacity];
+            const VTable* m_vtable = nullptr;
+    };
+}
+
+
+#endif /* TUTORIAL_TYPE_ERASURE_TYPE_ERASURE_SBOVEHICLE_HXX_ */
@@ -10,8 +10,11 @@
 #include <iostream>
 #include <initializer_list>
 #include <algorithm>
+#include <vector>
 
 #include "Vehicle.hxx"
+#include "SboVehicle.hxx"
+#include "../../commons/TypePartitioned.h"
 #include "Car.hxx"
 #include "Truck.hxx"
 
@@ -42,4 +45,54 @@ namespace test::erasure
 
         return 0;
     }
+
+    int testSbo()
+    {
+        // Fits both: the Car with its configurator (two strings) is the larger one
+        using vehicle_t = SboVehicle<80>;
+
+        std::vector<vehicle_t> vehicles;
+        vehicles.reserve(4);
+        vehicles.emplace_back(Car{"Audi", "A3985"}, Configurator<Car>{});
+        vehicles.emplace_back(Truck{"MQB_3273", 37}, Configurator<Truck>{});
+
+        // Contiguous, and copied without allocating: in place
+        auto copies = vehicles;
+        for (auto& vehicle : copies)
+        {
+            if (!vehicle.isInline()) return 1;
+
+            vehicle.configure();
+            vehicle.drive(drive_type::eco);
+        }
+
+        // The buffer too small: on the heap, moved by taking over the pointer
+        SboVehicle<16> large {Car{"Audi", "A3985"}, Configurator<Car>{}};
+        auto moved = std::move(large);
+        if (moved.isInline() || large || !moved) return 2;
+        moved.drive(drive_type::sport);
+
+        std::cout << "sizeof(SboVehicle<80>)= " << sizeof(vehicle_t) << ", sizeof(Vehicle)= " << sizeof(Vehicle) << '\n';
+
+        return 0;
+    }
+
+    int testPartitioned()
+    {
+        // Grouped by the concrete type: no erasure, the loop per type
+        utils::TypePartitioned<Car, Truck> vehicles;
+        vehicles.emplace<Car>("Audi", "A3985");
+        vehicles.emplace<Truck>("MQB_3273", 37);
+        vehicles.emplace<Car>("Skoda", "Octavia");
+
+        if (vehicles.size() != 3 || vehicles.partition<Car>().size() != 2) return 1;
+
+        vehicles.for_each([](auto& vehicle)
+        {
+            Configurator<std::decay_t<decltype(vehicle)>>{}(vehicle);
+            vehicle.drive(drive_type::sport);
+        });
+
+        return 0;
+    }
 }
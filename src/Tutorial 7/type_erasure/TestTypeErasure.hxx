@@ -11,6 +11,12 @@
 namespace test::erasure
 {
     int test();
+
+    // The small buffer: @see SboVehicle
+    int testSbo();
+
+    // Grouped by the type: @see utils::TypePartitioned
+    int testPartitioned();
 }
 
 
@@ -0,0 +1,386 @@
+/*
+ * AllocationPolicy.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef COMMONS_ALLOCATIONPOLICY_H_
+#define COMMONS_ALLOCATIONPOLICY_H_
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "FramePool.h"
+
+namespace utils
+{
+    /**
+     * The allocation policies for the short-lived objects, off the general-purpose heap:
+     *
+     * - arena:     monotonic - carved off the caller-provided buffer, released all at once (@see FrameArena)
+     * - pool:      the size classes, with the thread-local free lists (@see FramePool)
+     * - inline:    the small buffer, for the single object - within the owner itself
+     *
+     * Each comes in two flavors: as the storage - constructing the object (allocate<T>(args...), deallocate(ptr)),
+     * and as the standard allocator - providing the memory for the given type (Allocator<T>).
+     * Once the arena (inline buffer) is exhausted, the memory is taken from the heap.
+     */
+
+    /**
+     * The inline buffer of the single object at a time
+     */
+    class InlineStore
+    {
+        public:
+
+            InlineStore(const InlineStore&) = delete;
+            InlineStore& operator = (const InlineStore&) = delete;
+
+            /**
+             * @return The buffer, or nullptr - if too small, or already taken
+             */
+            void* allocate(std::size_t size, std::size_t alignment) noexcept
+            {
+                if (m_used || size > m_capacity || alignment > alignof(std::max_align_t)) return nullptr;
+
+                m_used = true;
+                return m_data;
+            }
+
+            bool owns(const void* p) const noexcept
+            {
+                return p == m_data;
+            }
+
+            void release() noexcept
+            {
+                m_used = false;
+            }
+
+        protected:
+
+            InlineStore(std::byte* data, std::size_t capacity) noexcept : m_data(data), m_capacity(capacity)
+            {}
+
+            ~InlineStore() = default;
+
+        private:
+
+            std::byte* const m_data;
+            const std::size_t m_capacity;
+            bool m_used = false;
+    };
+
+    template <std::size_t Capacity>
+    class InlineBuffer final : public InlineStore
+    {
+        public:
+
+            InlineBuffer() noexcept : InlineStore(m_buffer, Capacity)
+            {}
+
+        private:
+
+            alignas(std::max_align_t) std::byte m_buffer[Capacity];
+    };
+
+    /**
+     * The arena the storage created meanwhile allocates from, on the calling thread: e.g. per request
+     *
+     * @code
+     * FrameArena arena {buffer};
+     * ArenaScope scope {arena};
+     * Observer<Person, ArenaStorage> observer {...};
+     * @endcode
+     */
+    class ArenaScope final
+    {
+        public:
+
+            explicit ArenaScope(FrameArena& arena) noexcept : m_previous(std::exchange(t_current, &arena))
+            {}
+
+            ~ArenaScope()
+            {
+                t_current = m_previous;
+            }
+
+            ArenaScope(const ArenaScope&) = delete;
+            ArenaScope& operator = (const ArenaScope&) = delete;
+
+            static FrameArena* current() noexcept
+            {
+                return t_current;
+            }
+
+        private:
+
+            FrameArena* const m_previous;
+            static inline thread_local FrameArena* t_current = nullptr;
+    };
+
+    namespace details
+    {
+        // The address the object is allocated at: the polymorphic one may be given back through its base
+        template <typename T>
+        void* allocated(T* ptr) noexcept
+        {
+            if constexpr (std::is_polymorphic_v<T>) return const_cast<void*>(dynamic_cast<const volatile void*>(ptr));
+            else return const_cast<void*>(static_cast<const volatile void*>(ptr));
+        }
+
+        template <typename T, typename...Args>
+        T* construct(void* p, auto&& release, Args&&...args)
+        {
+            try
+            {
+                return ::new (p) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                release(p);
+                throw;
+            }
+        }
+    }
+
+    // Storages
+
+    /**
+     * The arena, if given (or scoped: @see ArenaScope) - otherwise, the heap.
+     * Freeing only counts down the objects alive: the memory is reused once the arena is reset
+     */
+    class ArenaStorage final
+    {
+        public:
+
+            ArenaStorage() noexcept : m_arena(ArenaScope::current())
+            {}
+
+            explicit ArenaStorage(FrameArena& arena) noexcept : m_arena(&arena)
+            {}
+
+            template <typename T, typename...Args>
+            T* allocate(Args&&...args)
+            {
+                static_assert(alignof(T) <= FrameArena::alignment, "ArenaStorage: over-aligned type");
+
+                void* p = m_arena ? m_arena->allocate(sizeof(T)) : nullptr;
+                if (!p) p = ::operator new(sizeof(T));
+                return details::construct<T>(p, [this](void* memory) { release(memory); }, std::forward<Args>(args)...);
+            }
+
+            template <typename T>
+            void deallocate(T* ptr) noexcept
+            {
+                if (!ptr) return;
+
+                void* const p = details::allocated(ptr);
+                std::destroy_at(ptr);
+                release(p);
+            }
+
+        private:
+
+            void release(void* p) noexcept
+            {
+                if (m_arena && m_arena->owns(p)) m_arena->deallocate(p, 0);
+                else ::operator delete(p);
+            }
+
+        private:
+
+            FrameArena* m_arena;
+    };
+
+    /**
+     * The thread-local pool of the size classes: the block is prefixed by its size,
+     * since the object may be given back through its base
+     */
+    struct PoolStorage
+    {
+        template <typename T, typename...Args>
+        T* allocate(Args&&...args)
+        {
+            static_assert(alignof(T) <= header, "PoolStorage: over-aligned type");
+
+            auto* const block = static_cast<std::byte*>(FramePool::allocate(sizeof(T) + header));
+            const std::size_t size = sizeof(T);
+            std::memcpy(block, &size, sizeof size);
+
+            return details::construct<T>(block + header, [](void* memory) { release(memory); }, std::forward<Args>(args)...);
+        }
+
+        template <typename T>
+        void deallocate(T* ptr) noexcept
+        {
+            if (!ptr) return;
+
+            void* const p = details::allocated(ptr);
+            std::destroy_at(ptr);
+            release(p);
+        }
+
+    private:
+
+        static constexpr std::size_t header = __STDCPP_DEFAULT_NEW_ALIGNMENT__; // keeps the object aligned
+
+        static void release(void* p) noexcept
+        {
+            auto* const block = static_cast<std::byte*>(p) - header;
+
+            std::size_t size = 0;
+            std::memcpy(&size, block, sizeof size);
+            FramePool::deallocate(block, size + header);
+        }
+    };
+
+    /**
+     * The single object within the owner itself, if it fits - otherwise, on the heap.
+     * Not copyable: the object is not handed over, but created anew (cloned) by the other owner
+     */
+    template <std::size_t Capacity, std::size_t Alignment = alignof(std::max_align_t)>
+    class InlineStorage final
+    {
+        static_assert(Alignment <= alignof(std::max_align_t), "InlineStorage: over-aligned buffer");
+
+        public:
+
+            InlineStorage() = default;
+
+            template <typename T, typename...Args>
+            T* allocate(Args&&...args)
+            {
+                void* p = (alignof(T) <= Alignment) ? m_buffer.allocate(sizeof(T), alignof(T)) : nullptr;
+                if (!p) p = ::operator new(sizeof(T));
+                return details::construct<T>(p, [this](void* memory) { release(memory); }, std::forward<Args>(args)...);
+            }
+
+            template <typename T>
+            void deallocate(T* ptr) noexcept
+            {
+                if (!ptr) return;
+
+                void* const p = details::allocated(ptr);
+                std::destroy_at(ptr);
+                release(p);
+            }
+
+        private:
+
+            void release(void* p) noexcept
+            {
+                if (m_buffer.owns(p)) m_buffer.release();
+                else ::operator delete(p);
+            }
+
+        private:
+
+            InlineBuffer<Capacity> m_buffer;
+    };
+
+    // Allocators
+
+    template <typename T>
+    struct ArenaAllocator
+    {
+        using value_type = T;
+
+        explicit ArenaAllocator(FrameArena& arena) noexcept : m_arena(&arena)
+        {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.m_arena)
+        {}
+
+        T* allocate(std::size_t n)
+        {
+            void* p = m_arena->allocate(n * sizeof(T));
+            return static_cast<T*>(p ? p : ::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            if (m_arena->owns(p)) m_arena->deallocate(p, n * sizeof(T));
+            else ::operator delete(p);
+        }
+
+        template <typename U>
+        bool operator == (const ArenaAllocator<U>& other) const noexcept
+        {
+            return m_arena == other.m_arena;
+        }
+
+        FrameArena* m_arena;
+    };
+
+    template <typename T>
+    struct PoolAllocator
+    {
+        using value_type = T;
+
+        PoolAllocator() = default;
+
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U>&) noexcept
+        {}
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(FramePool::allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            FramePool::deallocate(p, n * sizeof(T));
+        }
+
+        template <typename U>
+        bool operator == (const PoolAllocator<U>&) const noexcept
+        {
+            return true;
+        }
+    };
+
+    /**
+     * The inline buffer, of the owner: @see InlineBuffer - it's to outlive the objects allocated
+     */
+    template <typename T>
+    struct InlineAllocator
+    {
+        using value_type = T;
+
+        explicit InlineAllocator(InlineStore& store) noexcept : m_store(&store)
+        {}
+
+        template <typename U>
+        InlineAllocator(const InlineAllocator<U>& other) noexcept : m_store(other.m_store)
+        {}
+
+        T* allocate(std::size_t n)
+        {
+            void* p = m_store->allocate(n * sizeof(T), alignof(T));
+            return static_cast<T*>(p ? p : ::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t) noexcept
+        {
+            if (m_store->owns(p)) m_store->release();
+            else ::operator delete(p);
+        }
+
+        template <typename U>
+        bool operator == (const InlineAllocator<U>& other) const noexcept
+        {
+            return m_store == other.m_store;
+        }
+
+        InlineStore* m_store;
+    };
+}
+
+#endif /* COMMONS_ALLOCATIONPOLICY_H_ */
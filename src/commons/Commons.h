@@ -12,6 +12,20 @@
 #include <utility>
 #include <type_traits>
 #include <exception>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
 
 namespace utils
 {
@@ -30,31 +44,266 @@ namespace utils
     }
 
 
-    template<typename ... Args>
-    std::string string_format( const std::string& format, Args&&...args )
+    /**
+     * Reusable formatting buffer: the inline (stack) storage, with the fallback to the heap
+     * only in case that the formatted text doesn't fit.
+     * The heap storage, once allocated, is reused for the subsequent formatting.
+     *
+     * @tparam N    The inline storage size
+     */
+    template <std::size_t N = 512>
+    class FormatBuffer final
     {
-        const auto rv = std::snprintf( nullptr
-                , 0
-                , format.c_str()
-                , std::forward<Args>(args)... ) + 1; // Extra space for '\0'
+        public:
 
-        if (rv <= 0 )
-        {
-            throw std::runtime_error( "Error while obtaining the size." );
-        }
+            FormatBuffer() = default;
+
+            FormatBuffer(const FormatBuffer&) = delete;
+            FormatBuffer& operator = (const FormatBuffer&) = delete;
+
+            /**
+             * printf-like formatting: single pass, unless the text doesn't fit
+             *
+             * @param format    The printf-like format
+             * @param args      The arguments
+             * @return          The view into the buffer: valid until the next formatting
+             */
+            template <typename...Args>
+            std::string_view printf(const char* format, Args&&...args)
+            {
+                m_size = 0;
+
+                auto rv = std::snprintf(data(), capacity(), format, args...);
+                if (rv < 0)
+                {
+                    throw std::runtime_error( "Error while formatting." );
+                }
+
+                if (static_cast<std::size_t>(rv) >= capacity())// Overflow: once more, into the heap
+                {
+                    reserve(static_cast<std::size_t>(rv) + 1);
+                    rv = std::snprintf(data(), capacity(), format, args...);
+                }
+
+                m_size = static_cast<std::size_t>(rv);
+                return view();
+            }
+
+            /**
+             * Type-safe, std::format-like formatting.
+             * Without the std::format library support, only the default replacement fields
+             * "{}" are supported ("{{" and "}}" for the braces)
+             *
+             * @param format    The format
+             * @param args      The arguments
+             * @return          The view into the buffer: valid until the next formatting
+             */
+#if defined(__cpp_lib_format)
+            template <typename...Args>
+            std::string_view format(std::format_string<Args...> format, Args&&...args)
+            {
+                auto result = std::format_to_n(data(), capacity(), format, args...);
+                if (static_cast<std::size_t>(result.size) > capacity())
+                {
+                    reserve(static_cast<std::size_t>(result.size));
+                    result = std::format_to_n(data(), capacity(), format, args...);
+                }
+
+                m_size = static_cast<std::size_t>(result.size);
+                return view();
+            }
+#else
+            template <typename...Args>
+            std::string_view format(std::string_view format, const Args&...args)
+            {
+                using appender_f = void (*)(FormatBuffer&, const void*);
+
+                const std::array<appender_f, sizeof...(Args)> appenders {&appendArg<Args>...};
+                const std::array<const void*, sizeof...(Args)> values {static_cast<const void*>(&args)...};
+
+                m_size = 0;
+                std::size_t next = 0;
+
+                for (std::size_t i = 0; i < format.size(); ++i)
+                {
+                    const char c = format[i];
+                    if (('{' == c || '}' == c) && i + 1 < format.size() && format[i + 1] == c)
+                    {
+                        append(&c, 1);
+                        ++i;
+                    }
+                    else if ('{' == c && i + 1 < format.size() && '}' == format[i + 1])
+                    {
+                        if (next >= sizeof...(Args)) throw std::runtime_error( "Not enough formatting arguments." );
+
+                        appenders[next](*this, values[next]);
+                        ++next;
+                        ++i;
+                    }
+                    else if ('{' == c || '}' == c)
+                    {
+                        throw std::runtime_error( "Unsupported replacement field." );
+                    }
+                    else
+                    {
+                        append(&c, 1);
+                    }
+                }
+
+                return view();
+            }
+#endif
+
+            std::string_view view() const noexcept
+            {
+                return {data(), m_size};
+            }
+
+            std::string str() const
+            {
+                return std::string{view()};
+            }
+
+            std::size_t capacity() const noexcept
+            {
+                return m_pHeap ? m_capacity : N;
+            }
+
+        private:
+
+            char* data() noexcept
+            {
+                return m_pHeap ? m_pHeap.get() : m_inline.data();
+            }
+
+            const char* data() const noexcept
+            {
+                return m_pHeap ? m_pHeap.get() : m_inline.data();
+            }
+
+            void reserve(std::size_t size)
+            {
+                if (size <= capacity()) return;
+
+                const auto capacity = std::max(size, 2 * this->capacity());
+                auto pHeap = std::make_unique<char[]>(capacity);
+                std::copy_n(data(), m_size, pHeap.get());
 
-        const auto size = static_cast<std::size_t>(rv);
+                m_pHeap = std::move(pHeap);
+                m_capacity = capacity;
+            }
 
-        std::string buffer (size, 0);
-        if (std::snprintf(&buffer[0]
-                , size
-                , format.c_str()
-                , std::forward<Args>(args)...) <= 0)
+            void append(const char* text, std::size_t size)
+            {
+                reserve(m_size + size);
+                std::copy_n(text, size, data() + m_size);
+                m_size += size;
+            }
+
+#if !defined(__cpp_lib_format)
+            template <typename T>
+            void appendValue(const T& value)
+            {
+                using type = std::decay_t<T>;
+
+                if constexpr (std::is_same_v<type, bool>)
+                {
+                    append(value ? "true" : "false", value ? 4 : 5);
+                }
+                else if constexpr (std::is_same_v<type, char>)
+                {
+                    append(&value, 1);
+                }
+                else if constexpr (std::is_arithmetic_v<type>)
+                {
+                    char digits[64];
+                    const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+                    append(digits, static_cast<std::size_t>(end - digits));
+                }
+                else if constexpr (std::is_convertible_v<const type&, std::string_view>)
+                {
+                    const std::string_view text {value};
+                    append(text.data(), text.size());
+                }
+                else if constexpr (std::is_pointer_v<type> || std::is_null_pointer_v<type>)
+                {
+                    char digits[2 + 2 * sizeof(void*)] {'0', 'x'};
+                    const auto [end, ec] = std::to_chars(digits + 2, digits + sizeof(digits)
+                            , reinterpret_cast<std::uintptr_t>(static_cast<const void*>(value)), 16);
+                    append(digits, static_cast<std::size_t>(end - digits));
+                }
+                else
+                {
+                    static_assert(std::is_arithmetic_v<type>, "Unsupported formatting argument type!");
+                }
+            }
+
+            template <typename T>
+            static void appendArg(FormatBuffer& buffer, const void* value)
+            {
+                buffer.appendValue(*static_cast<const T*>(value));
+            }
+#endif
+
+        private:
+
+            std::array<char, N> m_inline;
+            std::unique_ptr<char[]> m_pHeap = nullptr;
+            std::size_t m_capacity = 0;
+            std::size_t m_size = 0;
+    };
+
+    namespace details
+    {
+        inline FormatBuffer<>& formatBuffer()
         {
-            throw std::runtime_error( "Error while formatting." );
+            thread_local FormatBuffer<> buffer;
+            return buffer;
         }
+    }
+
+    /**
+     * printf-like formatting into the thread-local buffer
+     *
+     * @note The view is valid until the next formatting within the same thread:
+     * the arguments must not refer to it
+     */
+    template <typename...Args>
+    std::string_view string_view_format(const char* format, Args&&...args)
+    {
+        return details::formatBuffer().printf(format, std::forward<Args>(args)...);
+    }
 
-        return buffer.erase(size-1, 1); // We don't want the '\0' inside
+    /**
+     * std::format-like formatting into the thread-local buffer
+     * @see FormatBuffer::format
+     *
+     * @note The view is valid until the next formatting within the same thread:
+     * the arguments must not refer to it
+     */
+#if defined(__cpp_lib_format)
+    template <typename...Args>
+    std::string_view format_view(std::format_string<Args...> format, Args&&...args)
+    {
+        return details::formatBuffer().format(format, std::forward<Args>(args)...);
+    }
+#else
+    template <typename...Args>
+    std::string_view format_view(std::string_view format, const Args&...args)
+    {
+        return details::formatBuffer().format(format, args...);
+    }
+#endif
+
+    /**
+     * printf-like formatting
+     * Single pass, through the thread-local buffer: the only allocation is
+     * the one for the resulting string (none, within the small string capacity)
+     */
+    template<typename ... Args>
+    std::string string_format( const std::string& format, Args&&...args )
+    {
+        return std::string{string_view_format(format.c_str(), std::forward<Args>(args)...)};
     }
 
 }
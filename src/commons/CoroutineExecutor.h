@@ -0,0 +1,85 @@
+/*
+ * CoroutineExecutor.h
+ *
+ *  Created on: Oct 15, 2026
+ */
+
+#ifndef COMMONS_COROUTINEEXECUTOR_H_
+#define COMMONS_COROUTINEEXECUTOR_H_
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace utils::coro
+{
+    // Where the suspended coroutine gets resumed: returns the one to transfer to, right away
+    struct executor
+    {
+        virtual ~executor() = default;
+        virtual std::coroutine_handle<> schedule(std::coroutine_handle<> handle) = 0;
+    };
+
+    // On the thread of the one resuming - the symmetric transfer, no hops
+    struct inline_executor final : executor
+    {
+        std::coroutine_handle<> schedule(std::coroutine_handle<> handle) override { return handle; }
+    };
+
+    // On the worker thread: it sleeps on the condition variable, while there is nothing to resume
+    class thread_executor final : public executor
+    {
+        public:
+            thread_executor() : worker_([this]{ run(); }) {}
+            ~thread_executor() { stop(); }
+
+            std::coroutine_handle<> schedule(std::coroutine_handle<> handle) override
+            {
+                {
+                    std::lock_guard lock{lock_};
+                    queue_.push_back(handle);
+                }
+                ready_.notify_one();
+                return std::noop_coroutine();
+            }
+
+            // Resume all that is scheduled, and join
+            void stop()
+            {
+                {
+                    std::lock_guard lock{lock_};
+                    stopped_ = true;
+                }
+                ready_.notify_one();
+                if (worker_.joinable()) worker_.join();
+            }
+
+        private:
+            void run()
+            {
+                for (;;)
+                {
+                    std::unique_lock lock{lock_};
+                    ready_.wait(lock, [this]{ return stopped_ or not queue_.empty(); });
+                    if (queue_.empty()) break; // stopped
+
+                    const auto handle = queue_.front();
+                    queue_.pop_front();
+                    lock.unlock();
+
+                    handle.resume();
+                }
+            }
+
+        private:
+            std::mutex lock_;
+            std::condition_variable ready_;
+            std::deque<std::coroutine_handle<>> queue_;
+            bool stopped_ = false;
+            std::thread worker_; // the last one: started once the rest is ready
+    };
+}//namespace utils::coro
+
+#endif /* COMMONS_COROUTINEEXECUTOR_H_ */
@@ -0,0 +1,272 @@
+/*
+ * FramePool.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef COMMONS_FRAMEPOOL_H_
+#define COMMONS_FRAMEPOOL_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+
+namespace utils
+{
+    /**
+     * The caller-provided memory, for the coroutine frames: monotonic.
+     * The frames are carved off the buffer (lock-free), and freeing them only counts them down:
+     * the memory is reused after reset(), once none of them is alive - e.g. per batch of the coroutines.
+     * Once the buffer is exhausted, the frames are taken from the FramePool.
+     */
+    class FrameArena final
+    {
+        public:
+
+            explicit FrameArena(std::span<std::byte> buffer) noexcept :
+                m_begin(buffer.data())
+                , m_capacity(buffer.size())
+            {}
+
+            FrameArena(const FrameArena&) = delete;
+            FrameArena& operator = (const FrameArena&) = delete;
+
+            /**
+             * @param size  The bytes
+             * @return      The memory, aligned to the default new alignment - or nullptr, if exhausted
+             */
+            void* allocate(std::size_t size) noexcept
+            {
+                size = (size + alignment - 1) & ~(alignment - 1);
+
+                auto offset = m_offset.load(std::memory_order_relaxed);
+                do
+                {
+                    if (m_capacity - offset < size) return nullptr;
+                }
+                while (!m_offset.compare_exchange_weak(offset, offset + size, std::memory_order_relaxed));
+
+                m_live.fetch_add(1, std::memory_order_relaxed);
+                return m_begin + offset;
+            }
+
+            void deallocate(void*, std::size_t) noexcept
+            {
+                m_live.fetch_sub(1, std::memory_order_release);
+            }
+
+            /**
+             * Reuse the buffer from the beginning
+             * @note None of the frames is to be alive, nor allocated meanwhile
+             */
+            void reset() noexcept
+            {
+                m_offset.store(0, std::memory_order_relaxed);
+            }
+
+            std::size_t live() const noexcept
+            {
+                return m_live.load(std::memory_order_acquire);
+            }
+
+            std::size_t used() const noexcept
+            {
+                return m_offset.load(std::memory_order_relaxed);
+            }
+
+            // Indication whether the memory is carved off this arena: rather than taken from elsewhere, once exhausted
+            bool owns(const void* p) const noexcept
+            {
+                const auto* const byte = static_cast<const std::byte*>(p);
+                return std::less_equal<>{}(m_begin, byte) && std::less<>{}(byte, m_begin + m_capacity);
+            }
+
+            static constexpr std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+        private:
+
+            std::byte* const m_begin;
+            const std::size_t m_capacity;
+            std::atomic<std::size_t> m_offset {0};
+            std::atomic<std::size_t> m_live {0};
+    };
+
+    /**
+     * Per-thread cache of the freed blocks, by the size class: the allocation and deallocation
+     * are the push/pop of the thread-local free list - no locking, no contention on the heap.
+     * The block freed in another thread goes into that thread cache (the coroutines move across
+     * the executors): each list is bounded, past that the block is returned to the heap.
+     * The large blocks are not cached.
+     */
+    class FramePool final
+    {
+        public:
+
+            static constexpr std::size_t granularity = 64;
+            static constexpr std::size_t classes = 32;  // up to 2 KiB
+            static constexpr std::size_t depth = 64;    // the blocks cached per class, per thread
+
+            struct Stats
+            {
+                std::uint64_t m_reused = 0;     // taken from the cache
+                std::uint64_t m_allocated = 0;  // from the heap
+            };
+
+            static void* allocate(std::size_t size)
+            {
+                const auto index = sizeClass(size);
+                if (index >= classes || t_closed) return ::operator new(size);
+
+                auto& cache = Cache::local();
+                auto& list = cache.m_lists[index];
+                if (list.m_head)
+                {
+                    ++cache.m_stats.m_reused;
+                    --list.m_count;
+                    return std::exchange(list.m_head, list.m_head->m_next);
+                }
+
+                ++cache.m_stats.m_allocated;
+                return ::operator new((index + 1) * granularity);
+            }
+
+            static void deallocate(void* p, std::size_t size) noexcept
+            {
+                const auto index = sizeClass(size);
+                if (index >= classes || t_closed)
+                {
+                    ::operator delete(p);
+                    return;
+                }
+
+                auto& list = Cache::local().m_lists[index];
+                if (list.m_count == depth)
+                {
+                    ::operator delete(p);
+                    return;
+                }
+
+                list.m_head = ::new (p) Node {list.m_head};
+                ++list.m_count;
+            }
+
+            /**
+             * @return The statistics of the calling thread
+             */
+            static Stats stats() noexcept
+            {
+                return t_closed ? Stats{} : Cache::local().m_stats;
+            }
+
+        private:
+
+            struct Node
+            {
+                Node* m_next;
+            };
+
+            struct List
+            {
+                Node* m_head = nullptr;
+                std::size_t m_count = 0;
+            };
+
+            struct Cache
+            {
+                std::array<List, classes> m_lists {};
+                Stats m_stats {};
+
+                static Cache& local() noexcept
+                {
+                    thread_local Cache cache;
+                    return cache;
+                }
+
+                ~Cache()
+                {
+                    t_closed = true; // the frames destroyed past the thread end go to the heap
+                    for (auto& list : m_lists)
+                    {
+                        while (list.m_head) ::operator delete(std::exchange(list.m_head, list.m_head->m_next));
+                    }
+                }
+            };
+
+            static constexpr std::size_t sizeClass(std::size_t size) noexcept
+            {
+                return (size + granularity - 1) / granularity - 1;
+            }
+
+            static inline thread_local bool t_closed = false;
+    };
+
+    /**
+     * The base of the coroutine promise: the frame is allocated from the FramePool (thread-local),
+     * or from the FrameArena - if passed to the coroutine, as the leading arguments:
+     *
+     * @code
+     * Task<int> parse(std::allocator_arg_t, FrameArena&, std::span<const std::byte> data);
+     * ...
+     * FrameArena arena {buffer};
+     * auto task = parse(std::allocator_arg, arena, data);
+     * @endcode
+     *
+     * The frame is prefixed by its origin, so that it's freed the same way.
+     */
+    struct PooledFrame
+    {
+        static void* operator new(std::size_t size)
+        {
+            return allocate(size, nullptr);
+        }
+
+        template <typename...Args>
+        static void* operator new(std::size_t size, std::allocator_arg_t, FrameArena& arena, Args&&...)
+        {
+            return allocate(size, &arena);
+        }
+
+        // The member function coroutine: the object goes first
+        template <typename Object, typename...Args>
+        static void* operator new(std::size_t size, Object&, std::allocator_arg_t, FrameArena& arena, Args&&...)
+        {
+            return allocate(size, &arena);
+        }
+
+        static void operator delete(void* p, std::size_t size) noexcept
+        {
+            auto* const block = static_cast<std::byte*>(p) - header;
+
+            FrameArena* arena = nullptr;
+            std::memcpy(&arena, block, sizeof arena);
+            if (arena) arena->deallocate(block, size + header);
+            else FramePool::deallocate(block, size + header);
+        }
+
+    private:
+
+        static constexpr std::size_t header = FrameArena::alignment; // keeps the frame aligned
+
+        static void* allocate(std::size_t size, FrameArena* arena)
+        {
+            void* block = arena ? arena->allocate(size + header) : nullptr;
+            if (!block)
+            {
+                arena = nullptr;
+                block = FramePool::allocate(size + header);
+            }
+
+            std::memcpy(block, &arena, sizeof arena);
+            return static_cast<std::byte*>(block) + header;
+        }
+    };
+}
+
+#endif /* COMMONS_FRAMEPOOL_H_ */
@@ -0,0 +1,110 @@
+/*
+ * Hash.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef COMMONS_HASH_H_
+#define COMMONS_HASH_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace utils
+{
+    /**
+     * The non-cryptographic 64-bit hash of the content: XXH64.
+     *
+     * The input is consumed in 32-byte stripes, by four independent lanes (accumulators):
+     * there is no dependency between them, so they are pipelined (and unrolled) - running
+     * close to the memory bandwidth.
+     *
+     * @note The result depends on the byte order: the lanes are read as the native words
+     *
+     * @param data  The content
+     * @param seed  The seed
+     * @return      The hash value
+     */
+    inline std::uint64_t xxhash64(std::span<const std::byte> data, std::uint64_t seed = 0) noexcept
+    {
+        constexpr std::uint64_t p1 = 11400714785074694791ULL;
+        constexpr std::uint64_t p2 = 14029467366897019727ULL;
+        constexpr std::uint64_t p3 = 1609587929392839161ULL;
+        constexpr std::uint64_t p4 = 9650029242287828579ULL;
+        constexpr std::uint64_t p5 = 2870177450012600261ULL;
+
+        const auto read64 = [](const std::byte* p) { std::uint64_t v; std::memcpy(&v, p, sizeof v); return v; };
+        const auto read32 = [](const std::byte* p) { std::uint32_t v; std::memcpy(&v, p, sizeof v); return v; };
+        const auto round = [](std::uint64_t acc, std::uint64_t input) { return std::rotl(acc + input * p2, 31) * p1; };
+        const auto merge = [&round](std::uint64_t acc, std::uint64_t lane) { return (acc ^ round(0, lane)) * p1 + p4; };
+
+        const auto* p = data.data();
+        const auto* const end = p + data.size();
+
+        std::uint64_t h = 0;
+        if (data.size() >= 32)
+        {
+            std::uint64_t v1 = seed + p1 + p2;
+            std::uint64_t v2 = seed + p2;
+            std::uint64_t v3 = seed;
+            std::uint64_t v4 = seed - p1;
+
+            for (; p + 32 <= end; p += 32)
+            {
+                v1 = round(v1, read64(p));
+                v2 = round(v2, read64(p + 8));
+                v3 = round(v3, read64(p + 16));
+                v4 = round(v4, read64(p + 24));
+            }
+
+            h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+            h = merge(h, v1);
+            h = merge(h, v2);
+            h = merge(h, v3);
+            h = merge(h, v4);
+        }
+        else
+        {
+            h = seed + p5;
+        }
+
+        h += data.size();
+
+        // The tail
+        for (; p + 8 <= end; p += 8) h = std::rotl(h ^ round(0, read64(p)), 27) * p1 + p4;
+        if (p + 4 <= end)
+        {
+            h = std::rotl(h ^ (read32(p) * p1), 23) * p2 + p3;
+            p += 4;
+        }
+        for (; p < end; ++p) h = std::rotl(h ^ (std::to_integer<std::uint64_t>(*p) * p5), 11) * p1;
+
+        // Avalanche
+        h ^= h >> 33;
+        h *= p2;
+        h ^= h >> 29;
+        h *= p3;
+        h ^= h >> 32;
+
+        return h;
+    }
+
+    /**
+     * Fibonacci hashing: the key mapped to one of the Slots, by its top bits after multiplying by 2^64/phi.
+     * The consecutive keys (e.g. the addresses of the objects in array) are spread over all of them.
+     *
+     * @tparam Slots    The number of slots: the power of two
+     */
+    template <std::size_t Slots>
+    requires (Slots > 1 && std::has_single_bit(Slots))
+    constexpr std::size_t fibonacci_index(std::uint64_t key) noexcept
+    {
+        constexpr auto shift = 64 - std::countr_zero(Slots);
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+}
+
+#endif /* COMMONS_HASH_H_ */
@@ -0,0 +1,75 @@
+/*
+ * ParallelFor.h
+ *
+ *  Created on: Oct 15, 2026
+ */
+
+#ifndef COMMONS_PARALLELFOR_H_
+#define COMMONS_PARALLELFOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace utils
+{
+    /**
+     * Invoke func(i) for each of the indices [0, count): claimed one by one by the executor jobs,
+     * and the calling thread. The ones not claimed yet are done by the caller, so it doesn't block
+     * within the executor - it can be called from its own worker.
+     *
+     * @param executor  The execution context: post(job) - e.g. utils::aot::ThreadPool
+     * @param count     The number of indices
+     * @param helpers   The number of the jobs posted, at most: beside the calling thread
+     * @param func      The callable: invoked concurrently for the different indices
+     * @throws          The first exception thrown by the callable: once all the indices are done
+     */
+    template <typename Executor, typename Func>
+    void parallel_for(Executor& executor, std::size_t count, std::size_t helpers, const Func& func)
+    {
+        if (0 == count) return;
+
+        struct State
+        {
+            std::atomic<std::size_t> m_next {0};
+            std::atomic<std::size_t> m_done {0};
+            std::mutex m_lock;
+            std::exception_ptr m_error;
+        };
+
+        auto state = std::make_shared<State>(); // the jobs started late find no indices left: the caller is gone
+
+        const auto work = [state, &func, count]
+        {
+            for (std::size_t i = 0; (i = state->m_next.fetch_add(1, std::memory_order_relaxed)) < count; )
+            {
+                try
+                {
+                    func(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock {state->m_lock};
+                    if (!state->m_error) state->m_error = std::current_exception();
+                }
+
+                if (state->m_done.fetch_add(1, std::memory_order_acq_rel) + 1 == count) state->m_done.notify_one();
+            }
+        };
+
+        for (std::size_t i = 0, jobs = std::min(helpers, count - 1); i < jobs; ++i) executor.post(work);
+        work();
+
+        for (auto done = state->m_done.load(std::memory_order_acquire); done < count; done = state->m_done.load(std::memory_order_acquire))
+        {
+            state->m_done.wait(done, std::memory_order_acquire);
+        }
+
+        if (state->m_error) std::rethrow_exception(state->m_error);
+    }
+}//namespace utils
+
+#endif /* COMMONS_PARALLELFOR_H_ */
@@ -0,0 +1,140 @@
+/*
+ * SpscQueue.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef COMMONS_SPSCQUEUE_H_
+#define COMMONS_SPSCQUEUE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace utils
+{
+    /**
+     * Bounded lock-free queue, for the single producer and the single consumer.
+     *
+     * The producer owns the tail, and the consumer the head index: each of them
+     * is written by one side only (release), and read by the other (acquire).
+     * Both sides keep the cached copy of the other side index, so that the shared
+     * cache line is touched only when the queue looks full (empty) from the local view.
+     *
+     * @tparam T        The element type
+     * @tparam Capacity The queue capacity, power of 2
+     */
+    template <typename T, std::size_t Capacity>
+    class SpscQueue final
+    {
+            static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2!");
+            static_assert(std::is_nothrow_move_constructible_v<T>, "Element type needs to be nothrow movable!");
+
+        public:
+
+            using value_type = T;
+
+            SpscQueue() = default;
+            ~SpscQueue() = default;
+
+            SpscQueue(const SpscQueue&) = delete;
+            SpscQueue& operator = (const SpscQueue&) = delete;
+
+            /**
+             * Producer side: enqueue the element
+             *
+             * @param value The element to enqueue
+             * @return      False, in case that the queue is full: the value is not moved from
+             */
+            template <typename U>
+            bool try_push(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+            {
+                const auto tail = m_tail.load(std::memory_order_relaxed);
+                if (tail - m_headCached == Capacity)
+                {
+                    m_headCached = m_head.load(std::memory_order_acquire);
+                    if (tail - m_headCached == Capacity) return false;
+                }
+
+                m_slots[tail & (Capacity - 1)].emplace(std::forward<U>(value));
+                m_tail.store(tail + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * Consumer side: dequeue the element
+             *
+             * @return The element, or none-value in case that the queue is empty
+             */
+            std::optional<T> try_pop() noexcept
+            {
+                const auto head = m_head.load(std::memory_order_relaxed);
+                if (head == m_tailCached)
+                {
+                    m_tailCached = m_tail.load(std::memory_order_acquire);
+                    if (head == m_tailCached) return {};
+                }
+
+                auto& slot = m_slots[head & (Capacity - 1)];
+                std::optional<T> value {std::move(*slot)};
+                slot.reset();
+
+                m_head.store(head + 1, std::memory_order_release);
+
+                return value;
+            }
+
+            /**
+             * Consumer side: dequeue all available elements at once
+             *
+             * @param func  The consumer of the elements
+             * @return      The number of dequeued elements
+             */
+            template <typename Func>
+            std::size_t consume_all(Func&& func)
+            {
+                const auto head = m_head.load(std::memory_order_relaxed);
+                const auto tail = m_tail.load(std::memory_order_acquire);
+
+                for (auto i = head; i != tail; ++i)
+                {
+                    auto& slot = m_slots[i & (Capacity - 1)];
+                    func(std::move(*slot));
+                    slot.reset();
+                }
+
+                m_tailCached = tail;
+                m_head.store(tail, std::memory_order_release);
+
+                return tail - head;
+            }
+
+            /**
+             * @note Approximation, unless called from the consumer side
+             */
+            bool empty() const noexcept
+            {
+                return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+            }
+
+            static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+        private:
+
+            std::array<std::optional<T>, Capacity> m_slots;
+
+            // Consumer side
+            alignas(64) std::atomic<std::size_t> m_head {0};
+            std::size_t m_tailCached = 0;
+
+            // Producer side
+            alignas(64) std::atomic<std::size_t> m_tail {0};
+            std::size_t m_headCached = 0;
+    };
+}
+
+#endif /* COMMONS_SPSCQUEUE_H_ */
@@ -0,0 +1,153 @@
+/*
+ * TypePartitioned.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef COMMONS_TYPEPARTITIONED_H_
+#define COMMONS_TYPEPARTITIONED_H_
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ParallelFor.h"
+
+namespace utils
+{
+    /**
+     * The heterogeneous collection, partitioned by the concrete type: each type in its own contiguous array.
+     * Instead of the collection of the erased objects (each call - the indirect one into the random
+     * heap location), the operation is applied as the loop per type: statically dispatched, inlined.
+     *
+     * @code
+     * TypePartitioned<Car, Truck> vehicles;
+     * vehicles.emplace<Car>("Audi", "A3985");
+     * vehicles.for_each([](const auto& vehicle) { vehicle.drive(drive_type::eco); });
+     * @endcode
+     *
+     * @note The order of the elements is preserved only within the same type
+     * @tparam Types    The concrete types: the closed set
+     */
+    template <typename...Types>
+    class TypePartitioned final
+    {
+        template <typename T>
+        static constexpr std::size_t count = (std::size_t{std::is_same_v<T, Types>} + ... + 0);
+
+        static_assert(sizeof...(Types) > 0 && ((count<Types> == 1) && ...), "TypePartitioned: the types are to be distinct");
+
+        public:
+
+            static constexpr std::size_t partitions = sizeof...(Types);
+
+            template <typename T, typename...Args>
+            T& emplace(Args&&...args)
+            {
+                return partition_of<T>().emplace_back(std::forward<Args>(args)...);
+            }
+
+            template <typename T>
+            void push_back(T&& value)
+            {
+                emplace<std::decay_t<T>>(std::forward<T>(value));
+            }
+
+            template <typename T>
+            void reserve(std::size_t capacity)
+            {
+                partition_of<T>().reserve(capacity);
+            }
+
+            template <typename T>
+            std::span<T> partition() noexcept
+            {
+                return partition_of<T>();
+            }
+
+            template <typename T>
+            std::span<const T> partition() const noexcept
+            {
+                return std::get<std::vector<T>>(m_partitions);
+            }
+
+            std::size_t size() const noexcept
+            {
+                return std::apply([](const auto&...partition) { return (partition.size() + ...); }, m_partitions);
+            }
+
+            bool empty() const noexcept
+            {
+                return 0 == size();
+            }
+
+            void clear() noexcept
+            {
+                std::apply([](auto&...partition) { (partition.clear(), ...); }, m_partitions);
+            }
+
+            /**
+             * Apply the operation on each element: type by type
+             *
+             * @param func  The callable: with each of the types
+             */
+            template <typename Func>
+            void for_each(Func&& func)
+            {
+                std::apply([&func](auto&...partition) { (loop(partition, func), ...); }, m_partitions);
+            }
+
+            template <typename Func>
+            void for_each(Func&& func) const
+            {
+                std::apply([&func](const auto&...partition) { (loop(partition, func), ...); }, m_partitions);
+            }
+
+            /**
+             * The same, the partitions in parallel: claimed one by one by the executor jobs,
+             * and the calling thread - the ones left are done by the caller (doesn't block within the executor)
+             *
+             * @param executor  The execution context: post(job) - e.g. utils::aot::ThreadPool
+             * @param func      The callable: invoked concurrently for the different types
+             * @throws          The first exception thrown by the callable: once all the partitions are done
+             */
+            template <typename Executor, typename Func>
+            void for_each(Executor& executor, const Func& func)
+            {
+                parallel_for(executor, partitions, partitions - 1, [this, &func](std::size_t i) { visit(i, func); });
+            }
+
+        private:
+
+            template <typename T>
+            std::vector<T>& partition_of() noexcept
+            {
+                static_assert(count<T> == 1, "TypePartitioned: not the one of the types");
+                return std::get<std::vector<T>>(m_partitions);
+            }
+
+            // The tight loop: the concrete type
+            template <typename Partition, typename Func>
+            static void loop(Partition& partition, Func& func)
+            {
+                for (auto& element : partition) func(element);
+            }
+
+            template <typename Func>
+            void visit(std::size_t index, const Func& func)
+            {
+                [&]<std::size_t...I>(std::index_sequence<I...>)
+                {
+                    ((I == index ? loop(std::get<I>(m_partitions), func) : void()), ...);
+                }(std::index_sequence_for<Types...>{});
+            }
+
+        private:
+            std::tuple<std::vector<Types>...> m_partitions;
+    };
+}
+
+#endif /* COMMONS_TYPEPARTITIONED_H_ */
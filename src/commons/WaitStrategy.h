@@ -0,0 +1,283 @@
+/*
+ * WaitStrategy.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef COMMONS_WAITSTRATEGY_H_
+#define COMMONS_WAITSTRATEGY_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace utils
+{
+    /**
+     * Hint to the CPU that the thread is busy-waiting: reduces the power consumption,
+     * and the penalty of leaving the spin loop (memory order violation)
+     */
+    inline void cpu_relax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield" ::: "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /**
+     * Adaptive spin-then-park waiting: on the condition variable, or on the atomic index (lock-free).
+     *
+     * Before the thread gets parked (suspended on the condition variable), it will
+     * check the condition for m_spins times with the pause instruction in between, and
+     * then for m_yields times giving up the rest of the time slice.
+     * While spinning, the lock is not taken on each round, to not compete with the notifier:
+     * only once the lock-free hint (i.e: the relaxed load of the ready flag) says the predicate may hold,
+     * or - without the hint - tried once per the try_period rounds. Once yielding, it's tried on each round.
+     *
+     * Waiting on the atomic index, the thread is parked on the atomic wait instead: the other side
+     * makes the system call only if there is someone parked (@see notify).
+     *
+     * The default (no spins, no yields) is the plain blocking wait.
+     * Spinning trades the CPU time for the wake-up latency: it pays off only if the
+     * condition is likely to be fulfilled within the microseconds, and there are
+     * more cores than busy threads.
+     */
+    struct WaitStrategy
+    {
+        std::uint32_t m_spins = 0;
+        std::uint32_t m_yields = 0;
+
+        static constexpr std::uint32_t try_period = 64; // the spin rounds per the lock attempt, without the hint
+
+        static constexpr WaitStrategy blocking() noexcept
+        {
+            return {};
+        }
+
+        static constexpr WaitStrategy adaptive(std::uint32_t spins = 4000, std::uint32_t yields = 16) noexcept
+        {
+            return {spins, yields};
+        }
+
+        /**
+         * Wait until the predicate is fulfilled
+         *
+         * @param condition The condition variable to park on
+         * @param lock      The acquired lock, guarding the predicate state: on return, it's acquired
+         * @param pred      The predicate to wait on
+         */
+        template <typename Predicate>
+        void wait(std::condition_variable& condition, std::unique_lock<std::mutex>& lock, Predicate pred) const
+        {
+            wait(condition, lock, pred, periodic());
+        }
+
+        /**
+         * Wait until the predicate is fulfilled
+         *
+         * @param condition The condition variable to park on
+         * @param lock      The acquired lock, guarding the predicate state: on return, it's acquired
+         * @param pred      The predicate to wait on
+         * @param hint      Called without the lock, while spinning: whether the predicate may hold
+         */
+        template <typename Predicate, typename Hint>
+        void wait(std::condition_variable& condition, std::unique_lock<std::mutex>& lock, Predicate pred, Hint hint) const
+        {
+            if (pred() || spin(lock, pred, hint)) return;
+
+            condition.wait(lock, pred);
+        }
+
+        /**
+         * Wait until the predicate is fulfilled, or the timeout expired
+         *
+         * @param condition The condition variable to park on
+         * @param lock      The acquired lock, guarding the predicate state: on return, it's acquired
+         * @param timeout   The time to wait
+         * @param pred      The predicate to wait on
+         * @return          The predicate outcome: false, in case of timeout
+         */
+        template <typename Rep, typename Period, typename Predicate>
+        bool wait_for(std::condition_variable& condition
+                , std::unique_lock<std::mutex>& lock
+                , const std::chrono::duration<Rep, Period>& timeout
+                , Predicate pred) const
+        {
+            return wait_for(condition, lock, timeout, pred, periodic());
+        }
+
+        /**
+         * Wait until the predicate is fulfilled, or the timeout expired
+         *
+         * @param condition The condition variable to park on
+         * @param lock      The acquired lock, guarding the predicate state: on return, it's acquired
+         * @param timeout   The time to wait
+         * @param pred      The predicate to wait on
+         * @param hint      Called without the lock, while spinning: whether the predicate may hold
+         * @return          The predicate outcome: false, in case of timeout
+         */
+        template <typename Rep, typename Period, typename Predicate, typename Hint>
+        bool wait_for(std::condition_variable& condition
+                , std::unique_lock<std::mutex>& lock
+                , const std::chrono::duration<Rep, Period>& timeout
+                , Predicate pred
+                , Hint hint) const
+        {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+            if (pred() || spin(lock, pred, hint)) return true;
+
+            return condition.wait_until(lock, deadline, pred);
+        }
+
+        /**
+         * Wait until the index is not the old one anymore: for the single waiter
+         *
+         * @param index     The index to wait on
+         * @param old       The index value seen
+         * @param parked    Tells the other side to notify: @see notify
+         */
+        template <typename Index>
+        void wait(const std::atomic<Index>& index, Index old, std::atomic<bool>& parked) const
+        {
+            if (spin(index, old)) return;
+
+            for (;;)
+            {
+                parked.store(true, std::memory_order_seq_cst);
+                if (index.load(std::memory_order_seq_cst) != old) break;
+                index.wait(old, std::memory_order_acquire);
+            }
+            parked.store(false, std::memory_order_relaxed);
+        }
+
+        /**
+         * Wait until the index is not the old one anymore: for many waiters, counted
+         *
+         * @param index     The index to wait on
+         * @param old       The index value seen
+         * @param waiters   The number of the parked ones: @see notify_all
+         */
+        template <typename Index>
+        void wait(const std::atomic<Index>& index, Index old, std::atomic<std::uint32_t>& waiters) const
+        {
+            if (spin(index, old)) return;
+
+            waiters.fetch_add(1, std::memory_order_seq_cst);
+            while (index.load(std::memory_order_seq_cst) == old)
+            {
+                index.wait(old, std::memory_order_acquire);
+            }
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * Wait until the index is not the old one anymore, or the deadline passed.
+         * There is no timed atomic wait: past spinning, it's polled with the growing pause
+         *
+         * @return False, in case of timeout
+         */
+        template <typename Index>
+        bool wait_until(const std::atomic<Index>& index, Index old, std::chrono::steady_clock::time_point deadline) const
+        {
+            using namespace std::chrono_literals;
+
+            if (spin(index, old)) return true;
+
+            for (auto pause = 50us; index.load(std::memory_order_acquire) == old; pause = std::min<std::chrono::microseconds>(pause * 2, 1ms))
+            {
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= deadline) return false;
+                std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(pause, deadline - now));
+            }
+            return true;
+        }
+
+        /**
+         * After the index is stored: the system call only if the other side is parked on it,
+         * and once per parking - the flag is taken (the waiter sets it again, if still waiting)
+         */
+        template <typename Index>
+        static void notify(std::atomic<Index>& index, std::atomic<bool>& parked) noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst); // ordered with the flag set/index check
+            if (parked.load(std::memory_order_relaxed) && parked.exchange(false, std::memory_order_relaxed))
+            {
+                index.notify_one();
+            }
+        }
+
+        template <typename Index>
+        static void notify_all(std::atomic<Index>& index, const std::atomic<std::uint32_t>& waiters) noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed)) index.notify_all();
+        }
+
+        private:
+
+            // On the index: no lock to take, just the load
+            template <typename Index>
+            bool spin(const std::atomic<Index>& index, Index old) const
+            {
+                // On the single CPU the other side can't move on, while this one spins
+                static const bool multicore = std::thread::hardware_concurrency() > 1;
+                const auto spins = multicore ? m_spins : 0;
+
+                for (std::uint32_t i = 0; i < spins + m_yields; ++i)
+                {
+                    if (index.load(std::memory_order_acquire) != old) return true;
+                    if (i < spins) cpu_relax();
+                    else std::this_thread::yield();
+                }
+                return index.load(std::memory_order_acquire) != old;
+            }
+
+            // Without the hint: the lock is tried once per the try_period rounds
+            static auto periodic() noexcept
+            {
+                return [round = std::uint32_t{0}]() mutable { return 0 == ++round % try_period; };
+            }
+
+            // Returns with the lock acquired, and the predicate fulfilled - if spinning succeeded
+            template <typename Predicate, typename Hint>
+            bool spin(std::unique_lock<std::mutex>& lock, Predicate& pred, Hint& hint) const
+            {
+                if (0 == m_spins + m_yields) return false;
+
+                lock.unlock();
+
+                for (std::uint32_t i = 0; i < m_spins + m_yields; ++i)
+                {
+                    const bool spinning = i < m_spins;
+                    if (spinning) cpu_relax();
+                    else std::this_thread::yield();
+
+                    if (!hint() && spinning) continue;
+
+                    if (lock.try_lock())
+                    {
+                        if (pred()) return true;
+                        lock.unlock();
+                    }
+                }
+
+                lock.lock();
+                return false;
+            }
+    };
+}
+
+#endif /* COMMONS_WAITSTRATEGY_H_ */
@@ -1,17 +1,30 @@
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <mutex>
 #include <semaphore>
+#include <span>
 #include <concepts>
+#include <condition_variable>
 #include <chrono>
 #include <functional>
+#include <thread>
+#include <utility>
 
 // for testing
 #include <memory>
 #include <iostream>
 #include <thread>
 #include <iterator>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+
+#include "../commons/WaitStrategy.h"
+#include "../measuring/ElapsedTime.h"
+#include "../measuring/Report.h"
 
 
 // CompilerExplorer: https://godbolt.org/z/zYarrTxzK
@@ -24,6 +37,11 @@ namespace utils
         std::array<T, BlockSize> data_; // the storage, that can hold up to BlockSize elements
     };
 
+    // The synchronization policies of the RingBuffer
+    struct locked_t {}; // mutex and the semaphores: any number of producers and consumers
+    struct spsc_t {};   // lock-free: exactly one producer, and one consumer
+    struct mpmc_t {};   // lock-free: any number of producers and consumers, on the sequenced slots
+
     /**
      * Producer-consumer implementation.
 
@@ -37,8 +55,16 @@ namespace utils
      * @tparam T            Type of the elements to store
      * @tparam Blocks       The number of slots to synchronized with
      * @tparam BlockSize    The size of the each slot, in elements of type T
+     * @tparam Policy       The synchronization policy: @see spsc_t, for the single producer and consumer,
+     *                      and mpmc_t, for many of them without the lock
+     *
+     * Besides copying the blocks in and out, the slots can be filled (parsed) in place:
+     * acquire_write() / commit_write(n) and acquire_read() / release_read() hand out the view
+     * into the slot itself. The reservation is exclusive on its side - the other producers
+     * (consumers) wait for it to be committed (released). It's the flag checked under the queue lock:
+     * the copying calls take no other lock, and none is held while the slot is being filled (parsed).
      */
-    template <typename T, std::size_t Blocks, std::size_t BlockSize>
+    template <typename T, std::size_t Blocks, std::size_t BlockSize, typename Policy = locked_t>
     class RingBuffer final
     {
 
@@ -51,9 +77,11 @@ namespace utils
         {
             writeSemaphore_.acquire(); // wait on empty slot
             {
-                std::lock_guard lock{lock_};
+                std::unique_lock lock{lock_};
+                waitUnreserved(lock, writeReserved_);
                 blocks_[writeIndex_] = std::forward<block_type>(data); 
                 writeIndex_ = (writeIndex_ +  1) % Blocks;
+                ++count_;
             } // unlock
             readSemaphore_.release(); // signal consumer data readiness
         }
@@ -65,18 +93,68 @@ namespace utils
             const auto written = std::min(BlockSize, collection.size());
             writeSemaphore_.acquire();
             {
-                std::lock_guard lock{lock_};
+                std::unique_lock lock{lock_};
+                waitUnreserved(lock, writeReserved_);
 
                 auto&& col = std::forward<Collection>(collection);
                 auto& block = blocks_[writeIndex_];
                 block.size_ = written;
                 std::copy(col.cbegin(), std::next(collection.cbegin(), written), block.data_.begin());
                 writeIndex_ = (writeIndex_ + 1) % Blocks;
+                ++count_;
             } // unlock
             readSemaphore_.release();
             return written;
         }
 
+        // In place: the slot to be filled, up to BlockSize elements
+        std::span<T, BlockSize> acquire_write()
+        {
+            writeSemaphore_.acquire();
+            std::unique_lock lock{lock_};
+            waitUnreserved(lock, writeReserved_);
+            writeReserved_ = true; // until committed: the index is not moved meanwhile
+            return blocks_[writeIndex_].data_;
+        }
+
+        void commit_write(std::size_t size)
+        {
+            bool notify = false;
+            {
+                std::lock_guard lock{lock_};
+                blocks_[writeIndex_].size_ = std::min(BlockSize, size);
+                writeIndex_ = (writeIndex_ + 1) % Blocks;
+                ++count_;
+                notify = unreserve(writeReserved_);
+            } // unlock
+            if (notify) reserved_.notify_all();
+            readSemaphore_.release();
+        }
+
+        // In place: the elements stored in the slot, valid until released
+        std::span<const T> acquire_read()
+        {
+            readSemaphore_.acquire();
+            std::unique_lock lock{lock_};
+            waitUnreserved(lock, readReserved_);
+            readReserved_ = true; // until released
+            const auto& block = blocks_[readIndex_];
+            return {block.data_.data(), block.size_};
+        }
+
+        void release_read()
+        {
+            bool notify = false;
+            {
+                std::lock_guard lock{lock_};
+                readIndex_ = (readIndex_ + 1) % Blocks;
+                --count_;
+                notify = unreserve(readReserved_);
+            } // unlock
+            if (notify) reserved_.notify_all();
+            writeSemaphore_.release();
+        }
+
         bool read(block_type& block) {
             return readImpl(&semaphore_type::acquire, block);
         }
@@ -92,7 +170,7 @@ namespace utils
             return readImpl([&](const block_type& block) mutable
             {
                 collection.reserve(block.size_);
-                std::copy(block.data_.cbegin(), block.data_.cend(), std::back_inserter(collection));
+                std::copy(block.data_.cbegin(), std::next(block.data_.cbegin(), block.size_), std::back_inserter(collection));
             });
         }
 
@@ -103,7 +181,7 @@ namespace utils
             return readImpl([&](const block_type& block) mutable
             {
                 collection.reserve(block.size_);
-                std::copy(block.data_.cbegin(), block.data_.cend(), std::back_inserter(collection));
+                std::copy(block.data_.cbegin(), std::next(block.data_.cbegin(), block.size_), std::back_inserter(collection));
             });
         }
 
@@ -135,7 +213,7 @@ namespace utils
         bool is_empty() const 
         {
             std::lock_guard lock {lock_};
-            return writeIndex_ == readIndex_;
+            return 0 == count_;
         }
 
     private:
@@ -144,9 +222,12 @@ namespace utils
         bool readImpl(Func&& func) 
         {
             {
-               std::lock_guard lock{lock_};
-               if ( writeIndex_ == readIndex_) return false;
+               std::unique_lock lock{lock_};
+               waitUnreserved(lock, readReserved_);
+               if (0 == count_) return false;
                std::invoke(std::forward<Func>(func), blocks_[readIndex_]);
+               readIndex_ = (readIndex_ + 1) % Blocks;
+               --count_;
             } // unlock
             writeSemaphore_.release();
             return true;
@@ -161,20 +242,42 @@ namespace utils
                 std::invoke(std::forward<Func>(func), readSemaphore_, std::forward<Args>(args)...);
             }
             {
-                std::lock_guard lock{lock_};
-                if (readIndex_ == writeIndex_) { // empty buffer
+                std::unique_lock lock{lock_};
+                waitUnreserved(lock, readReserved_);
+                if (0 == count_) { // empty buffer
                     return false;
                 }
                 block = blocks_[readIndex_];
                 readIndex_ = (readIndex_ + 1) % Blocks;
+                --count_;
             } // unlock
 
             writeSemaphore_.release();
             return true;
         }
 
+        // The slot reserved in place, on the same side: rarely the case, so the waiters are counted
+        void waitUnreserved(std::unique_lock<std::mutex>& lock, const bool& reserved)
+        {
+            if (not reserved) return;
+            ++reservedWaiters_;
+            reserved_.wait(lock, [&reserved] { return not reserved; });
+            --reservedWaiters_;
+        }
+
+        // Under the lock: whether there is anyone to notify, once unlocked
+        bool unreserve(bool& reserved) noexcept
+        {
+            reserved = false;
+            return reservedWaiters_ > 0;
+        }
+
     private:
         mutable std::mutex lock_;
+        std::condition_variable reserved_;
+        std::size_t reservedWaiters_ = 0;
+        bool writeReserved_ = false; // the slot being filled in place: the producers wait for the commit
+        bool readReserved_ = false;  // the slot being parsed in place: the consumers wait for the release
 
         using semaphore_type = std::counting_semaphore<Blocks>;
         semaphore_type writeSemaphore_ {Blocks};
@@ -182,10 +285,418 @@ namespace utils
 
         std::size_t writeIndex_ = 0; // index of the slot to write to
         std::size_t readIndex_ = 0; // index of the slot to read from
+        std::size_t count_ = 0; // the slots written: the indices alone can't tell full from empty
 
         std::array<block_type, Blocks> blocks_;
     
     }; // RingBuffer
+
+    /**
+     * Producer-consumer implementation, for exactly one producer and one consumer.
+     *
+     * Lock-free: the producer owns the tail index, and the consumer the head index - each of them
+     * written by one side only (release), and read by the other (acquire). There are no
+     * read-modify-write operations, and each side keeps the cached copy of the other side index:
+     * the shared cache line is touched only when the buffer looks full (empty) from the local view.
+     * The indices are padded onto the separate cache lines, to prevent false sharing.
+     *
+     * The blocking calls wait on the other side index: @see utils::WaitStrategy
+     * The slots can be filled (parsed) in place, as with the locked version.
+     */
+    template <typename T, std::size_t Blocks, std::size_t BlockSize>
+    class RingBuffer<T, Blocks, BlockSize, spsc_t> final
+    {
+
+    public:
+
+        using block_type = block<T, BlockSize>;
+
+        explicit RingBuffer(WaitStrategy wait = {}) noexcept : wait_(wait) {}
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator = (const RingBuffer&) = delete;
+
+        // Producer side
+
+        void write(block_type&& data)
+        {
+            const auto tail = wait_writable();
+            blocks_[tail % Blocks] = std::move(data);
+            publish(tail);
+        }
+
+        template <typename Collection>
+        requires std::convertible_to<decltype(*std::declval<Collection&>().begin()), T>
+        std::size_t write(Collection&& collection)
+        {
+            const auto written = std::min(BlockSize, collection.size());
+            const auto tail = wait_writable();
+
+            auto& block = blocks_[tail % Blocks];
+            block.size_ = written;
+            std::copy(collection.cbegin(), std::next(collection.cbegin(), written), block.data_.begin());
+
+            publish(tail);
+            return written;
+        }
+
+        // In place: the slot to be filled, up to BlockSize elements
+        std::span<T, BlockSize> acquire_write()
+        {
+            return blocks_[wait_writable() % Blocks].data_;
+        }
+
+        void commit_write(std::size_t size)
+        {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            blocks_[tail % Blocks].size_ = std::min(BlockSize, size);
+            publish(tail);
+        }
+
+        // Consumer side
+
+        // In place: the elements stored in the slot, valid until released
+        std::span<const T> acquire_read()
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+            wait_readable(head, no_timeout);
+
+            const auto& block = blocks_[head % Blocks];
+            return {block.data_.data(), block.size_};
+        }
+
+        void release_read()
+        {
+            release(head_.load(std::memory_order_relaxed));
+        }
+
+        bool read(block_type& block)
+        {
+            return consume(no_timeout, [&block](const block_type& slot) { block = slot; });
+        }
+
+        bool read_for(block_type& block, std::chrono::milliseconds timeout)
+        {
+            return consume(deadline(timeout), [&block](const block_type& slot) { block = slot; });
+        }
+
+        template <typename Collection>
+        auto read(Collection& collection)
+        {
+            return consume(no_timeout, append(collection));
+        }
+
+        template <typename Collection>
+        auto read_for(Collection& collection, std::chrono::milliseconds timeout)
+        {
+            return consume(deadline(timeout), append(collection));
+        }
+
+        template <typename Byte>
+        static constexpr bool is_byte = std::is_same_v<Byte, unsigned char> || std::is_same_v<Byte, std::uint8_t> || std::is_same_v<Byte, std::byte>;
+        bool read_bytes(T* ptr, std::size_t& size) requires is_byte<T>
+        {
+            return consume(no_timeout, copy(ptr, size));
+        }
+
+        bool read_bytes_for(T* ptr, std::size_t& size, std::chrono::milliseconds timeout)
+        requires is_byte<T>
+        {
+            return consume(deadline(timeout), copy(ptr, size));
+        }
+
+        // Approximation, unless called from either side
+        bool is_empty() const
+        {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+
+    private:
+        using clock_type = std::chrono::steady_clock;
+        static constexpr clock_type::time_point no_timeout = clock_type::time_point::max();
+
+        static clock_type::time_point deadline(std::chrono::milliseconds timeout)
+        {
+            return clock_type::now() + timeout;
+        }
+
+        template <typename Collection>
+        static auto append(Collection& collection)
+        {
+            return [&collection](const block_type& block)
+            {
+                collection.reserve(block.size_);
+                std::copy(block.data_.cbegin(), std::next(block.data_.cbegin(), block.size_), std::back_inserter(collection));
+            };
+        }
+
+        static auto copy(T* ptr, std::size_t& size)
+        {
+            return [ptr, &size](const block_type& block)
+            {
+                size = std::min(size, block.size_);
+                std::memcpy(ptr, block.data_.data(), size);
+            };
+        }
+
+        // Wait on the free slot: the consumer to move on
+        std::size_t wait_writable()
+        {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            while (tail - headCached_ == Blocks) {
+                headCached_ = head_.load(std::memory_order_acquire);
+                if (tail - headCached_ < Blocks) break;
+                wait_.wait(head_, headCached_, producerParked_);
+            }
+            return tail;
+        }
+
+        void publish(std::size_t tail)
+        {
+            tail_.store(tail + 1, std::memory_order_release);
+            WaitStrategy::notify(tail_, consumerParked_);
+        }
+
+        // Wait on the slot written: the producer to move on
+        bool wait_readable(std::size_t head, clock_type::time_point until)
+        {
+            while (head == tailCached_) {
+                tailCached_ = tail_.load(std::memory_order_acquire);
+                if (head != tailCached_) break;
+
+                if (until == no_timeout) wait_.wait(tail_, head, consumerParked_);
+                else if (not wait_.wait_until(tail_, head, until)) return false;
+            }
+            return true;
+        }
+
+        void release(std::size_t head)
+        {
+            head_.store(head + 1, std::memory_order_release);
+            WaitStrategy::notify(head_, producerParked_);
+        }
+
+        template <typename Func>
+        bool consume(clock_type::time_point until, Func&& func)
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+            if (not wait_readable(head, until)) return false;
+
+            std::invoke(std::forward<Func>(func), blocks_[head % Blocks]);
+
+            release(head);
+            return true;
+        }
+
+    private:
+        // Consumer side
+        alignas(64) std::atomic<std::size_t> head_ {0}; // the next slot to read from
+        std::size_t tailCached_ = 0;
+        std::atomic<bool> consumerParked_ {false};
+
+        // Producer side
+        alignas(64) std::atomic<std::size_t> tail_ {0}; // the next slot to write to
+        std::size_t headCached_ = 0;
+        std::atomic<bool> producerParked_ {false};
+
+        alignas(64) std::array<block_type, Blocks> blocks_;
+        const WaitStrategy wait_;
+
+    }; // RingBuffer<spsc_t>
+
+    /**
+     * Producer-consumer implementation, for any number of producers and consumers - lock-free.
+     *
+     * Each slot carries the sequence number, telling the lap it's at (D. Vyukov bounded queue):
+     * the slot at the position is free to write, once its sequence equals the position,
+     * and ready to read once it's the position + 1. The producers (consumers) claim the positions
+     * with CAS on the shared counter, then work on the slot claimed concurrently with each other:
+     * the slot is published by the release store of the next sequence - the position + 1 (+ Blocks).
+     * The slots are padded onto the separate cache lines: the neighbouring ones are written at once.
+     *
+     * The blocking calls wait on the sequence of the slot: @see utils::WaitStrategy
+     *
+     * @note Without the in-place reservation: the slot claimed would have to be named on commit.
+     */
+    template <typename T, std::size_t Blocks, std::size_t BlockSize>
+    class RingBuffer<T, Blocks, BlockSize, mpmc_t> final
+    {
+
+    public:
+
+        using block_type = block<T, BlockSize>;
+
+        explicit RingBuffer(WaitStrategy wait = {}) noexcept : wait_(wait)
+        {
+            for (std::size_t i = 0; i < Blocks; ++i) {
+                slots_[i].sequence_.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator = (const RingBuffer&) = delete;
+
+        // Producers
+
+        void write(block_type&& data)
+        {
+            const auto [slot, position] = claim_write();
+            slot->block_ = std::move(data);
+            publish(*slot, position + 1);
+        }
+
+        template <typename Collection>
+        requires std::convertible_to<decltype(*std::declval<Collection&>().begin()), T>
+        std::size_t write(Collection&& collection)
+        {
+            const auto written = std::min(BlockSize, collection.size());
+            const auto [slot, position] = claim_write();
+
+            slot->block_.size_ = written;
+            std::copy(collection.cbegin(), std::next(collection.cbegin(), written), slot->block_.data_.begin());
+
+            publish(*slot, position + 1);
+            return written;
+        }
+
+        // Consumers
+
+        bool read(block_type& block)
+        {
+            return consume(no_timeout, [&block](const block_type& slot) { block = slot; });
+        }
+
+        bool read_for(block_type& block, std::chrono::milliseconds timeout)
+        {
+            return consume(deadline(timeout), [&block](const block_type& slot) { block = slot; });
+        }
+
+        template <typename Collection>
+        auto read(Collection& collection)
+        {
+            return consume(no_timeout, append(collection));
+        }
+
+        template <typename Collection>
+        auto read_for(Collection& collection, std::chrono::milliseconds timeout)
+        {
+            return consume(deadline(timeout), append(collection));
+        }
+
+        template <typename Byte>
+        static constexpr bool is_byte = std::is_same_v<Byte, unsigned char> || std::is_same_v<Byte, std::uint8_t> || std::is_same_v<Byte, std::byte>;
+        bool read_bytes(T* ptr, std::size_t& size) requires is_byte<T>
+        {
+            return consume(no_timeout, copy(ptr, size));
+        }
+
+        bool read_bytes_for(T* ptr, std::size_t& size, std::chrono::milliseconds timeout)
+        requires is_byte<T>
+        {
+            return consume(deadline(timeout), copy(ptr, size));
+        }
+
+        // Approximation: the next slot to read is not ready yet
+        bool is_empty() const
+        {
+            const auto position = readPosition_.load(std::memory_order_relaxed);
+            return slots_[position % Blocks].sequence_.load(std::memory_order_acquire) != position + 1;
+        }
+
+    private:
+        using clock_type = std::chrono::steady_clock;
+        static constexpr clock_type::time_point no_timeout = clock_type::time_point::max();
+
+        struct alignas(64) slot_type {
+            std::atomic<std::size_t> sequence_;
+            std::atomic<std::uint32_t> waiters_ {0}; // parked on the sequence
+            block_type block_;
+        };
+
+        static clock_type::time_point deadline(std::chrono::milliseconds timeout)
+        {
+            return clock_type::now() + timeout;
+        }
+
+        template <typename Collection>
+        static auto append(Collection& collection)
+        {
+            return [&collection](const block_type& block)
+            {
+                collection.reserve(block.size_);
+                std::copy(block.data_.cbegin(), std::next(block.data_.cbegin(), block.size_), std::back_inserter(collection));
+            };
+        }
+
+        static auto copy(T* ptr, std::size_t& size)
+        {
+            return [ptr, &size](const block_type& block)
+            {
+                size = std::min(size, block.size_);
+                std::memcpy(ptr, block.data_.data(), size);
+            };
+        }
+
+        static void publish(slot_type& slot, std::size_t sequence)
+        {
+            slot.sequence_.store(sequence, std::memory_order_release);
+            WaitStrategy::notify_all(slot.sequence_, slot.waiters_); // the waiters may be many: all of them check it again
+        }
+
+        // Claim the next free slot: waiting on the consumers to release it, if the buffer is full
+        std::pair<slot_type*, std::size_t> claim_write()
+        {
+            auto position = writePosition_.load(std::memory_order_relaxed);
+            for (;;) {
+                auto& slot = slots_[position % Blocks];
+                const auto sequence = slot.sequence_.load(std::memory_order_acquire);
+                const auto lap = static_cast<std::ptrdiff_t>(sequence - position);
+
+                if (0 == lap) {
+                    if (writePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) return {&slot, position};
+                }
+                else {
+                    if (lap < 0) wait_.wait(slot.sequence_, sequence, slot.waiters_); // full: not read on the previous lap yet
+                    position = writePosition_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Claim the next ready slot, read and release it - for the next lap
+        template <typename Func>
+        bool consume(clock_type::time_point until, Func&& func)
+        {
+            auto position = readPosition_.load(std::memory_order_relaxed);
+            for (;;) {
+                auto& slot = slots_[position % Blocks];
+                const auto sequence = slot.sequence_.load(std::memory_order_acquire);
+                const auto lap = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+                if (0 == lap) {
+                    if (readPosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        std::invoke(std::forward<Func>(func), slot.block_);
+                        publish(slot, position + Blocks);
+                        return true;
+                    }
+                }
+                else {
+                    if (lap < 0) { // empty: not written on this lap yet
+                        if (until == no_timeout) wait_.wait(slot.sequence_, sequence, slot.waiters_);
+                        else if (not wait_.wait_until(slot.sequence_, sequence, until)) return false;
+                    }
+                    position = readPosition_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+    private:
+        alignas(64) std::atomic<std::size_t> writePosition_ {0}; // the next position to claim, by the producers
+        alignas(64) std::atomic<std::size_t> readPosition_ {0};  // and by the consumers
+
+        std::array<slot_type, Blocks> slots_;
+        const WaitStrategy wait_;
+
+    }; // RingBuffer<mpmc_t>
 }
 
 // Unit test
@@ -277,9 +788,290 @@ namespace test {
         stop.request_stop(); // signal cancellation event
 
     }
+
+    // Throughput of the single producer and consumer: the same API, for each policy
+    template <typename Policy, typename...Args>
+    void benchmarkRingBuffer(const char* name, Args&&...args)
+    {
+        using ring_buffer_t = utils::RingBuffer<A, 64, 10>;
+        using policy_buffer_t = utils::RingBuffer<A, 64, 10, Policy>;
+        static_assert(std::is_same_v<typename ring_buffer_t::block_type, typename policy_buffer_t::block_type>);
+
+        constexpr int blocks = 1'000'000;
+        auto ringBuffer = std::make_unique<policy_buffer_t>(std::forward<Args>(args)...);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::jthread producerThread {[&ringBuffer]
+        {
+            for (int i = 0; i < blocks; ++i) {
+                const std::array<A, 2> a {i, -i};
+                ringBuffer->write(a);
+            }
+        }};
+
+        long long sum = 0;
+        for (int i = 0; i < blocks; ++i) {
+            typename policy_buffer_t::block_type data;
+            ringBuffer->read(data);
+            sum += data.data_[0].get() == i; // in order
+        }
+        producerThread.join();
+
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << name << ": " << blocks << " blocks in " << elapsed.count() << " ms"
+                  << ((sum == blocks) ? "" : " - out of order!") << '\n';
+    }
+
+    // Fan in from the producers, and out to the consumers: the same API, for each policy
+    template <typename Policy>
+    void benchmarkFanInOut(const char* name, int producers = 4, int consumers = 4)
+    {
+        using ring_buffer_t = utils::RingBuffer<A, 64, 10, Policy>;
+
+        constexpr int blocks = 250'000; // by each producer
+        auto ringBuffer = std::make_unique<ring_buffer_t>();
+        std::atomic<long long> sum {0};
+
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::vector<std::jthread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.emplace_back([&ringBuffer]
+                {
+                    for (int i = 0; i < blocks; ++i) {
+                        const std::array<A, 1> a {i};
+                        ringBuffer->write(a);
+                    }
+                });
+            }
+
+            const auto total = static_cast<long long>(blocks) * producers;
+            for (int c = 0; c < consumers; ++c) {
+                threads.emplace_back([&ringBuffer, &sum, count = total / consumers + (c < total % consumers)]
+                {
+                    long long local = 0;
+                    for (long long i = 0; i < count; ++i) {
+                        typename ring_buffer_t::block_type data;
+                        ringBuffer->read(data);
+                        local += data.data_[0].get();
+                    }
+                    sum += local;
+                });
+            }
+        } // joined
+
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        const auto expected = static_cast<long long>(blocks) * (blocks - 1) / 2 * producers;
+        std::cout << name << ": " << producers << " x " << blocks << " blocks to " << consumers << " consumers in "
+                  << elapsed.count() << " ms" << ((sum == expected) ? "" : " - lost!") << '\n';
+    }
+
+    // The large blocks of bytes: copied in and out, against filled and parsed in place
+    template <typename Policy, bool InPlace>
+    void benchmarkBytes(const char* name)
+    {
+        using ring_buffer_t = utils::RingBuffer<std::uint8_t, 16, 64 * 1024, Policy>;
+
+        constexpr int blocks = 20'000;
+        auto ringBuffer = std::make_unique<ring_buffer_t>();
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::jthread producerThread {[&ringBuffer]
+        {
+            std::vector<std::uint8_t> payload(64 * 1024);
+            for (int i = 0; i < blocks; ++i) {
+                if constexpr (InPlace) {
+                    auto slot = ringBuffer->acquire_write(); // e.g. recv() straight into the slot
+                    std::memset(slot.data(), i & 0xFF, slot.size());
+                    ringBuffer->commit_write(slot.size());
+                }
+                else {
+                    std::memset(payload.data(), i & 0xFF, payload.size());
+                    ringBuffer->write(payload);
+                }
+            }
+        }};
+
+        std::size_t bytes = 0;
+        std::vector<std::uint8_t> buffer(64 * 1024);
+        for (int i = 0; i < blocks; ++i) {
+            if constexpr (InPlace) {
+                const auto data = ringBuffer->acquire_read();
+                bytes += (data.back() == (i & 0xFF)) ? data.size() : 0;
+                ringBuffer->release_read();
+            }
+            else {
+                std::size_t size = buffer.size();
+                ringBuffer->read_bytes(buffer.data(), size);
+                bytes += (buffer[size - 1] == (i & 0xFF)) ? size : 0;
+            }
+        }
+        producerThread.join();
+
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << name << ": " << (bytes >> 20) << " MiB in " << elapsed.count() << " ms\n";
+    }
 }
 
-int main() 
+// The sweep: run with --benchmark [results.json]
+namespace bench {
+    using result_t = utils::measure::Result;
+
+    using utils::measure::timestamp;
+
+    using utils::measure::items_for;
+
+    template <typename Policy>
+    constexpr const char* policy_name()
+    {
+        if constexpr (std::is_same_v<Policy, utils::spsc_t>) return "spsc";
+        else if constexpr (std::is_same_v<Policy, utils::mpmc_t>) return "mpmc";
+        else return "locked";
+    }
+
+    /**
+     * The items are stamped by the producers, and the handoff latency is taken by the consumers on receiving them:
+     * at the full rate, it includes the time spent queued (the buffer being full).
+     * Either way, the whole block is produced and consumed (summed up): only the copies made differ.
+     */
+    template <typename Policy, std::size_t Slots, std::size_t BlockSize, bool InPlace>
+    result_t run(int producers, int consumers, const char* wait = "blocking")
+    {
+        using ring_buffer_t = utils::RingBuffer<std::uint64_t, Slots, BlockSize, Policy>;
+
+        std::unique_ptr<ring_buffer_t> ringBuffer;
+        if constexpr (std::is_same_v<Policy, utils::locked_t>) ringBuffer = std::make_unique<ring_buffer_t>();
+        else ringBuffer = std::make_unique<ring_buffer_t>(std::string_view{wait} == "adaptive"
+                            ? utils::WaitStrategy::adaptive() : utils::WaitStrategy::blocking());
+
+        constexpr auto blockBytes = BlockSize * sizeof(std::uint64_t);
+        const auto perProducer = items_for(blockBytes) / producers;
+        const auto total = perProducer * producers;
+        std::vector<utils::measure::Samples> latencies(consumers);
+        std::atomic<std::uint64_t> checksum {0}; // keeps the reads
+
+        utils::measure::ElapsedTime<std::chrono::steady_clock, std::chrono::nanoseconds> elapsed;
+        elapsed.start();
+        {
+            std::vector<std::jthread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.emplace_back([&ringBuffer, perProducer]
+                {
+                    std::vector<std::uint64_t> payload(BlockSize);
+                    for (std::size_t i = 0; i < perProducer; ++i) {
+                        if constexpr (InPlace) {
+                            auto slot = ringBuffer->acquire_write();
+                            std::fill(slot.begin(), slot.end(), i);
+                            slot[0] = timestamp();
+                            ringBuffer->commit_write(slot.size());
+                        }
+                        else {
+                            std::fill(payload.begin(), payload.end(), i);
+                            payload[0] = timestamp();
+                            ringBuffer->write(payload);
+                        }
+                    }
+                });
+            }
+
+            for (int c = 0; c < consumers; ++c) {
+                const auto count = total / consumers + (static_cast<std::size_t>(c) < total % consumers);
+                threads.emplace_back([&ringBuffer, &samples = latencies[c], &checksum, count]
+                {
+                    samples.reserve(count);
+                    auto block = std::make_unique<typename ring_buffer_t::block_type>(); // the large ones: off the stack
+                    std::uint64_t sum = 0;
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if constexpr (InPlace) {
+                            const auto data = ringBuffer->acquire_read();
+                            samples.record(timestamp() - data[0]);
+                            sum = std::accumulate(data.begin(), data.end(), sum);
+                            ringBuffer->release_read();
+                        }
+                        else {
+                            ringBuffer->read(*block);
+                            samples.record(timestamp() - block->data_[0]);
+                            sum = std::accumulate(block->data_.cbegin(), block->data_.cend(), sum);
+                        }
+                    }
+                    checksum += sum;
+                });
+            }
+        } // joined
+
+        result_t result;
+        result.m_elapsed = std::chrono::nanoseconds{elapsed.stop()};
+        result.m_name = std::string{"ring_buffer/"} + policy_name<Policy>() + (InPlace ? "/in_place" : "/copied");
+        result.m_params = {{"block_bytes", blockBytes}, {"slots", Slots}
+                        , {"producers", static_cast<std::uint64_t>(producers)}, {"consumers", static_cast<std::uint64_t>(consumers)}
+                        , {"wait", std::string{wait}}};
+        result.m_items = total;
+        result.m_bytes = total * blockBytes;
+
+        for (std::size_t c = 1; c < latencies.size(); ++c) latencies[0].merge(latencies[c]);
+        result.summarize(latencies[0]);
+
+        return result;
+    }
+
+    template <std::size_t Slots, std::size_t BlockSize>
+    void sweep(std::vector<result_t>& results)
+    {
+        const auto add = [&results](result_t result)
+        {
+            std::cout << result << '\n';
+            results.push_back(std::move(result));
+        };
+
+        add(run<utils::locked_t, Slots, BlockSize, false>(1, 1));
+        add(run<utils::locked_t, Slots, BlockSize, true>(1, 1));
+        add(run<utils::locked_t, Slots, BlockSize, false>(4, 4));
+        add(run<utils::spsc_t, Slots, BlockSize, false>(1, 1));
+        add(run<utils::spsc_t, Slots, BlockSize, true>(1, 1));
+        add(run<utils::spsc_t, Slots, BlockSize, true>(1, 1, "adaptive"));
+        add(run<utils::mpmc_t, Slots, BlockSize, false>(1, 1));
+        add(run<utils::mpmc_t, Slots, BlockSize, false>(4, 4));
+        add(run<utils::mpmc_t, Slots, BlockSize, false>(4, 4, "adaptive"));
+    }
+
+    int main(const char* json)
+    {
+        std::vector<result_t> results;
+
+        // The blocks of 64 B, 4 KiB and 64 KiB, over the few and the many slots
+        sweep<4, 8>(results);
+        sweep<64, 8>(results);
+        sweep<4, 512>(results);
+        sweep<64, 512>(results);
+        sweep<4, 8192>(results);
+        sweep<64, 8192>(results);
+
+        if (json && !utils::measure::writeJson(json, results)) {
+            std::cerr << "Failed to write " << json << '\n';
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
 {
+    if (argc > 1 && std::string_view{argv[1]} == "--benchmark") return bench::main(argc > 2 ? argv[2] : nullptr);
+
     test::testRingBuffer();
+
+    test::benchmarkRingBuffer<utils::locked_t>("mutex + semaphores");
+    test::benchmarkRingBuffer<utils::spsc_t>("spsc, blocking", utils::WaitStrategy::blocking());
+    test::benchmarkRingBuffer<utils::spsc_t>("spsc, adaptive", utils::WaitStrategy::adaptive());
+    test::benchmarkRingBuffer<utils::mpmc_t>("mpmc, blocking");
+
+    test::benchmarkFanInOut<utils::locked_t>("mutex + semaphores");
+    test::benchmarkFanInOut<utils::mpmc_t>("mpmc");
+
+    test::benchmarkBytes<utils::locked_t, false>("mutex + semaphores, copied");
+    test::benchmarkBytes<utils::locked_t, true>("mutex + semaphores, in place");
+    test::benchmarkBytes<utils::spsc_t, false>("spsc, copied");
+    test::benchmarkBytes<utils::spsc_t, true>("spsc, in place");
 }
\ No newline at end of file
@@ -9,10 +9,24 @@
 #include <algorithm>
 #include <iterator>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <string_view>
 
+#include "../commons/CoroutineExecutor.h"
+#include "../commons/FramePool.h"
+#include "../measuring/ElapsedTime.h"
+#include "../measuring/Report.h"
 
-#define FUNC() std::cout << __func__ << '\n'
+
+
+inline bool trace = true; // the transitions: off while benchmarking
+#define FUNC() do { if (trace) std::cout << __func__ << '\n'; } while (false)
 
 namespace details
 {
@@ -37,6 +51,10 @@ namespace details
     {
         printIterable(std::cbegin(container), std::cend(container));
     }
+
+    using utils::coro::executor;
+    using utils::coro::inline_executor;
+    using utils::coro::thread_executor;
 }
 
 
@@ -48,19 +66,33 @@ class [[nodiscard]] AudioDataResult final
         
         // Predefined interface that has to be specify in order to implement
         // coroutine's state-machine transitions
-        class promise_type 
+        //
+        // The channel of one value, between the producer and consumer: the state tells whether
+        // it's empty, ready (the value stored), or the consumer waits on it (its handle stored).
+        // The consumer is resumed through the executor, by the producer yielding the value.
+        // The frame comes from the thread-local pool, or from the arena: @see utils::PooledFrame
+        class promise_type : public utils::PooledFrame
         {
             
             public:
                 
                 using value_type = std::vector<int>;
 
+                promise_type() noexcept : executor_(inline_) {}
+
+                // The producer: the first argument tells where the consumer gets resumed
+                template <typename...Args>
+                explicit promise_type(details::executor& executor, Args&&...) noexcept : executor_(executor) {}
+
+                template <typename...Args>
+                promise_type(std::allocator_arg_t, utils::FrameArena&, details::executor& executor, Args&&...) noexcept : executor_(executor) {}
+
                 AudioDataResult get_return_object() 
                 {
                     return AudioDataResult{handle_type::from_promise(*this)};
                 }
                 std::suspend_never initial_suspend() noexcept { return {}; }
-                std::suspend_always final_suspend() noexcept { return {}; }
+                auto final_suspend() noexcept { return FinalAwaiter{*this}; }
                 void return_void() {}
                 void unhandled_exception() 
                 {
@@ -70,13 +102,45 @@ class [[nodiscard]] AudioDataResult final
                 // Generates the value and suspend the "producer"
                 template <typename Data>
                 requires std::convertible_to<std::decay_t<Data>, value_type>
-                std::suspend_always yield_value(Data&& value) 
+                auto yield_value(Data&& value) 
                 {
                     data_ = std::forward<Data>(value);
-                    data_ready_.store(true, std::memory_order_relaxed);
-                    return {};
+                    return YieldAwaiter{*this};
                 }
 
+                void wait() const { done_.wait(false, std::memory_order_acquire); }
+
+                // Tell the ones waiting on the coroutine to be done: @see AudioDataResult::wait
+                struct FinalAwaiter
+                {
+                    promise_type& promise_;
+
+                    bool await_ready() const noexcept { return false; }
+                    void await_suspend(handle_type) const noexcept
+                    {
+                        promise_.done_.store(true, std::memory_order_release);
+                        promise_.done_.notify_all();
+                    }
+                    void await_resume() const noexcept {}
+                };
+
+                // Hand the value over, once the producer is suspended: the consumer may resume it right away
+                struct YieldAwaiter
+                {
+                    promise_type& promise_;
+
+                    bool await_ready() const noexcept { return false; }
+
+                    std::coroutine_handle<> await_suspend(handle_type) const noexcept
+                    {
+                        void* const waiting = promise_.state_.exchange(ready(), std::memory_order_acq_rel);
+                        if (nullptr == waiting) return std::noop_coroutine(); // not awaited yet
+                        return promise_.executor_.schedule(std::coroutine_handle<>::from_address(waiting));
+                    }
+
+                    void await_resume() const noexcept {}
+                };
+
                 auto await_transform(handle_type other) 
                 {
                     // Awaiter interface: for consumer waiting on data being ready
@@ -84,17 +148,18 @@ class [[nodiscard]] AudioDataResult final
                     {
                         explicit AudioDataAwaiter(promise_type& promise) noexcept: promise_(promise) {}
 
-                        bool await_ready() const { return promise_.data_ready_.load(std::memory_order_relaxed);}
+                        bool await_ready() const { return ready() == promise_.state_.load(std::memory_order_acquire);}
                         
-                        void await_suspend(handle_type) const
+                        // Suspend for real: the producer resumes the consumer, once the value is there
+                        bool await_suspend(handle_type consumer) const
                         {
-                            while(not promise_.data_ready_.exchange(false)) {
-                                std::this_thread::yield(); 
-                            }
+                            void* empty = nullptr;
+                            return promise_.state_.compare_exchange_strong(empty, consumer.address(), std::memory_order_acq_rel);
                         }
                         
                         value_type&& await_resume() const 
                         {
+                            promise_.state_.store(nullptr, std::memory_order_relaxed); // the producer is suspended: resumed past this
                             return std::move(promise_.data_);
                         }
 
@@ -107,8 +172,18 @@ class [[nodiscard]] AudioDataResult final
 
         
             private:
+                // The tag of the value stored: never the address of the coroutine frame
+                static void* ready() noexcept
+                {
+                    static char tag;
+                    return &tag;
+                }
+
                 value_type data_;
-                std::atomic<bool> data_ready_;
+                std::atomic<void*> state_ {nullptr}; // empty, ready(), or the consumer waiting
+                std::atomic<bool> done_ {false};
+                details::executor& executor_;
+                inline static details::inline_executor inline_;
         }; //promise_type interface
 
         explicit operator handle_type() const { return handle_;}
@@ -132,6 +207,10 @@ class [[nodiscard]] AudioDataResult final
 
         // For resuming the producer - at the point when the data are consumed
         void resume() {if (not handle_.done()) { FUNC(); handle_.resume();}}
+        void resume_on(details::executor& executor) {if (not handle_.done()) { FUNC(); executor.schedule(handle_).resume();}}
+
+        // Wait on the coroutine to be done: the executors running it are to be stopped, before it's destroyed
+        void wait() const { handle_.promise().wait(); }
 
             
     private:
@@ -143,10 +222,11 @@ class [[nodiscard]] AudioDataResult final
 
 
 using data_type = std::vector<int>;
-AudioDataResult producer(const data_type& data) 
+AudioDataResult producer(details::executor&, const data_type& data) 
 {
     for (std::size_t i = 0; i < 5; ++i) {
         FUNC();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // recording: the consumer is suspended meanwhile
         co_yield data;
     }
     co_yield data_type{}; // exit criteria
@@ -154,7 +234,7 @@ AudioDataResult producer(const data_type& data)
     co_return;
 }
 
-AudioDataResult consumer(AudioDataResult& audioDataResult) 
+AudioDataResult consumer(AudioDataResult& audioDataResult, details::executor& recorder) 
 {
     for(;;)
     {
@@ -164,18 +244,122 @@ AudioDataResult consumer(AudioDataResult& audioDataResult)
         std::cout << "Data received:";
         details::printContainer(data);
 
-        audioDataResult.resume(); // resume producer
+        audioDataResult.resume_on(recorder); // resume producer: records on its own thread
     }
     co_return;
 }
 
-int main() 
+// The handoff cost of the single value channel: run with --benchmark [results.json]
+namespace bench
 {
+    using result_t = utils::measure::Result;
+    using utils::measure::timestamp;
+
+    using utils::measure::items_for;
+
+    AudioDataResult producer(details::executor&, std::size_t items, std::size_t blockSize, std::vector<std::uint64_t>& stamps)
     {
+        data_type data(blockSize);
+        for (std::size_t i = 0; i < items; ++i) {
+            std::fill(data.begin(), data.end(), static_cast<int>(i + 1));
+            stamps[i] = timestamp();
+            co_yield data;
+        }
+        co_yield data_type{}; // exit criteria
+    }
+
+    AudioDataResult consumer(AudioDataResult& producer, details::executor& recorder
+        , const std::vector<std::uint64_t>& stamps, utils::measure::Samples& samples, std::uint64_t& checksum)
+    {
+        for (std::size_t i = 0;; ++i)
+        {
+            const auto data = co_await static_cast<AudioDataResult::handle_type>(producer);
+            if (data.empty()) break;
+            samples.record(timestamp() - stamps[i]);
+            checksum = std::accumulate(data.cbegin(), data.cend(), checksum);
+
+            producer.resume_on(recorder);
+        }
+    }
+
+    // Inline: the consumer resumes the producer on its own thread. Threads: as the demo - each on its executor
+    result_t run(std::size_t blockSize, bool threads)
+    {
+        const auto blockBytes = blockSize * sizeof(int);
+        const auto items = items_for(blockBytes);
+
+        std::vector<std::uint64_t> stamps(items);
+        utils::measure::Samples samples;
+        samples.reserve(items);
+        std::uint64_t checksum = 0;
+
+        utils::measure::ElapsedTime<std::chrono::steady_clock, std::chrono::nanoseconds> elapsed;
+        elapsed.start();
+        if (threads) {
+            details::thread_executor recorder;
+            details::thread_executor player;
+
+            auto audioDataProducer = producer(player, items, blockSize, stamps);
+            auto audioPlayed = consumer(audioDataProducer, recorder, stamps, samples, checksum);
+
+            audioPlayed.wait();
+            recorder.stop();
+            player.stop();
+        }
+        else {
+            details::inline_executor inlined;
+
+            auto audioDataProducer = producer(inlined, items, blockSize, stamps);
+            auto audioPlayed = consumer(audioDataProducer, inlined, stamps, samples, checksum);
+            audioPlayed.wait();
+        }
+
+        result_t result;
+        result.m_elapsed = std::chrono::nanoseconds{elapsed.stop()};
+        result.m_name = "coroutine_2/" + std::string{threads ? "threads" : "inline"};
+        result.m_params = {{"block_bytes", blockBytes}, {"slots", std::uint64_t{1}}, {"producers", std::uint64_t{1}}, {"consumers", std::uint64_t{1}}};
+        result.m_items = items;
+        result.m_bytes = items * blockBytes;
+        result.summarize(samples);
+
+        return result;
+    }
+
+    int main(const char* json)
+    {
+        trace = false;
+
+        std::vector<result_t> results;
+        for (const std::size_t blockSize : {16, 1024, 16384}) {    // 64 B, 4 KiB, 64 KiB
+            for (const bool threads : {false, true}) {
+                results.push_back(run(blockSize, threads));
+                std::cout << results.back() << '\n';
+            }
+        }
+
+        if (json && !utils::measure::writeJson(json, results)) {
+            std::cerr << "Failed to write " << json << '\n';
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::string_view{argv[1]} == "--benchmark") return bench::main(argc > 2 ? argv[2] : nullptr);
+
+    {
+        details::thread_executor recorder; // the producer is resumed there,
+        details::thread_executor player;   // and the consumer there: both idle, while suspended
+
         const data_type data = {1, 2, 3, 4};
-        auto audioDataProducer = producer(data);
-        std::thread t ([&]{auto audioRecorded = consumer(audioDataProducer);});
-        t.join();
+        auto audioDataProducer = producer(player, data);
+        auto audioRecorded = consumer(audioDataProducer, recorder);
+
+        audioRecorded.wait();
+        recorder.stop();
+        player.stop();
     }
 
     std::cout << "bye-bye!\n";
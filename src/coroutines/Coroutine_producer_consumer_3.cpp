@@ -0,0 +1,431 @@
+#include <iostream>
+#include <vector>
+#include <coroutine>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <iterator>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <span>
+#include <stdexcept>
+
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <string_view>
+
+#include "../commons/CoroutineExecutor.h"
+#include "../commons/FramePool.h"
+#include "../measuring/ElapsedTime.h"
+#include "../measuring/Report.h"
+
+
+
+inline bool trace = true; // the transitions: off while benchmarking
+#define FUNC() do { if (trace) std::cout << __func__ << '\n'; } while (false)
+
+namespace details
+{
+    template <typename InputIterator>
+    void printIterable(InputIterator first, InputIterator last)
+    {
+        using value_type = std::decay_t<decltype(*first)>;
+        std::cout << '[';
+        if constexpr (std::is_same_v<std::uint8_t, value_type>) {
+            std::copy(first, std::prev(last), std::ostream_iterator<std::uint16_t>(std::cout, ", "));
+            std::cout << static_cast<std::uint16_t>(*std::prev(last)) << "]\n";
+        }
+        else
+        {
+            std::copy(first, std::prev(last), std::ostream_iterator<value_type>(std::cout, ", "));
+            std::cout << *std::prev(last) << "]\n";
+        }
+    }
+
+    template <typename Container>
+    void printContainer(const Container& container)
+    {
+        printIterable(std::cbegin(container), std::cend(container));
+    }
+
+    using utils::coro::executor;
+    using utils::coro::inline_executor;
+    using utils::coro::thread_executor;
+}
+
+
+// The fixed pool of the frame buffers: allocated once, handed out as the views.
+// Not synchronized: the producer acquires them while running, and the consumer
+// gives them back while the producer is suspended (@see AudioStream).
+class AudioBuffers final
+{
+    public:
+        AudioBuffers(std::size_t frames, std::size_t frameSize) : storage_(frames * frameSize), frameSize_(frameSize)
+        {
+            free_.reserve(frames);
+            for (std::size_t i = frames; i > 0; --i) free_.push_back(i - 1);
+        }
+
+        std::size_t frames() const noexcept { return storage_.size() / frameSize_; }
+
+        std::span<int> acquire()
+        {
+            if (free_.empty()) throw std::logic_error("AudioBuffers: no free frame");
+            const auto index = free_.back();
+            free_.pop_back();
+            return {storage_.data() + index * frameSize_, frameSize_};
+        }
+
+        // The view given back starts at the frame acquired: it may be shorter
+        void release(std::span<const int> frame) noexcept
+        {
+            free_.push_back(static_cast<std::size_t>(frame.data() - storage_.data()) / frameSize_);
+        }
+
+    private:
+        std::vector<int> storage_;
+        std::size_t frameSize_;
+        std::vector<std::size_t> free_;
+};
+
+
+class [[nodiscard]] AudioStream final
+{
+    public:
+        class promise_type;
+        using handle_type = std::coroutine_handle<promise_type>;
+        
+        // The batched generator of the frames, into the pool of buffers: the producer yields the views,
+        // and gets suspended once the batch is full - the consumer takes the whole batch at once.
+        // The buffers of the batch go back to the pool, once the consumer awaits the next one:
+        // while it processes the batch, the producer fills the other one - two batches of buffers are needed.
+        // Neither the frames, nor the batches (reserved up front) are allocated, in the steady state.
+        class promise_type : public utils::PooledFrame
+        {
+            
+            public:
+                
+                using frame_type = std::span<int>;
+                using batch_type = std::span<const frame_type>;
+
+                promise_type() noexcept : executor_(inline_) {}
+
+                // The producer: where the consumer gets resumed, the buffers, and the frames handed over at once
+                template <typename...Args>
+                promise_type(details::executor& executor, AudioBuffers& buffers, std::size_t batch, Args&&...) :
+                    executor_(executor), buffers_(&buffers), batchSize_(std::max<std::size_t>(batch, 1))
+                {
+                    if (buffers.frames() < 2 * batchSize_) throw std::invalid_argument("AudioStream: two batches of buffers needed");
+                    filling_.reserve(batchSize_);
+                    handed_.reserve(batchSize_);
+                }
+
+                AudioStream get_return_object() 
+                {
+                    return AudioStream{handle_type::from_promise(*this)};
+                }
+                std::suspend_never initial_suspend() noexcept { return {}; }
+                auto final_suspend() noexcept { return FinalAwaiter{*this}; }
+                void return_void() {}
+                void unhandled_exception() 
+                {
+                    std::rethrow_exception(std::current_exception());
+                }
+
+                // Batched: the producer is suspended only once the batch is full
+                auto yield_value(frame_type frame) 
+                {
+                    filling_.push_back(frame);
+                    return YieldAwaiter{*this, filling_.size() == batchSize_};
+                }
+
+                void wait() const { done_.wait(false, std::memory_order::acquire); }
+
+                struct YieldAwaiter
+                {
+                    promise_type& promise_;
+                    bool full_;
+
+                    bool await_ready() const noexcept { return not full_; }
+                    std::coroutine_handle<> await_suspend(handle_type) const noexcept { return promise_.hand_over(); }
+                    void await_resume() const noexcept {}
+                };
+
+                // The producer hands over what's left, as the last batch - it may be empty
+                struct FinalAwaiter
+                {
+                    promise_type& promise_;
+
+                    bool await_ready() const noexcept { return false; }
+                    std::coroutine_handle<> await_suspend(handle_type) const noexcept
+                    {
+                        promise_.done_.store(true, std::memory_order::release);
+                        promise_.done_.notify_all();
+                        if (nullptr == promise_.buffers_) return std::noop_coroutine();
+
+                        promise_.last_ = true;
+                        return promise_.hand_over();
+                    }
+                    void await_resume() const noexcept {}
+                };
+
+                // Awaiter interface: for consumer waiting on the batch being ready
+                struct BatchAwaiter 
+                {
+                    explicit BatchAwaiter(promise_type& promise) noexcept: promise_(promise) {}
+
+                    bool await_ready() const { return promise_.ended_ or ready() == promise_.state_.load(std::memory_order::acquire);}
+                    
+                    bool await_suspend(std::coroutine_handle<> consumer) const
+                    {
+                        void* empty = nullptr;
+                        return promise_.state_.compare_exchange_strong(empty, consumer.address(), std::memory_order::acq_rel);
+                    }
+
+                    // The producer is suspended: the previous batch goes back to the pool, and it's swapped with the one filled
+                    batch_type await_resume() const 
+                    {
+                        for (const auto frame : promise_.handed_) promise_.buffers_->release(frame);
+                        promise_.handed_.clear();
+                        if (promise_.ended_) return {};
+
+                        promise_.state_.store(nullptr, std::memory_order::relaxed);
+                        promise_.handed_.swap(promise_.filling_);
+                        promise_.ended_ = promise_.last_;
+                        return promise_.handed_;
+                    }
+
+                    private: 
+                        promise_type& promise_;
+                };//Awaiter interface
+
+        
+            private:
+                // The tag of the batch handed over: never the address of the coroutine frame
+                static void* ready() noexcept
+                {
+                    static char tag;
+                    return &tag;
+                }
+
+                // Once the producer is suspended: the consumer may resume it right away
+                std::coroutine_handle<> hand_over() noexcept
+                {
+                    void* const waiting = state_.exchange(ready(), std::memory_order::acq_rel);
+                    if (nullptr == waiting) return std::noop_coroutine(); // not awaited yet
+                    return executor_.schedule(std::coroutine_handle<>::from_address(waiting));
+                }
+
+                std::vector<frame_type> filling_;   // the producer side
+                std::vector<frame_type> handed_;    // the consumer side
+                bool last_ = false;                 // the batch filled is the last one
+                bool ended_ = false;                // the last batch handed over
+
+                std::atomic<void*> state_ {nullptr}; // empty, ready(), or the consumer waiting
+                std::atomic<bool> done_ {false};
+                details::executor& executor_;
+                AudioBuffers* buffers_ = nullptr;
+                std::size_t batchSize_ = 1;
+                inline static details::inline_executor inline_;
+        }; //promise_type interface
+
+        
+        auto operator co_await() noexcept   
+        {
+            return promise_type::BatchAwaiter{handle_.promise()};
+        }
+
+        // Make the result type move-only, due to ownership over the handle
+        AudioStream(const AudioStream&) = delete;
+        AudioStream& operator=(const AudioStream&) = delete;
+
+        AudioStream(AudioStream&& other) noexcept: handle_(std::exchange(other.handle_, nullptr)){}
+        AudioStream& operator=(AudioStream&& other) noexcept 
+        {
+            using namespace std;
+            AudioStream tmp = std::move(other);
+            swap(*this, tmp);
+            return *this;
+        }
+
+        // d-tor: RAII
+        ~AudioStream() { if (handle_) {FUNC(); handle_.destroy();}}
+
+        // For resuming the producer - once the batch is taken: it fills the next one, meanwhile
+        void resume_on(details::executor& executor) {if (not handle_.done()) { executor.schedule(handle_).resume();}}
+
+        // Wait on the coroutine to be done: the executors running it are to be stopped, before it's destroyed
+        void wait() const { handle_.promise().wait(); }
+    
+    private:
+        AudioStream(handle_type handle) noexcept : handle_(handle) {}
+
+    private:
+    handle_type handle_;
+};
+
+
+AudioStream producer(details::executor&, AudioBuffers& buffers, std::size_t, std::size_t frames) 
+{
+    FUNC();
+    for (std::size_t i = 0; i < frames; ++i) {
+        auto frame = buffers.acquire(); // recording: straight into the buffer
+        std::fill(frame.begin(), frame.end(), static_cast<int>(i));
+        co_yield frame;
+    }
+
+    co_return; // the partial batch: handed over at the end
+}
+
+AudioStream consumer(AudioStream& audioStream, details::executor& recorder) 
+{
+    FUNC();
+    std::size_t frames = 0;
+    std::size_t batches = 0;
+    for(;;)
+    {
+        const auto batch = co_await audioStream; // the previous batch: back to the pool
+        if (batch.empty()) break;
+
+        audioStream.resume_on(recorder); // records the next batch, while this one is processed
+        ++batches;
+        for (const auto frame : batch) {
+            std::cout << "Frame received:";
+            details::printContainer(frame);
+            ++frames;
+        }
+    }
+    std::cout << frames << " frames in " << batches << " batches - exit!\n";
+    co_return;
+}
+
+// The handoff cost per frame, by the batch size: run with --benchmark [results.json]
+namespace bench
+{
+    using result_t = utils::measure::Result;
+    using utils::measure::timestamp;
+
+    using utils::measure::items_for;
+
+    AudioStream producer(details::executor&, AudioBuffers& buffers, std::size_t, std::size_t frames, std::vector<std::uint64_t>& stamps)
+    {
+        for (std::size_t i = 0; i < frames; ++i) {
+            auto frame = buffers.acquire();
+            std::fill(frame.begin(), frame.end(), static_cast<int>(i + 1));
+            stamps[i] = timestamp();
+            co_yield frame;
+        }
+    }
+
+    AudioStream consumer(AudioStream& audioStream, details::executor& recorder
+        , const std::vector<std::uint64_t>& stamps, utils::measure::Samples& samples, std::uint64_t& checksum)
+    {
+        std::size_t frames = 0;
+        for (;;)
+        {
+            const auto batch = co_await audioStream;
+            if (batch.empty()) break;
+
+            audioStream.resume_on(recorder);
+            for (const auto frame : batch) {
+                samples.record(timestamp() - stamps[frames++]);
+                checksum = std::accumulate(frame.begin(), frame.end(), checksum);
+            }
+        }
+    }
+
+    // Inline: the consumer resumes the producer on its own thread. Threads: as the demo - each on its executor
+    result_t run(std::size_t frameSize, std::size_t batch, bool threads)
+    {
+        const auto frameBytes = frameSize * sizeof(int);
+        const auto frames = items_for(frameBytes);
+
+        AudioBuffers buffers{2 * batch, frameSize};
+        std::vector<std::uint64_t> stamps(frames);
+        utils::measure::Samples samples;
+        samples.reserve(frames);
+        std::uint64_t checksum = 0;
+
+        utils::measure::ElapsedTime<std::chrono::steady_clock, std::chrono::nanoseconds> elapsed;
+        elapsed.start();
+        if (threads) {
+            details::thread_executor recorder;
+            details::thread_executor player;
+
+            auto audioProducer = producer(player, buffers, batch, frames, stamps);
+            auto audioPlayed = consumer(audioProducer, recorder, stamps, samples, checksum);
+
+            audioPlayed.wait();
+            recorder.stop();
+            player.stop();
+        }
+        else {
+            details::inline_executor inlined;
+
+            auto audioProducer = producer(inlined, buffers, batch, frames, stamps);
+            auto audioPlayed = consumer(audioProducer, inlined, stamps, samples, checksum);
+            audioPlayed.wait();
+        }
+
+        result_t result;
+        result.m_elapsed = std::chrono::nanoseconds{elapsed.stop()};
+        result.m_name = "coroutine_3/" + std::string{threads ? "threads" : "inline"};
+        result.m_params = {{"block_bytes", frameBytes}, {"slots", 2 * batch}, {"batch", batch}
+                        , {"producers", std::uint64_t{1}}, {"consumers", std::uint64_t{1}}};
+        result.m_items = frames;
+        result.m_bytes = frames * frameBytes;
+        result.summarize(samples);
+
+        return result;
+    }
+
+    int main(const char* json)
+    {
+        trace = false;
+
+        std::vector<result_t> results;
+        for (const std::size_t frameSize : {16, 1024, 16384}) {    // 64 B, 4 KiB, 64 KiB
+            for (const std::size_t batch : {1, 4, 16}) {
+                for (const bool threads : {false, true}) {
+                    results.push_back(run(frameSize, batch, threads));
+                    std::cout << results.back() << '\n';
+                }
+            }
+        }
+
+        if (json && !utils::measure::writeJson(json, results)) {
+            std::cerr << "Failed to write " << json << '\n';
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::string_view{argv[1]} == "--benchmark") return bench::main(argc > 2 ? argv[2] : nullptr);
+
+    {
+        details::thread_executor recorder; // the producer is resumed there,
+        details::thread_executor player;   // and the consumer there
+
+        constexpr std::size_t batch = 4;
+        AudioBuffers buffers{2 * batch, 8};
+
+        auto audioProducer = producer(player, buffers, batch, 10);
+        auto audioPlayed = consumer(audioProducer, recorder);
+
+        audioPlayed.wait();
+        recorder.stop();
+        player.stop();
+    }
+
+    std::cout << "bye-bye!\n";
+    return 0;
+}
@@ -1,7 +1,12 @@
+#include <cstdint>
 #include <iostream>
+#include <new>
 #include <optional>
 #include <string>
 #include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace details
 {
@@ -53,12 +58,105 @@ namespace utils
                  */
                auto build() && { return impl().create(); }
 
+                /**
+                 * Build the outer class in place: returned by value (guaranteed copy elision),
+                 * the properties are moved from the builder - no allocation, no copies.
+                 * The derived builder provides the factory method: Outer make() &&
+                 */
+                auto build_in_place() && { return std::move(impl()).make(); }
+
+                /**
+                 * Build the outer class into the caller storage: i.e. the pool slot
+                 *
+                 * @param storage   Uninitialized storage, suitable for the outer class (size, alignment)
+                 * @return          The built object: to be destroyed by the caller
+                 */
+                auto* build_at(void* storage) &&
+                {
+                    using outer_t = decltype(std::move(impl()).make());
+                    return ::new (storage) outer_t(std::move(impl()).make()); // constructed directly in the storage
+                }
+
         private:
             Derived& impl() { return static_cast<Derived&>(*this); }
 
         private:
             std::tuple<std::optional<Args>&...> m_properties;
     };
+
+
+    /**
+     * Generic builder, with the compile-time checks.
+     * Which properties are set is the part of the builder type (the bit mask): each setter returns
+     * the builder of the next state, moving the properties along. Building with any of the required
+     * properties not set doesn't compile - and the required ones are taken without any runtime checks.
+     *
+     * @tparam Derived  The builder: the class template over the bit mask - CRTP.
+     *                  Provides the mask of the required properties (required), and the factory method
+     *                  for the outer class: Outer make() &&
+     * @tparam Set      The properties set so far: bit per property index
+     * @tparam Args     The types of the properties
+     */
+    template <template <std::uint64_t> class Derived, std::uint64_t Set, typename...Args>
+    class static_builder_t
+    {
+        static_assert(sizeof...(Args) <= 64, "<Builder> Too many properties");
+
+        public:
+                using properties_t = std::tuple<std::optional<Args>...>;
+
+                static_builder_t() = default;
+                explicit static_builder_t(properties_t&& properties) noexcept : m_properties(std::move(properties)) {}
+
+                template <std::size_t Ind>
+                static constexpr bool is_set = 0 != (Set & (std::uint64_t{1} << Ind));
+
+                template <std::size_t Ind>
+                auto setter(auto&& arg) &&
+                {
+                    std::get<Ind>(m_properties).emplace(std::forward<decltype(arg)>(arg));
+                    return Derived<Set | (std::uint64_t{1} << Ind)>{std::move(m_properties)};
+                }
+
+                /**
+                 * Build the outer class in place: returned by value (guaranteed copy elision)
+                 */
+                auto build() &&
+                {
+                    constexpr auto required = Derived<Set>::required;
+                    static_assert((Set & required) == required, "<Builder> Not all required properties are set");
+
+                    if constexpr ((Set & required) == required) return std::move(impl()).make(); // otherwise: only the assertion is reported
+                }
+
+                /**
+                 * @see builder_t::build_at
+                 */
+                auto* build_at(void* storage) &&
+                {
+                    using outer_t = decltype(std::move(*this).build());
+                    return ::new (storage) outer_t(std::move(*this).build());
+                }
+
+        protected:
+
+                /**
+                 * @return The property: moved out - as is, if set (known at compile time), or as optional
+                 */
+                template <std::size_t Ind>
+                decltype(auto) take()
+                {
+                    auto& property = std::get<Ind>(m_properties);
+                    if constexpr (is_set<Ind>) return std::move(*property);
+                    else return std::move(property);
+                }
+
+        private:
+            Derived<Set>& impl() { return static_cast<Derived<Set>&>(*this); }
+
+        private:
+            properties_t m_properties;
+    };
 }
 
 
@@ -88,6 +186,9 @@ class A
                 m_id = builder.m_id;
             }
 
+            // In place: the properties are moved from the builder
+            explicit A(Builder&& builder) noexcept;
+
     public:
             
     
@@ -135,6 +236,15 @@ class A
                 {
                     return std::unique_ptr<A>(new (std::nothrow) A(*this));
                 }
+
+                /**
+                 * The outer class factory method for building in place - called inside
+                 * the generic build_in_place()/build_at() methods
+                 */
+                A make() &&
+                {
+                    return A(std::move(*this));
+                }
         }; // Builder
 
         friend std::ostream& operator << (std::ostream& os, const A& a) 
@@ -147,6 +257,79 @@ class A
         }
 };
 
+inline A::A(Builder&& builder) noexcept : m_name(std::move(builder.m_name)), m_id(std::move(builder.m_id))
+{}
+
+
+/**
+ * The message built at a high rate: the topic and the payload are required,
+ * the priority is optional - without the runtime validation, and without allocating the message
+ */
+class Message
+{
+    std::string m_topic;
+    std::string m_payload;
+    std::optional<int> m_priority;
+
+    Message(std::string&& topic, std::string&& payload, std::optional<int>&& priority) noexcept
+        : m_topic(std::move(topic)), m_payload(std::move(payload)), m_priority(std::move(priority))
+    {}
+
+    public:
+
+        Message(const Message&) = delete;
+        Message& operator = (const Message&) = delete;
+
+        template <std::uint64_t Set = 0>
+        class Builder final : public utils::static_builder_t<Builder, Set, std::string, std::string, int>
+        {
+            using base = utils::static_builder_t<Builder, Set, std::string, std::string, int>;
+
+            public:
+
+                static constexpr std::uint64_t required = 0b011; // the topic, and the payload
+
+                using base::base;
+
+                template <typename T>
+                auto setTopic(T&& topic) &&
+                {
+                    static_assert(details::is_string_v<T>, "<Setter> The argument is not \"string-like\" one");
+                    return std::move(*this).template setter<0>(std::forward<T>(topic));
+                }
+
+                template <typename T>
+                auto setPayload(T&& payload) &&
+                {
+                    static_assert(details::is_string_v<T>, "<Setter> The argument is not \"string-like\" one");
+                    return std::move(*this).template setter<1>(std::forward<T>(payload));
+                }
+
+                auto setPriority(int priority) &&
+                {
+                    return std::move(*this).template setter<2>(priority);
+                }
+
+                /**
+                 * The outer class factory method - called inside the generic build() method.
+                 * The required properties are taken as they are: known to be set
+                 */
+                Message make() &&
+                {
+                    return Message(this->template take<0>(), this->template take<1>(), std::optional<int>(this->template take<2>()));
+                }
+        }; // Builder
+
+        friend std::ostream& operator << (std::ostream& os, const Message& msg)
+        {
+            os << "Topic: " << msg.m_topic << ", payload: " << msg.m_payload;
+            if (msg.m_priority) os << ", priority=" << *msg.m_priority;
+            os << '\n';
+
+            return os;
+        }
+};
+
 
 int main()
 {
@@ -165,4 +348,24 @@ int main()
      // Rebuild it, adding additional properties
      auto c = A::Builder(*b).setId(48).build();
      std::cout << "c: " << *c;
+
+     // In place: by value, or into the caller storage
+     A d = A::Builder(*c).setName("Marko").build_in_place();
+     std::cout << "d: " << d;
+
+     alignas(A) unsigned char storage[sizeof(A)];
+     A* e = A::Builder().setId(3).build_at(storage);
+     std::cout << "e: " << *e;
+     e->~A();
+
+     // Compile-time checked: the required properties
+     Message msg = Message::Builder<>().setTopic("sensors/temperature").setPayload("21.5").setPriority(1).build();
+     std::cout << "msg: " << msg;
+     // Nok: the payload is required
+     //auto nok = Message::Builder<>().setTopic("sensors/temperature").build();
+
+     alignas(Message) unsigned char slot[sizeof(Message)];
+     Message* pMsg = Message::Builder<>().setPayload("on").setTopic("lights/kitchen").build_at(slot);
+     std::cout << "pMsg: " << *pMsg;
+     pMsg->~Message();
 }
\ No newline at end of file
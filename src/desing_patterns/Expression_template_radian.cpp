@@ -2,7 +2,20 @@
 #include <type_traits>
 #include <numbers>
 #include <tuple>
+#include <vector>
+#include <span>
+#include <ranges>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <stdexcept>
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <thread>
 
+#include "../AOT/ThreadPool.h"
+#include "../commons/ParallelFor.h"
 
 namespace utils
 {
@@ -68,7 +81,7 @@ namespace utils
         struct argument
         {
             template <typename UnderlyingType>
-            StrongType operator=(UnderlyingType&& val) const
+            constexpr StrongType operator=(UnderlyingType&& val) const
             {
                 return StrongType(std::forward<UnderlyingType>(val));
             }
@@ -87,22 +100,38 @@ namespace utils
 
 namespace details
 {
+    template <typename Func, typename...Args>
+    class Expression;
+
+    // The sub-expressions are held by value (they are the temporaries: a + b + c), the operands - by reference
+    template <typename T>
+    struct argument_storage { using type = const T&; };
+
+    template <typename Func, typename...Args>
+    struct argument_storage<Expression<Func, Args...>> { using type = Expression<Func, Args...>; };
+
     template <typename Func, typename...Args>
     class Expression
     {
         public:
             using expression_t = Func;
 
-            explicit Expression(Func&& func, const Args&...args) noexcept : expr_(std::forward<Func>(func)), args_(std::tie(args...)) {}
+            constexpr explicit Expression(Func&& func, const Args&...args) noexcept : expr_(std::forward<Func>(func)), args_(args...) {}
 
-            auto operator()() const
+            constexpr auto operator()() const
             {
                 return std::apply(expr_, args_);
             }
 
+            // As the operand of the enclosing expression: the same as the StrongType
+            constexpr auto get() const
+            {
+                return operator()();
+            }
+
         private:
             expression_t expr_;
-            std::tuple<const Args&...> args_; // std::tuple can strore only distinguish types!
+            std::tuple<typename argument_storage<Args>::type...> args_; // std::tuple can strore only distinguish types!
     };
 
     // CTDA
@@ -123,7 +152,7 @@ namespace details
     */
     template <typename LH, typename RH>
     requires add_binary_expression_on_strong_type<LH, RH>
-    auto operator+(const LH& lhs, const RH& rhs) 
+    constexpr auto operator+(const LH& lhs, const RH& rhs) 
     {
         return Expression{[](const auto& arg1, const auto& arg2)
                           { return arg1.get() + arg2.get(); },
@@ -131,6 +160,208 @@ namespace details
                            rhs
                          };
     }
+
+    /*
+        The trigonometry: constexpr - folded at compile time, when the operands are the constants.
+        At runtime, the accuracy tier selects the implementation:
+        - fast:     the table (128 steps per octant), linearly interpolated: ~1e-5
+        - balanced: the polynomial, of degree 9/10: ~1e-9
+        - precise:  std::sin/std::cos (at compile time: the polynomial of degree 19/20, ~1e-16)
+        The argument is reduced to [-pi/4, pi/4] first: accurate for |x| up to ~1e5
+    */
+    namespace trig
+    {
+        enum class accuracy_t { fast, balanced, precise };
+
+        // The Taylor series, by Horner's scheme: x (1 - x^2/(2*3) (1 - x^2/(4*5) (1 - ...))) - the factors precomputed
+        template <std::size_t Terms, std::size_t Offset>
+        inline constexpr auto factors = []
+        {
+            std::array<double, Terms> values {};
+            for (std::size_t n = 1; n < Terms; ++n) values[n] = 1.0 / ((2.0 * n - 1 + Offset) * (2.0 * n + Offset));
+            return values;
+        }();
+
+        template <std::size_t Terms>
+        constexpr double sin_poly(double x) noexcept
+        {
+            const double x2 = x * x;
+            double result = 1.0;
+            for (std::size_t n = Terms - 1; n > 0; --n) result = 1.0 - x2 * factors<Terms, 1>[n] * result;
+            return x * result;
+        }
+
+        template <std::size_t Terms>
+        constexpr double cos_poly(double x) noexcept
+        {
+            const double x2 = x * x;
+            double result = 1.0;
+            for (std::size_t n = Terms - 1; n > 0; --n) result = 1.0 - x2 * factors<Terms, 0>[n] * result;
+            return result;
+        }
+
+        // The sine and cosine over [0, pi/4]
+        inline constexpr std::size_t steps = 128;
+        inline constexpr double step = std::numbers::pi / 4 / steps;
+
+        inline constexpr auto sin_table = []
+        {
+            std::array<double, steps + 1> table {};
+            for (std::size_t i = 0; i <= steps; ++i) table[i] = sin_poly<11>(i * step);
+            return table;
+        }();
+
+        inline constexpr auto cos_table = []
+        {
+            std::array<double, steps + 1> table {};
+            for (std::size_t i = 0; i <= steps; ++i) table[i] = cos_poly<11>(i * step);
+            return table;
+        }();
+
+        constexpr double lookup(const std::array<double, steps + 1>& table, double x) noexcept
+        {
+            const double position = x / step;
+            const auto i = std::min(static_cast<std::size_t>(position), steps - 1);
+            const double fraction = position - i;
+            return table[i] + (table[i + 1] - table[i]) * fraction;
+        }
+
+        template <accuracy_t Accuracy>
+        constexpr double sin_reduced(double x) noexcept
+        {
+            if constexpr (Accuracy == accuracy_t::fast) return x < 0 ? -lookup(sin_table, -x) : lookup(sin_table, x);
+            else if constexpr (Accuracy == accuracy_t::balanced) return sin_poly<5>(x);
+            else return sin_poly<10>(x);
+        }
+
+        template <accuracy_t Accuracy>
+        constexpr double cos_reduced(double x) noexcept
+        {
+            if constexpr (Accuracy == accuracy_t::fast) return lookup(cos_table, x < 0 ? -x : x);
+            else if constexpr (Accuracy == accuracy_t::balanced) return cos_poly<6>(x);
+            else return cos_poly<11>(x);
+        }
+
+        /**
+         * x = k * pi/2 + r, r in [-pi/4, pi/4]: pi/2 split in two (Cody-Waite), so that k * pi/2 is exact
+         * @return The quadrant: k mod 4
+         */
+        constexpr unsigned reduce(double x, double& r) noexcept
+        {
+            constexpr double pio2_hi = 1.57079632673412561417e+00; // the leading 33 bits
+            constexpr double pio2_lo = 6.07710050650619224932e-11;
+
+            const double q = x * (2 / std::numbers::pi);
+            const auto k = static_cast<long long>(q < 0 ? q - 0.5 : q + 0.5);
+            r = (x - k * pio2_hi) - k * pio2_lo;
+            return static_cast<unsigned>(k & 3);
+        }
+
+        template <accuracy_t Accuracy = accuracy_t::precise>
+        constexpr double sin(double x) noexcept
+        {
+            if (Accuracy == accuracy_t::precise && !std::is_constant_evaluated()) return std::sin(x);
+
+            double r = 0;
+            switch (reduce(x, r))
+            {
+                case 0: return sin_reduced<Accuracy>(r);
+                case 1: return cos_reduced<Accuracy>(r);
+                case 2: return -sin_reduced<Accuracy>(r);
+                default: return -cos_reduced<Accuracy>(r);
+            }
+        }
+
+        template <accuracy_t Accuracy = accuracy_t::precise>
+        constexpr double cos(double x) noexcept
+        {
+            if (Accuracy == accuracy_t::precise && !std::is_constant_evaluated()) return std::cos(x);
+
+            double r = 0;
+            switch (reduce(x, r))
+            {
+                case 0: return cos_reduced<Accuracy>(r);
+                case 1: return -sin_reduced<Accuracy>(r);
+                case 2: return -cos_reduced<Accuracy>(r);
+                default: return sin_reduced<Accuracy>(r);
+            }
+        }
+    }
+
+    // The trigonometric expressions: over the StrongType, or the other expression
+    template <trig::accuracy_t Accuracy = trig::accuracy_t::precise, typename Arg>
+    constexpr auto sin(const Arg& arg)
+    {
+        return Expression{[](const auto& a) { return trig::sin<Accuracy>(static_cast<double>(a.get())); }, arg};
+    }
+
+    template <trig::accuracy_t Accuracy = trig::accuracy_t::precise, typename Arg>
+    constexpr auto cos(const Arg& arg)
+    {
+        return Expression{[](const auto& a) { return trig::cos<Accuracy>(static_cast<double>(a.get())); }, arg};
+    }
+
+    /*
+        Evaluating the many expressions at once: past the threshold, in parallel - the chunks of the range
+        across the pool (and the calling thread), and the reduction combines the partials per chunk,
+        in their order (no shared accumulator, the result doesn't depend on the number of threads).
+        @note The pool is to be started
+    */
+    inline constexpr std::size_t parallel_threshold = 1u << 14;
+    inline constexpr std::size_t parallel_chunk = 1u << 12; // the expressions
+
+    template <typename Func>
+    void for_each_chunk(utils::aot::ThreadPool& pool, std::size_t n, const Func& func)
+    {
+        const std::size_t chunks = (n + parallel_chunk - 1) / parallel_chunk;
+        utils::parallel_for(pool, chunks, pool.size(), [&func, n](std::size_t c)
+        {
+            func(c, c * parallel_chunk, std::min(n, (c + 1) * parallel_chunk));
+        });
+    }
+
+    template <std::ranges::random_access_range Expressions, std::ranges::random_access_range Out>
+    void evaluate(utils::aot::ThreadPool& pool, const Expressions& expressions, Out&& out)
+    {
+        if (std::ranges::size(expressions) != std::ranges::size(out)) throw std::length_error("evaluate: the size mismatch");
+
+        const auto eval = [](const auto& expression) { return expression(); };
+        const auto first = std::ranges::begin(expressions);
+        const auto result = std::ranges::begin(out);
+        const std::size_t n = std::ranges::size(expressions);
+
+        if (n < parallel_threshold)
+        {
+            std::transform(first, std::ranges::end(expressions), result, eval);
+            return;
+        }
+
+        for_each_chunk(pool, n, [&](std::size_t, std::size_t begin, std::size_t end)
+        {
+            std::transform(first + begin, first + end, result + begin, eval);
+        });
+    }
+
+    template <std::ranges::random_access_range Expressions, typename T>
+    T sum(utils::aot::ThreadPool& pool, const Expressions& expressions, T init)
+    {
+        const auto eval = [](const auto& expression) -> T { return expression(); };
+        const auto first = std::ranges::begin(expressions);
+        const std::size_t n = std::ranges::size(expressions);
+
+        if (n < parallel_threshold)
+        {
+            return std::transform_reduce(first, std::ranges::end(expressions), init, std::plus{}, eval);
+        }
+
+        std::vector<T> partials((n + parallel_chunk - 1) / parallel_chunk, T{});
+        for_each_chunk(pool, n, [&](std::size_t c, std::size_t begin, std::size_t end)
+        {
+            partials[c] = std::transform_reduce(first + begin, first + end, T{}, std::plus{}, eval);
+        });
+
+        return std::accumulate(partials.begin(), partials.end(), init);
+    }
 }
 
 
@@ -176,5 +407,69 @@ int main()
     const auto c = a + b;
     //std::cout << c << '\n'; // No stream operator overloading for Expression type
     std::cout << c() << '\n'; // expression being evaluated first after calling call operator!
-    
+
+    // Over the constants: the whole tree folded at compile time
+    {
+        static constexpr auto x = utils::StrongType<Radian, struct Arg1>{Radian{std::numbers::pi / 4}};
+        static constexpr auto y = utils::StrongType<Radian, struct Arg2>{Radian{std::numbers::pi / 4}};
+
+        constexpr auto right = details::sin(x + y); // sin(pi/2)
+        static_assert(right() > 1 - 1e-15 && right() < 1 + 1e-15);
+
+        constexpr double folded = details::cos(x + y + x)(); // cos(3pi/4)
+        static_assert(folded > -std::numbers::sqrt2 / 2 - 1e-15 && folded < -std::numbers::sqrt2 / 2 + 1e-15);
+        std::cout << "sin(pi/2) = " << right() << ", cos(3pi/4) = " << folded << '\n';
+    }
+
+    // The hot runtime math: the accuracy tiers, against std::sin
+    {
+        using details::trig::accuracy_t;
+
+        std::vector<double> angles(1u << 20);
+        for (std::size_t i = 0; i < angles.size(); ++i) angles[i] = -100.0 + 200.0 * i / angles.size();
+
+        const auto tier = [&angles]<accuracy_t Accuracy>(const char* name)
+        {
+            double error = 0, checksum = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (const double angle : angles) checksum += details::trig::sin<Accuracy>(angle);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            for (const double angle : angles) error = std::max(error, std::abs(details::trig::sin<Accuracy>(angle) - std::sin(angle)));
+            std::cout << name << ": " << elapsed.count() << " ms, max error " << error << " (checksum " << checksum << ")\n";
+        };
+
+        tier.operator()<accuracy_t::fast>("fast");
+        tier.operator()<accuracy_t::balanced>("balanced");
+        tier.operator()<accuracy_t::precise>("precise");
+    }
+
+    // Many of them: evaluated in parallel
+    {
+        constexpr std::size_t count = 1u << 20;
+
+        std::vector<utils::StrongType<Radian, struct Arg1>> lhs;
+        std::vector<utils::StrongType<Radian, struct Arg2>> rhs;
+        lhs.reserve(count);
+        rhs.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            lhs.emplace_back(Radian{std::numbers::pi / 4});
+            rhs.emplace_back(Radian{std::numbers::pi / 4});
+        }
+
+        std::vector<decltype(lhs[0] + rhs[0])> expressions; // referring to the arguments
+        expressions.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) expressions.push_back(lhs[i] + rhs[i]);
+
+        utils::aot::ThreadPool pool {std::max(std::thread::hardware_concurrency(), 2u) - 1}; // and the calling thread
+        if (!pool.start()) return 1;
+
+        std::vector<Radian> angles(count, Radian{0});
+        details::evaluate(pool, expressions, angles);
+        std::cout << angles.back();
+
+        const Radian total = details::sum(pool, expressions, 0.0);
+        std::cout << "sum of " << count << ": " << total;
+    }
 }
\ No newline at end of file
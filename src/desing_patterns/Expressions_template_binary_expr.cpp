@@ -2,6 +2,23 @@
 #include <type_traits>
 #include <numbers>
 #include <functional>
+#include <span>
+#include <ranges>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "../measuring/ElapsedTime.h"
+#include "../AOT/ThreadPool.h"
+#include "../commons/ParallelFor.h"
 
 
 namespace details
@@ -60,7 +77,19 @@ namespace details
 
     template <typename T>
     concept Numeric = std::is_integral_v<T> || std::is_arithmetic_v<T>;
-    // todo: or objects a.operator+(b)
+
+    // Or objects a.operator+=(b): e.g. the SIMD batches - applied in place, rather than passed around by value:
+    // the wider ones would change the calling convention, outside of the kernels of their target
+    template <typename T>
+    concept Additive = !Numeric<T> && requires(T& a, const T& b) {
+        a += b;
+        a -= b;
+    };
+
+    template <typename T>
+    concept Multiplicative = !Numeric<T> && requires(T& a, const T& b) {
+        a *= b;
+    };
 
     // Binary operations
     struct plus
@@ -70,6 +99,12 @@ namespace details
         {
             return a + b;
         }
+
+        template <Additive T>
+        [[gnu::always_inline]] constexpr void operator()(T& a, const T& b) const
+        {
+            a += b;
+        }
     };
 
     struct minus
@@ -79,6 +114,27 @@ namespace details
         {
             return a - b;
         }
+
+        template <Additive T>
+        [[gnu::always_inline]] constexpr void operator()(T& a, const T& b) const
+        {
+            a -= b;
+        }
+    };
+
+    struct multiplies
+    {
+        template <Numeric T1, Numeric T2>
+        constexpr auto operator()(const T1& a, const T2& b) const
+        {
+            return a * b;
+        }
+
+        template <Multiplicative T>
+        [[gnu::always_inline]] constexpr void operator()(T& a, const T& b) const
+        {
+            a *= b;
+        }
     };
 
     // Expresion templates + operators overloading
@@ -109,6 +165,294 @@ namespace details
                     r
                 };
     }
+
+    // Element-wise expressions over the contiguous ranges: std::vector, std::array, std::span.
+    // The tree is evaluated by the assignment, in the single pass - no temporaries.
+
+    // The SIMD batch of the given width: SSE/AVX/AVX-512 (x86), or NEON (ARM) - the vector extension
+    // maps to the instruction set the function is compiled for
+    template <typename T, std::size_t Bytes>
+    struct simd
+    {
+        typedef T type __attribute__((vector_size(Bytes)));
+        static constexpr std::size_t lanes = Bytes / sizeof(T);
+    };
+
+    template <typename T, std::size_t Bytes>
+    using simd_t = typename simd<T, Bytes>::type;
+
+    template <typename E>
+    concept array_expression = requires(const E& e, std::size_t i) {
+        typename E::value_type;
+        { e.size() } -> std::convertible_to<std::size_t>;
+        { e[i] } -> std::convertible_to<typename E::value_type>;
+    };
+
+    // Leaf: the view of the operand
+    template <Numeric T>
+    struct Terminal
+    {
+        using value_type = T;
+
+        constexpr std::size_t size() const noexcept { return data_.size(); }
+        constexpr T operator[](std::size_t i) const noexcept { return data_[i]; }
+
+        template <std::size_t Bytes>
+        [[gnu::always_inline]] void load(std::size_t i, simd_t<T, Bytes>& batch) const noexcept
+        {
+            std::memcpy(&batch, data_.data() + i, Bytes); // unaligned
+        }
+
+        std::span<const T> data_;
+    };
+
+    template <std::ranges::contiguous_range Range>
+    constexpr auto view(const Range& range) noexcept
+    {
+        return Terminal<std::ranges::range_value_t<Range>>{std::span{range}};
+    }
+
+    template <typename Function, array_expression L, array_expression R>
+    requires std::is_same_v<typename L::value_type, typename R::value_type> // the same lanes
+    struct ElementwiseExpression
+    {
+        using value_type = typename L::value_type;
+
+        constexpr std::size_t size() const noexcept { return l_.size(); }
+        constexpr value_type operator[](std::size_t i) const { return Function{}(l_[i], r_[i]); }
+
+        template <std::size_t Bytes>
+        [[gnu::always_inline]] void load(std::size_t i, simd_t<value_type, Bytes>& batch) const noexcept
+        {
+            simd_t<value_type, Bytes> other;
+            l_.template load<Bytes>(i, batch);
+            r_.template load<Bytes>(i, other);
+            Function{}(batch, other);
+        }
+
+        L l_;
+        R r_;
+    };
+
+    // The node is built over the operands of the same size: the loads don't check the bounds
+    template <typename Function, array_expression L, array_expression R>
+    constexpr auto elementwise(const L& l, const R& r)
+    {
+        if (l.size() != r.size()) throw std::length_error("elementwise: the operand size mismatch");
+        return ElementwiseExpression<Function, L, R>{l, r};
+    }
+
+    template <array_expression L, array_expression R>
+    constexpr auto operator+(const L& l, const R& r)
+    {
+        return elementwise<plus>(l, r);
+    }
+
+    template <array_expression L, array_expression R>
+    constexpr auto operator-(const L& l, const R& r)
+    {
+        return elementwise<minus>(l, r);
+    }
+
+    template <array_expression L, array_expression R>
+    constexpr auto operator*(const L& l, const R& r)
+    {
+        return elementwise<multiplies>(l, r);
+    }
+
+    // The fused loop: the whole tree per batch, then the remainder - one by one
+    template <typename T, typename E>
+    struct AssignKernel
+    {
+        template <std::size_t Bytes>
+        [[gnu::always_inline]] void operator()() const
+        {
+            constexpr auto lanes = simd<T, Bytes>::lanes;
+
+            std::size_t i = first_;
+            for (; i + lanes <= last_; i += lanes)
+            {
+                simd_t<T, Bytes> batch;
+                e_.template load<Bytes>(i, batch);
+                std::memcpy(out_ + i, &batch, Bytes);
+            }
+            for (; i < last_; ++i) out_[i] = e_[i];
+        }
+
+        T* out_;
+        const E& e_;
+        std::size_t first_, last_;
+    };
+
+    // The batch accumulated, then added up across the lanes
+    template <typename E>
+    struct SumKernel
+    {
+        using value_type = typename E::value_type;
+
+        template <std::size_t Bytes>
+        [[gnu::always_inline]] value_type operator()() const
+        {
+            constexpr auto lanes = simd<value_type, Bytes>::lanes;
+
+            simd_t<value_type, Bytes> acc {};
+            std::size_t i = first_;
+            for (; i + lanes <= last_; i += lanes)
+            {
+                simd_t<value_type, Bytes> batch;
+                e_.template load<Bytes>(i, batch);
+                acc += batch;
+            }
+
+            value_type total {};
+            for (std::size_t lane = 0; lane < lanes; ++lane) total += acc[lane];
+            for (; i < last_; ++i) total += e_[i];
+            return total;
+        }
+
+        const E& e_;
+        std::size_t first_, last_;
+    };
+
+#if defined(__x86_64__) && !defined(__AVX512F__) && defined(__GNUC__)
+    // Runtime dispatch: the widest one the CPU supports, unless built for it already
+    template <typename Kernel>
+    [[gnu::target("avx512f")]] auto run_avx512(const Kernel& kernel) { return kernel.template operator()<64>(); }
+
+    template <typename Kernel>
+    [[gnu::target("avx2")]] auto run_avx2(const Kernel& kernel) { return kernel.template operator()<32>(); }
+#endif
+
+    template <typename T, typename Kernel>
+    auto run(const Kernel& kernel)
+    {
+#if defined(__AVX512F__)
+        return kernel.template operator()<64>();
+#elif defined(__x86_64__) && defined(__GNUC__)
+        if (__builtin_cpu_supports("avx512f")) return run_avx512(kernel);
+        if (__builtin_cpu_supports("avx2")) return run_avx2(kernel);
+        return kernel.template operator()<16>(); // SSE2: the baseline
+#elif defined(__ARM_NEON) || defined(__SSE2__)
+        return kernel.template operator()<16>();
+#else
+        return kernel.template operator()<sizeof(T)>(); // scalar
+#endif
+    }
+
+    template <Numeric T, array_expression E>
+    requires std::is_same_v<T, typename E::value_type>
+    void assign(std::span<T> out, const E& e)
+    {
+        if (out.size() != e.size()) throw std::length_error("assign: the expression size mismatch");
+
+        run<T>(AssignKernel<T, E>{out.data(), e, 0, out.size()});
+    }
+
+    template <std::ranges::contiguous_range Range, array_expression E>
+    void assign(Range& out, const E& e)
+    {
+        assign(std::span<std::ranges::range_value_t<Range>>{out}, e);
+    }
+
+    // Reductions
+    template <array_expression E>
+    typename E::value_type sum(const E& e)
+    {
+        return run<typename E::value_type>(SumKernel<E>{e, 0, e.size()});
+    }
+
+    template <array_expression L, array_expression R>
+    auto dot(const L& l, const R& r)
+    {
+        if (l.size() != r.size()) throw std::length_error("dot: the expression size mismatch");
+        return sum(l * r);
+    }
+
+    /**
+     * The parallel evaluation: the index space is split into the chunks - cache-sized,
+     * claimed by the pool workers and the calling thread, one by one (load balancing).
+     * Below the threshold, the evaluation stays serial: not worth the hand-off.
+     *
+     * The workers pick up the chunks as they get to them: waiting within the worker doesn't block,
+     * the chunks left over are evaluated by the caller. Reductions combine the partials of the chunks
+     * in their order: the result doesn't depend on the number of threads.
+     *
+     * @note The pool is to be started
+     */
+    struct parallel
+    {
+        utils::aot::ThreadPool& pool_;
+        std::size_t threshold_ = 1u << 18; // the elements
+        std::size_t chunk_ = 64u << 10;    // the bytes, of each operand
+    };
+
+    // The elements of the chunk: the multiple of the cache line, so that the chunks written don't share it
+    template <typename T>
+    constexpr std::size_t chunk_size(const parallel& policy) noexcept
+    {
+        constexpr std::size_t line = 64 / sizeof(T);
+        return std::max(policy.chunk_ / sizeof(T) / line, std::size_t{1}) * line;
+    }
+
+    template <typename Func>
+    void for_each_chunk(const parallel& policy, std::size_t n, std::size_t chunk, const Func& func)
+    {
+        const std::size_t chunks = (n + chunk - 1) / chunk;
+        utils::parallel_for(policy.pool_, chunks, policy.pool_.size(), [&func, n, chunk](std::size_t c)
+        {
+            func(c, c * chunk, std::min(n, (c + 1) * chunk));
+        });
+    }
+
+    template <Numeric T, array_expression E>
+    requires std::is_same_v<T, typename E::value_type>
+    void assign(const parallel& policy, std::span<T> out, const E& e)
+    {
+        if (out.size() != e.size()) throw std::length_error("assign: the expression size mismatch");
+        if (out.size() < policy.threshold_) return assign(out, e);
+
+        for_each_chunk(policy, out.size(), chunk_size<T>(policy), [&](std::size_t, std::size_t first, std::size_t last)
+        {
+            run<T>(AssignKernel<T, E>{out.data(), e, first, last});
+        });
+    }
+
+    template <std::ranges::contiguous_range Range, array_expression E>
+    void assign(const parallel& policy, Range& out, const E& e)
+    {
+        assign(policy, std::span<std::ranges::range_value_t<Range>>{out}, e);
+    }
+
+    template <array_expression E>
+    typename E::value_type sum(const parallel& policy, const E& e)
+    {
+        using value_type = typename E::value_type;
+        if (e.size() < policy.threshold_) return sum(e);
+
+        // Each on its own cache line: written by the different workers
+        struct alignas(64) Partial
+        {
+            value_type value_ {};
+        };
+
+        const auto chunk = chunk_size<value_type>(policy);
+        std::vector<Partial> partials((e.size() + chunk - 1) / chunk);
+        for_each_chunk(policy, e.size(), chunk, [&](std::size_t c, std::size_t first, std::size_t last)
+        {
+            partials[c].value_ = run<value_type>(SumKernel<E>{e, first, last});
+        });
+
+        value_type total {};
+        for (const auto& partial : partials) total += partial.value_;
+        return total;
+    }
+
+    template <array_expression L, array_expression R>
+    auto dot(const parallel& policy, const L& l, const R& r)
+    {
+        if (l.size() != r.size()) throw std::length_error("dot: the expression size mismatch");
+        return sum(policy, l * r);
+    }
 } // namespace: details
 
 // Domain conversion: radians->degrees
@@ -132,4 +476,62 @@ int main()
 
     const auto em = e2 - e1;
     std::cout << to_degrees(em()) << " [degrees]\n"; 
+
+    // Over the arrays: a + b - c, evaluated in the single pass on assignment
+    {
+        using details::view;
+
+        constexpr std::size_t size = 1u << 24; // 16M floats: 64 MiB per array
+        std::vector<float> a(size, 1.5f), b(size, 2.0f), c(size, 0.25f), out(size);
+
+        // The best of the runs
+        const auto measure = [](auto&& run)
+        {
+            utils::measure::ElapsedTime<std::chrono::steady_clock, std::chrono::microseconds> elapsed;
+            auto best = std::numeric_limits<decltype(elapsed.stop())>::max();
+            for (int i = 0; i < 5; ++i)
+            {
+                elapsed.start();
+                run();
+                best = std::min(best, elapsed.stop());
+            }
+            return best;
+        };
+
+        const auto fused = measure([&] { details::assign(out, view(a) + view(b) - view(c)); });
+
+        // The same, with the temporary per operation
+        std::vector<float> tmp(size), naive(size);
+        const auto temporaries = measure([&]
+        {
+            std::transform(a.cbegin(), a.cend(), b.cbegin(), tmp.begin(), std::plus{});
+            std::transform(tmp.cbegin(), tmp.cend(), c.cbegin(), naive.begin(), std::minus{});
+        });
+
+        constexpr double bytes = 4.0 * size * sizeof(float); // three read, one written
+        std::cout << "a + b - c: " << out[size - 1] << (out == naive ? "" : " - mismatch!")
+                  << ", fused " << fused << " us (" << bytes / fused / 1e3 << " GB/s)"
+                  << ", with temporaries " << temporaries << " us\n";
+
+        // In parallel: the chunks across the pool
+        utils::aot::ThreadPool pool {std::max(std::thread::hardware_concurrency(), 2u) - 1}; // and the calling thread
+        if (!pool.start()) return 1;
+
+        const details::parallel par {pool};
+        std::vector<float> parallel(size);
+        const auto chunked = measure([&] { details::assign(par, parallel, view(a) + view(b) - view(c)); });
+        std::cout << "a + b - c: " << (parallel == out ? "" : "mismatch! ") << "in parallel " << chunked << " us ("
+                  << bytes / chunked / 1e3 << " GB/s), " << pool.size() + 1 << " threads\n";
+
+        // Reductions: the ones, and the halves - exact in float
+        std::vector<float> halves(size, 0.5f);
+        const auto ones = view(halves) + view(halves);
+        std::cout << "sum: " << details::sum(ones) << ", in parallel " << details::sum(par, ones)
+                  << "; dot: " << details::dot(ones, view(halves)) << ", in parallel " << details::dot(par, ones, view(halves)) << '\n';
+
+        std::array<double, 5> x {1, 2, 3, 4, 5}, y {5, 4, 3, 2, 1};
+        std::array<double, 5> z {};
+        details::assign(z, view(x) - view(y) + view(x));
+        std::cout << "x - y + x: " << z[0] << ' ' << z[4] << '\n';
+    }
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <memory>
 #include <memory_resource>
 
+#include "../commons/AllocationPolicy.h"
+
 
 #define fw(arg) std::forward<decltype(arg)>(arg)
 #define log_function() std::cout << __func__ << "():\n"
@@ -36,8 +38,8 @@ namespace details
         {
             //static_assert(std::is_constructible_v<T, Args...>, "<Factory> Invalid arguments pack, or c-tor is not accessible");
             
-            // Allocate memory
-            auto* ptr = m_allocator.allocate(sizeof(T));
+            // Allocate memory: for the single object
+            auto* ptr = m_allocator.allocate(1);
             
             // Construct the object of type T - T::T(Args...) needs to be accessible
             new(ptr)T(std::forward<Args>(args)...); // placement new
@@ -49,7 +51,7 @@ namespace details
                  {
                      ptr->~T(); // @note: call destructor explicitly, since we use placement new
                      std::cout << "<Factory> Deallocate ptr:" << ptr << '\n';
-                     alloc.deallocate(ptr, sizeof(*ptr));
+                     alloc.deallocate(ptr, 1);
                  } 
             };
 
@@ -168,7 +170,42 @@ void test_type_equality()
 }
 
 
+// The short-lived objects: off the general-purpose heap
+void test_allocation_policies()
+{
+    log_function();
+
+    // Monotonic: released all at once
+    alignas(std::max_align_t) std::array<std::byte, 1024> buffer;
+    utils::FrameArena arena {buffer};
+    {
+        auto pa = A::create(details::Factory{utils::ArenaAllocator<A>{arena}}, 1);
+        auto pb = A::create(details::Factory{utils::ArenaAllocator<B>{arena}}, 2);
+        std::cout << "Arena: " << arena.live() << " alive, " << arena.used() << " bytes used\n";
+    }
+    arena.reset();
+
+    // The size classes, with the thread-local free lists: the block freed is reused by the next one
+    for (int id = 3; id < 6; ++id)
+    {
+        auto pb = A::create(details::Factory{utils::PoolAllocator<B>{}}, id);
+        pb->doSomething();
+    }
+    const auto stats = utils::FramePool::stats();
+    std::cout << "Pool: " << stats.m_allocated << " allocated, " << stats.m_reused << " reused\n";
+
+    // Inline: within the owner, the single object
+    utils::InlineBuffer<64> inlined;
+    {
+        auto pa = A::create(details::Factory{utils::InlineAllocator<A>{inlined}}, 6);
+        auto pb = A::create(details::Factory{utils::InlineAllocator<B>{inlined}}, 7); // taken: on the heap
+        std::cout << *pa << *pb;
+    }
+}
+
+
 int main()
 {
     test_type_equality();
+    test_allocation_policies();
 }
\ No newline at end of file
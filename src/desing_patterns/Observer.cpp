@@ -7,6 +7,19 @@
 #include <algorithm>
 #include <utility>
 #include <exception>
+#include <array>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <limits>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <future>
+#include <concepts>
+
+#include "../AOT/ThreadPool.h" // AOThread, ThreadPool: the executors to observe on
+#include "../commons/AllocationPolicy.h"
 
 
 // https://godbolt.org/z/71sacx7Gr
@@ -50,14 +63,14 @@ namespace details
     {
         using allocator_type = std::remove_cvref_t<Allocator>;
 
-        explicit Deleter(allocator_type& allocator) noexcept: allocator_(allocator)
+        explicit Deleter(allocator_type& allocator) noexcept: allocator_(&allocator)
         {}
 
         void operator()(auto* ptr) {
-            allocator_.deallocate(ptr);
+            allocator_->deallocate(ptr);
         }
        private:
-            Allocator& allocator_; // storage needs to outlive deleter
+            allocator_type* allocator_; // storage needs to outlive deleter: reassigned along with the pointer
     };
 
     template<typename T,  class Allocator>
@@ -128,6 +141,7 @@ struct Observer {
       
        using unique_ptr= details::unique_ptr<IObserver, Storage>;
        virtual unique_ptr clone(Storage& storage) const = 0;
+       virtual unique_ptr relocate(Storage& storage) = 0; // moved into the other storage
     };
 
     template <typename Func>
@@ -143,6 +157,8 @@ struct Observer {
       explicit ObserverImpl(Func&& func, onErrorCallback errorCallback) noexcept: ObserverImpl(std::forward<Func>(func), errorCallback, nullptr) 
       {}
 
+      ObserverImpl(const ObserverImpl&) = default;
+      ObserverImpl(ObserverImpl&&) = default;
       ~ObserverImpl() override = default;
 
       void onNext(const value_type& value) override {
@@ -164,6 +180,10 @@ struct Observer {
         return details::make_unique<ObserverImpl>(storage, *this);
       }
 
+      IObserver::unique_ptr relocate(Storage& storage) override { 
+        return details::make_unique<ObserverImpl>(storage, std::move(*this));
+      }
+
       private:
          onNextCallback<std::decay_t<Func>> nextCallback_;
          onErrorCallback errorCallback_;
@@ -180,6 +200,15 @@ struct Observer {
         return details::make_unique<O, Storage>(storage_, std::forward<Args>(args)...);
     }
 
+    IObserver::unique_ptr take(Observer& other) {
+        if constexpr (stealable) {
+            return typename IObserver::unique_ptr{other.observer_.release(), details::Deleter<Storage>{storage_}};
+        }
+        else {
+            return other.observer_->relocate(storage_);
+        }
+    }
+
     public:
     
     //Templated C-tor: customization point
@@ -200,14 +229,26 @@ struct Observer {
     //  Copy functions: to support value semantic
     Observer(const Observer& other): observer_(other.observer_->clone(storage_)) {}
     Observer& operator = (const Observer& other) {
-        Observer tmp(other);
-        tmp.observer_.swap(observer_);
+        if (this != &other) {
+            observer_.reset(); // the storage may hold only one
+            observer_ = other.observer_->clone(storage_);
+        }
         return *this;
     }
 
-    // Move functions - defaulted
-    Observer(Observer&& ) noexcept = default;
-    Observer& operator = (Observer&& ) noexcept = default;
+    // Move functions: with the stateless storage (the heap, the thread-local pool), any instance releases
+    // what the other one allocated - the implementation is handed over. Otherwise, it's moved into
+    // the own storage: the stack one can't be handed over
+    static constexpr bool stealable = std::is_empty_v<Storage>;
+
+    Observer(Observer&& other) noexcept(stealable): observer_(take(other)) {}
+    Observer& operator = (Observer&& other) noexcept(stealable) {
+        if (this != &other) {
+            observer_.reset();
+            observer_ = take(other);
+        }
+        return *this;
+    }
 
     //NVI: onNext method that support both, lvalue & rvalue arguments
     // @see Consumer<T> implementation
@@ -226,38 +267,297 @@ struct Observer {
     }
 };
 
+// Flow control: what happens to the items the subscriber can't keep up with
+enum class overflow_t : std::uint8_t {
+    drop,   // the newest item is discarded
+    latest, // the oldest one is discarded: the latest ones are kept
+    block   // the producer waits for the room
+};
+
+struct Backpressure {
+    std::size_t capacity_ = 64; // the items buffered for the subscriber
+    overflow_t overflow_ = overflow_t::drop;
+};
+
+template <typename Observer>
+class Observable;
+
+/**
+  The subscription with the demand signaling (reactive streams): the observer is given
+  only as many items as it has requested, the rest is buffered - bounded, with the overflow policy.
+  
+  The items are delivered by whoever finds them deliverable - the producer emitting while there is the demand,
+  or the subscriber requesting while there are items buffered: one at a time, in order.
+  The observer that is not to be run by the producer at all requests only the ones buffered: @see pending
+*/
+template <typename Observer>
+class Subscription final {
+ public:
+    using observer_type = std::decay_t<Observer>;
+    using value_type = typename observer_type::value_type;
+    using error_type = typename observer_type::error_type;
+
+    Subscription(const observer_type& observer, Backpressure backpressure) :
+        observer_(observer),
+        overflow_(backpressure.overflow_),
+        buffer_(std::max<std::size_t>(backpressure.capacity_, 1))
+    {}
+
+    Subscription(const Subscription&) = delete;
+    Subscription& operator = (const Subscription&) = delete;
+
+    // Demand: the observer is ready for n more items - the buffered ones are delivered right away, on the calling thread
+    void request(std::size_t n) {
+        {
+            std::lock_guard lock{lock_};
+            demand_ = (n > unbounded - demand_) ? unbounded : demand_ + n;
+        }
+        drain();
+    }
+
+    // No more items: releases the producer, if blocked
+    void cancel() {
+        {
+            std::lock_guard lock{lock_};
+            cancelled_ = true;
+            clear();
+        }
+        notFull_.notify_all();
+    }
+
+    std::size_t pending() const {
+        std::lock_guard lock{lock_};
+        return count_;
+    }
+
+    std::size_t dropped() const {
+        std::lock_guard lock{lock_};
+        return dropped_;
+    }
+
+    static constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+
+ private:
+    template <typename> friend class Observable;
+
+    template <typename U>
+    void offer(U&& item) {
+        {
+            std::unique_lock lock{lock_};
+            if (cancelled_ || terminal_) return;
+
+            if (count_ == buffer_.size()) {
+                switch (overflow_) {
+                    case overflow_t::drop:
+                        ++dropped_;
+                        return;
+                    case overflow_t::latest:
+                        pop();
+                        ++dropped_;
+                        break;
+                    case overflow_t::block:
+                        notFull_.wait(lock, [this]{ return count_ < buffer_.size() || cancelled_; });
+                        if (cancelled_) return;
+                        break;
+                }
+            }
+
+            buffer_[(head_ + count_) % buffer_.size()].emplace(std::forward<U>(item));
+            ++count_;
+        }
+        drain();
+    }
+
+    // Delivered once the items buffered are: it takes no demand
+    void terminate(std::optional<error_type> error) {
+        {
+            std::lock_guard lock{lock_};
+            if (cancelled_ || terminal_) return;
+            terminal_ = true;
+            error_ = std::move(error);
+        }
+        drain();
+    }
+
+    // The one delivering at a time: those that come meanwhile leave it to the one in progress
+    void drain() {
+        std::unique_lock lock{lock_};
+        if (draining_) return;
+        draining_ = true;
+
+        while (!cancelled_ && demand_ > 0 && count_ > 0) {
+            auto item = pop();
+            if (demand_ != unbounded) --demand_;
+            lock.unlock();
+
+            notFull_.notify_one();
+            observer_.onNext(std::move(item));
+
+            lock.lock();
+        }
+
+        const bool terminate = !cancelled_ && terminal_ && 0 == count_ && !terminated_;
+        if (terminate) terminated_ = true;
+        draining_ = false;
+        lock.unlock();
+
+        if (terminate) {
+            if (error_) observer_.onError(*error_);
+            else observer_.onCompletion();
+        }
+    }
+
+    // Under the lock
+    value_type pop() {
+        auto& slot = buffer_[head_];
+        value_type item = std::move(*slot);
+        slot.reset();
+        head_ = (head_ + 1) % buffer_.size();
+        --count_;
+        return item;
+    }
+
+    void clear() {
+        while (count_ > 0) pop();
+    }
+
+ private:
+    observer_type observer_;
+    const overflow_t overflow_;
+
+    mutable std::mutex lock_;
+    std::condition_variable notFull_; // the producer blocked: overflow_t::block
+    std::vector<std::optional<value_type>> buffer_; // the ring: allocated once
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+    std::size_t demand_ = 0;
+    std::size_t dropped_ = 0;
+    std::optional<error_type> error_;
+    bool terminal_ = false;   // completed, or failed
+    bool terminated_ = false; // and told so
+    bool cancelled_ = false;
+    bool draining_ = false;
+};
+
+/**
+  The subscribers, stored by value: contiguously - the broadcast is the linear scan, with no pointer chasing.
+
+  Read-copy-update: the notification takes the snapshot, with no lock, while subscribe and unsubscribe
+  publish the new copy (serialized among themselves). The snapshot stays valid for as long as
+  the notification runs over it: the late subscriber is notified from the next one on.
+  @note Being copied along, the observers are to keep their state outside (by reference)
+*/
+template <typename Observer>
+class SubscriberRegistry final : public std::enable_shared_from_this<SubscriberRegistry<Observer>> {
+ public:
+    using observer_type = std::decay_t<Observer>;
+    using id_type = std::uint64_t;
+
+    struct Entry {
+        id_type id_;
+        observer_type observer_;
+    };
+    using snapshot_type = std::vector<Entry>;
+
+    // Unsubscribes on going out of scope, or being reset
+    class Handle final {
+     public:
+        Handle() = default;
+        Handle(std::weak_ptr<SubscriberRegistry> registry, id_type id) noexcept : registry_(std::move(registry)), id_(id) {}
+        ~Handle() { reset(); }
+
+        Handle(Handle&& other) noexcept : registry_(std::move(other.registry_)), id_(std::exchange(other.id_, 0)) {}
+        Handle& operator = (Handle&& other) noexcept {
+            Handle tmp(std::move(other));
+            std::swap(registry_, tmp.registry_);
+            std::swap(id_, tmp.id_);
+            return *this;
+        }
+
+        explicit operator bool() const noexcept { return 0 != id_; }
+
+        void reset() {
+            if (auto registry = registry_.lock(); registry && id_) registry->remove(id_);
+            id_ = 0;
+        }
+
+     private:
+        std::weak_ptr<SubscriberRegistry> registry_;
+        id_type id_ = 0;
+    };
+
+    Handle add(const observer_type& observer) {
+        std::lock_guard lock{writeLock_};
+        const auto current = snapshot_.load(std::memory_order_relaxed);
+
+        auto next = std::make_shared<snapshot_type>();
+        next->reserve(current->size() + 1);
+        next->assign(current->cbegin(), current->cend());
+        const auto id = ++lastId_;
+        next->push_back(Entry{id, observer});
+
+        snapshot_.store(std::move(next), std::memory_order_release);
+        return Handle{this->weak_from_this(), id};
+    }
+
+    void remove(id_type id) {
+        std::lock_guard lock{writeLock_};
+        const auto current = snapshot_.load(std::memory_order_relaxed);
+
+        auto next = std::make_shared<snapshot_type>();
+        next->reserve(current->size());
+        std::copy_if(current->cbegin(), current->cend(), std::back_inserter(*next), [id](const Entry& entry) { return entry.id_ != id; });
+
+        snapshot_.store(std::move(next), std::memory_order_release);
+    }
+
+    std::shared_ptr<snapshot_type> snapshot() const {
+        return snapshot_.load(std::memory_order_acquire);
+    }
+
+ private:
+    std::mutex writeLock_;
+    id_type lastId_ = 0;
+    std::atomic<std::shared_ptr<snapshot_type>> snapshot_ {std::make_shared<snapshot_type>()};
+};
+
 template <typename Observer>
 class Observable {
  public:
     using observer_type = std::decay_t<Observer>;
+    using subscription_type = Subscription<observer_type>;
+    using registry_type = SubscriberRegistry<observer_type>;
    /**
       Subscribe the observer, by meaning of the callable
       that will be invoked each time when there is something to be 
       emitted.
-      @note In order to utilize on RVO, the return value must not be discarded
+      @note In order to utilize on RVO, the return value must not be discarded:
+      the observer is unsubscribed along with it
+   */
+   [[nodiscard]] typename registry_type::Handle subscribe(const observer_type& observer) {
+       return registry_->add(observer);
+    }
+
+   /**
+      Subscribe the observer with the flow control: it receives only the items requested, 
+      @see Subscription::request
    */
-   [[nodiscard]] std::shared_ptr<observer_type> subscribe(const observer_type& observer) {
-       auto subscription = std::make_shared<observer_type>(observer);
-       observers_.push_back(subscription);
-       return subscription;   
+   [[nodiscard]] std::shared_ptr<subscription_type> subscribe(const observer_type& observer, Backpressure backpressure) {
+       auto subscription = std::make_shared<subscription_type>(observer, backpressure);
+       std::lock_guard lock{subscriptionsLock_};
+       subscriptions_.push_back(subscription);
+       return subscription;
     }
  private:
     //template <typename Item>
     //using notify_f = void (observer_type::*)(Item&&);
 
     template <typename T, typename Func>
-    void notifyImpl(T&& item, Func&& func) {
-        using std::cbegin;
-        using std::cend;
-
-        auto notify = [item = std::forward<T>(item), func = std::forward<Func>(func)](const auto& observer) {
-            if (auto ptr = observer.lock()){
-                std::invoke(func, *ptr, item);
-            }
-        };
-        std::for_each(cbegin(observers_),
-                      cend(observers_),
-                      notify);
+    void notifyImpl(const T& item, Func&& func) {
+        const auto snapshot = registry_->snapshot(); // no lock: subscribing meanwhile publishes the new one
+        for (auto& entry : *snapshot) {
+            std::invoke(func, entry.observer_, item);
+        }
     }
  public:
     template <typename T>
@@ -273,19 +573,56 @@ class Observable {
             }
             observer.onNext(val);
         };
+        offer(value);
         notifyImpl(std::forward<T>(value), dispatch);
     }
 
     void notifyError(typename observer_type::error_type error) {
+        for (const auto& subscription : flowControlled()) {
+            subscription->terminate(error);
+        }
         notifyImpl(error, &observer_type::onError);
     }
 
     void notifyCompletion() {
-        notifyImpl(&observer_type::onCompletion);
+        for (const auto& subscription : flowControlled()) {
+            subscription->terminate(std::nullopt);
+        }
+        const auto snapshot = registry_->snapshot();
+        for (auto& entry : *snapshot) {
+            entry.observer_.onCompletion();
+        }
     }
 
  private:
-   std::vector<std::weak_ptr<observer_type>> observers_;
+    template <typename T>
+    void offer(const T& value) {
+        for (const auto& subscription : flowControlled()) {
+            subscription->offer(value);
+        }
+    }
+
+    // The flow-controlled subscriptions still alive - the expired ones pruned: called outside the lock
+    std::vector<std::shared_ptr<subscription_type>> flowControlled() {
+        std::vector<std::shared_ptr<subscription_type>> alive;
+
+        std::lock_guard lock{subscriptionsLock_};
+        if (subscriptions_.empty()) return alive;
+
+        alive.reserve(subscriptions_.size());
+        std::erase_if(subscriptions_, [&alive](const auto& subscription) {
+            auto ptr = subscription.lock();
+            if (!ptr) return true;
+            alive.push_back(std::move(ptr));
+            return false;
+        });
+        return alive;
+    }
+
+ private:
+   std::shared_ptr<registry_type> registry_ = std::make_shared<registry_type>();
+   std::mutex subscriptionsLock_; // subscribe may run concurrently with the notification
+   std::vector<std::weak_ptr<subscription_type>> subscriptions_; // with the flow control
 };
 
 //Operators: map example
@@ -319,6 +656,157 @@ auto map(Func&& func) {
 }
 
 
+//Operators: scheduling - AOThread, ThreadPool, or anything else that runs the job posted
+
+template <typename Executor>
+concept executor = requires(Executor& executor) {
+    executor.post([]{});
+};
+
+/**
+  The observers are notified on the executor, rather than on the emitting thread.
+  The items emitted meanwhile are coalesced into the single job - delivered as the batch:
+  one batch is in flight at a time (even on the pool), so the order is preserved.
+  @note The executor is to outlive the deliveries
+*/
+template <typename Observer, executor Executor>
+class ObserveOn final {
+ public:
+    using observer_type = std::decay_t<Observer>;
+    using value_type = typename observer_type::value_type;
+    using error_type = typename observer_type::error_type;
+
+    explicit ObserveOn(Executor& executor) : state_(std::make_shared<State>(executor)) {}
+
+    [[nodiscard]] auto subscribe(const observer_type& observer) {
+        return state_->downstream_.subscribe(observer);
+    }
+
+    template <typename T>
+    requires std::is_base_of_v<value_type, std::decay_t<T>> || std::convertible_to<T, value_type>
+    void notify(T&& value) {
+        state_->push(std::forward<T>(value));
+    }
+
+    void notifyError(error_type error) {
+        state_->terminate(std::move(error));
+    }
+
+    void notifyCompletion() {
+        state_->terminate(std::nullopt);
+    }
+
+    // The scheduling hops taken
+    std::size_t batches() const noexcept {
+        return state_->batches_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    // Shared with the job scheduled: outlives the operator
+    struct State : std::enable_shared_from_this<State> {
+        explicit State(Executor& executor) noexcept : executor_(executor) {}
+
+        template <typename T>
+        void push(T&& value) {
+            {
+                std::lock_guard lock{lock_};
+                if (terminal_) return;
+                pending_.emplace_back(std::forward<T>(value));
+                if (std::exchange(scheduled_, true)) return; // taken by the batch in flight
+            }
+            schedule();
+        }
+
+        // Delivered after the items emitted before
+        void terminate(std::optional<error_type> error) {
+            {
+                std::lock_guard lock{lock_};
+                if (terminal_) return;
+                terminal_ = true;
+                error_ = std::move(error);
+                if (std::exchange(scheduled_, true)) return;
+            }
+            schedule();
+        }
+
+        void schedule() {
+            executor_.post([self = this->shared_from_this()]{ self->drain(); });
+        }
+
+        void drain() {
+            for (;;) {
+                {
+                    std::lock_guard lock{lock_};
+                    batch_.swap(pending_); // both reused: no allocation, once grown
+                    if (batch_.empty()) {
+                        scheduled_ = false;
+                        if (!terminal_ || std::exchange(terminated_, true)) return;
+                    }
+                }
+
+                if (batch_.empty()) { // nothing is emitted past the terminal one
+                    if (error_) downstream_.notifyError(*error_);
+                    else downstream_.notifyCompletion();
+                    return;
+                }
+
+                batches_.fetch_add(1, std::memory_order_relaxed);
+                for (const auto& item : batch_) downstream_.notify(item);
+                batch_.clear();
+            }
+        }
+
+        Executor& executor_;
+        Observable<Observer> downstream_;
+
+        std::mutex lock_;
+        std::vector<value_type> pending_;   // emitted
+        std::vector<value_type> batch_;     // being delivered: by the one job in flight
+        std::optional<error_type> error_;
+        bool scheduled_ = false;
+        bool terminal_ = false;
+        bool terminated_ = false;
+        std::atomic<std::size_t> batches_ {0};
+    };
+
+    std::shared_ptr<State> state_;
+};
+
+template <typename Observer, executor Executor>
+auto observeOn(Executor& executor) {
+    return ObserveOn<Observer, Executor>{executor};
+}
+
+/**
+  The source - emitting into the observable given - is run on the executor, once subscribed:
+  the subscribing thread doesn't wait on it. Cold: each subscription runs it anew.
+*/
+template <typename Observer, executor Executor, typename Source>
+requires std::invocable<Source&, Observable<Observer>&>
+class SubscribeOn final {
+ public:
+    using observer_type = std::decay_t<Observer>;
+
+    SubscribeOn(Executor& executor, Source source) : executor_(executor), source_(std::move(source)) {}
+
+    [[nodiscard]] auto subscribe(const observer_type& observer) {
+        auto observable = std::make_shared<Observable<Observer>>();
+        auto subscription = observable->subscribe(observer);
+        executor_.post([observable, source = source_]() mutable { std::invoke(source, *observable); });
+        return subscription;
+    }
+
+ private:
+    Executor& executor_;
+    Source source_;
+};
+
+template <typename Observer, executor Executor, typename Source>
+auto subscribeOn(Executor& executor, Source&& source) {
+    return SubscribeOn<Observer, Executor, std::decay_t<Source>>{executor, std::forward<Source>(source)};
+}
+
+
 // Subject to observe: one can use the strong type for fields
 struct Person {
     std::string name_;
@@ -336,6 +824,8 @@ int main()
 {
    // Alias as customization point for storage
    // using Storage = details::DynamicStorage;
+   // using Storage = utils::PoolStorage;      // the thread-local size classes
+   // using Storage = utils::InlineStorage<128u>; // inline, or the heap - if it doesn't fit
    using Storage = details::StackStorage<128u, alignof(void*)>;
 
    using PersonObserver = Observer<Person, Storage>;
@@ -360,4 +850,104 @@ int main()
 
    personNameObservable.notify(alex);
 
+   // Allocation policies: the short-lived observers, off the heap
+   {
+       alignas(std::max_align_t) std::array<std::byte, 4096> buffer;
+       utils::FrameArena arena {buffer};
+       {
+           utils::ArenaScope scope {arena}; // taken by the storage created meanwhile, on this thread
+           using ArenaObserver = Observer<Person, utils::ArenaStorage>;
+           Observable<ArenaObserver> observable;
+           auto first = observable.subscribe(ArenaObserver{[](const auto& person){ std::cout << "Arena: " << person; }});
+           observable.notify(alex);
+       }
+       std::cout << "Arena: " << arena.live() << " alive, of " << arena.used() << " bytes used\n";
+       arena.reset();
+
+       using PoolObserver = Observer<Person, utils::PoolStorage>;
+       using InlineObserver = Observer<Person, utils::InlineStorage<16u>>; // too small: on the heap
+       utils::PoolStorage pool; // the make_unique<T, Storage> customization point: the storage outlives the object
+       auto pooled = details::make_unique<PoolObserver>(pool, [](const auto& person){ std::cout << "Pool: " << person; });
+       InlineObserver{[](const auto& person){ std::cout << "Inline: " << person; }}.onNext(alex);
+       if (pooled) pooled->onNext(alex);
+   }
+
+   // Subscribing and unsubscribing, while being notified: no lock taken by the notification
+   {
+       using CountObserver = Observer<int, Storage>;
+       Observable<CountObserver> counter;
+
+       std::atomic<long> received {0};
+       auto subscription = counter.subscribe(CountObserver{[&received](int i){ received += i; }});
+
+       std::jthread notifier {[&counter]{ for (int i = 0; i < 10'000; ++i) counter.notify(1); }};
+       for (int i = 0; i < 100; ++i) {
+           auto temporary = counter.subscribe(CountObserver{[&received](int value){ received += value; }});
+       } // unsubscribed
+       notifier.join();
+
+       std::cout << "Received: " << received << " (at least 10000)\n";
+   }
+
+   // Scheduling: emitted on the pool (subscribeOn), observed on the single thread (observeOn) - in batches
+   {
+       using QuoteObserver = Observer<double, Storage>;
+
+       utils::aot::ThreadPool pool {2};
+       utils::aot::AOThread ui;
+       if (!pool.start() || !ui.start()) return 1;
+
+       auto onUi = observeOn<QuoteObserver>(ui);
+       std::size_t received = 0;
+       double last = 0;
+       std::promise<void> done;
+       auto uiSubscription = onUi.subscribe(QuoteObserver{[&received, &last](double price){ ++received; last = price; },
+                                                          nullptr,
+                                                          [&done]{ done.set_value(); }});
+
+       auto feed = subscribeOn<QuoteObserver>(pool, [](Observable<QuoteObserver>& quotes){
+           for (int i = 1; i <= 10'000; ++i) quotes.notify(100.0 + i * 0.01);
+           quotes.notifyCompletion();
+       });
+       auto feedSubscription = feed.subscribe(QuoteObserver{[&onUi](double price){ onUi.notify(price); },
+                                                            nullptr,
+                                                            [&onUi]{ onUi.notifyCompletion(); }});
+
+       done.get_future().wait();
+       std::cout << "Observed: " << received << " quotes in " << onUi.batches() << " batches, the last one " << last << '\n';
+   }
+
+   // Flow control: the market data emitted at the full rate, to the slow observer
+   using QuoteObserver = Observer<double, Storage>;
+
+   for (const auto overflow : {overflow_t::drop, overflow_t::latest, overflow_t::block}) {
+       Observable<QuoteObserver> quotes;
+
+       std::size_t fast = 0;
+       auto fastSubscription = quotes.subscribe(QuoteObserver{[&fast](double){ ++fast; }}, Backpressure{});
+       fastSubscription->request(Subscription<QuoteObserver>::unbounded); // keeps up: as if subscribed directly
+
+       std::size_t slow = 0;
+       double last = 0;
+       auto slowSubscription = quotes.subscribe(QuoteObserver{[&slow, &last](double price){ ++slow; last = price; },
+                                                              nullptr,
+                                                              [&slow, &last]{ std::cout << "Slow: " << slow << " quotes, the last one " << last << '\n'; }},
+                                                Backpressure{.capacity_ = 16, .overflow_ = overflow});
+
+       std::jthread consumer {[slowSubscription](std::stop_token stop){
+           while (!stop.stop_requested()) {
+               std::this_thread::sleep_for(std::chrono::milliseconds(1)); // processing
+               if (slowSubscription->pending()) slowSubscription->request(1);
+           }
+           slowSubscription->request(Subscription<QuoteObserver>::unbounded); // the rest, and the completion
+       }};
+
+       for (int i = 1; i <= 200; ++i) quotes.notify(100.0 + i * 0.01);
+       consumer.request_stop();
+       consumer.join();
+
+       quotes.notifyCompletion();
+       std::cout << "Overflow " << static_cast<int>(overflow) << ": dropped " << slowSubscription->dropped()
+                 << ", fast: " << fast << " quotes\n";
+   }
 }
\ No newline at end of file
@@ -5,12 +5,28 @@
  *      Author: <a href="mailto:damirlj@yahoo.com">Damir Ljubic</a>
  */
 
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
 #include <iterator>
+#include <optional>
+#include <system_error>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 
 #include "Directory.h"
+#include "../measuring/TraceScope.h"
 
 
 using namespace utils::files;
@@ -18,39 +34,684 @@ using namespace std;
 using namespace std::filesystem;
 
 
-Directory::Directory(path_t root) noexcept : m_root(root),
-        m_pSyncThread(make_unique<utils::aot::AOThread>())
+Directory::Directory(path_t root, std::size_t parallelism) noexcept : m_root(root),
+        m_pSyncThread(make_unique<utils::aot::AOThread>(utils::aot::dequeue_policy_t::drain))
 {
+    if (parallelism > 1)
+    {
+        m_pPool = make_unique<utils::aot::ThreadPool>(parallelism);
+        if (!m_pPool->start()) m_pPool.reset(); // the sequential walk, instead
+    }
+
     m_pSyncThread->start();
 }
 
 Directory::~Directory()
 {
-    m_pSyncThread->stop();
+    m_pSyncThread->stop(); // joined: the watcher is set up within
+
+    if (m_watcher.joinable())
+    {
+        const std::uint64_t stop = 1;
+        (void)::write(m_wakeup, &stop, sizeof stop);
+        m_watcher.join();
+    }
+
+    if (m_wakeup >= 0) (void)::close(m_wakeup);
+    if (m_inotify >= 0) (void)::close(m_inotify);
+}
+
+std::int64_t Directory::modifiedTime(const path_t& directory) noexcept
+{
+    struct stat st {};
+    if (0 != ::stat(directory.c_str(), &st)) return DirectoryIndex::unvisited;
+
+    return static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
 }
 
-void Directory::getAllEntries(std::filesystem::path root)
+void Directory::getAllEntries(const path_t& directory, id_t id, Result& result) const
 {
-    for (const auto& entry : directory_iterator {root} )
+    // The watch and the modification time go first: nothing changed during the iteration is missed
+    if (const auto wd = addWatch(m_inotify, directory); wd >= 0) result.m_watches.push_back({wd, Watch{directory, id}});
+    result.m_index.setModified(id, modifiedTime(directory));
+
+    for (const auto& entry : directory_iterator {directory} )
     {
         //cout << "entry=" << entry << '\n';
         if (entry.is_directory())
         {
-            m_directories.push_back(entry);
-            getAllEntries(entry);
+            const auto subdirectory = result.m_index.addDirectory(id, entry.path().filename().native());
+            if (!entry.is_symlink()) getAllEntries(entry.path(), subdirectory, result);//no cycles
         }
         else if (entry.is_regular_file())
         {
-            m_files.push_back(entry);
+            result.m_index.addFile(id, entry.path().filename().native());
         }
     }
     //cout << "Exit: " << __func__ << '\n';
 }
 
 
+/**
+ * The state of the single parallel walk
+ */
+struct Directory::Walk
+{
+    // The entry with the parent, as found by the (other) worker: within its shard
+    struct Pending
+    {
+        DirectoryIndex::Entry m_entry;
+        std::uint32_t m_shard;
+    };
+
+    // The directory walked: within the shard that found it
+    struct Visited
+    {
+        std::uint32_t m_shard;
+        id_t m_id;
+        std::int64_t m_modified;
+    };
+
+    // Per-worker results: aligned to the cache line, to prevent false sharing
+    struct alignas(64) Shard
+    {
+        std::uint32_t m_id = 0;
+        DirectoryIndex::Arena m_arena;
+        std::vector<Pending> m_directories;
+        std::vector<Pending> m_files;
+        std::vector<std::pair<int, Watch>> m_watches;
+        std::vector<std::uint32_t> m_watched;   // the shard of each watched directory
+        std::vector<Visited> m_visited;
+    };
+
+    utils::aot::ThreadPool& m_pool;
+    std::vector<Shard> m_shards;
+    const std::uint64_t m_generation;
+    const int m_inotify; // the watch mode: otherwise -1
+
+    std::atomic<std::size_t> m_claimed {0};  // shards taken by the workers
+    std::atomic<std::size_t> m_pending {0};  // directories posted, but not yet visited
+    std::promise<void> m_done;
+
+    Walk(utils::aot::ThreadPool& pool, std::uint64_t generation, int inotify) :
+        m_pool(pool)
+        , m_shards(pool.size())
+        , m_generation(generation)
+        , m_inotify(inotify)
+    {
+        for (std::size_t i = 0; i < m_shards.size(); ++i) m_shards[i].m_id = static_cast<std::uint32_t>(i);
+    }
+
+    Shard& shard() noexcept
+    {
+        // Each worker claims its shard once per walk
+        thread_local std::uint64_t t_generation = 0;
+        thread_local std::size_t t_index = 0;
+
+        if (t_generation != m_generation)
+        {
+            t_generation = m_generation;
+            t_index = m_claimed.fetch_add(1, std::memory_order_relaxed);
+        }
+        return m_shards[t_index];
+    }
+};
+
+
+void Directory::visit(Walk& walk, const path_t& directory, std::uint32_t shardId, id_t id) noexcept
+{
+    try
+    {
+        auto& shard = walk.shard();
+        if (const auto wd = addWatch(walk.m_inotify, directory); wd >= 0)
+        {
+            shard.m_watches.push_back({wd, Watch{directory, id}});
+            shard.m_watched.push_back(shardId);
+        }
+        shard.m_visited.push_back({shardId, id, modifiedTime(directory)});
+
+        error_code ec;
+        for (directory_iterator it {directory, directory_options::skip_permission_denied, ec}, end; !ec && it != end; it.increment(ec))
+        {
+            const auto& entry = *it;
+            const auto name = shard.m_arena.intern(entry.path().filename().native());
+            const Walk::Pending pending {{name.data(), static_cast<std::uint32_t>(name.size()), id}, shardId};
+
+            if (entry.is_directory(ec))
+            {
+                shard.m_directories.push_back(pending);
+                if (entry.is_symlink(ec)) continue;//no cycles
+
+                // The subdirectory is pushed into the local queue: the idle workers will steal it
+                const auto subdirectory = static_cast<id_t>(shard.m_directories.size() - 1);
+                walk.m_pending.fetch_add(1, std::memory_order_relaxed);
+                walk.m_pool.post([&walk, path = entry.path(), owner = shard.m_id, subdirectory]{ visit(walk, path, owner, subdirectory); });
+            }
+            else if (entry.is_regular_file(ec))
+            {
+                shard.m_files.push_back(pending);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        cerr << directory << ": " << e.what() << '\n';
+    }
+
+    if (1 == walk.m_pending.fetch_sub(1, std::memory_order_acq_rel))
+    {
+        walk.m_done.set_value(); // the last one
+    }
+}
+
+
+void Directory::walkParallel(Result& result)
+{
+    static std::atomic<std::uint64_t> generation {0};
+
+    Walk walk {*m_pPool, generation.fetch_add(1, std::memory_order_relaxed) + 1, m_inotify};
+    auto done = walk.m_done.get_future();
+
+    walk.m_pending.store(1, std::memory_order_relaxed);
+    m_pPool->post([&walk, root = m_root]{ visit(walk, root, 0, DirectoryIndex::root); });
+    done.wait();
+
+    // Merge: the shards one after the other - the parents are remapped by the shard offset
+    std::vector<id_t> offsets;
+    id_t directories = 0;
+    std::size_t files = 0;
+    for (const auto& shard : walk.m_shards)
+    {
+        offsets.push_back(directories);
+        directories += static_cast<id_t>(shard.m_directories.size());
+        files += shard.m_files.size();
+    }
+
+    const auto remap = [&offsets](id_t id, std::uint32_t shard)
+    {
+        return (id == DirectoryIndex::root) ? id : id + offsets[shard];
+    };
+
+    auto& index = result.m_index;
+    for (auto& shard : walk.m_shards)
+    {
+        index.arena().splice(shard.m_arena);
+        for (const auto& [entry, owner] : shard.m_directories) index.addDirectory({entry.m_name, entry.m_length, remap(entry.m_parent, owner)});
+        for (const auto& [entry, owner] : shard.m_files) index.addFile({entry.m_name, entry.m_length, remap(entry.m_parent, owner)});
+
+        for (std::size_t i = 0; i < shard.m_watches.size(); ++i)
+        {
+            auto& [wd, watch] = shard.m_watches[i];
+            watch.m_id = remap(watch.m_id, shard.m_watched[i]);
+            result.m_watches.push_back({wd, std::move(watch)});
+        }
+    }
+
+    for (const auto& shard : walk.m_shards)
+    {
+        for (const auto& visited : shard.m_visited) index.setModified(remap(visited.m_id, visited.m_shard), visited.m_modified);
+    }
+}
+
+
+/**
+ * The entries of the saved index, by parent: the directory's own ones - in the contiguous ranges
+ */
+struct Directory::Children
+{
+    std::vector<std::size_t> m_directoryStart; // per parent: the root is the last one
+    std::vector<std::size_t> m_fileStart;
+    std::vector<id_t> m_directories;
+    std::vector<id_t> m_files;
+
+    explicit Children(const DirectoryIndex& index)
+    {
+        group(index.directories(), index.directories().size(), m_directoryStart, m_directories);
+        group(index.files(), index.directories().size(), m_fileStart, m_files);
+    }
+
+    std::span<const id_t> directories(id_t parent, std::size_t count) const noexcept
+    {
+        return range(m_directoryStart, m_directories, (parent == DirectoryIndex::root) ? count : parent);
+    }
+
+    std::span<const id_t> files(id_t parent, std::size_t count) const noexcept
+    {
+        return range(m_fileStart, m_files, (parent == DirectoryIndex::root) ? count : parent);
+    }
+
+private:
+
+    // The counting sort: O(entries)
+    static void group(std::span<const DirectoryIndex::Entry> entries, std::size_t directories
+            , std::vector<std::size_t>& start, std::vector<id_t>& ids)
+    {
+        const auto slot = [directories](id_t parent) { return (parent == DirectoryIndex::root) ? directories : parent; };
+
+        start.assign(directories + 2, 0);
+        for (const auto& entry : entries) ++start[slot(entry.m_parent) + 1];
+        for (std::size_t i = 1; i < start.size(); ++i) start[i] += start[i - 1];
+
+        ids.resize(entries.size());
+        auto next = start;
+        for (id_t id = 0; id < entries.size(); ++id) ids[next[slot(entries[id].m_parent)]++] = id;
+    }
+
+    static std::span<const id_t> range(const std::vector<std::size_t>& start, const std::vector<id_t>& ids, std::size_t slot) noexcept
+    {
+        return std::span<const id_t>{ids}.subspan(start[slot], start[slot + 1] - start[slot]);
+    }
+};
+
+
+void Directory::reconcile(const DirectoryIndex& saved, const Children& children
+        , id_t savedId, const path_t& directory, id_t id, Result& result) const
+{
+    const auto modified = modifiedTime(directory);
+    if (DirectoryIndex::unvisited == modified) return; // gone
+
+    if (const auto wd = addWatch(m_inotify, directory); wd >= 0) result.m_watches.push_back({wd, Watch{directory, id}});
+    result.m_index.setModified(id, modified);
+
+    const auto count = saved.directories().size();
+    if (modified == saved.modified(savedId))
+    {
+        // Unchanged: the same entries - the names are shared with the saved index
+        for (const auto file : children.files(savedId, count))
+        {
+            const auto& entry = saved.files()[file];
+            result.m_index.addFile({entry.m_name, entry.m_length, id});
+        }
+
+        for (const auto subdirectory : children.directories(savedId, count))
+        {
+            const auto& entry = saved.directories()[subdirectory];
+            const auto newId = result.m_index.addDirectory({entry.m_name, entry.m_length, id});
+            if (DirectoryIndex::unvisited != saved.modified(subdirectory))
+            {
+                reconcile(saved, children, subdirectory, directory / DirectoryIndex::name(entry), newId, result);
+            }
+        }
+        return;
+    }
+
+    // Changed: listed again - the known subdirectories are reconciled, while the new ones are walked
+    std::unordered_map<std::string_view, id_t> known;
+    for (const auto subdirectory : children.directories(savedId, count)) known.emplace(DirectoryIndex::name(saved.directories()[subdirectory]), subdirectory);
+
+    for (const auto& entry : directory_iterator {directory} )
+    {
+        const auto name = entry.path().filename();
+        if (entry.is_directory())
+        {
+            const auto subdirectory = result.m_index.addDirectory(id, name.native());
+            if (entry.is_symlink()) continue;//no cycles
+
+            const auto it = known.find(name.native());
+            if (it != known.end() && DirectoryIndex::unvisited != saved.modified(it->second))
+            {
+                reconcile(saved, children, it->second, entry.path(), subdirectory, result);
+            }
+            else
+            {
+                getAllEntries(entry.path(), subdirectory, result);
+            }
+        }
+        else if (entry.is_regular_file())
+        {
+            result.m_index.addFile(id, name.native());
+        }
+    }
+}
+
+
+void Directory::restore(const path_t& file)
+{
+    std::optional<DirectoryIndex> saved;
+    try
+    {
+        saved.emplace(DirectoryIndex::load(file));
+    }
+    catch (const std::exception& e)
+    {
+        cerr << e.what() << ": the full walk, instead\n";
+    }
+
+    if (!saved || saved->rootPath() != m_root)
+    {
+        walk();
+        return;
+    }
+
+    Result result {DirectoryIndex {m_root}, {}};
+    result.m_index.arena().splice(saved->arena()); // the mapping: kept alive along with the new index
+
+    const Children children {*saved};
+    reconcile(*saved, children, DirectoryIndex::root, m_root, DirectoryIndex::root, result);
+
+    install(std::move(result));
+}
+
+
+void Directory::walk()
+{
+    TRACE_SCOPE("Directory::sync");
+
+    // Rebuild: the previous entries are dropped
+    Result result {DirectoryIndex {m_root}, {}};
+    if (m_pPool)
+    {
+        walkParallel(result);
+    }
+    else
+    {
+        getAllEntries(m_root, DirectoryIndex::root, result);
+    }
+
+    install(std::move(result));
+}
+
+
+void Directory::install(Result&& result)
+{
+    auto index = make_shared<DirectoryIndex>(std::move(result.m_index));
+    {
+        lock_guard<mutex> lock {m_lock};
+
+        m_index = index;
+        if (m_inotify < 0)
+        {
+            // Never updated in place: published as is
+            index->setEpoch(++m_epoch);
+            m_snapshot = std::move(index);
+            return;
+        }
+
+        m_snapshot.reset();
+    }
+
+    // Watch mode: the same directory yields the same watch descriptor - remove only those no longer walked
+    unordered_set<int> walked;
+    for (const auto& watch : result.m_watches) walked.insert(watch.first);
+    for (const auto& watch : m_watches)
+    {
+        if (!walked.contains(watch.first)) (void)::inotify_rm_watch(m_inotify, watch.first);
+    }
+
+    m_watches.clear();
+    m_watchIndex.clear();
+    for (auto& [wd, watch] : result.m_watches)
+    {
+        m_watchIndex[watch.m_path.string()] = wd;
+        m_watches[wd] = std::move(watch);
+    }
+
+    reindex();
+}
+
+
+void Directory::reindex()
+{
+    m_directoryIds.clear();
+    m_fileIds.clear();
+
+    const auto directories = m_index->directories();
+    for (id_t id = 0; id < directories.size(); ++id) m_directoryIds.emplace(key_t {directories[id].m_parent, DirectoryIndex::name(directories[id])}, id);
+
+    const auto files = m_index->files();
+    for (id_t id = 0; id < files.size(); ++id) m_fileIds.emplace(key_t {files[id].m_parent, DirectoryIndex::name(files[id])}, id);
+}
+
+
+void Directory::publish()
+{
+    // The copy: the index itself is still to be updated
+    auto index = make_shared<DirectoryIndex>(m_index->compact());
+    index->setEpoch(++m_epoch);
+    m_snapshot = std::move(index);
+}
+
+
+int Directory::addWatch(int inotify, const path_t& directory) noexcept
+{
+    if (inotify < 0) return -1;
+
+    constexpr std::uint32_t events = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+    return ::inotify_add_watch(inotify, directory.c_str(), events);
+}
+
+
+void Directory::startWatching()
+{
+    if (m_inotify >= 0)
+    {
+        walk(); // already watching: the full rebuild
+        return;
+    }
+
+    m_inotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify < 0) throw system_error(errno, system_category(), "inotify_init1");
+
+    m_wakeup = ::eventfd(0, EFD_CLOEXEC);
+    if (m_wakeup < 0)
+    {
+        const auto error = errno;
+        (void)::close(m_inotify);
+        m_inotify = -1;
+        throw system_error(error, system_category(), "eventfd");
+    }
+
+    walk(); // registers the watches
+    m_watcher = std::thread {&Directory::pollEvents, this};
+}
+
+
+void Directory::pollEvents() noexcept
+{
+    pollfd fds[] = {{m_inotify, POLLIN, 0}, {m_wakeup, POLLIN, 0}};
+
+    for (;;)
+    {
+        if (::poll(fds, 2, -1) < 0)
+        {
+            if (EINTR == errno) continue;
+            cerr << "Directory watch: " << system_category().message(errno) << '\n';
+            return;
+        }
+
+        if (fds[1].revents) return; // stopped
+
+        if (fds[0].revents & POLLIN)
+        {
+            // Suitably aligned: the events are read in place
+            vector<char> events(64 * 1024);
+            const auto bytes = ::read(m_inotify, events.data(), events.size());
+            if (bytes <= 0) continue;
+
+            events.resize(static_cast<std::size_t>(bytes));
+            m_pSyncThread->post([this, events = std::move(events)]{ apply(events); }); // in order, with the walks
+        }
+    }
+}
+
+
+void Directory::apply(const std::vector<char>& events) noexcept
+{
+    try
+    {
+        for (std::size_t offset = 0; offset + sizeof(inotify_event) <= events.size(); )
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(events.data() + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                walk(); // the events are lost: the full rebuild
+                return;
+            }
+
+            const auto it = m_watches.find(event->wd);
+            if (it == m_watches.end()) continue;
+
+            if (event->mask & IN_IGNORED)
+            {
+                m_watchIndex.erase(it->second.m_path.string());
+                m_watches.erase(it);
+                continue;
+            }
+
+            if (0 == event->len) continue;
+            const Watch parent = it->second; // the watches might be updated
+            const std::string_view name {event->name};
+
+            // The rename is applied as the delete, followed by the create
+            if (event->mask & (IN_DELETE | IN_MOVED_FROM)) removeEntry(parent, name);
+            else if (event->mask & (IN_CREATE | IN_MOVED_TO)) addEntry(parent, name);
+        }
+
+        // Reclaim the removed entries, once they outweigh the rest
+        const auto entries = m_index->directories().size() + m_index->files().size();
+        if (m_index->removed() > entries / 2)
+        {
+            std::vector<id_t> remap;
+            auto index = make_shared<DirectoryIndex>(m_index->compact(&remap));
+            for (auto& [wd, watch] : m_watches)
+            {
+                if (watch.m_id != DirectoryIndex::root) watch.m_id = remap[watch.m_id];
+            }
+
+            {
+                lock_guard<mutex> lock {m_lock};
+                m_index = std::move(index); // the published snapshot is left as is
+            }
+            reindex();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        cerr << "Directory watch: " << e.what() << '\n';
+    }
+}
+
+
+void Directory::addEntry(const Watch& parent, std::string_view name)
+{
+    const key_t key {parent.m_id, name};
+    if (m_directoryIds.contains(key) || m_fileIds.contains(key)) return; // already walked
+
+    const auto path = parent.m_path / name;
+
+    error_code ec;
+    const entry_t entry {path, ec};
+    if (ec) return; // already gone
+
+    if (entry.is_directory(ec))
+    {
+        Result result {DirectoryIndex {path}, {}};
+        if (!entry.is_symlink(ec))
+        {
+            // The new (or moved in) subtree: outside of the lock
+            try
+            {
+                getAllEntries(path, DirectoryIndex::root, result);
+            }
+            catch (const filesystem_error&)
+            {
+                // Removed in the meantime: the events will follow
+            }
+        }
+
+        id_t id = 0, offset = 0;
+        std::size_t files = 0;
+        {
+            lock_guard<mutex> lock {m_lock};
+
+            id = m_index->addDirectory(parent.m_id, name);
+            files = m_index->files().size();
+            offset = m_index->merge(std::move(result.m_index), id);
+            m_snapshot.reset();
+        }
+
+        // The names are keyed as interned
+        const auto directories = m_index->directories();
+        for (auto i = id; i < directories.size(); ++i) m_directoryIds.emplace(key_t {directories[i].m_parent, DirectoryIndex::name(directories[i])}, i);
+
+        const auto allFiles = m_index->files();
+        for (auto i = files; i < allFiles.size(); ++i) m_fileIds.emplace(key_t {allFiles[i].m_parent, DirectoryIndex::name(allFiles[i])}, static_cast<id_t>(i));
+
+        for (auto& [wd, watch] : result.m_watches)
+        {
+            watch.m_id = (watch.m_id == DirectoryIndex::root) ? id : watch.m_id + offset;
+            m_watchIndex[watch.m_path.string()] = wd;
+            m_watches[wd] = std::move(watch);
+        }
+    }
+    else if (entry.is_regular_file(ec))
+    {
+        id_t id = 0;
+        {
+            lock_guard<mutex> lock {m_lock};
+
+            id = m_index->addFile(parent.m_id, name);
+            m_snapshot.reset();
+        }
+
+        m_fileIds.emplace(key_t {parent.m_id, DirectoryIndex::name(m_index->files()[id])}, id);
+    }
+}
+
+
+void Directory::removeEntry(const Watch& parent, std::string_view name)
+{
+    const key_t key {parent.m_id, name};
+    if (const auto it = m_fileIds.find(key); it != m_fileIds.end())
+    {
+        {
+            lock_guard<mutex> lock {m_lock};
+
+            m_index->removeFile(it->second);
+            m_snapshot.reset();
+        }
+        m_fileIds.erase(it);
+        return;
+    }
+
+    const auto it = m_directoryIds.find(key);
+    if (it == m_directoryIds.end()) return;
+
+    {
+        lock_guard<mutex> lock {m_lock};
+
+        m_index->removeDirectory(it->second); // with the whole subtree
+        m_snapshot.reset();
+    }
+    m_directoryIds.erase(it);
+
+    // Moved out: the watches of the subtree are still there - the ordered paths, sharing the prefix
+    const auto path = (parent.m_path / name).string();
+    const auto prefix = path + '/';
+
+    auto first = m_watchIndex.lower_bound(prefix);
+    auto last = first;
+    for (; last != m_watchIndex.end() && last->first.starts_with(prefix); ++last)
+    {
+        (void)::inotify_rm_watch(m_inotify, last->second);
+        m_watches.erase(last->second);
+    }
+    m_watchIndex.erase(first, last);
+
+    if (const auto watch = m_watchIndex.find(path); watch != m_watchIndex.end())
+    {
+        (void)::inotify_rm_watch(m_inotify, watch->second);
+        m_watches.erase(watch->second);
+        m_watchIndex.erase(watch);
+    }
+}
+
+
 future<void> Directory::sync()
 {
-    return m_pSyncThread->emplace_enqueue(&Directory::getAllEntries, this, m_root);
+    return m_pSyncThread->emplace_enqueue(&Directory::walk, this);
 }
 
 future<void> Directory::forceSync()
@@ -58,26 +719,60 @@ future<void> Directory::forceSync()
     return sync();
 }
 
+void Directory::save(const path_t& file)
+{
+    snapshot()->save(file);
+}
 
-Directory::entries_t Directory::getAllFiles()
+future<void> Directory::load(const path_t& file)
+{
+    call_once(m_syncOnce, []{}); // the entries are rather synced by the returned future
+    return m_pSyncThread->emplace_enqueue(&Directory::restore, this, file);
+}
+
+future<void> Directory::watch()
+{
+    call_once(m_syncOnce, []{}); // the entries are rather synced by the returned future
+    return m_pSyncThread->emplace_enqueue(&Directory::startWatching, this);
+}
+
+
+Directory::snapshot_t Directory::snapshot()
 {
     call_once(m_syncOnce, [this]{
        const auto f = sync();
        f.wait();
     });
 
-    return m_files;
+    lock_guard<mutex> lock {m_lock};
+    if (!m_index) return make_shared<const DirectoryIndex>(m_root); // not walked: empty
+
+    if (!m_snapshot) publish(); // updated since: once per change, rather than per reader
+    return m_snapshot;
 }
 
 
-Directory::entries_t Directory::getSubdirectories()
+Directory::paths_t Directory::getAllFiles()
 {
-   call_once(m_syncOnce, [this]{
-       const auto f = sync();
-       f.wait();
-   });
+    const auto index = snapshot();
+
+    paths_t files;
+    files.reserve(index->files().size());
+    for (const auto& file : index->files()) files.push_back(index->path(file));
+
+    return files;
+}
+
+
+Directory::paths_t Directory::getSubdirectories()
+{
+    const auto index = snapshot();
+
+    paths_t directories;
+    directories.reserve(index->directories().size());
+    for (const auto& directory : index->directories()) directories.push_back(index->path(directory));
 
-   return m_directories;
+    return directories;
 }
 
 
@@ -86,18 +781,17 @@ namespace utils::files
 {
     void printDirectoryEntries(Directory& directory)
     {
-        auto subdirectories = directory.getSubdirectories();
+        const auto index = directory.snapshot();
         cout << "\n<Directories>:\n\n";
-        for (const auto& dir : subdirectories)
+        for (const auto& dir : index->directories())
         {
-            cout << dir << '\n';
+            cout << index->path(dir) << '\n';
         }
 
-        auto files = directory.getAllFiles();
         cout << "\n<Files>:\n\n";
-        for (const auto& file : files)
+        for (const auto& file : index->files())
         {
-            cout << file << '\n';
+            cout << index->path(file) << '\n';
         }
     }
 }
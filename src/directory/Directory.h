@@ -8,47 +8,198 @@
 #ifndef DS_FILES_DIRECTORY_H_
 #define DS_FILES_DIRECTORY_H_
 
+#include <cstdint>
 #include <filesystem>
-#include <list>
 #include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 #include "../AOT/AOThread_v2.h"
+#include "../AOT/ThreadPool.h"
+#include "DirectoryIndex.h"
+#include "DirectoryStream.h"
 
 namespace utils::files
 {
+    /**
+     * The directory tree, cached into memory: the subdirectories and the regular files
+     *
+     * The entries are kept in the compact index (@see DirectoryIndex), published as the
+     * immutable snapshot of each sync: the readers share it - without copying, and without
+     * being affected by the concurrent sync.
+     *
+     * The tree is walked within the background thread. With the parallelism level above one,
+     * the subdirectories are spread across the pool of workers (work stealing): for the file
+     * systems where the walk is mostly waiting on I/O (i.e: network). Each worker collects
+     * the entries on its own, and the results are merged at the end - without the shared lock.
+     *
+     * In the watch mode, the inotify watches are registered during the walk, and the changes
+     * (create, delete, rename) are applied to the cached entries as they come: O(changes),
+     * rather than O(tree) for each refresh.
+     *
+     * The symbolic links to the directories are listed, but not followed.
+     * The unreadable subdirectories are skipped, in parallel walk.
+     */
     class Directory final
     {
         public:
 
             using entry_t = std::filesystem::directory_entry;
-            using entries_t = std::list<entry_t>;
             using path_t = std::filesystem::path;
+            using paths_t = std::vector<path_t>;
+            using snapshot_t = std::shared_ptr<const DirectoryIndex>;
 
-            explicit Directory(path_t root) noexcept;
+            /**
+             * C-tor
+             *
+             * @param root          The root directory
+             * @param parallelism   The number of workers walking the tree: 1 - sequential walk
+             */
+            explicit Directory(path_t root, std::size_t parallelism = 1) noexcept;
             ~Directory();
 
             std::future<void> forceSync();
 
-            entries_t getSubdirectories();
-            entries_t getAllFiles();
+            /**
+             * Save the index of the latest sync
+             * @note It will throw std::system_error, in case that the file can't be written
+             *
+             * @param file  The file path: replaced atomically
+             */
+            void save(const path_t& file);
+
+            /**
+             * Start from the saved index, reconciled with the file system: only the directories
+             * modified since are listed again, and only the new subdirectories walked
+             *
+             * @param file  The file path
+             * @return The future of the reconciliation, to wait on before reading the entries:
+             * with the full walk instead, in case that the saved index can't be used
+             */
+            std::future<void> load(const path_t& file);
+
+            /**
+             * Enter the watch mode: walk the tree registering the watches,
+             * and keep the cached entries up to date afterwards
+             *
+             * @return The future of the initial walk, to wait on before reading the entries:
+             * std::system_error, in case that the watches can't be set up
+             */
+            std::future<void> watch();
+
+            /**
+             * The index of the latest sync: the copy of the pointer only
+             *
+             * @return The snapshot - immutable, it stays valid across the further syncs
+             */
+            snapshot_t snapshot();
+
+            /**
+             * Stream the entries, as they are found: without waiting for the walk
+             * to complete, and without caching them
+             *
+             * @param capacity  The maximum number of entries buffered, between the walker and the consumer
+             * @return          The stream (single pass) of the entries
+             */
+            DirectoryStream stream(std::size_t capacity = 1024) const
+            {
+                return DirectoryStream {m_root, capacity};
+            }
+
+            /**
+             * The paths materialized from the snapshot: the type is known from the index,
+             * so nothing is queried from the file system
+             */
+            paths_t getSubdirectories();
+            paths_t getAllFiles();
 
         private:
 
+            using id_t = DirectoryIndex::id_t;
+
+            /**
+             * The watched directory
+             */
+            struct Watch
+            {
+                path_t m_path;
+                id_t m_id; // within the index
+            };
+
+            using watches_t = std::vector<std::pair<int, Watch>>;
+
+            /**
+             * The outcome of the walk
+             */
+            struct Result
+            {
+                DirectoryIndex m_index;
+                watches_t m_watches;
+            };
+
             /**
              * Cache the entries (directories/files) into memory
              */
             std::future<void> sync();
-            void getAllEntries(std::filesystem::path root);
+            void walk();
+            void getAllEntries(const path_t& directory, id_t id, Result& result) const;
+
+            static std::int64_t modifiedTime(const path_t& directory) noexcept;
+
+            struct Walk;
+            void walkParallel(Result& result);
+            static void visit(Walk& walk, const path_t& directory, std::uint32_t shard, id_t id) noexcept;
+
+            struct Children;
+            void restore(const path_t& file);
+            void reconcile(const DirectoryIndex& saved, const Children& children
+                    , id_t savedId, const path_t& directory, id_t id, Result& result) const;
+
+            /**
+             * Replace the cached entries with the outcome of the walk
+             */
+            void install(Result&& result);
+
+            // Watch mode
+
+            static int addWatch(int inotify, const path_t& directory) noexcept;
+            void startWatching();
+            void pollEvents() noexcept;
+            void apply(const std::vector<char>& events) noexcept;
+            void addEntry(const Watch& parent, std::string_view name);
+            void removeEntry(const Watch& parent, std::string_view name);
+            void reindex();
+            void publish();
 
         private:
 
             std::filesystem::path m_root;
 
-            entries_t m_directories;
-            entries_t m_files;
+            std::mutex m_lock; // the index: updated within the sync thread, against the readers
+            std::shared_ptr<DirectoryIndex> m_index;
+            snapshot_t m_snapshot;  // published: reset once the index is updated in place
+            std::uint64_t m_epoch = 0;
             std::once_flag m_syncOnce;
 
+            // Watch mode: within the sync thread only - the entries by (parent, name), for O(log n) updates
+            using key_t = std::pair<id_t, std::string_view>;
+            std::map<key_t, id_t> m_directoryIds;
+            std::map<key_t, id_t> m_fileIds;
+            std::unordered_map<int, Watch> m_watches;     // watch descriptor -> directory
+            std::map<std::string, int> m_watchIndex;      // directory -> watch descriptor
+            int m_inotify = -1;
+            int m_wakeup = -1;                            // eventfd: to stop the watcher
+            std::thread m_watcher;                        // reads the events: applied within the sync thread
+
+            std::unique_ptr<utils::aot::ThreadPool> m_pPool; // for the parallel walk
             std::unique_ptr<utils::aot::AOThread> m_pSyncThread;
 
     };
@@ -0,0 +1,424 @@
+/*
+ * DirectoryIndex.cpp
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+
+
+#include "DirectoryIndex.h"
+#include "../FileStreams/MappedInputFile.h"
+
+
+using namespace utils::files;
+using namespace std;
+
+
+namespace
+{
+    /**
+     * The layout of the saved index:
+     * header | root path | directories | modification times | files | names
+     * each of the sections aligned to 8 bytes
+     */
+    struct Header
+    {
+        char m_magic[8];
+        std::uint32_t m_version;
+        std::uint32_t m_rootLength;
+        std::uint64_t m_directories;
+        std::uint64_t m_files;
+        std::uint64_t m_names;
+        std::int64_t m_rootModified;
+    };
+
+    struct Record
+    {
+        std::uint64_t m_offset; // within the names
+        std::uint32_t m_length;
+        std::uint32_t m_parent;
+    };
+
+    constexpr char magic[8] = {'D', 'I', 'R', 'I', 'D', 'X', '0', '1'};
+    constexpr std::uint32_t version = 1;
+
+    constexpr std::size_t aligned(std::size_t size) noexcept
+    {
+        return (size + 7) & ~std::size_t{7};
+    }
+}
+
+
+std::string_view DirectoryIndex::Arena::intern(std::string_view name)
+{
+    if (name.size() > chunk)
+    {
+        // Oversized: the dedicated chunk, ahead of the one being filled
+        auto data = make_unique<char[]>(name.size());
+        memcpy(data.get(), name.data(), name.size());
+        const std::string_view interned {data.get(), name.size()};
+
+        m_chunks.insert(m_chunks.empty() ? m_chunks.end() : prev(m_chunks.end()), std::move(data));
+        m_bytes += name.size();
+        return interned;
+    }
+
+    if (m_used + name.size() > chunk)
+    {
+        m_chunks.push_back(make_unique<char[]>(chunk));
+        m_used = 0;
+    }
+
+    char* data = m_chunks.back().get() + m_used;
+    memcpy(data, name.data(), name.size());
+    m_used += name.size();
+    m_bytes += name.size();
+
+    return {data, name.size()};
+}
+
+void DirectoryIndex::Arena::splice(Arena& other)
+{
+    if (this == &other) return;
+    if (other.m_chunks.empty() && other.m_owners.empty()) return;
+
+    if (m_chunks.empty())
+    {
+        m_used = other.m_used;
+    }
+
+    // The chunk being filled stays the last one
+    const auto position = m_chunks.empty() ? m_chunks.end() : prev(m_chunks.end());
+    m_chunks.insert(position, make_move_iterator(other.m_chunks.begin()), make_move_iterator(other.m_chunks.end()));
+    m_owners.insert(m_owners.end(), make_move_iterator(other.m_owners.begin()), make_move_iterator(other.m_owners.end()));
+    m_bytes += other.m_bytes;
+
+    other.m_chunks.clear();
+    other.m_owners.clear();
+    other.m_used = chunk;
+    other.m_bytes = 0;
+}
+
+void DirectoryIndex::Arena::retain(std::shared_ptr<const void> owner)
+{
+    m_owners.push_back(std::move(owner));
+}
+
+
+DirectoryIndex::DirectoryIndex(path_t root, std::shared_ptr<Arena> arena) :
+        m_root(std::move(root))
+        , m_arena(std::move(arena))
+{}
+
+
+DirectoryIndex::path_t DirectoryIndex::path(const Entry& entry) const
+{
+    // Up to the root: the names in reverse
+    std::vector<std::string_view> names {name(entry)};
+    for (auto parent = entry.m_parent; parent != root; parent = m_directories[parent].m_parent)
+    {
+        names.push_back(name(m_directories[parent]));
+    }
+
+    path_t path = m_root;
+    for (auto it = names.rbegin(); it != names.rend(); ++it) path /= *it;
+
+    return path;
+}
+
+DirectoryIndex::path_t DirectoryIndex::directory(id_t id) const
+{
+    return (id == root) ? m_root : path(m_directories[id]);
+}
+
+std::size_t DirectoryIndex::bytes() const noexcept
+{
+    return (m_directories.capacity() + m_files.capacity()) * sizeof(Entry) + m_modified.capacity() * sizeof(std::int64_t) + m_arena->size();
+}
+
+
+DirectoryIndex::id_t DirectoryIndex::addDirectory(id_t parent, std::string_view name)
+{
+    const auto interned = m_arena->intern(name);
+    return addDirectory({interned.data(), static_cast<std::uint32_t>(interned.size()), parent});
+}
+
+DirectoryIndex::id_t DirectoryIndex::addFile(id_t parent, std::string_view name)
+{
+    const auto interned = m_arena->intern(name);
+    return addFile({interned.data(), static_cast<std::uint32_t>(interned.size()), parent});
+}
+
+DirectoryIndex::id_t DirectoryIndex::addDirectory(const Entry& entry)
+{
+    m_directories.push_back(entry);
+    m_modified.push_back(unvisited);
+    return static_cast<id_t>(m_directories.size() - 1);
+}
+
+DirectoryIndex::id_t DirectoryIndex::addFile(const Entry& entry)
+{
+    m_files.push_back(entry);
+    return static_cast<id_t>(m_files.size() - 1);
+}
+
+
+DirectoryIndex::id_t DirectoryIndex::merge(DirectoryIndex&& other, id_t parent)
+{
+    const auto offset = static_cast<id_t>(m_directories.size());
+    const auto remap = [offset, parent](id_t id) { return (id == root) ? parent : id + offset; };
+
+    m_arena->splice(*other.m_arena);
+
+    m_directories.reserve(m_directories.size() + other.m_directories.size());
+    for (const auto& entry : other.m_directories) m_directories.push_back({entry.m_name, entry.m_length, remap(entry.m_parent)});
+    m_modified.insert(m_modified.end(), other.m_modified.begin(), other.m_modified.end());
+    setModified(parent, other.m_rootModified);
+
+    m_files.reserve(m_files.size() + other.m_files.size());
+    for (const auto& entry : other.m_files) m_files.push_back({entry.m_name, entry.m_length, remap(entry.m_parent)});
+
+    return offset;
+}
+
+
+void DirectoryIndex::removeDirectory(id_t id)
+{
+    if (m_removedDirectories.size() < m_directories.size()) m_removedDirectories.resize(m_directories.size());
+    if (m_removedDirectories[id]) return;
+
+    m_removedDirectories[id] = true;
+    ++m_removed;
+}
+
+void DirectoryIndex::removeFile(id_t id)
+{
+    if (m_removedFiles.size() < m_files.size()) m_removedFiles.resize(m_files.size());
+    if (m_removedFiles[id]) return;
+
+    m_removedFiles[id] = true;
+    ++m_removed;
+}
+
+
+DirectoryIndex DirectoryIndex::compact(std::vector<id_t>* remap) const
+{
+    DirectoryIndex index {m_root, m_arena};
+    index.m_epoch = m_epoch;
+    index.m_rootModified = m_rootModified;
+
+    // The directory survives only with all of its parents: resolved once per directory
+    enum : std::uint8_t { unknown, alive, removed };
+    std::vector<std::uint8_t> state(m_directories.size(), unknown);
+    std::vector<id_t> chain;
+
+    for (id_t id = 0; id < m_directories.size(); ++id)
+    {
+        auto parent = id;
+        chain.clear();
+        while (parent != root && unknown == state[parent])
+        {
+            if (isRemovedDirectory(parent))
+            {
+                state[parent] = removed;
+                break;
+            }
+            chain.push_back(parent);
+            parent = m_directories[parent].m_parent;
+        }
+
+        const auto outcome = (parent == root || alive == state[parent]) ? alive : removed;
+        for (const auto directory : chain) state[directory] = outcome;
+    }
+
+    // The parents may follow their children (i.e: parallel walk): the new ids first
+    std::vector<id_t> ids(m_directories.size(), root);
+    id_t next = 0;
+    for (id_t id = 0; id < m_directories.size(); ++id)
+    {
+        if (alive == state[id]) ids[id] = next++;
+    }
+
+    const auto parentOf = [&ids](const Entry& entry) { return (entry.m_parent == root) ? root : ids[entry.m_parent]; };
+
+    index.m_directories.reserve(next);
+    index.m_modified.reserve(next);
+    for (id_t id = 0; id < m_directories.size(); ++id)
+    {
+        if (alive != state[id]) continue;
+        index.m_directories.push_back({m_directories[id].m_name, m_directories[id].m_length, parentOf(m_directories[id])});
+        index.m_modified.push_back(m_modified[id]);
+    }
+
+    index.m_files.reserve(m_files.size());
+    for (id_t id = 0; id < m_files.size(); ++id)
+    {
+        const auto& file = m_files[id];
+        if (isRemovedFile(id) || (file.m_parent != root && alive != state[file.m_parent])) continue;
+        index.m_files.push_back({file.m_name, file.m_length, parentOf(file)});
+    }
+    index.m_files.shrink_to_fit();
+
+    if (remap) *remap = std::move(ids);
+
+    return index;
+}
+
+
+void DirectoryIndex::save(const path_t& file) const
+{
+    if (m_removed > 0)
+    {
+        compact().save(file);
+        return;
+    }
+
+    const auto& root = m_root.native();
+
+    Header header {};
+    memcpy(header.m_magic, magic, sizeof magic);
+    header.m_version = version;
+    header.m_rootLength = static_cast<std::uint32_t>(root.size());
+    header.m_directories = m_directories.size();
+    header.m_files = m_files.size();
+    header.m_rootModified = m_rootModified;
+
+    // The names are laid out in the order of the entries: the directories, then the files
+    const auto toRecords = [&header](std::span<const Entry> entries)
+    {
+        std::vector<Record> records;
+        records.reserve(entries.size());
+        for (const auto& entry : entries)
+        {
+            records.push_back({header.m_names, entry.m_length, entry.m_parent});
+            header.m_names += entry.m_length;
+        }
+        return records;
+    };
+
+    const auto directories = toRecords(m_directories);
+    const auto files = toRecords(m_files);
+
+    // Into the temporary file first: the previous snapshot stays intact, until replaced
+    auto temporary = file;
+    temporary += ".tmp";
+
+    {
+        ofstream out {temporary, ios_base::binary | ios_base::trunc};
+        if (!out) throw system_error(errno, system_category(), temporary.string());
+
+        const char padding[8] = {};
+        const auto write = [&out, &padding](const void* data, std::size_t size)
+        {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            out.write(padding, static_cast<std::streamsize>(aligned(size) - size));
+        };
+
+        write(&header, sizeof header);
+        write(root.data(), root.size());
+        write(directories.data(), directories.size() * sizeof(Record));
+        write(m_modified.data(), m_modified.size() * sizeof(std::int64_t));
+        write(files.data(), files.size() * sizeof(Record));
+
+        for (const auto& entry : m_directories) out.write(entry.m_name, entry.m_length);
+        for (const auto& entry : m_files) out.write(entry.m_name, entry.m_length);
+
+        out.flush();
+        if (!out) throw system_error(errno, system_category(), temporary.string());
+    }
+
+    std::error_code ec;
+    filesystem::rename(temporary, file, ec);
+    if (ec) throw system_error(ec, file.string());
+}
+
+
+DirectoryIndex DirectoryIndex::load(const path_t& file)
+{
+    using namespace utils::file;
+
+    auto mapping = make_shared<MappedBinaryInputFile>(file, access_t::normal);
+    const auto data = mapping->data();
+
+    const auto malformed = [&file](const char* reason)
+    {
+        return runtime_error(file.string() + ": " + reason);
+    };
+
+    Header header {};
+    if (data.size() < sizeof header) throw malformed("truncated");
+    memcpy(&header, data.data(), sizeof header);
+
+    if (0 != memcmp(header.m_magic, magic, sizeof magic)) throw malformed("not the directory index");
+    if (header.m_version != version) throw malformed("unsupported version");
+
+    // The sections: checked against the file size upfront
+    std::size_t offset = aligned(sizeof header);
+    const auto section = [&offset](std::size_t size)
+    {
+        const auto begin = offset;
+        offset += aligned(size);
+        return begin;
+    };
+
+    if (header.m_directories >= root || header.m_files >= root) throw malformed("too many entries");
+
+    const auto rootPath = section(header.m_rootLength);
+    const auto directories = section(header.m_directories * sizeof(Record));
+    const auto modified = section(header.m_directories * sizeof(std::int64_t));
+    const auto files = section(header.m_files * sizeof(Record));
+    const auto names = section(0);
+    if (offset > data.size() || header.m_names > data.size() - names) throw malformed("truncated");
+
+    const auto* base = reinterpret_cast<const char*>(data.data());
+    DirectoryIndex index {path_t {std::string {base + rootPath, header.m_rootLength}}};
+    index.m_rootModified = header.m_rootModified;
+
+    const auto toEntries = [&](std::size_t from, std::uint64_t count, std::vector<Entry>& entries)
+    {
+        entries.reserve(count);
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            Record record;
+            memcpy(&record, base + from + i * sizeof(Record), sizeof record);
+
+            if (record.m_offset > header.m_names || record.m_length > header.m_names - record.m_offset) throw malformed("name out of range");
+            if (record.m_parent != root && record.m_parent >= header.m_directories) throw malformed("parent out of range");
+
+            entries.push_back({base + names + record.m_offset, record.m_length, record.m_parent});
+        }
+    };
+
+    toEntries(directories, header.m_directories, index.m_directories);
+    toEntries(files, header.m_files, index.m_files);
+
+    // Each directory must lead to the root: no cycles
+    enum : std::uint8_t { unknown, visiting, valid };
+    std::vector<std::uint8_t> state(index.m_directories.size(), unknown);
+    std::vector<id_t> chain;
+    for (id_t id = 0; id < index.m_directories.size(); ++id)
+    {
+        chain.clear();
+        for (auto parent = id; parent != root && valid != state[parent]; parent = index.m_directories[parent].m_parent)
+        {
+            if (visiting == state[parent]) throw malformed("cycle");
+            state[parent] = visiting;
+            chain.push_back(parent);
+        }
+        for (const auto directory : chain) state[directory] = valid;
+    }
+
+    index.m_modified.resize(header.m_directories);
+    memcpy(index.m_modified.data(), base + modified, header.m_directories * sizeof(std::int64_t));
+
+    index.m_arena->retain(std::move(mapping)); // the names are used in place
+
+    return index;
+}
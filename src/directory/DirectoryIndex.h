@@ -0,0 +1,247 @@
+/*
+ * DirectoryIndex.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef DS_FILES_DIRECTORYINDEX_H_
+#define DS_FILES_DIRECTORYINDEX_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace utils::files
+{
+    /**
+     * The compact index of the directory tree: the directories and the regular files,
+     * stored contiguously - each entry with the name and the index of its parent directory.
+     * The names are interned into the append-only arena: the paths are rebuilt on demand,
+     * rather than stored.
+     *
+     * Once published, the index is immutable: it's shared across the readers as the snapshot
+     * of the single epoch (sync), while the next one is being built.
+     *
+     * The index can be saved into the file, and mapped back: the names are used in place,
+     * from the mapping. The modification time of each walked directory is kept along,
+     * for the loaded index to be reconciled with the file system.
+     */
+    class DirectoryIndex final
+    {
+        public:
+
+            using id_t = std::uint32_t;
+            using path_t = std::filesystem::path;
+
+            // The parent of the top-level entries
+            static constexpr id_t root = std::numeric_limits<id_t>::max();
+
+            // The modification time of the directory not walked into (i.e: symbolic link)
+            static constexpr std::int64_t unvisited = -1;
+
+            struct Entry
+            {
+                const char* m_name;     // within the arena: not null-terminated
+                std::uint32_t m_length;
+                id_t m_parent;          // index into the directories, or root
+            };
+
+            /**
+             * Append-only storage for the names: the chunks never move, so the interned
+             * names stay valid for the arena lifetime - across the snapshots that share it
+             */
+            class Arena final
+            {
+                public:
+
+                    Arena() = default;
+                    Arena(const Arena&) = delete;
+                    Arena& operator = (const Arena&) = delete;
+
+                    std::string_view intern(std::string_view name);
+
+                    /**
+                     * Take over the chunks of the other arena: the names interned there stay valid
+                     */
+                    void splice(Arena& other);
+
+                    /**
+                     * Keep alive the external storage of the names: i.e, the file mapping
+                     */
+                    void retain(std::shared_ptr<const void> owner);
+
+                    std::size_t size() const noexcept
+                    {
+                        return m_bytes;
+                    }
+
+                private:
+
+                    static constexpr std::size_t chunk = 64 * 1024;
+
+                    std::vector<std::unique_ptr<char[]>> m_chunks;
+                    std::vector<std::shared_ptr<const void>> m_owners;
+                    std::size_t m_used = chunk; // within the last chunk
+                    std::size_t m_bytes = 0;
+            };
+
+            explicit DirectoryIndex(path_t root, std::shared_ptr<Arena> arena = std::make_shared<Arena>());
+
+            DirectoryIndex(DirectoryIndex&&) noexcept = default;
+            DirectoryIndex& operator = (DirectoryIndex&&) noexcept = default;
+
+            const path_t& rootPath() const noexcept
+            {
+                return m_root;
+            }
+
+            /**
+             * @return The sync this index is the outcome of
+             */
+            std::uint64_t epoch() const noexcept
+            {
+                return m_epoch;
+            }
+
+            void setEpoch(std::uint64_t epoch) noexcept
+            {
+                m_epoch = epoch;
+            }
+
+            std::span<const Entry> directories() const noexcept
+            {
+                return m_directories;
+            }
+
+            std::span<const Entry> files() const noexcept
+            {
+                return m_files;
+            }
+
+            static std::string_view name(const Entry& entry) noexcept
+            {
+                return {entry.m_name, entry.m_length};
+            }
+
+            /**
+             * Rebuild the path of the entry: through its parents
+             */
+            path_t path(const Entry& entry) const;
+            path_t directory(id_t id) const;
+
+            /**
+             * @param id    The directory, or root
+             * @return      The modification time (ns), as sampled before the directory was walked: or unvisited
+             */
+            std::int64_t modified(id_t id) const noexcept
+            {
+                return (id == root) ? m_rootModified : m_modified[id];
+            }
+
+            void setModified(id_t id, std::int64_t modified) noexcept
+            {
+                ((id == root) ? m_rootModified : m_modified[id]) = modified;
+            }
+
+            /**
+             * @return The memory footprint: the entries and the names
+             */
+            std::size_t bytes() const noexcept;
+
+            Arena& arena() noexcept
+            {
+                return *m_arena;
+            }
+
+            // Building
+
+            id_t addDirectory(id_t parent, std::string_view name);
+            id_t addFile(id_t parent, std::string_view name);
+
+            /**
+             * Add the entries with the names already interned into this arena
+             */
+            id_t addDirectory(const Entry& entry);
+            id_t addFile(const Entry& entry);
+
+            /**
+             * Append the index of the subtree, taking over its arena
+             *
+             * @param other     The index rooted at the directory
+             * @param parent    The directory id, within this index
+             * @return          The offset of the subtree directory ids, within this index
+             */
+            id_t merge(DirectoryIndex&& other, id_t parent);
+
+            /**
+             * Mark the entry as removed: with the directory, the whole subtree is removed.
+             * The storage is reclaimed by compact()
+             */
+            void removeDirectory(id_t id);
+            void removeFile(id_t id);
+
+            std::size_t removed() const noexcept
+            {
+                return m_removed;
+            }
+
+            /**
+             * The copy without the removed entries, sharing the arena
+             *
+             * @param remap     The new ids of the directories, or root - if removed
+             */
+            DirectoryIndex compact(std::vector<id_t>* remap = nullptr) const;
+
+            // Persistence: in the native byte order - for the same host
+
+            /**
+             * Save the index, replacing the file atomically
+             * @note It will throw std::system_error, in case that the file can't be written
+             *
+             * @param file  The file path
+             */
+            void save(const path_t& file) const;
+
+            /**
+             * Map the saved index: the entries are rebuilt in the single pass - the names are not copied
+             * @note It will throw std::runtime_error, in case that the file can't be read, or is malformed
+             *
+             * @param file  The file path
+             * @return      The index
+             */
+            static DirectoryIndex load(const path_t& file);
+
+        private:
+
+            bool isRemovedDirectory(id_t id) const noexcept
+            {
+                return id < m_removedDirectories.size() && m_removedDirectories[id];
+            }
+
+            bool isRemovedFile(id_t id) const noexcept
+            {
+                return id < m_removedFiles.size() && m_removedFiles[id];
+            }
+
+        private:
+
+            path_t m_root;
+            std::shared_ptr<Arena> m_arena;
+            std::vector<Entry> m_directories;
+            std::vector<Entry> m_files;
+            std::vector<std::int64_t> m_modified; // per directory
+            std::int64_t m_rootModified = unvisited;
+            std::uint64_t m_epoch = 0;
+
+            // Tombstones
+            std::vector<bool> m_removedDirectories;
+            std::vector<bool> m_removedFiles;
+            std::size_t m_removed = 0;
+    };
+}
+
+#endif /* DS_FILES_DIRECTORYINDEX_H_ */
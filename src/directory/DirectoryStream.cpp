@@ -0,0 +1,115 @@
+/*
+ * DirectoryStream.cpp
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#include <system_error>
+#include <utility>
+#include <vector>
+
+
+#include "DirectoryStream.h"
+
+
+using namespace utils::files;
+using namespace std;
+using namespace std::filesystem;
+
+
+DirectoryStream::DirectoryStream(path_t root, std::size_t capacity) :
+        m_root(std::move(root))
+        , m_capacity(capacity ? capacity : 1)
+{}
+
+
+DirectoryStream::iterator DirectoryStream::begin()
+{
+    if (!m_started)
+    {
+        m_started = true;
+        m_walker = jthread {[this](std::stop_token token) { walk(std::move(token)); }};
+    }
+
+    return (!m_batch.empty() || next()) ? iterator {this} : iterator {};
+}
+
+
+void DirectoryStream::walk(std::stop_token token)
+{
+    try
+    {
+        // Depth-first, without the recursion: the subdirectories pending to be listed
+        vector<path_t> pending {m_root};
+        while (!pending.empty() && !token.stop_requested())
+        {
+            const auto directory = std::move(pending.back());
+            pending.pop_back();
+
+            error_code ec;
+            for (directory_iterator it {directory, directory_options::skip_permission_denied, ec}, end; !ec && it != end; it.increment(ec))
+            {
+                const auto& entry = *it;
+                if (entry.is_directory(ec))
+                {
+                    if (!entry.is_symlink(ec)) pending.push_back(entry.path());//no cycles
+                }
+                else if (!entry.is_regular_file(ec))
+                {
+                    continue;
+                }
+
+                if (!push(entry, token)) return; // stopped
+            }
+
+            if (ec && directory == m_root) throw filesystem_error("directory stream", directory, ec);
+        }
+    }
+    catch (...)
+    {
+        lock_guard<mutex> lock {m_lock};
+        m_error = current_exception();
+    }
+
+    {
+        lock_guard<mutex> lock {m_lock};
+        m_finished = true;
+    }
+    m_notEmpty.notify_one();
+}
+
+
+bool DirectoryStream::push(entry_t entry, const std::stop_token& token)
+{
+    bool wasEmpty = false;
+    {
+        unique_lock<mutex> lock {m_lock};
+        if (!m_notFull.wait(lock, token, [this]{ return m_queue.size() < m_capacity; })) return false;
+
+        wasEmpty = m_queue.empty();
+        m_queue.push_back(std::move(entry));
+    }
+
+    if (wasEmpty) m_notEmpty.notify_one();
+    return true;
+}
+
+
+bool DirectoryStream::next()
+{
+    if (!m_batch.empty()) return true;
+
+    exception_ptr error;
+    {
+        unique_lock<mutex> lock {m_lock};
+        m_notEmpty.wait(lock, [this]{ return m_finished || !m_queue.empty(); });
+
+        // All that is buffered: one lock for the whole batch
+        m_batch.swap(m_queue);
+        if (m_batch.empty()) error = std::exchange(m_error, nullptr);
+    }
+    m_notFull.notify_one();
+
+    if (error) rethrow_exception(error);
+    return !m_batch.empty();
+}
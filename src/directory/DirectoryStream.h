@@ -0,0 +1,147 @@
+/*
+ * DirectoryStream.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef DS_FILES_DIRECTORYSTREAM_H_
+#define DS_FILES_DIRECTORYSTREAM_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace utils::files
+{
+    /**
+     * The directory tree, streamed: the entries (subdirectories and regular files) are yielded
+     * as the background walker finds them - the consumer doesn't wait for the whole walk.
+     * The walker and the consumer are decoupled through the bounded buffer: once it's full,
+     * the walker waits for the consumer to catch up.
+     *
+     * @code
+     * DirectoryStream stream {root};
+     * for (const auto& entry : stream) { ... }
+     * @endcode
+     *
+     * The symbolic links to the directories are yielded, but not followed.
+     * The unreadable subdirectories are skipped: the failure to open the root is rethrown
+     * to the consumer, at the end of the stream.
+     */
+    class DirectoryStream final
+    {
+        public:
+
+            using entry_t = std::filesystem::directory_entry;
+            using path_t = std::filesystem::path;
+
+            class iterator final
+            {
+                public:
+
+                    using iterator_concept = std::input_iterator_tag;
+                    using value_type = entry_t;
+                    using difference_type = std::ptrdiff_t;
+
+                    iterator() = default;
+
+                    const entry_t& operator * () const noexcept
+                    {
+                        return m_pStream->m_batch.front();
+                    }
+
+                    const entry_t* operator -> () const noexcept
+                    {
+                        return &m_pStream->m_batch.front();
+                    }
+
+                    iterator& operator ++ ()
+                    {
+                        m_pStream->m_batch.pop_front();
+                        if (!m_pStream->next()) m_pStream = nullptr;
+                        return *this;
+                    }
+
+                    void operator ++ (int)
+                    {
+                        ++*this;
+                    }
+
+                    friend bool operator == (const iterator& it, std::default_sentinel_t) noexcept
+                    {
+                        return nullptr == it.m_pStream;
+                    }
+
+                private:
+
+                    friend class DirectoryStream;
+
+                    explicit iterator(DirectoryStream* pStream) noexcept : m_pStream(pStream)
+                    {}
+
+                    DirectoryStream* m_pStream = nullptr;
+            };
+
+            /**
+             * C-tor
+             *
+             * @param root      The root directory
+             * @param capacity  The maximum number of entries buffered - on each side
+             */
+            explicit DirectoryStream(path_t root, std::size_t capacity = 1024);
+            ~DirectoryStream() = default; // the walker is stopped, and joined
+
+            DirectoryStream(const DirectoryStream&) = delete;
+            DirectoryStream& operator = (const DirectoryStream&) = delete;
+
+            /**
+             * Start the walk, on the first call: the single pass
+             *
+             * @return The iterator to the next entry
+             */
+            iterator begin();
+
+            std::default_sentinel_t end() const noexcept
+            {
+                return {};
+            }
+
+        private:
+
+            void walk(std::stop_token token);
+            bool push(entry_t entry, const std::stop_token& token);
+
+            /**
+             * Wait for the next entries, if none is buffered on the consumer side
+             * @note It will rethrow the walk failure, once all the entries are consumed
+             *
+             * @return Indication whether there is the next entry
+             */
+            bool next();
+
+        private:
+
+            path_t m_root;
+            const std::size_t m_capacity;
+
+            std::mutex m_lock;
+            std::condition_variable_any m_notFull;
+            std::condition_variable_any m_notEmpty;
+            std::deque<entry_t> m_queue;    // the walker side
+            bool m_finished = false;
+            std::exception_ptr m_error;
+
+            std::deque<entry_t> m_batch;    // the consumer side: taken at once
+            bool m_started = false;
+
+            std::jthread m_walker;          // the last one: stopped first
+    };
+}
+
+#endif /* DS_FILES_DIRECTORYSTREAM_H_ */
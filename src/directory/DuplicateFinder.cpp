@@ -0,0 +1,245 @@
+/*
+ * DuplicateFinder.cpp
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <semaphore>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+
+#include "DuplicateFinder.h"
+#include "../commons/Hash.h"
+#include "../FileStreams/MappedInputFile.h"
+
+
+using namespace utils::files;
+using namespace std;
+
+
+namespace
+{
+    // The first block: read on its own, to rule out the files of the same size
+    constexpr std::size_t block = 4096;
+}
+
+
+/**
+ * The state of the single search
+ */
+class DuplicateFinder::Run final
+{
+    public:
+
+        Run(utils::aot::ThreadPool& pool, std::size_t inFlight, bool indexAll) :
+            m_pool(pool)
+            , m_inFlight(std::max<std::size_t>(inFlight, 1))
+            , m_slots(static_cast<std::ptrdiff_t>(m_inFlight))
+            , m_indexAll(indexAll)
+        {}
+
+        ~Run()
+        {
+            drain(); // the jobs refer to the files
+        }
+
+        void add(path_t path, std::uint64_t size)
+        {
+            if (0 == size) return;
+
+            auto& file = m_files.emplace_back(std::move(path), size);
+            if (m_indexAll)
+            {
+                submit(file, true);
+                return;
+            }
+
+            // The first of the size waits for the other one
+            const auto [it, first] = m_bySize.try_emplace(size, &file);
+            if (first) return;
+
+            if (it->second)
+            {
+                submit(*it->second, false);
+                it->second = nullptr;
+            }
+            submit(file, false);
+        }
+
+        Result finish()
+        {
+            drain();
+
+            if (!m_indexAll)
+            {
+                // Sharing the size and the first block: hashed in full
+                unordered_map<Digest, vector<File*>, DigestHash> candidates;
+                for (auto& file : m_files)
+                {
+                    if (file.m_state == state_t::prefixed) candidates[{file.m_size, file.m_prefix}].push_back(&file);
+                }
+
+                for (const auto& group : candidates)
+                {
+                    if (group.second.size() < 2) continue;
+                    for (auto* file : group.second) submit(*file, true);
+                }
+
+                drain();
+            }
+
+            Result result;
+            for (auto& file : m_files)
+            {
+                if (file.m_state == state_t::hashed) result.m_contents[{file.m_size, file.m_hash}].push_back(std::move(file.m_path));
+            }
+
+            for (const auto& group : result.m_contents)
+            {
+                if (group.second.size() > 1) result.m_duplicates.push_back(group.second);
+            }
+
+            return result;
+        }
+
+    private:
+
+        enum class state_t : std::uint8_t { pending, prefixed, hashed, failed };
+
+        struct File
+        {
+            path_t m_path;
+            std::uint64_t m_size;
+            std::uint64_t m_prefix = 0; // hash of the first block
+            std::uint64_t m_hash = 0;   // hash of the content
+            state_t m_state = state_t::pending;
+
+            File(path_t path, std::uint64_t size) : m_path(std::move(path)), m_size(size)
+            {}
+        };
+
+        void submit(File& file, bool full)
+        {
+            m_slots.acquire(); // bounded: the files being read at once
+            m_pool.post([this, &file, full]
+            {
+                hash(file, full);
+                m_slots.release();
+            });
+        }
+
+        /**
+         * Wait for all the jobs submitted: by taking all the slots
+         */
+        void drain()
+        {
+            for (std::size_t i = 0; i < m_inFlight; ++i) m_slots.acquire();
+            m_slots.release(static_cast<std::ptrdiff_t>(m_inFlight));
+        }
+
+        static void hash(File& file, bool full) noexcept
+        {
+            try
+            {
+                if (!full && file.m_size > block)
+                {
+                    file.m_prefix = hashPrefix(file.m_path);
+                    file.m_state = state_t::prefixed;
+                    return;
+                }
+
+                // The small files: the first block is the whole content
+                const utils::file::MappedBinaryInputFile content {file.m_path, utils::file::access_t::sequential};
+                file.m_hash = utils::xxhash64(std::as_bytes(content.data()));
+                file.m_state = state_t::hashed;
+            }
+            catch (const std::exception& e)
+            {
+                cerr << file.m_path << ": " << e.what() << '\n';
+                file.m_state = state_t::failed;
+            }
+        }
+
+        static std::uint64_t hashPrefix(const path_t& path)
+        {
+            const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) throw system_error(errno, system_category(), "open");
+
+            array<std::byte, block> buffer;
+            ssize_t bytes = 0;
+            do
+            {
+                bytes = ::pread(fd, buffer.data(), buffer.size(), 0);
+            } while (bytes < 0 && EINTR == errno);
+
+            const auto error = errno;
+            (void)::close(fd);
+            if (bytes < 0) throw system_error(error, system_category(), "pread");
+
+            return utils::xxhash64(std::span<const std::byte>{buffer.data(), static_cast<std::size_t>(bytes)});
+        }
+
+    private:
+
+        utils::aot::ThreadPool& m_pool;
+        const std::size_t m_inFlight;
+        std::counting_semaphore<> m_slots;
+        const bool m_indexAll;
+
+        std::deque<File> m_files; // stable: referred to by the jobs
+        std::unordered_map<std::uint64_t, File*> m_bySize; // the first file of the size: until the other one is found
+};
+
+
+DuplicateFinder::DuplicateFinder(std::size_t workers, std::size_t inFlight, bool indexAll) :
+        m_pool(workers)
+        , m_inFlight(inFlight)
+        , m_indexAll(indexAll)
+{
+    if (!m_pool.start()) throw runtime_error("DuplicateFinder: the workers can't be started");
+}
+
+
+DuplicateFinder::Result DuplicateFinder::find(const DirectoryIndex& index)
+{
+    Run run {m_pool, m_inFlight, m_indexAll};
+
+    for (const auto& file : index.files())
+    {
+        // Not following the symbolic links: those are not the copies
+        auto path = index.path(file);
+        struct stat st {};
+        if (0 == ::lstat(path.c_str(), &st) && S_ISREG(st.st_mode)) run.add(std::move(path), static_cast<std::uint64_t>(st.st_size));
+    }
+
+    return run.finish();
+}
+
+
+DuplicateFinder::Result DuplicateFinder::find(DirectoryStream& stream)
+{
+    Run run {m_pool, m_inFlight, m_indexAll};
+
+    error_code ec;
+    for (const auto& entry : stream)
+    {
+        if (!entry.is_regular_file(ec) || entry.is_symlink(ec)) continue; // not the copies
+
+        const auto size = entry.file_size(ec);
+        if (!ec) run.add(entry.path(), size);
+    }
+
+    return run.finish();
+}
@@ -0,0 +1,98 @@
+/*
+ * DuplicateFinder.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef DS_FILES_DUPLICATEFINDER_H_
+#define DS_FILES_DUPLICATEFINDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+#include "../AOT/ThreadPool.h"
+#include "DirectoryIndex.h"
+#include "DirectoryStream.h"
+
+namespace utils::files
+{
+    /**
+     * Finding the files with the same content, over the directory tree.
+     *
+     * The files are grouped by size first: only those sharing the size are read at all.
+     * Of them, the first block is hashed, and only those sharing the size and the first block
+     * are hashed in full (mapped into memory). The hashing is spread across the pool of workers,
+     * with the number of files being read at once bounded - to keep the disks busy,
+     * without thrashing them.
+     *
+     * With the stream as the input, the hashing overlaps the walk: the file is hashed
+     * as soon as the other one of the same size is found.
+     *
+     * @note The content is identified by the size and the 64-bit hash (XXH64), rather than compared
+     * byte by byte. The empty files are not considered.
+     */
+    class DuplicateFinder final
+    {
+        public:
+
+            using path_t = std::filesystem::path;
+            using group_t = std::vector<path_t>;
+
+            /**
+             * The content identity
+             */
+            struct Digest
+            {
+                std::uint64_t m_size;
+                std::uint64_t m_hash;
+
+                bool operator == (const Digest&) const = default;
+            };
+
+            struct DigestHash
+            {
+                std::size_t operator () (const Digest& digest) const noexcept
+                {
+                    return static_cast<std::size_t>(digest.m_hash ^ (digest.m_size * 0x9E3779B97F4A7C15ULL));
+                }
+            };
+
+            struct Result
+            {
+                std::vector<group_t> m_duplicates;   // the files with the same content: two or more
+                std::unordered_map<Digest, group_t, DigestHash> m_contents; // the content index: of the files hashed
+            };
+
+            /**
+             * C-tor
+             *
+             * @param workers   The number of workers hashing the files
+             * @param inFlight  The maximum number of files being read at once
+             * @param indexAll  Indication whether to hash each file - for the complete content index,
+             *                  rather than only the candidates for duplicates
+             */
+            explicit DuplicateFinder(std::size_t workers = std::thread::hardware_concurrency()
+                    , std::size_t inFlight = 16
+                    , bool indexAll = false);
+
+            Result find(const DirectoryIndex& index);
+            Result find(DirectoryStream& stream);
+
+        private:
+
+            class Run;
+
+        private:
+
+            utils::aot::ThreadPool m_pool;
+            const std::size_t m_inFlight;
+            const bool m_indexAll;
+    };
+}
+
+#endif /* DS_FILES_DUPLICATEFINDER_H_ */
@@ -0,0 +1,406 @@
+/*
+ * Benchmark.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef MEASURING_BENCHMARK_H_
+#define MEASURING_BENCHMARK_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#include "Report.h"
+#include "../Thread/ThreadWrapper.h"
+
+namespace utils::measure
+{
+    /**
+     * Keep the value: the computation of it is not to be optimized away as unused
+     */
+    template <typename T>
+    inline void doNotOptimize(T&& value) noexcept
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * The compiler barrier: the stores before are to be done, the loads after - to be repeated
+     */
+    inline void clobberMemory() noexcept
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : : "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /**
+     * The time stamp counter, as the clock (e.g. ElapsedTime<TscClock, std::chrono::nanoseconds>):
+     * the read is the few nanoseconds, without the system call.
+     * The ticks are converted into nanoseconds by the rate, calibrated once against the steady clock.
+     *
+     * @note Meaningful only with the invariant TSC (@see invariant()): the constant rate across
+     *       the frequency changes, and synchronized across the cores. Otherwise, and on the other
+     *       architectures - the steady clock.
+     */
+    class TscClock final
+    {
+        public:
+            using duration = std::chrono::nanoseconds;
+            using rep = duration::rep;
+            using period = duration::period;
+            using time_point = std::chrono::time_point<TscClock>;
+
+            static constexpr bool is_steady = true;
+
+            static time_point now() noexcept
+            {
+                return time_point{duration{static_cast<rep>(static_cast<double>(ticks()) * nsPerTick())}};
+            }
+
+            // The rate: for converting the raw ticks (@see ticks()) off the hot path
+            static double nsPerTick() noexcept
+            {
+                static const double rate = calibrate();
+                return rate;
+            }
+
+            static bool invariant() noexcept
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+                return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8));
+#else
+                return false;
+#endif
+            }
+
+            static std::uint64_t ticks() noexcept
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                static const bool tsc = invariant();
+                if (tsc) [[likely]]
+                {
+                    _mm_lfence(); // not to be executed ahead of the preceding instructions
+                    return __rdtsc();
+                }
+#endif
+                using namespace std::chrono;
+                return static_cast<std::uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+            }
+
+        private:
+
+            // The rate: over the 10ms - once
+            static double calibrate() noexcept
+            {
+                using namespace std::chrono;
+
+                const auto start = steady_clock::now();
+                const auto startTicks = ticks();
+                while (steady_clock::now() - start < 10ms) {}
+                const auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start);
+                const auto elapsedTicks = ticks() - startTicks;
+
+                return elapsedTicks ? static_cast<double>(elapsed.count()) / elapsedTicks : 1.0;
+            }
+    };
+
+    /**
+     * The benchmark configuration
+     */
+    struct BenchmarkOptions
+    {
+        std::chrono::nanoseconds m_warmup {std::chrono::milliseconds{50}};        // before the measurement: caches, branch predictors, frequency
+        std::chrono::nanoseconds m_sampleTime {std::chrono::milliseconds{10}};    // the iterations per sample: calibrated to take at least that long
+        std::size_t m_samples = 31;
+        std::uint64_t m_maxIterations = 1ull << 30;  // per sample: the callable which is optimized away doesn't ever take long
+        std::optional<int> m_core {};   // the core to run on: pinned, through ThreadWrapper::setAffinity
+    };
+
+    /**
+     * The outcome of the benchmark: the time per iteration over the samples, in nanoseconds
+     */
+    struct BenchmarkResult
+    {
+        std::string m_name;
+        std::vector<std::pair<std::string, Result::param_t>> m_params; // the configuration: e.g. the variant, the size
+        std::uint64_t m_iterations = 0; // per sample
+        std::vector<double> m_samples;
+
+        double m_min = 0.0;
+        double m_median = 0.0;
+        double m_p99 = 0.0;
+        double m_mean = 0.0;
+        double m_stddev = 0.0;
+
+        void summarize()
+        {
+            if (m_samples.empty()) return;
+
+            auto sorted = m_samples;
+            std::sort(sorted.begin(), sorted.end());
+
+            const auto rank = [&sorted](double p)
+            {
+                const auto n = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+                return sorted[std::max<std::size_t>(n, 1) - 1];
+            };
+
+            m_min = sorted.front();
+            m_median = rank(50);
+            m_p99 = rank(99);
+            m_mean = std::accumulate(sorted.cbegin(), sorted.cend(), 0.0) / sorted.size();
+
+            const auto squares = std::accumulate(sorted.cbegin(), sorted.cend(), 0.0, [this](double sum, double sample)
+            {
+                return sum + (sample - m_mean) * (sample - m_mean);
+            });
+            m_stddev = sorted.size() > 1 ? std::sqrt(squares / (sorted.size() - 1)) : 0.0;
+        }
+    };
+
+    /**
+     * Microbenchmark harness: for comparing the hot paths, rather than timing the single call.
+     *
+     * - warm-up:       the callable is run for the given time first, unmeasured
+     * - calibration:   the iterations per sample are chosen so that the sample takes long enough,
+     *                  compared to the clock resolution and the cost of reading it
+     * - samples:       repeated, summarized as min/median/p99/mean/stddev of the time per iteration
+     *
+     * @code
+     * Benchmark<TscClock> benchmark {{.m_core = 2}};
+     * benchmark.run("hash", [&key] { return hash(key); }, {{"size", key.size()}});
+     * writeCsv(std::cout, benchmark.results());
+     * @endcode
+     *
+     * @note The value returned by the callable is kept (@see doNotOptimize): otherwise, the callable
+     *       with no observable effect may be measured as nothing
+     * @tparam Clock The clock: steady_clock, or TscClock
+     */
+    template <class Clock = std::chrono::steady_clock>
+    class Benchmark final
+    {
+        public:
+
+            using params_t = std::vector<std::pair<std::string, Result::param_t>>;
+
+            explicit Benchmark(BenchmarkOptions options = {}) : m_options(std::move(options))
+            {}
+
+            /**
+             * @param name      The benchmark name
+             * @param func      The callable: the single iteration
+             * @param params    The configuration, reported along
+             * @return          The outcome, kept in results() as well
+             */
+            template <typename Func>
+            const BenchmarkResult& run(std::string name, Func&& func, params_t params = {})
+            {
+                BenchmarkResult result;
+                result.m_name = std::move(name);
+                result.m_params = std::move(params);
+
+                if (m_options.m_core)
+                {
+                    // Pinned before the warm-up: the thread waits for it
+                    std::atomic<bool> pinned = false;
+                    bool affinity = false;
+
+                    utils::ThreadWrapper thread {[&]
+                    {
+                        pinned.wait(false, std::memory_order_acquire);
+                        measure(func, result);
+                    }};
+
+                    affinity = thread.setAffinity(m_options.m_core);
+                    pinned.store(true, std::memory_order_release);
+                    pinned.notify_one();
+                    thread.join();
+
+                    result.m_params.emplace_back("core", affinity ? std::to_string(*m_options.m_core) : std::string{"unpinned"});
+                }
+                else
+                {
+                    measure(func, result);
+                }
+
+                return m_results.emplace_back(std::move(result));
+            }
+
+            std::span<const BenchmarkResult> results() const noexcept
+            {
+                return m_results;
+            }
+
+        private:
+
+            template <typename Func>
+            static void iterate(Func& func, std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    if constexpr (std::is_void_v<std::invoke_result_t<Func&>>) func();
+                    else doNotOptimize(func());
+                }
+            }
+
+            template <typename Func>
+            static std::chrono::nanoseconds time(Func& func, std::uint64_t iterations)
+            {
+                clobberMemory();
+                const auto start = Clock::now();
+                iterate(func, iterations);
+                clobberMemory();
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            }
+
+            template <typename Func>
+            void measure(Func& func, BenchmarkResult& result) const
+            {
+                using namespace std::chrono;
+
+                // Warm-up
+                for (const auto start = steady_clock::now(); steady_clock::now() - start < m_options.m_warmup; ) iterate(func, 16);
+
+                // Calibration: grow towards the sample time
+                std::uint64_t iterations = 1;
+                for (;;)
+                {
+                    const auto elapsed = time(func, iterations);
+                    if (elapsed >= m_options.m_sampleTime || iterations >= m_options.m_maxIterations) break;
+
+                    const auto scale = elapsed.count() ? 1.2 * m_options.m_sampleTime.count() / elapsed.count() : 10.0;
+                    const auto grown = static_cast<std::uint64_t>(std::ceil(iterations * std::clamp(scale, 1.5, 10.0)));
+                    iterations = std::min(m_options.m_maxIterations, std::max(iterations + 1, grown)); // at least one more
+                }
+
+                result.m_iterations = iterations;
+                result.m_samples.reserve(m_options.m_samples);
+                for (std::size_t i = 0; i < m_options.m_samples; ++i)
+                {
+                    const auto elapsed = time(func, iterations);
+                    result.m_samples.push_back(static_cast<double>(elapsed.count()) / iterations);
+                }
+
+                result.summarize();
+            }
+
+        private:
+            const BenchmarkOptions m_options;
+            std::vector<BenchmarkResult> m_results;
+    };
+
+    /**
+     * The human-readable line
+     */
+    inline std::ostream& operator << (std::ostream& os, const BenchmarkResult& result)
+    {
+        os << result.m_name;
+        for (const auto& [name, value] : result.m_params)
+        {
+            os << ' ' << name << '=';
+            std::visit([&os](const auto& v) { os << v; }, value);
+        }
+
+        return os << ": min/median/p99 " << result.m_min << '/' << result.m_median << '/' << result.m_p99
+                  << " ns, stddev " << result.m_stddev << " ns (" << result.m_samples.size() << " x " << result.m_iterations << ")";
+    }
+
+    /**
+     * The JSON fields of its own, @see writeJson (Report.h): the time per iteration
+     */
+    inline void writeJsonFields(std::ostream& os, const BenchmarkResult& result)
+    {
+        os << "\"iterations\": " << result.m_iterations
+           << ", \"samples\": " << result.m_samples.size()
+           << ", \"ns_per_iteration\": {\"min\": " << result.m_min
+           << ", \"median\": " << result.m_median
+           << ", \"p99\": " << result.m_p99
+           << ", \"mean\": " << result.m_mean
+           << ", \"stddev\": " << result.m_stddev << '}';
+    }
+
+    namespace details
+    {
+        // RFC 4180: quoted, the quotes doubled
+        inline void writeCsvField(std::ostream& os, const std::string& value)
+        {
+            os << '"';
+            for (const char c : value)
+            {
+                if ('"' == c) os << '"';
+                os << c;
+            }
+            os << '"';
+        }
+    }
+
+    /**
+     * Export as CSV: one row per result, the params as "name=value;..."
+     */
+    inline void writeCsv(std::ostream& os, std::span<const BenchmarkResult> results)
+    {
+        os << "name,params,iterations,samples,min_ns,median_ns,p99_ns,mean_ns,stddev_ns\n";
+        for (const auto& result : results)
+        {
+            std::string params;
+            for (const auto& [name, value] : result.m_params)
+            {
+                if (!params.empty()) params += ';';
+                params += name + '=';
+                std::visit([&params](const auto& v)
+                {
+                    if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::string>) params += v;
+                    else params += std::to_string(v);
+                }, value);
+            }
+
+            details::writeCsvField(os, result.m_name);
+            os << ',';
+            details::writeCsvField(os, params);
+            os << ',' << result.m_iterations << ',' << result.m_samples.size()
+               << ',' << result.m_min << ',' << result.m_median << ',' << result.m_p99
+               << ',' << result.m_mean << ',' << result.m_stddev << '\n';
+        }
+    }
+
+    /**
+     * @return Indication whether the file is written
+     */
+    inline bool writeCsv(const char* path, std::span<const BenchmarkResult> results)
+    {
+        std::ofstream out {path};
+        writeCsv(out, results);
+        return static_cast<bool>(out);
+    }
+
+}//namespace utils::measure
+
+#endif /* MEASURING_BENCHMARK_H_ */
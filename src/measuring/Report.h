@@ -0,0 +1,241 @@
+/*
+ * Report.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef MEASURING_REPORT_H_
+#define MEASURING_REPORT_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace utils::measure
+{
+    /**
+     * The stamp for the latency samples: the steady clock, in nanoseconds
+     */
+    inline std::uint64_t timestamp() noexcept
+    {
+        using namespace std::chrono;
+        return static_cast<std::uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * The number of items for about 128 MB moved by each run: within the bounds, for the small and the large ones
+     */
+    constexpr std::size_t items_for(std::size_t itemBytes) noexcept
+    {
+        return std::clamp<std::size_t>((std::size_t{128} << 20) / itemBytes, 2'000, 200'000);
+    }
+
+    /**
+     * The latency samples, in nanoseconds: recorded by one thread, and merged afterwards.
+     * The storage is to be reserved up front, so that recording doesn't allocate on the measured path.
+     */
+    class Samples final
+    {
+        public:
+
+            void reserve(std::size_t count)
+            {
+                m_samples.reserve(count);
+            }
+
+            void record(std::uint64_t ns)
+            {
+                m_samples.push_back(ns);
+                m_sorted = false;
+            }
+
+            void merge(const Samples& other)
+            {
+                m_samples.insert(m_samples.end(), other.m_samples.cbegin(), other.m_samples.cend());
+                m_sorted = false;
+            }
+
+            std::size_t size() const noexcept
+            {
+                return m_samples.size();
+            }
+
+            /**
+             * @param p The percentile: [0, 100]
+             * @return  The nearest-rank value, or zero - if there are no samples
+             */
+            std::uint64_t percentile(double p)
+            {
+                if (m_samples.empty()) return 0;
+                if (!m_sorted)
+                {
+                    std::sort(m_samples.begin(), m_samples.end());
+                    m_sorted = true;
+                }
+
+                const auto rank = static_cast<std::size_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * m_samples.size()));
+                return m_samples[std::max<std::size_t>(rank, 1) - 1];
+            }
+
+        private:
+
+            std::vector<std::uint64_t> m_samples;
+            bool m_sorted = true;
+    };
+
+    /**
+     * The outcome of the single benchmark run: the throughput and the latency distribution
+     */
+    struct Result
+    {
+        using param_t = std::variant<std::uint64_t, std::string>;
+
+        struct Latency
+        {
+            std::uint64_t m_p50 = 0;
+            std::uint64_t m_p99 = 0;
+            std::uint64_t m_p999 = 0;
+            std::uint64_t m_max = 0;
+        };
+
+        std::string m_name;
+        std::vector<std::pair<std::string, param_t>> m_params; // the configuration: e.g. block size, slots
+        std::uint64_t m_items = 0;
+        std::uint64_t m_bytes = 0;
+        std::chrono::nanoseconds m_elapsed {0};
+        Latency m_latency {};   // in nanoseconds
+
+        void summarize(Samples& samples)
+        {
+            m_latency = {samples.percentile(50), samples.percentile(99), samples.percentile(99.9), samples.percentile(100)};
+        }
+
+        double itemsPerSecond() const noexcept
+        {
+            return m_elapsed.count() ? m_items * 1e9 / m_elapsed.count() : 0.0;
+        }
+
+        // MB: 10^6 bytes
+        double megabytesPerSecond() const noexcept
+        {
+            return m_elapsed.count() ? m_bytes * 1e3 / m_elapsed.count() : 0.0;
+        }
+    };
+
+    namespace details
+    {
+        inline void writeString(std::ostream& os, const std::string& value)
+        {
+            os << '"';
+            for (const char c : value)
+            {
+                if ('"' == c || '\\' == c) os << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof escaped, "\\u%04x", static_cast<unsigned>(c));
+                    os << escaped;
+                }
+                else os << c;
+            }
+            os << '"';
+        }
+
+        inline void writeParam(std::ostream& os, const Result::param_t& param)
+        {
+            std::visit([&os](const auto& value)
+            {
+                if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string>) writeString(os, value);
+                else os << value;
+            }, param);
+        }
+    }
+
+    /**
+     * The human-readable line
+     */
+    inline std::ostream& operator << (std::ostream& os, const Result& result)
+    {
+        os << result.m_name;
+        for (const auto& [name, value] : result.m_params)
+        {
+            os << ' ' << name << '=';
+            std::visit([&os](const auto& v) { os << v; }, value);
+        }
+
+        return os << ": " << result.itemsPerSecond() << " items/s, " << result.megabytesPerSecond() << " MB/s"
+                  << ", latency p50/p99/p99.9 " << result.m_latency.m_p50 << '/' << result.m_latency.m_p99
+                  << '/' << result.m_latency.m_p999 << " ns";
+    }
+
+    /**
+     * The fields of the result beside its name and params: found by ADL, for each kind of the result
+     */
+    inline void writeJsonFields(std::ostream& os, const Result& result)
+    {
+        os << "\"items\": " << result.m_items
+           << ", \"bytes\": " << result.m_bytes
+           << ", \"elapsed_ns\": " << result.m_elapsed.count()
+           << ", \"items_per_s\": " << result.itemsPerSecond()
+           << ", \"mb_per_s\": " << result.megabytesPerSecond()
+           << ", \"latency_ns\": {\"p50\": " << result.m_latency.m_p50
+           << ", \"p99\": " << result.m_latency.m_p99
+           << ", \"p99.9\": " << result.m_latency.m_p999
+           << ", \"max\": " << result.m_latency.m_max << '}';
+    }
+
+    /**
+     * Export as the JSON array of the results: for tracking the regressions across the commits.
+     * The same format for any kind of the result: {"name": ..., "params": {...}, the fields of its own}
+     */
+    template <typename Results>
+    requires requires (std::ostream& os, const Results& results) { writeJsonFields(os, *std::ranges::begin(results)); }
+    void writeJson(std::ostream& os, const Results& results)
+    {
+        os << "[\n";
+        for (auto it = std::ranges::begin(results); it != std::ranges::end(results); )
+        {
+            const auto& result = *it;
+
+            os << "  {\"name\": ";
+            details::writeString(os, result.m_name);
+            os << ", \"params\": {";
+            for (std::size_t p = 0; p < result.m_params.size(); ++p)
+            {
+                if (p) os << ", ";
+                details::writeString(os, result.m_params[p].first);
+                os << ": ";
+                details::writeParam(os, result.m_params[p].second);
+            }
+            os << "}, ";
+            writeJsonFields(os, result);
+            os << (++it != std::ranges::end(results) ? "},\n" : "}\n");
+        }
+        os << "]\n";
+    }
+
+    /**
+     * @return Indication whether the file is written
+     */
+    template <typename Results>
+    bool writeJson(const char* path, const Results& results)
+    {
+        std::ofstream out {path};
+        writeJson(out, results);
+        return static_cast<bool>(out);
+    }
+
+}//namespace utils::measure
+
+#endif /* MEASURING_REPORT_H_ */
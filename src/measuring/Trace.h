@@ -0,0 +1,548 @@
+/*
+ * Trace.h
+ *
+ *  Created on: Oct 14, 2026
+ */
+
+#ifndef MEASURING_TRACE_H_
+#define MEASURING_TRACE_H_
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../commons/SpscQueue.h"
+#include "../Logging/file/DataLogger.h"
+
+namespace utils::measure::trace
+{
+    /**
+     * The span, as written into the per-thread ring: fixed-size - no formatting on the hot path.
+     * The names are registered once per call site, and referred by id.
+     */
+    struct Record
+    {
+        std::uint64_t m_start;      // TscClock::ticks(): in nanoseconds - once drained
+        std::uint64_t m_duration;
+        std::uint32_t m_name;
+        std::uint32_t m_thread;
+    };
+
+    /**
+     * Registry of the span names: append-only
+     */
+    class Registry final
+    {
+        public:
+
+            static Registry& instance()
+            {
+                static Registry registry;//Scott Meyers singleton pattern
+                return registry;
+            }
+
+            std::uint32_t add(std::string name)
+            {
+                std::lock_guard<std::mutex> lock {m_lock};
+                m_names.push_back(std::move(name));
+                return static_cast<std::uint32_t>(m_names.size() - 1);
+            }
+
+            // Stable references: std::deque doesn't move the elements on push_back
+            const std::string& name(std::uint32_t id)
+            {
+                std::lock_guard<std::mutex> lock {m_lock};
+                return m_names.at(id);
+            }
+
+        private:
+
+            Registry() = default;
+
+        private:
+
+            std::mutex m_lock;
+            std::deque<std::string> m_names;
+    };
+
+    /**
+     * The tracing backend.
+     *
+     * The spans are pushed into the lock-free SPSC ring of the thread - dropped (and reported), if it's full.
+     * The background drainer collects them periodically, encodes them along with the definitions of
+     * the names, and hands them over to the binary sink: i.e. FileLogger<uint8_t>, that writes them
+     * within its own thread. @see convert() - for the Chrome/Perfetto trace JSON.
+     *
+     * The thread names (@see ThreadWrapper::setName) are picked up when the thread writes its first span,
+     * on flush() - for the running threads, and when the thread exits.
+     *
+     * Binary trace format (native byte order):
+     *  "TRC1\n"
+     *  'N' id:u32 length:u16 name                          - the span name, before first use
+     *  'T' id:u32 length:u16 name                          - the thread name: the latest one wins
+     *  'S' start:u64 duration:u64 name:u32 thread:u32      - the span
+     */
+    class Tracer final
+    {
+            static constexpr std::size_t ring_capacity = 4096;
+
+            struct Ring
+            {
+                utils::SpscQueue<Record, ring_capacity> m_records;
+
+                std::mutex m_lock; // the name: against the thread exit
+                const pthread_t m_handle = pthread_self();
+                const std::uint32_t m_thread;
+                std::string m_name;
+                bool m_closed = false;
+
+                explicit Ring(std::uint32_t thread) : m_thread(thread)
+                {
+                    refreshName();
+                }
+
+                // Within the thread itself, or while it's alive: under the lock
+                void refreshName()
+                {
+                    char name[16] = {'\0'};
+                    if (0 == pthread_getname_np(m_handle, name, sizeof(name))) m_name = name;
+                }
+            };
+
+            struct RingHolder
+            {
+                std::shared_ptr<Ring> m_pRing = nullptr;
+
+                ~RingHolder()
+                {
+                    if (!m_pRing) return;
+
+                    std::lock_guard<std::mutex> lock {m_pRing->m_lock};
+                    m_pRing->refreshName();
+                    m_pRing->m_closed = true;
+                }
+            };
+
+        public:
+
+            using sink_t = utils::log::ILoggerR<std::vector<std::uint8_t>>;
+
+            static Tracer& instance()
+            {
+                static Tracer tracer;//Scott Meyers singleton pattern
+                return tracer;
+            }
+
+            ~Tracer()
+            {
+                stop();
+            }
+
+            Tracer(const Tracer&) = delete;
+            Tracer& operator = (const Tracer&) = delete;
+
+            /**
+             * Start tracing: the spans are recorded from now on
+             *
+             * @param sink      The binary sink - e.g. FileLogger<uint8_t>: shared, so that it outlives the drainer
+             * @param period    The drain period
+             * @return          Indication of the operation outcome: false, if already started
+             */
+            bool start(std::shared_ptr<sink_t> sink, std::chrono::milliseconds period = std::chrono::milliseconds{10})
+            {
+                std::lock_guard<std::mutex> lock {m_drainLock};
+                if (m_drainer.joinable() || !sink) return false;
+
+                m_pSink = std::move(sink);
+                m_sinkObject.store(dynamic_cast<const void*>(m_pSink.get()), std::memory_order_release);
+                m_period = period;
+                m_stop = false;
+                m_definedNames.clear();
+                m_definedThreads.clear();
+
+                const char header[] = "TRC1\n";
+                m_pSink->log(std::vector<std::uint8_t>(header, header + sizeof(header) - 1));
+
+                m_drainer = std::thread(&Tracer::drain, this);
+                s_enabled.store(true, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * Stop tracing: the spans recorded so far are handed over to the sink
+             */
+            void stop()
+            {
+                s_enabled.store(false, std::memory_order_release);
+                {
+                    std::lock_guard<std::mutex> lock {m_drainLock};
+                    if (!m_drainer.joinable()) return;
+                    m_stop = true;
+                }
+                m_wakeUp.notify_one();
+                m_drainer.join();
+
+                std::lock_guard<std::mutex> lock {m_drainLock};
+                m_sinkObject.store(nullptr, std::memory_order_release);
+                m_pSink.reset();
+            }
+
+            /**
+             * Drain the spans recorded so far, with the current thread names
+             */
+            void flush()
+            {
+                std::unique_lock<std::mutex> lock {m_drainLock};
+                if (!m_drainer.joinable()) return;
+
+                const auto requested = ++m_flushRequested;
+                m_wakeUp.notify_one();
+                m_flushed.wait(lock, [this, requested] { return m_flushedCount >= requested || m_stop; });
+            }
+
+            static bool enabled() noexcept
+            {
+                return s_enabled.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * Whether the spans of the calling thread are recorded: not, once it has been muted
+             */
+            static bool recording() noexcept
+            {
+                return enabled() && !t_muted;
+            }
+
+            /**
+             * Stop recording the spans of the calling thread: i.e. the one writing the trace itself,
+             * so that the tracer doesn't trace its own output
+             */
+            static void mute() noexcept
+            {
+                t_muted = true;
+            }
+
+            /**
+             * @param logger    The logger: its most derived object
+             * @return          Indication whether it is the sink of the trace
+             */
+            bool isSink(const void* logger) const noexcept
+            {
+                return logger && m_sinkObject.load(std::memory_order_acquire) == logger;
+            }
+
+            /**
+             * Producer side: hand over the span, without blocking
+             */
+            void push(Record record) noexcept
+            {
+                auto& ring = local();
+                record.m_thread = ring.m_thread;
+                if (!ring.m_records.try_push(record)) m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+
+        private:
+
+            Tracer() = default;
+
+            Ring& local()
+            {
+                thread_local RingHolder holder;
+                if (!holder.m_pRing)
+                {
+                    std::lock_guard<std::mutex> lock {m_lock};
+                    holder.m_pRing = std::make_shared<Ring>(m_threads++);
+                    m_rings.push_back(holder.m_pRing);
+                }
+                return *holder.m_pRing;
+            }
+
+            void drain()
+            {
+                std::vector<std::shared_ptr<Ring>> rings;
+                std::vector<std::uint8_t> bytes;
+
+                const double nsPerTick = TscClock::nsPerTick();
+
+                for (bool stop = false; !stop; )
+                {
+                    std::uint64_t flushRequested = 0;
+                    {
+                        std::unique_lock<std::mutex> lock {m_drainLock};
+                        m_wakeUp.wait_for(lock, m_period, [this] { return m_stop || m_flushRequested > m_flushedCount; });
+                        stop = m_stop;
+                        flushRequested = m_flushRequested;
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock {m_lock};
+                        rings = m_rings;
+                    }
+
+                    const bool refresh = stop || flushRequested > m_flushedCount;
+                    for (const auto& ring : rings)
+                    {
+                        writeThread(*ring, refresh, bytes);
+                        ring->m_records.consume_all([this, &bytes, nsPerTick](Record&& record)
+                        {
+                            record.m_start = static_cast<std::uint64_t>(record.m_start * nsPerTick);
+                            record.m_duration = static_cast<std::uint64_t>(record.m_duration * nsPerTick);
+                            writeSpan(record, bytes);
+                        });
+                    }
+
+                    if (!bytes.empty())
+                    {
+                        m_pSink->log(std::move(bytes));
+                        bytes = {};
+                    }
+
+                    if (const auto dropped = m_dropped.exchange(0, std::memory_order_relaxed); dropped > 0)
+                    {
+                        std::fprintf(stderr, "<Tracer>: %zu span(s) dropped\n", dropped);
+                    }
+
+                    rings.clear();
+                    {
+                        std::lock_guard<std::mutex> lock {m_lock};
+                        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [](const auto& ring)
+                        {
+                            std::lock_guard<std::mutex> ringLock {ring->m_lock};
+                            return ring->m_closed && ring->m_records.empty();
+                        }), m_rings.end());
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock {m_drainLock};
+                        m_flushedCount = std::max(m_flushedCount, flushRequested);
+                    }
+                    m_flushed.notify_all();
+                }
+            }
+
+            // The name of the thread: whenever it changes
+            void writeThread(Ring& ring, bool refresh, std::vector<std::uint8_t>& bytes)
+            {
+                std::string name;
+                {
+                    std::lock_guard<std::mutex> lock {ring.m_lock};
+                    if (refresh && !ring.m_closed) ring.refreshName();
+                    name = ring.m_name;
+                }
+
+                auto [it, added] = m_definedThreads.try_emplace(ring.m_thread, name);
+                if (!added && it->second == name) return;
+
+                it->second = name;
+                writeDefinition('T', ring.m_thread, name, bytes);
+            }
+
+            void writeSpan(const Record& record, std::vector<std::uint8_t>& bytes)
+            {
+                if (record.m_name >= m_definedNames.size()) m_definedNames.resize(record.m_name + 1, false);
+                if (!m_definedNames[record.m_name])
+                {
+                    writeDefinition('N', record.m_name, Registry::instance().name(record.m_name), bytes);
+                    m_definedNames[record.m_name] = true;
+                }
+
+                raw("S", 1, bytes);
+                raw(&record.m_start, sizeof(record.m_start), bytes);
+                raw(&record.m_duration, sizeof(record.m_duration), bytes);
+                raw(&record.m_name, sizeof(record.m_name), bytes);
+                raw(&record.m_thread, sizeof(record.m_thread), bytes);
+            }
+
+            static void writeDefinition(char type, std::uint32_t id, const std::string& name, std::vector<std::uint8_t>& bytes)
+            {
+                const auto length = static_cast<std::uint16_t>(std::min<std::size_t>(name.size(), UINT16_MAX));
+
+                raw(&type, 1, bytes);
+                raw(&id, sizeof(id), bytes);
+                raw(&length, sizeof(length), bytes);
+                raw(name.data(), length, bytes);
+            }
+
+            static void raw(const void* data, std::size_t size, std::vector<std::uint8_t>& bytes)
+            {
+                const auto* p = static_cast<const std::uint8_t*>(data);
+                bytes.insert(bytes.end(), p, p + size);
+            }
+
+        private:
+
+            static inline std::atomic<bool> s_enabled {false};
+            static inline thread_local bool t_muted = false;
+
+            std::mutex m_lock; // guards only the rings registry
+            std::vector<std::shared_ptr<Ring>> m_rings;
+            std::uint32_t m_threads = 0;
+
+            std::atomic<std::size_t> m_dropped {0};
+
+            // Within the drainer only
+            std::vector<bool> m_definedNames;
+            std::unordered_map<std::uint32_t, std::string> m_definedThreads;
+
+            std::mutex m_drainLock;
+            std::condition_variable m_wakeUp;
+            std::condition_variable m_flushed;
+            std::shared_ptr<sink_t> m_pSink = nullptr;
+            std::atomic<const void*> m_sinkObject {nullptr};
+            std::chrono::milliseconds m_period {10};
+            bool m_stop = false;
+            std::uint64_t m_flushRequested = 0;
+            std::uint64_t m_flushedCount = 0;
+            std::thread m_drainer;
+    };
+
+    /**
+     * The scoped span: the same as Measure::ScopeElapsedTime, with the start recorded as well.
+     * Only the raw ticks are read on the hot path: converted by the drainer.
+     * Nothing is recorded, unless the tracer is started.
+     */
+    class Span final
+    {
+        public:
+
+            explicit Span(std::uint32_t name) noexcept : m_name(name)
+            {
+                if (Tracer::recording()) m_start = TscClock::ticks();
+            }
+
+            ~Span()
+            {
+                if (0 == m_start || !Tracer::recording()) return; // muted within the span: i.e. the job writing the trace
+
+                const auto end = TscClock::ticks();
+                Tracer::instance().push(Record{m_start, end - m_start, m_name, 0});
+            }
+
+            Span(const Span&) = delete;
+            Span& operator = (const Span&) = delete;
+
+        private:
+
+            const std::uint32_t m_name;
+            std::uint64_t m_start = 0;
+    };
+
+    /**
+     * Convert the binary trace into the Chrome trace event format (JSON):
+     * for chrome://tracing, or https://ui.perfetto.dev
+     *
+     * @param in    The binary trace, @see Tracer
+     * @param out   The JSON output
+     * @return      Indication of the operation outcome: false, if the input is not the trace, or truncated
+     */
+    inline bool convert(std::istream& in, std::ostream& out)
+    {
+        const auto read = [&in](void* data, std::size_t size)
+        {
+            return static_cast<bool>(in.read(static_cast<char*>(data), static_cast<std::streamsize>(size)));
+        };
+
+        char magic[5] = {};
+        if (!read(magic, sizeof(magic)) || 0 != std::memcmp(magic, "TRC1\n", sizeof(magic))) return false;
+
+        std::unordered_map<std::uint32_t, std::string> names;
+        std::unordered_map<std::uint32_t, std::string> threads;
+        std::vector<Record> spans;
+
+        for (char type = 0; read(&type, 1); )
+        {
+            if ('S' == type)
+            {
+                Record record {};
+                if (!(read(&record.m_start, sizeof(record.m_start)) && read(&record.m_duration, sizeof(record.m_duration))
+                        && read(&record.m_name, sizeof(record.m_name)) && read(&record.m_thread, sizeof(record.m_thread)))) return false;
+
+                spans.push_back(record);
+                continue;
+            }
+
+            std::uint32_t id = 0;
+            std::uint16_t length = 0;
+            if (('N' != type && 'T' != type) || !read(&id, sizeof(id)) || !read(&length, sizeof(length))) return false;
+
+            std::string name(length, '\0');
+            if (!read(name.data(), length)) return false;
+
+            ('N' == type ? names : threads)[id] = std::move(name);
+        }
+
+        // Relative to the first span: microseconds, as expected by the format
+        std::uint64_t base = UINT64_MAX;
+        for (const auto& span : spans) base = std::min(base, span.m_start);
+
+        const auto micros = [&out](std::uint64_t ns)
+        {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.3f", ns / 1e3);
+            out << text;
+        };
+
+        out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+
+        bool first = true;
+        for (const auto& [id, name] : threads)
+        {
+            out << (first ? "  " : ",\n  ") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << id << ", \"args\": {\"name\": ";
+            utils::measure::details::writeString(out, name.empty() ? "thread-" + std::to_string(id) : name);
+            out << "}}";
+            first = false;
+        }
+
+        for (const auto& span : spans)
+        {
+            const auto it = names.find(span.m_name);
+
+            out << (first ? "  " : ",\n  ") << "{\"name\": ";
+            utils::measure::details::writeString(out, it != names.end() ? it->second : "span-" + std::to_string(span.m_name));
+            out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << span.m_thread << ", \"ts\": ";
+            micros(span.m_start - base);
+            out << ", \"dur\": ";
+            micros(span.m_duration);
+            out << '}';
+            first = false;
+        }
+
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+
+}//namespace utils::measure::trace
+
+/**
+ * TRACE_SCOPE("name"): the span over the rest of the scope.
+ * Compiled in only with MEASURE_ENABLE_TRACING defined - otherwise, nothing is left
+ */
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#if defined(MEASURE_ENABLE_TRACING)
+#define TRACE_SCOPE(name)                                                                                                       \
+    static const std::uint32_t TRACE_CONCAT(trace_name_, __LINE__) = ::utils::measure::trace::Registry::instance().add(name); \
+    const ::utils::measure::trace::Span TRACE_CONCAT(trace_span_, __LINE__) {TRACE_CONCAT(trace_name_, __LINE__)}
+#elif !defined(TRACE_SCOPE)
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif /* MEASURING_TRACE_H_ */
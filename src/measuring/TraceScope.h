@@ -0,0 +1,20 @@
+/*
+ * TraceScope.h
+ *
+ *  Created on: Oct 15, 2026
+ */
+
+#ifndef MEASURING_TRACESCOPE_H_
+#define MEASURING_TRACESCOPE_H_
+
+/**
+ * TRACE_SCOPE("name") only: for the core headers, which are not to depend on the tracer.
+ * The tracer itself is pulled in only with MEASURE_ENABLE_TRACING defined, @see Trace.h
+ */
+#if defined(MEASURE_ENABLE_TRACING)
+#include "Trace.h"
+#elif !defined(TRACE_SCOPE)
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif /* MEASURING_TRACESCOPE_H_ */
@@ -0,0 +1,49 @@
+/*
+ * TraceToChrome.cpp
+ *
+ *  Created on: Oct 14, 2026
+ *
+ *  Offline converter of the binary trace, written by the Tracer into the Chrome trace JSON:
+ *  open it with chrome://tracing, or https://ui.perfetto.dev
+ *  Usage: TraceToChrome <binary trace> [output json: stdout by default]
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "Trace.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <binary trace> [output json]\n";
+        return 1;
+    }
+
+    std::ifstream in {argv[1], std::ios::binary};
+    if (!in)
+    {
+        std::cerr << "Failed to open: " << argv[1] << '\n';
+        return 1;
+    }
+
+    std::ofstream file;
+    if (argc > 2)
+    {
+        file.open(argv[2]);
+        if (!file)
+        {
+            std::cerr << "Failed to open: " << argv[2] << '\n';
+            return 1;
+        }
+    }
+
+    if (!utils::measure::trace::convert(in, argc > 2 ? file : std::cout))
+    {
+        std::cerr << "Not the trace, or truncated: " << argv[1] << '\n';
+        return 1;
+    }
+
+    return 0;
+}